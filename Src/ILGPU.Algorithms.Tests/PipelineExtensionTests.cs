@@ -0,0 +1,95 @@
+﻿using ILGPU.Algorithms.ScanReduceOperations;
+using ILGPU.Algorithms.Sequencers;
+using ILGPU.Tests;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace ILGPU.Algorithms.Tests
+{
+    public abstract partial class PipelineExtensionTests : TestBase
+    {
+        protected PipelineExtensionTests(
+            ITestOutputHelper output,
+            TestContext testContext)
+            : base(output, testContext)
+        { }
+
+        #region MemberData
+
+        public static TheoryData<object> TestDataLength =>
+            new TheoryData<object>
+        {
+            { 1 },
+            { 31 },
+            { 33 },
+            { 127 },
+            { 1027 },
+        };
+
+        #endregion
+
+        [Theory]
+        [MemberData(nameof(TestDataLength))]
+        public void PipelineStore(int length)
+        {
+            using var stream = Accelerator.CreateStream();
+            using var input = Accelerator.Allocate1D<int>(length);
+            using var output = Accelerator.Allocate1D<long>(length);
+
+            var sequence = new Int32TestSequencer().ComputeSequence(42, 1, length);
+            input.CopyFromCPU(stream, sequence);
+
+            Accelerator.CreatePipeline(input.View)
+                .Map(new IntToNegIntTransformer())
+                .Map<long, IntToLongTransformer>(new IntToLongTransformer())
+                .Store(stream, output.View);
+
+            stream.Synchronize();
+            Verify(output.View, sequence.Select(x => (long)-x).ToArray());
+        }
+
+        [Theory]
+        [MemberData(nameof(TestDataLength))]
+        public void PipelineReduce(int length)
+        {
+            using var stream = Accelerator.CreateStream();
+            var result = Accelerator.CreateSequencePipeline<Index1D, IndexSequencer>(
+                length,
+                default)
+                .Map<int, IndexToInt32Transformer>(default)
+                .Map(new IntToNegIntTransformer())
+                .Reduce<AddInt32>(stream);
+
+            Assert.Equal(-Enumerable.Range(0, length).Sum(), result);
+        }
+
+        [Theory]
+        [MemberData(nameof(TestDataLength))]
+        public void PipelineScan(int length)
+        {
+            using var stream = Accelerator.CreateStream();
+            using var input = Accelerator.Allocate1D<int>(length);
+            using var output = Accelerator.Allocate1D<int>(length);
+            using var temp = Accelerator.Allocate1D<int>(
+                Accelerator.ComputeScanTempStorageSize<int>(length));
+
+            var sequence = new Int32TestSequencer().ComputeSequence(1, 1, length);
+            input.CopyFromCPU(stream, sequence);
+
+            Accelerator.CreatePipeline(input.View)
+                .Map(new IntToNegIntTransformer())
+                .Scan<AddInt32>(stream, ScanKind.Inclusive, output.View, temp.View);
+
+            stream.Synchronize();
+            int sum = 0;
+            var expected = sequence.Select(x => sum -= x).ToArray();
+            Verify(output.View, expected);
+        }
+    }
+
+    internal readonly struct IndexToInt32Transformer : ITransformer<Index1D, int>
+    {
+        public int Transform(Index1D value) => value.X;
+    }
+}
@@ -0,0 +1,662 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                   ILGPU.Algorithms
+//                      Copyright (c) 2020 ILGPU Algorithms Project
+//                                    www.ilgpu.net
+//
+// File: PipelineExtensions.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.Algorithms.Resources;
+using ILGPU.Algorithms.ScanReduceOperations;
+using ILGPU.Algorithms.Sequencers;
+using ILGPU.Runtime;
+using System;
+using System.Runtime.CompilerServices;
+
+namespace ILGPU.Algorithms
+{
+    /// <summary>
+    /// Represents an abstract source of a fused pipeline.
+    /// </summary>
+    /// <typeparam name="T">The element type.</typeparam>
+    public interface IPipelineSource<T>
+        where T : unmanaged
+    {
+        /// <summary>
+        /// Returns the number of elements.
+        /// </summary>
+        long Length { get; }
+
+        /// <summary>
+        /// Loads the element with the given index.
+        /// </summary>
+        /// <param name="index">The element index.</param>
+        /// <returns>The loaded element.</returns>
+        T Load(LongIndex1D index);
+    }
+
+    /// <summary>
+    /// A pipeline source that reads all elements from an array view.
+    /// </summary>
+    /// <typeparam name="T">The element type.</typeparam>
+    /// <typeparam name="TStride">The 1D stride of the source view.</typeparam>
+    public readonly struct ViewPipelineSource<T, TStride> : IPipelineSource<T>
+        where T : unmanaged
+        where TStride : struct, IStride1D
+    {
+        /// <summary>
+        /// Constructs a new view source.
+        /// </summary>
+        /// <param name="view">The source view.</param>
+        public ViewPipelineSource(ArrayView1D<T, TStride> view)
+        {
+            View = view;
+        }
+
+        /// <summary>
+        /// Returns the source view.
+        /// </summary>
+        public ArrayView1D<T, TStride> View { get; }
+
+        /// <summary cref="IPipelineSource{T}.Length"/>
+        public long Length => View.Length;
+
+        /// <summary cref="IPipelineSource{T}.Load(LongIndex1D)"/>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public T Load(LongIndex1D index) => View[index];
+    }
+
+    /// <summary>
+    /// A pipeline source that computes all elements using a sequencer.
+    /// </summary>
+    /// <typeparam name="T">The element type.</typeparam>
+    /// <typeparam name="TSequencer">The sequencer type.</typeparam>
+    public readonly struct SequencePipelineSource<T, TSequencer> : IPipelineSource<T>
+        where T : unmanaged
+        where TSequencer : struct, ISequencer<T>
+    {
+        /// <summary>
+        /// Constructs a new sequence source.
+        /// </summary>
+        /// <param name="length">The number of elements.</param>
+        /// <param name="sequencer">The sequencer instance.</param>
+        public SequencePipelineSource(long length, TSequencer sequencer)
+        {
+            Length = length;
+            Sequencer = sequencer;
+        }
+
+        /// <summary cref="IPipelineSource{T}.Length"/>
+        public long Length { get; }
+
+        /// <summary>
+        /// Returns the sequencer instance.
+        /// </summary>
+        public TSequencer Sequencer { get; }
+
+        /// <summary cref="IPipelineSource{T}.Load(LongIndex1D)"/>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public T Load(LongIndex1D index) => Sequencer.ComputeSequenceElement(index);
+    }
+
+    /// <summary>
+    /// Represents the composition of two transformers.
+    /// </summary>
+    /// <typeparam name="TSource">The source value type.</typeparam>
+    /// <typeparam name="TIntermediate">The intermediate value type.</typeparam>
+    /// <typeparam name="TTarget">The target value type.</typeparam>
+    /// <typeparam name="TFirst">The first transformer.</typeparam>
+    /// <typeparam name="TSecond">The second transformer.</typeparam>
+    public readonly struct ComposedTransformer<
+        TSource,
+        TIntermediate,
+        TTarget,
+        TFirst,
+        TSecond> : ITransformer<TSource, TTarget>
+        where TSource : struct
+        where TIntermediate : struct
+        where TTarget : struct
+        where TFirst : struct, ITransformer<TSource, TIntermediate>
+        where TSecond : struct, ITransformer<TIntermediate, TTarget>
+    {
+        /// <summary>
+        /// Constructs a new composed transformer.
+        /// </summary>
+        /// <param name="first">The first transformer.</param>
+        /// <param name="second">The second transformer.</param>
+        public ComposedTransformer(TFirst first, TSecond second)
+        {
+            First = first;
+            Second = second;
+        }
+
+        /// <summary>
+        /// Returns the first transformer.
+        /// </summary>
+        public TFirst First { get; }
+
+        /// <summary>
+        /// Returns the second transformer.
+        /// </summary>
+        public TSecond Second { get; }
+
+        /// <summary>
+        /// Applies both transformers to the given value.
+        /// </summary>
+        /// <param name="value">The value to transform.</param>
+        /// <returns>The transformed value.</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public TTarget Transform(TSource value) =>
+            Second.Transform(First.Transform(value));
+    }
+
+    /// <summary>
+    /// Represents a sequence of element-wise transformations that are fused into a
+    /// single kernel, which is launched by the terminal operation of the pipeline.
+    /// </summary>
+    /// <typeparam name="TSource">The element type of the source.</typeparam>
+    /// <typeparam name="TPipelineSource">The pipeline source.</typeparam>
+    /// <typeparam name="T">The element type of the pipeline.</typeparam>
+    /// <typeparam name="TTransformer">The fused transformer of all stages.</typeparam>
+    public readonly struct Pipeline<TSource, TPipelineSource, T, TTransformer>
+        where TSource : unmanaged
+        where TPipelineSource : struct, IPipelineSource<TSource>
+        where T : unmanaged
+        where TTransformer : struct, ITransformer<TSource, T>
+    {
+        #region Instance
+
+        /// <summary>
+        /// Constructs a new pipeline.
+        /// </summary>
+        /// <param name="accelerator">The parent accelerator.</param>
+        /// <param name="source">The pipeline source.</param>
+        /// <param name="transformer">The fused transformer.</param>
+        internal Pipeline(
+            Accelerator accelerator,
+            TPipelineSource source,
+            TTransformer transformer)
+        {
+            Accelerator = accelerator;
+            Source = source;
+            Transformer = transformer;
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Returns the parent accelerator.
+        /// </summary>
+        public Accelerator Accelerator { get; }
+
+        /// <summary>
+        /// Returns the pipeline source.
+        /// </summary>
+        public TPipelineSource Source { get; }
+
+        /// <summary>
+        /// Returns the fused transformer of all stages.
+        /// </summary>
+        public TTransformer Transformer { get; }
+
+        /// <summary>
+        /// Returns the number of elements.
+        /// </summary>
+        public long Length => Source.Length;
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Appends a new element-wise transformation stage.
+        /// </summary>
+        /// <typeparam name="TTarget">The target element type.</typeparam>
+        /// <typeparam name="TStage">The transformer of the new stage.</typeparam>
+        /// <param name="stage">The transformer instance.</param>
+        /// <returns>The extended pipeline.</returns>
+        public Pipeline<
+            TSource,
+            TPipelineSource,
+            TTarget,
+            ComposedTransformer<TSource, T, TTarget, TTransformer, TStage>>
+            Map<TTarget, TStage>(TStage stage)
+            where TTarget : unmanaged
+            where TStage : struct, ITransformer<T, TTarget> =>
+            new Pipeline<
+                TSource,
+                TPipelineSource,
+                TTarget,
+                ComposedTransformer<TSource, T, TTarget, TTransformer, TStage>>(
+                Accelerator,
+                Source,
+                new ComposedTransformer<TSource, T, TTarget, TTransformer, TStage>(
+                    Transformer,
+                    stage));
+
+        /// <summary>
+        /// Appends a new element-wise transformation stage that does not change the
+        /// element type.
+        /// </summary>
+        /// <typeparam name="TStage">The transformer of the new stage.</typeparam>
+        /// <param name="stage">The transformer instance.</param>
+        /// <returns>The extended pipeline.</returns>
+        public Pipeline<
+            TSource,
+            TPipelineSource,
+            T,
+            ComposedTransformer<TSource, T, T, TTransformer, TStage>>
+            Map<TStage>(TStage stage)
+            where TStage : struct, ITransformer<T, T> =>
+            Map<T, TStage>(stage);
+
+        /// <summary>
+        /// Stores all transformed elements in the given target view using a single
+        /// kernel.
+        /// </summary>
+        /// <typeparam name="TTargetStride">The 1D stride of the target view.</typeparam>
+        /// <param name="stream">The accelerator stream.</param>
+        /// <param name="target">The target view.</param>
+        public void Store<TTargetStride>(
+            AcceleratorStream stream,
+            ArrayView1D<T, TTargetStride> target)
+            where TTargetStride : struct, IStride1D
+        {
+            if (!target.IsValid)
+                throw new ArgumentNullException(nameof(target));
+            if (target.Length < Length)
+            {
+                throw new ArgumentOutOfRangeException(
+                    nameof(target),
+                    string.Format(
+                        ErrorMessages.ViewOutOfRange,
+                        nameof(Source),
+                        nameof(target)));
+            }
+
+            var kernel = Accelerator.LoadGridStrideKernel<
+                PipelineExtensions.StoreImplementation<
+                    TSource,
+                    TPipelineSource,
+                    T,
+                    TTargetStride,
+                    TTransformer>>();
+            kernel(
+                stream,
+                Length,
+                new PipelineExtensions.StoreImplementation<
+                    TSource,
+                    TPipelineSource,
+                    T,
+                    TTargetStride,
+                    TTransformer>(
+                    Source,
+                    target,
+                    Transformer));
+        }
+
+        /// <summary>
+        /// Stores all transformed elements in the given target view using a single
+        /// kernel.
+        /// </summary>
+        /// <param name="stream">The accelerator stream.</param>
+        /// <param name="target">The target view.</param>
+        public void Store(AcceleratorStream stream, ArrayView<T> target) =>
+            Store<Stride1D.Dense>(stream, target);
+
+        /// <summary>
+        /// Reduces all transformed elements using a single kernel.
+        /// </summary>
+        /// <typeparam name="TReduction">The type of the reduction logic.</typeparam>
+        /// <param name="stream">The accelerator stream.</param>
+        /// <param name="output">The output view to store the reduced value.</param>
+        public void Reduce<TReduction>(AcceleratorStream stream, ArrayView<T> output)
+            where TReduction : struct, IScanReduceOperation<T>
+        {
+            if (!output.IsValid)
+                throw new ArgumentNullException(nameof(output));
+            if (output.Length < 1)
+                throw new ArgumentOutOfRangeException(nameof(output));
+
+            // Ensure a single element in the ouput view
+            output = output.SubView(0, 1);
+
+            TReduction reduction = default;
+            var initializer = Accelerator.CreateInitializer<T, Stride1D.Dense>();
+            initializer(stream, output, reduction.Identity);
+
+            var kernel = Accelerator.LoadGridStrideKernel<
+                PipelineExtensions.ReductionImplementation<
+                    TSource,
+                    TPipelineSource,
+                    T,
+                    TTransformer,
+                    TReduction>>();
+            kernel(
+                stream,
+                Length,
+                new PipelineExtensions.ReductionImplementation<
+                    TSource,
+                    TPipelineSource,
+                    T,
+                    TTransformer,
+                    TReduction>(
+                    Source,
+                    output,
+                    Transformer));
+        }
+
+        /// <summary>
+        /// Reduces all transformed elements using a single kernel.
+        /// </summary>
+        /// <typeparam name="TReduction">The type of the reduction logic.</typeparam>
+        /// <param name="stream">The accelerator stream.</param>
+        /// <returns>The reduced value.</returns>
+        public T Reduce<TReduction>(AcceleratorStream stream)
+            where TReduction : struct, IScanReduceOperation<T>
+        {
+            using var output = Accelerator.Allocate1D<T>(1);
+            Reduce<TReduction>(stream, output.View);
+            T result = default;
+            output.View.CopyToCPU(stream, ref result, 1);
+            return result;
+        }
+
+        /// <summary>
+        /// Scans all transformed elements.
+        /// </summary>
+        /// <typeparam name="TScanOperation">The type of the scan operation.</typeparam>
+        /// <param name="stream">The accelerator stream.</param>
+        /// <param name="kind">The scan kind.</param>
+        /// <param name="output">The output view to store the scanned values.</param>
+        /// <param name="temp">The temp view to store temporary results.</param>
+        /// <remarks>
+        /// All stages are fused into a single kernel that writes the transformed
+        /// elements to the output view, which is then scanned in place.
+        /// </remarks>
+        public void Scan<TScanOperation>(
+            AcceleratorStream stream,
+            ScanKind kind,
+            ArrayView<T> output,
+            ArrayView<int> temp)
+            where TScanOperation : struct, IScanReduceOperation<T>
+        {
+            Store(stream, output);
+            var scan = Accelerator.CreateScan<T, TScanOperation>(kind);
+            output = output.SubView(0, Length);
+            scan(stream, output, output, temp);
+        }
+
+        #endregion
+    }
+
+    /// <summary>
+    /// Pipeline functionality for accelerators.
+    /// </summary>
+    public static class PipelineExtensions
+    {
+        #region Pipeline Implementation
+
+        /// <summary>
+        /// Stores all transformed elements of a pipeline.
+        /// </summary>
+        /// <typeparam name="TSource">The element type of the source.</typeparam>
+        /// <typeparam name="TPipelineSource">The pipeline source.</typeparam>
+        /// <typeparam name="T">The element type of the pipeline.</typeparam>
+        /// <typeparam name="TTargetStride">The 1D stride of the target view.</typeparam>
+        /// <typeparam name="TTransformer">The fused transformer.</typeparam>
+        internal readonly struct StoreImplementation<
+            TSource,
+            TPipelineSource,
+            T,
+            TTargetStride,
+            TTransformer> : IGridStrideKernelBody
+            where TSource : unmanaged
+            where TPipelineSource : struct, IPipelineSource<TSource>
+            where T : unmanaged
+            where TTargetStride : struct, IStride1D
+            where TTransformer : struct, ITransformer<TSource, T>
+        {
+            /// <summary>
+            /// Creates a new store implementation.
+            /// </summary>
+            /// <param name="source">The pipeline source.</param>
+            /// <param name="target">The target view.</param>
+            /// <param name="transformer">The fused transformer.</param>
+            [MethodImpl(MethodImplOptions.AggressiveInlining)]
+            public StoreImplementation(
+                TPipelineSource source,
+                ArrayView1D<T, TTargetStride> target,
+                TTransformer transformer)
+            {
+                Source = source;
+                Target = target;
+                Transformer = transformer;
+            }
+
+            /// <summary>
+            /// Returns the pipeline source.
+            /// </summary>
+            public TPipelineSource Source { get; }
+
+            /// <summary>
+            /// Returns the target view.
+            /// </summary>
+            public ArrayView1D<T, TTargetStride> Target { get; }
+
+            /// <summary>
+            /// Returns the fused transformer.
+            /// </summary>
+            public TTransformer Transformer { get; }
+
+            /// <summary>
+            /// Transforms and stores a single element.
+            /// </summary>
+            [MethodImpl(MethodImplOptions.AggressiveInlining)]
+            public readonly void Execute(LongIndex1D linearIndex)
+            {
+                if (linearIndex >= Source.Length)
+                    return;
+
+                Target[linearIndex] = Transformer.Transform(Source.Load(linearIndex));
+            }
+
+            /// <summary>
+            /// Performs no operation.
+            /// </summary>
+            [MethodImpl(MethodImplOptions.AggressiveInlining)]
+            public readonly void Finish() { }
+        }
+
+        /// <summary>
+        /// Reduces all transformed elements of a pipeline.
+        /// </summary>
+        /// <typeparam name="TSource">The element type of the source.</typeparam>
+        /// <typeparam name="TPipelineSource">The pipeline source.</typeparam>
+        /// <typeparam name="T">The element type of the pipeline.</typeparam>
+        /// <typeparam name="TTransformer">The fused transformer.</typeparam>
+        /// <typeparam name="TReduction">The type of the reduction to use.</typeparam>
+        internal struct ReductionImplementation<
+            TSource,
+            TPipelineSource,
+            T,
+            TTransformer,
+            TReduction> : IGridStrideKernelBody
+            where TSource : unmanaged
+            where TPipelineSource : struct, IPipelineSource<TSource>
+            where T : unmanaged
+            where TTransformer : struct, ITransformer<TSource, T>
+            where TReduction : struct, IScanReduceOperation<T>
+        {
+            /// <summary>
+            /// Creates a new reduction instance.
+            /// </summary>
+            [MethodImpl(MethodImplOptions.AggressiveInlining)]
+            private static TReduction GetReduction()
+            {
+                TReduction reduction = default;
+                return reduction;
+            }
+
+            /// <summary>
+            /// Creates a new reduction implementation.
+            /// </summary>
+            /// <param name="source">The pipeline source.</param>
+            /// <param name="output">The output view (1 element min).</param>
+            /// <param name="transformer">The fused transformer.</param>
+            [MethodImpl(MethodImplOptions.AggressiveInlining)]
+            public ReductionImplementation(
+                TPipelineSource source,
+                ArrayView<T> output,
+                TTransformer transformer)
+            {
+                Source = source;
+                Output = output;
+                Transformer = transformer;
+                ReducedValue = GetReduction().Identity;
+            }
+
+            /// <summary>
+            /// Returns the pipeline source.
+            /// </summary>
+            public TPipelineSource Source { get; }
+
+            /// <summary>
+            /// Returns the output view.
+            /// </summary>
+            public ArrayView<T> Output { get; }
+
+            /// <summary>
+            /// Returns the fused transformer.
+            /// </summary>
+            public TTransformer Transformer { get; }
+
+            /// <summary>
+            /// Stores the current intermediate result of this thread.
+            /// </summary>
+            public T ReducedValue { get; private set; }
+
+            /// <summary>
+            /// Transforms and reduces each element in a grid-stride loop.
+            /// </summary>
+            [MethodImpl(MethodImplOptions.AggressiveInlining)]
+            public void Execute(LongIndex1D linearIndex)
+            {
+                if (linearIndex >= Source.Length)
+                    return;
+
+                ReducedValue = GetReduction().Apply(
+                    ReducedValue,
+                    Transformer.Transform(Source.Load(linearIndex)));
+            }
+
+            /// <summary>
+            /// Finished a group-wide reduction operation using shuffles, shared memory
+            /// and atomic operations.
+            /// </summary>
+            [MethodImpl(MethodImplOptions.AggressiveInlining)]
+            public void Finish()
+            {
+                // Perform group wide reduction
+                ReducedValue = GroupExtensions.Reduce<T, TReduction>(ReducedValue);
+
+                if (Group.IsFirstThread)
+                    GetReduction().AtomicApply(ref Output[0], ReducedValue);
+            }
+        }
+
+        #endregion
+
+        /// <summary>
+        /// Creates a new pipeline that reads its elements from the given view.
+        /// </summary>
+        /// <typeparam name="T">The element type.</typeparam>
+        /// <typeparam name="TStride">The 1D stride of the source view.</typeparam>
+        /// <param name="accelerator">The accelerator.</param>
+        /// <param name="source">The source view.</param>
+        /// <returns>The created pipeline.</returns>
+        public static Pipeline<
+            T,
+            ViewPipelineSource<T, TStride>,
+            T,
+            IdentityTransformer<T>>
+            CreatePipeline<T, TStride>(
+            this Accelerator accelerator,
+            ArrayView1D<T, TStride> source)
+            where T : unmanaged
+            where TStride : struct, IStride1D
+        {
+            if (accelerator is null)
+                throw new ArgumentNullException(nameof(accelerator));
+            if (!source.IsValid)
+                throw new ArgumentNullException(nameof(source));
+            return new Pipeline<
+                T,
+                ViewPipelineSource<T, TStride>,
+                T,
+                IdentityTransformer<T>>(
+                accelerator,
+                new ViewPipelineSource<T, TStride>(source),
+                default);
+        }
+
+        /// <summary>
+        /// Creates a new pipeline that reads its elements from the given view.
+        /// </summary>
+        /// <typeparam name="T">The element type.</typeparam>
+        /// <param name="accelerator">The accelerator.</param>
+        /// <param name="source">The source view.</param>
+        /// <returns>The created pipeline.</returns>
+        public static Pipeline<
+            T,
+            ViewPipelineSource<T, Stride1D.Dense>,
+            T,
+            IdentityTransformer<T>>
+            CreatePipeline<T>(
+            this Accelerator accelerator,
+            ArrayView<T> source)
+            where T : unmanaged =>
+            accelerator.CreatePipeline<T, Stride1D.Dense>(source);
+
+        /// <summary>
+        /// Creates a new pipeline that computes its elements using the given
+        /// sequencer.
+        /// </summary>
+        /// <typeparam name="T">The element type.</typeparam>
+        /// <typeparam name="TSequencer">The type of the sequencer to use.</typeparam>
+        /// <param name="accelerator">The accelerator.</param>
+        /// <param name="length">The number of elements.</param>
+        /// <param name="sequencer">The sequencer instance.</param>
+        /// <returns>The created pipeline.</returns>
+        public static Pipeline<
+            T,
+            SequencePipelineSource<T, TSequencer>,
+            T,
+            IdentityTransformer<T>>
+            CreateSequencePipeline<T, TSequencer>(
+            this Accelerator accelerator,
+            long length,
+            TSequencer sequencer)
+            where T : unmanaged
+            where TSequencer : struct, ISequencer<T>
+        {
+            if (accelerator is null)
+                throw new ArgumentNullException(nameof(accelerator));
+            if (length < 0)
+                throw new ArgumentOutOfRangeException(nameof(length));
+            return new Pipeline<
+                T,
+                SequencePipelineSource<T, TSequencer>,
+                T,
+                IdentityTransformer<T>>(
+                accelerator,
+                new SequencePipelineSource<T, TSequencer>(length, sequencer),
+                default);
+        }
+    }
+}
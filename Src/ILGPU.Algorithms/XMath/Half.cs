@@ -0,0 +1,151 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                   ILGPU.Algorithms
+//                      Copyright (c) 2019 ILGPU Algorithms Project
+//                                    www.ilgpu.net
+//
+// File: Half.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using System.Runtime.CompilerServices;
+
+namespace ILGPU.Algorithms
+{
+    partial class XMath
+    {
+        #region Half
+
+        /// <summary>
+        /// Computes |value|.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>|value|.</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static Half Abs(Half value) =>
+            Half.Abs(value);
+
+        /// <summary>
+        /// Computes min(first, second).
+        /// </summary>
+        /// <param name="first">The first argument.</param>
+        /// <param name="second">The second argument.</param>
+        /// <returns>The minimum of first and second value.</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static Half Min(Half first, Half second) =>
+            first < second ? first : second;
+
+        /// <summary>
+        /// Computes max(first, second).
+        /// </summary>
+        /// <param name="first">The first argument.</param>
+        /// <param name="second">The second argument.</param>
+        /// <returns>The maximum of first and second value.</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static Half Max(Half first, Half second) =>
+            first > second ? first : second;
+
+        /// <summary>
+        /// Computes sqrt(value) in single precision.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>sqrt(value).</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static Half Sqrt(Half value) =>
+            (Half)Sqrt((float)value);
+
+        /// <summary>
+        /// Computes 1/sqrt(value) in single precision.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>1/sqrt(value).</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static Half Rsqrt(Half value) =>
+            (Half)Rsqrt((float)value);
+
+        /// <summary>
+        /// Computes 1/value in single precision.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>1/value.</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static Half Rcp(Half value) =>
+            (Half)Rcp((float)value);
+
+        /// <summary>
+        /// Computes first * second + third in single precision.
+        /// </summary>
+        /// <param name="first">The first argument.</param>
+        /// <param name="second">The second argument.</param>
+        /// <param name="third">The third argument.</param>
+        /// <returns>first * second + third.</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static Half Fma(Half first, Half second, Half third) =>
+            (Half)((float)first * second + third);
+
+        #endregion
+
+        #region Half2
+
+        /// <summary>
+        /// Computes |value| for both lanes.
+        /// </summary>
+        /// <param name="value">The packed value.</param>
+        /// <returns>|value|.</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static Half2 Abs(Half2 value) =>
+            Half2.Abs(value);
+
+        /// <summary>
+        /// Computes min(first, second) for both lanes.
+        /// </summary>
+        /// <param name="first">The first argument.</param>
+        /// <param name="second">The second argument.</param>
+        /// <returns>The lane-wise minimum of first and second value.</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static Half2 Min(Half2 first, Half2 second) =>
+            Half2.Min(first, second);
+
+        /// <summary>
+        /// Computes max(first, second) for both lanes.
+        /// </summary>
+        /// <param name="first">The first argument.</param>
+        /// <param name="second">The second argument.</param>
+        /// <returns>The lane-wise maximum of first and second value.</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static Half2 Max(Half2 first, Half2 second) =>
+            Half2.Max(first, second);
+
+        /// <summary>
+        /// Computes sqrt(value) for both lanes.
+        /// </summary>
+        /// <param name="value">The packed value.</param>
+        /// <returns>sqrt(value).</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static Half2 Sqrt(Half2 value) =>
+            new Half2(Sqrt(value.X), Sqrt(value.Y));
+
+        /// <summary>
+        /// Computes 1/sqrt(value) for both lanes.
+        /// </summary>
+        /// <param name="value">The packed value.</param>
+        /// <returns>1/sqrt(value).</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static Half2 Rsqrt(Half2 value) =>
+            new Half2(Rsqrt(value.X), Rsqrt(value.Y));
+
+        /// <summary>
+        /// Computes first * second + third for both lanes.
+        /// </summary>
+        /// <param name="first">The first argument.</param>
+        /// <param name="second">The second argument.</param>
+        /// <param name="third">The third argument.</param>
+        /// <returns>first * second + third.</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static Half2 Fma(Half2 first, Half2 second, Half2 third) =>
+            Half2.Fma(first, second, third);
+
+        #endregion
+    }
+}
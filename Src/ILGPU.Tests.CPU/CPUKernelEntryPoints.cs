@@ -0,0 +1,61 @@
+﻿using ILGPU.Backends;
+using ILGPU.Backends.EntryPoints;
+using ILGPU.Backends.IL;
+using ILGPU.Runtime;
+using ILGPU.Runtime.CPU;
+using System.Linq;
+using System.Reflection;
+using Xunit;
+
+namespace ILGPU.Tests.CPU
+{
+    public class CPUKernelEntryPoints
+    {
+        internal static void RangeEntryPointKernel(
+            Index1D index,
+            ArrayView1D<int, Stride1D.Dense> output)
+        {
+            output[index] = index;
+        }
+
+        [Theory]
+        [InlineData(1, 37)]
+        [InlineData(4, 1021)]
+        [InlineData(16, 1025)]
+        public void CPURangeEntryPoint(int groupSize, int length)
+        {
+            using var context = CPUTestContext.CreateCPUContext(_ => { });
+            using var accelerator = context.CreateCPUAccelerator(
+                0,
+                CPUAcceleratorMode.Parallel);
+
+            // The kernel does not rely on any group semantics and has to be executed
+            // via its range launcher
+            var kernelMethod = typeof(CPUKernelEntryPoints).GetMethod(
+                nameof(RangeEntryPointKernel),
+                BindingFlags.NonPublic | BindingFlags.Static);
+            var compiled = accelerator.GetBackend().Compile(
+                EntryPointDescription.FromImplicitlyGroupedKernel(kernelMethod),
+                new KernelSpecialization());
+            Assert.NotNull(
+                Assert.IsType<ILCompiledKernel>(compiled).RangeExecutionHandler);
+
+            // Pad the buffer to detect writes beyond the last partial group
+            var data = Enumerable.Repeat(-1, length + groupSize).ToArray();
+            using var buffer = accelerator.Allocate1D(data);
+            using var kernel = accelerator.LoadImplicitlyGroupedKernel(
+                compiled,
+                groupSize);
+            kernel.Launch(
+                accelerator.DefaultStream,
+                new Index1D(length),
+                buffer.View);
+            accelerator.Synchronize();
+
+            var expected = Enumerable.Range(0, length)
+                .Concat(Enumerable.Repeat(-1, groupSize))
+                .ToArray();
+            Assert.Equal(expected, buffer.GetAsArray1D());
+        }
+    }
+}
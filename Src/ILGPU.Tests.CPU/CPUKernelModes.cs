@@ -0,0 +1,225 @@
+﻿using ILGPU.Runtime;
+using ILGPU.Runtime.CPU;
+using System;
+using System.Runtime.CompilerServices;
+using Xunit;
+
+namespace ILGPU.Tests.CPU
+{
+    public class CPUKernelModes
+    {
+        private const int Length = 32;
+        private const int NumGroups = 4;
+
+        /// <summary>
+        /// 2^24, the smallest positive integer value whose successor cannot be
+        /// represented as a 32-bit float.
+        /// </summary>
+        private const double Float32Limit = 16777216.0;
+
+        internal static void RoundingKernel(
+            Index1D index,
+            ArrayView1D<int, Stride1D.Dense> data)
+        {
+            double value = Float32Limit + index.X;
+            data[index] = (int)(value + 1.0 - Float32Limit);
+        }
+
+        internal static void CallKernel(
+            Index1D index,
+            ArrayView1D<int, Stride1D.Dense> data,
+            SpecializedValue<int> offset)
+        {
+            data[index] = index.X + offset;
+        }
+
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        internal static int GetGlobalIndex() => Grid.IdxX * Group.DimX + Group.IdxX;
+
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        internal static int BroadcastLastGlobalIndex()
+        {
+            int value = GetGlobalIndex();
+            Group.Barrier();
+            return Group.Broadcast(value, Group.DimX - 1);
+        }
+
+        internal static void GroupIntrinsicsKernel(ArrayView1D<int, Stride1D.Dense> data)
+        {
+            int index = Grid.GlobalIndex.X;
+            data[index * 3] = GetGlobalIndex();
+            data[index * 3 + 1] = BroadcastLastGlobalIndex();
+            data[index * 3 + 2] = Grid.DimX * Group.DimX;
+        }
+
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        internal static int GetLaneIndex() => Warp.LaneIdx;
+
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        internal static int ShuffleReversed(int value)
+        {
+            Warp.Barrier();
+            return Warp.Shuffle(value, Warp.WarpSize - 1 - GetLaneIndex());
+        }
+
+        internal static void WarpIntrinsicsKernel(ArrayView1D<int, Stride1D.Dense> data)
+        {
+            int index = Grid.GlobalIndex.X;
+            data[index * 2] = GetLaneIndex();
+            data[index * 2 + 1] = ShuffleReversed(index);
+        }
+
+        /// <summary>
+        /// Launches the given explicitly grouped kernel using one warp per group and
+        /// returns all values written by the kernel.
+        /// </summary>
+        private static int[] LaunchGroupedKernel(
+            CPUKernelMode kernelMode,
+            Action<ArrayView1D<int, Stride1D.Dense>> kernelMethod,
+            int valuesPerThread,
+            out int groupSize)
+        {
+            using var context = CPUTestContext.CreateCPUContext(builder => builder
+                .Optimize(OptimizationLevel.O1)
+                .CPUKernels(kernelMode));
+            using var accelerator = context.CreateCPUAccelerator(0);
+            groupSize = accelerator.WarpSize;
+            using var buffer = accelerator.Allocate1D<int>(
+                NumGroups * groupSize * valuesPerThread);
+            var kernel = accelerator.LoadStreamKernel(kernelMethod);
+            kernel((NumGroups, groupSize), buffer.View);
+            accelerator.Synchronize();
+            return buffer.GetAsArray1D();
+        }
+
+        [Fact]
+        public void IRKernelsGroupIntrinsics()
+        {
+            var data = LaunchGroupedKernel(
+                CPUKernelMode.IRKernels,
+                GroupIntrinsicsKernel,
+                3,
+                out int groupSize);
+
+            var expected = new int[data.Length];
+            for (int i = 0, e = NumGroups * groupSize; i < e; ++i)
+            {
+                expected[i * 3] = i;
+                expected[i * 3 + 1] = (i / groupSize + 1) * groupSize - 1;
+                expected[i * 3 + 2] = e;
+            }
+            Assert.Equal(expected, data);
+            Assert.Equal(
+                data,
+                LaunchGroupedKernel(
+                    CPUKernelMode.ManagedKernels,
+                    GroupIntrinsicsKernel,
+                    3,
+                    out _));
+        }
+
+        [Fact]
+        public void IRKernelsWarpIntrinsics()
+        {
+            var data = LaunchGroupedKernel(
+                CPUKernelMode.IRKernels,
+                WarpIntrinsicsKernel,
+                2,
+                out int warpSize);
+
+            var expected = new int[data.Length];
+            for (int i = 0, e = NumGroups * warpSize; i < e; ++i)
+            {
+                int laneIndex = i % warpSize;
+                expected[i * 2] = laneIndex;
+                expected[i * 2 + 1] = i - laneIndex + warpSize - 1 - laneIndex;
+            }
+            Assert.Equal(expected, data);
+            Assert.Equal(
+                data,
+                LaunchGroupedKernel(
+                    CPUKernelMode.ManagedKernels,
+                    WarpIntrinsicsKernel,
+                    2,
+                    out _));
+        }
+
+        private static int[] LaunchRoundingKernel(
+            CPUKernelMode kernelMode,
+            MathMode mathMode)
+        {
+            using var context = CPUTestContext.CreateCPUContext(builder => builder
+                .Optimize(OptimizationLevel.O1)
+                .Math(mathMode)
+                .CPUKernels(kernelMode));
+            using var accelerator = context.CreateCPUAccelerator(0);
+            using var buffer = accelerator.Allocate1D<int>(Length);
+            var kernel = accelerator.LoadAutoGroupedStreamKernel<
+                Index1D,
+                ArrayView1D<int, Stride1D.Dense>>(RoundingKernel);
+            kernel(Length, buffer.View);
+            accelerator.Synchronize();
+            return buffer.GetAsArray1D();
+        }
+
+        [Fact]
+        public void IRKernels()
+        {
+            using var context = CPUTestContext.CreateCPUContext(builder => builder
+                .Optimize(OptimizationLevel.O1)
+                .CPUKernels(CPUKernelMode.IRKernels));
+            using var accelerator = context.CreateCPUAccelerator(0);
+            using var buffer = accelerator.Allocate1D<int>(Length);
+
+            // Loading fails if the kernel cannot be generated from its IR
+            var kernel = accelerator.LoadAutoGroupedStreamKernel<
+                Index1D,
+                ArrayView1D<int, Stride1D.Dense>,
+                SpecializedValue<int>>(CallKernel);
+            kernel(Length, buffer.View, SpecializedValue.New(7));
+            accelerator.Synchronize();
+
+            var expected = new int[Length];
+            for (int i = 0; i < Length; ++i)
+                expected[i] = i + 7;
+            Assert.Equal(expected, buffer.GetAsArray1D());
+        }
+
+        [Fact]
+        public void IRKernelsWithoutFallback()
+        {
+            using var context = CPUTestContext.CreateCPUContext(builder => builder
+                .Optimize(OptimizationLevel.O0)
+                .CPUKernels(CPUKernelMode.IRKernels));
+            using var accelerator = context.CreateCPUAccelerator(0);
+
+            // Kernels compiled with O0 always invoke their managed kernel methods
+            var exception = Assert.Throws<InternalCompilerException>(() =>
+                accelerator.LoadAutoGroupedStreamKernel<
+                    Index1D,
+                    ArrayView1D<int, Stride1D.Dense>>(RoundingKernel));
+            Assert.IsType<NotSupportedException>(exception.InnerException);
+        }
+
+        [Fact]
+        public void IRKernelsUseOptimizedIR()
+        {
+            // Managed kernel methods ignore all IR-level settings
+            var managed = LaunchRoundingKernel(
+                CPUKernelMode.ManagedKernels,
+                MathMode.Fast32BitOnly);
+            Assert.Equal(1, managed[0]);
+
+            // IR kernels perform all 64-bit float operations using 32-bit floats
+            var ir = LaunchRoundingKernel(
+                CPUKernelMode.IRKernels,
+                MathMode.Fast32BitOnly);
+            Assert.Equal(0, ir[0]);
+
+            // Both modes agree on kernels that are not affected by the IR settings
+            Assert.Equal(
+                managed,
+                LaunchRoundingKernel(CPUKernelMode.IRKernels, MathMode.Default));
+        }
+    }
+}
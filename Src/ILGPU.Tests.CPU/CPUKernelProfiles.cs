@@ -0,0 +1,332 @@
+﻿using ILGPU.Backends.PTX.Analyses;
+using ILGPU.IR.Values;
+using ILGPU.Runtime;
+using ILGPU.Runtime.CPU;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Reflection;
+using Xunit;
+
+namespace ILGPU.Tests.CPU
+{
+    public class CPUKernelProfiles
+    {
+        private const int Length = 64;
+        private const int Threshold = 60;
+
+        internal static int ProfiledHelper(int value)
+        {
+            if (value % 16 == 0)
+                return value * 3;
+            return value + 1;
+        }
+
+        internal static void ProfiledKernel(
+            Index1D index,
+            ArrayView1D<int, Stride1D.Dense> data,
+            int threshold)
+        {
+            if (index.X < threshold)
+                data[index] = ProfiledHelper(index.X);
+            else
+                data[index] = -1;
+        }
+
+        internal static int GenericProfiledHelper<T>(int value, T tag)
+            where T : struct
+        {
+            if (value < Threshold)
+                return 1;
+            return 2;
+        }
+
+        internal static void GenericProfiledKernel(
+            Index1D index,
+            ArrayView1D<int, Stride1D.Dense> data)
+        {
+            data[index] =
+                GenericProfiledHelper(index.X, 0) +
+                GenericProfiledHelper(index.X, 0L);
+        }
+
+        private static MethodInfo GetMethod(string name, params Type[] typeArguments)
+        {
+            var method = typeof(CPUKernelProfiles).GetMethod(
+                name,
+                BindingFlags.Static | BindingFlags.NonPublic);
+            return typeArguments.Length > 0
+                ? method.MakeGenericMethod(typeArguments)
+                : method;
+        }
+
+        /// <summary>
+        /// Returns the recorded counts of all branches of the given method.
+        /// </summary>
+        private static (long Taken, long NotTaken)[] GetBranchCounts(
+            KernelProfile profile,
+            MethodInfo method)
+        {
+            var result = new List<(long, long)>();
+            int ilLength = method.GetMethodBody().GetILAsByteArray().Length;
+            for (int offset = 0; offset < ilLength; ++offset)
+            {
+                if (profile.TryGetBranchCounts(
+                    method,
+                    offset,
+                    out long taken,
+                    out long notTaken))
+                {
+                    result.Add((taken, notTaken));
+                }
+            }
+            return result.ToArray();
+        }
+
+        /// <summary>
+        /// Asserts that the given method contains a single branch whose directions
+        /// have been recorded the given number of times.
+        /// </summary>
+        private static void VerifyBranchCounts(
+            KernelProfile profile,
+            MethodInfo method,
+            long first,
+            long second)
+        {
+            var counts = Assert.Single(GetBranchCounts(profile, method));
+            Assert.Equal(
+                new[] { first, second }.OrderBy(x => x),
+                new[] { counts.Taken, counts.NotTaken }.OrderBy(x => x));
+        }
+
+        /// <summary>
+        /// Asserts that the given profiles contain the same counts for all branches
+        /// of the profiled kernel and its helper.
+        /// </summary>
+        private static void VerifyEqualCounts(
+            KernelProfile expected,
+            KernelProfile profile,
+            int factor)
+        {
+            var methods = new[]
+            {
+                GetMethod(nameof(ProfiledKernel)),
+                GetMethod(nameof(ProfiledHelper)),
+            };
+            foreach (var method in methods)
+            {
+                Assert.Equal(
+                    GetBranchCounts(expected, method).Select(entry =>
+                        (entry.Taken * factor, entry.NotTaken * factor)),
+                    GetBranchCounts(profile, method));
+            }
+        }
+
+        /// <summary>
+        /// Launches the profiled kernel on an instrumented CPU accelerator.
+        /// </summary>
+        private static KernelProfile RecordProfile()
+        {
+            var profile = new KernelProfile();
+            using var context = CPUTestContext.CreateCPUContext(builder => builder
+                .InstrumentKernels(profile));
+            using var accelerator = context.CreateCPUAccelerator(0);
+            using var buffer = accelerator.Allocate1D<int>(Length);
+
+            var kernel = accelerator.LoadAutoGroupedStreamKernel<
+                Index1D,
+                ArrayView1D<int, Stride1D.Dense>,
+                int>(ProfiledKernel);
+            kernel(Length, buffer.View, Threshold);
+            accelerator.Synchronize();
+
+            var expected = Enumerable.Range(0, Length)
+                .Select(i => i < Threshold ? ProfiledHelper(i) : -1)
+                .ToArray();
+            Assert.Equal(expected, buffer.GetAsArray1D());
+            return profile;
+        }
+
+        [Fact]
+        public void InstrumentCallees()
+        {
+            var profile = RecordProfile();
+            Assert.Equal(2, profile.NumMethods);
+
+            VerifyBranchCounts(
+                profile,
+                GetMethod(nameof(ProfiledKernel)),
+                Threshold,
+                Length - Threshold);
+
+            // Multiples of 16 below the threshold take the cold path in the helper
+            int numCold = (Threshold + 15) / 16;
+            VerifyBranchCounts(
+                profile,
+                GetMethod(nameof(ProfiledHelper)),
+                numCold,
+                Threshold - numCold);
+        }
+
+        [Fact]
+        public void InstrumentGenericInstantiations()
+        {
+            var profile = new KernelProfile();
+            using var context = CPUTestContext.CreateCPUContext(builder => builder
+                .InstrumentKernels(profile));
+            using var accelerator = context.CreateCPUAccelerator(0);
+            using var buffer = accelerator.Allocate1D<int>(Length);
+
+            var kernel = accelerator.LoadAutoGroupedStreamKernel<
+                Index1D,
+                ArrayView1D<int, Stride1D.Dense>>(GenericProfiledKernel);
+            kernel(Length, buffer.View);
+            accelerator.Synchronize();
+            Assert.Equal(
+                Enumerable.Range(0, Length)
+                    .Select(i => i < Threshold ? 2 : 4)
+                    .ToArray(),
+                buffer.GetAsArray1D());
+
+            // Every instantiation records its own counts
+            Assert.Equal(3, profile.NumMethods);
+            foreach (var type in new[] { typeof(int), typeof(long) })
+            {
+                VerifyBranchCounts(
+                    profile,
+                    GetMethod(nameof(GenericProfiledHelper), type),
+                    Threshold,
+                    Length - Threshold);
+            }
+            Assert.Empty(GetBranchCounts(
+                profile,
+                GetMethod(nameof(GenericProfiledHelper), typeof(float))));
+        }
+
+        [Fact]
+        public void SaveLoadMerge()
+        {
+            var profile = RecordProfile();
+
+            using var stream = new MemoryStream();
+            profile.Save(stream);
+            stream.Position = 0;
+            var loaded = KernelProfile.Load(stream);
+            Assert.Equal(stream.Length, stream.Position);
+            Assert.Equal(profile.NumMethods, loaded.NumMethods);
+            VerifyEqualCounts(profile, loaded, 1);
+
+            var merged = new KernelProfile();
+            merged.Merge(profile);
+            merged.Merge(loaded);
+            merged.Merge(merged);
+            Assert.Equal(profile.NumMethods, merged.NumMethods);
+            VerifyEqualCounts(profile, merged, 2);
+        }
+
+        [Fact]
+        public void ModuleVersionMismatch()
+        {
+            using var stream = new MemoryStream();
+            RecordProfile().Save(stream);
+            var data = stream.ToArray();
+
+            // Change the module version id of the first method profile, which
+            // follows the header and the number of methods
+            data[12] ^= 0xFF;
+            var profile = KernelProfile.Load(new MemoryStream(data));
+            var mismatches = new List<MethodBase>();
+            profile.ModuleVersionMismatch += (sender, method) => mismatches.Add(method);
+
+            // Stale counts are still available and reported once per method
+            var methods = new[]
+            {
+                GetMethod(nameof(ProfiledKernel)),
+                GetMethod(nameof(ProfiledHelper)),
+            };
+            for (int i = 0; i < 2; ++i)
+            {
+                foreach (var method in methods)
+                    Assert.Single(GetBranchCounts(profile, method));
+            }
+            Assert.Contains(Assert.Single(mismatches), methods);
+        }
+
+        [Fact]
+        public void InvalidProfileHeader()
+        {
+            foreach (var data in new[] { new byte[0], new byte[16] })
+            {
+                using var stream = new MemoryStream(data);
+                var exception = Assert.Throws<InvalidDataException>(() =>
+                    KernelProfile.Load(stream));
+                Assert.DoesNotContain("version", exception.Message);
+            }
+        }
+
+        [Fact]
+        public void UnsupportedProfileVersion()
+        {
+            using var stream = new MemoryStream();
+            new KernelProfile().Save(stream);
+            var data = stream.ToArray();
+            BitConverter.GetBytes(KernelProfile.FormatVersion + 41).CopyTo(data, 4);
+
+            var exception = Assert.Throws<InvalidDataException>(() =>
+                KernelProfile.Load(new MemoryStream(data)));
+            Assert.Contains(
+                (KernelProfile.FormatVersion + 41).ToString(),
+                exception.Message);
+        }
+
+        [Fact]
+        public void TruncatedProfileData()
+        {
+            using var stream = new MemoryStream();
+            RecordProfile().Save(stream);
+            var data = stream.ToArray();
+
+            for (int length = 0; length < data.Length; length += 5)
+            {
+                using var truncated = new MemoryStream(data, 0, length);
+                Assert.Throws<InvalidDataException>(() =>
+                    KernelProfile.Load(truncated));
+            }
+        }
+
+        [Fact]
+        public void ProfileGuidedBlockSchedule()
+        {
+            var profile = RecordProfile();
+            using var context = CPUTestContext.CreateCPUContext(builder => builder
+                .Optimize(OptimizationLevel.O1)
+                .ProfileGuidedOptimization(profile));
+            using var accelerator = context.CreateCPUAccelerator(0);
+
+            // Collect whether all likely targets become fall-through blocks of the
+            // optimized PTX block schedule
+            var likelyTargets = new List<bool>();
+            TestBase.InspectKernel(
+                accelerator,
+                GetMethod(nameof(ProfiledKernel)),
+                (kernelContext, kernelMethod) =>
+                {
+                    var schedule = kernelMethod.Blocks.CreateOptimizedPTXSchedule();
+                    foreach (var block in kernelMethod.Blocks)
+                    {
+                        if (block.Terminator is IfBranch ifBranch &&
+                            ifBranch.LikelyTarget != null)
+                        {
+                            likelyTargets.Add(schedule.IsImplicitSuccessor(
+                                block,
+                                ifBranch.LikelyTarget));
+                        }
+                    }
+                });
+
+            Assert.NotEmpty(likelyTargets);
+            Assert.DoesNotContain(false, likelyTargets);
+        }
+    }
+}
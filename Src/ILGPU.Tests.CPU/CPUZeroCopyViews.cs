@@ -0,0 +1,157 @@
+﻿using ILGPU.Runtime;
+using ILGPU.Runtime.CPU;
+using System;
+using System.Linq;
+using System.Runtime.InteropServices;
+using Xunit;
+
+namespace ILGPU.Tests.CPU
+{
+    public class CPUZeroCopyViews
+    {
+        private const int Length = 128;
+        private const int Offset = 16;
+
+        internal static void ZeroCopyKernel(
+            Index1D index,
+            ArrayView1D<int, Stride1D.Dense> data)
+        {
+            data[index] = data[index] * 2 + 1;
+        }
+
+        private static int[] GetExpected(int length) =>
+            Enumerable.Range(0, length).Select(i => i * 2 + 1).ToArray();
+
+        private static Context CreateContext() =>
+            CPUTestContext.CreateCPUContext(_ => { });
+
+        /// <summary>
+        /// Launches the zero-copy kernel on the given buffer.
+        /// </summary>
+        private static void Launch(
+            CPUAccelerator accelerator,
+            MemoryBuffer1D<int, Stride1D.Dense> buffer)
+        {
+            var kernel = accelerator.LoadAutoGroupedStreamKernel<
+                Index1D,
+                ArrayView1D<int, Stride1D.Dense>>(ZeroCopyKernel);
+            kernel((int)buffer.Length, buffer.View);
+            accelerator.Synchronize();
+        }
+
+        [Fact]
+        public void WrapArray()
+        {
+            using var context = CreateContext();
+            using var accelerator = context.CreateCPUAccelerator(0);
+            var array = Enumerable.Range(0, Length).ToArray();
+
+            using (var buffer = accelerator.Wrap(array))
+            {
+                Assert.Equal(Length, buffer.Length);
+                Launch(accelerator, buffer);
+
+                // Kernel writes are directly visible in host memory
+                Assert.Equal(GetExpected(Length), array);
+                Assert.Equal(GetExpected(Length), buffer.GetAsArray1D());
+            }
+            Assert.Equal(GetExpected(Length), array);
+        }
+
+        [Fact]
+        public void WrapMemory()
+        {
+            using var context = CreateContext();
+            using var accelerator = context.CreateCPUAccelerator(0);
+            var array = new int[Length + 2 * Offset];
+            var memory = new Memory<int>(array, Offset, Length);
+            for (int i = 0; i < Length; ++i)
+                memory.Span[i] = i;
+
+            using (var buffer = accelerator.Wrap(memory))
+            {
+                Assert.Equal(Length, buffer.Length);
+                Launch(accelerator, buffer);
+            }
+
+            // Only the wrapped slice has been modified
+            Assert.Equal(GetExpected(Length), memory.ToArray());
+            Assert.All(array.Take(Offset), value => Assert.Equal(0, value));
+            Assert.All(array.Skip(Offset + Length), value => Assert.Equal(0, value));
+        }
+
+        [Fact]
+        public void WrapPointer()
+        {
+            using var context = CreateContext();
+            using var accelerator = context.CreateCPUAccelerator(0);
+            var ptr = Marshal.AllocHGlobal(Length * sizeof(int));
+            try
+            {
+                Marshal.Copy(Enumerable.Range(0, Length).ToArray(), 0, ptr, Length);
+                using (var buffer = accelerator.Wrap<int>(ptr, Length))
+                {
+                    Assert.Equal(Length, buffer.Length);
+                    Assert.Equal(ptr, buffer.NativePtr);
+                    Launch(accelerator, buffer);
+                }
+
+                var result = new int[Length];
+                Marshal.Copy(ptr, result, 0, Length);
+                Assert.Equal(GetExpected(Length), result);
+            }
+            finally
+            {
+                Marshal.FreeHGlobal(ptr);
+            }
+        }
+
+        [Fact]
+        public void WrapInvalidArguments()
+        {
+            using var context = CreateContext();
+            using var accelerator = context.CreateCPUAccelerator(0);
+            Assert.Throws<ArgumentNullException>(() =>
+                accelerator.Wrap<int>((int[])null));
+            Assert.Throws<ArgumentNullException>(() =>
+                accelerator.Wrap<int>(IntPtr.Zero, Length));
+            Assert.Throws<ArgumentOutOfRangeException>(() =>
+                accelerator.Wrap<int>(new IntPtr(sizeof(int)), -1));
+        }
+
+        [Fact]
+        public void WrapDisposed()
+        {
+            using var context = CreateContext();
+            using var accelerator = context.CreateCPUAccelerator(0);
+            var array = new int[Length];
+            var ptr = Marshal.AllocHGlobal(Length * sizeof(int));
+            try
+            {
+                var buffers = new[]
+                {
+                    accelerator.Wrap(array),
+                    accelerator.Wrap(new Memory<int>(array)),
+                    accelerator.Wrap<int>(ptr, Length),
+                };
+                foreach (var buffer in buffers)
+                {
+                    var view = buffer.View.BaseView;
+                    buffer.Dispose();
+
+                    // Stale buffers and views must not expose released memory
+                    Assert.Equal(IntPtr.Zero, buffer.NativePtr);
+                    Assert.Equal(IntPtr.Zero, view.LoadEffectiveAddressAsPtr());
+                    Assert.Throws<ObjectDisposedException>(() =>
+                        view.CopyToCPU(new int[Length]));
+                    Assert.Throws<ObjectDisposedException>(() =>
+                        view.MemSetToZero());
+                }
+            }
+            finally
+            {
+                Marshal.FreeHGlobal(ptr);
+            }
+        }
+    }
+}
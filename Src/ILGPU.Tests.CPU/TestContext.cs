@@ -37,6 +37,15 @@ namespace ILGPU.Tests.CPU
                 : CPUDeviceKind.Default;
         }
 
+        /// <summary>
+        /// Creates a new context for CPU-specific tests that uses the CPU kind of all
+        /// CPU tests.
+        /// </summary>
+        /// <param name="configure">Applies test-specific context settings.</param>
+        /// <returns>The created context.</returns>
+        public static Context CreateCPUContext(Action<Context.Builder> configure) =>
+            Context.Create(builder => configure(builder.CPU(GetCPUDeviceKind())));
+
         /// <summary>
         /// Creates a new test context instance.
         /// </summary>
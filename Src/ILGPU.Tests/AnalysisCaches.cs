@@ -0,0 +1,110 @@
+﻿using ILGPU.Backends.EntryPoints;
+using ILGPU.IR;
+using ILGPU.IR.Analyses;
+using ILGPU.IR.Transformations;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace ILGPU.Tests
+{
+    public abstract class AnalysisCaches : TestBase
+    {
+        protected AnalysisCaches(ITestOutputHelper output, TestContext testContext)
+            : base(output, testContext)
+        { }
+
+        /// <summary>
+        /// Applies itself to every method without changing anything.
+        /// </summary>
+        private sealed class PreservingTransformation : UnorderedTransformation
+        {
+            public PreservingTransformation(PreservedAnalyses preserved)
+            {
+                Preserved = preserved;
+            }
+
+            public PreservedAnalyses Preserved { get; }
+
+            protected override PreservedAnalyses PreservedAnalyses => Preserved;
+
+            protected override bool PerformTransformation(Method.Builder builder) =>
+                true;
+        }
+
+        /// <summary>
+        /// Splits the first non-empty block of every method while claiming to
+        /// preserve all control-flow analyses.
+        /// </summary>
+        private sealed class SplitBlockTransformation : UnorderedTransformation
+        {
+            protected override PreservedAnalyses PreservedAnalyses =>
+                PreservedAnalyses.ControlFlow;
+
+            protected override bool PerformTransformation(Method.Builder builder)
+            {
+                var block = builder.SourceBlocks.First(current => current.Count > 0);
+                builder[block].SplitBlock(block[0].Resolve(), true);
+                return true;
+            }
+        }
+
+        /// <summary>
+        /// Imports an optimized IR method of the given kernel into a new context.
+        /// </summary>
+        private Method Import(IRContext irContext, string kernelName) =>
+            irContext.Import(
+                Accelerator.GetBackend().PreCompileKernelMethod(
+                    EntryPointDescription.FromImplicitlyGroupedKernel(
+                        GetKernelMethod(typeof(BasicLoops), kernelName, null))));
+
+        [Fact]
+        public void PreservedAnalysesAreCached()
+        {
+            using var irContext = new IRContext(Context);
+            var method = Import(irContext, nameof(BasicLoops.NestedForCounterKernel));
+
+            var cfg = method.Analyses.GetCFG();
+            var dominators = method.Analyses.GetDominators();
+            var loops = method.Analyses.GetLoops();
+            Assert.Same(cfg, method.Analyses.GetCFG());
+            Assert.Same(loops, method.Analyses.GetLoops());
+
+            new PreservingTransformation(PreservedAnalyses.ControlFlow).Transform(
+                irContext.Methods);
+            Assert.Same(cfg, method.Analyses.GetCFG());
+            Assert.Same(dominators, method.Analyses.GetDominators());
+            Assert.Same(loops, method.Analyses.GetLoops());
+
+            new PreservingTransformation(PreservedAnalyses.Loops).Transform(
+                irContext.Methods);
+            Assert.NotSame(cfg, method.Analyses.GetCFG());
+            Assert.NotSame(dominators, method.Analyses.GetDominators());
+            Assert.Same(loops, method.Analyses.GetLoops());
+
+            new PreservingTransformation(PreservedAnalyses.None).Transform(
+                irContext.Methods);
+            Assert.NotSame(loops, method.Analyses.GetLoops());
+        }
+
+        [Fact]
+        public void ControlFlowChangesInvalidateAnalyses()
+        {
+            using var irContext = new IRContext(Context);
+            var method = Import(irContext, nameof(BasicLoops.NestedForCounterKernel));
+
+            var cfg = method.Analyses.GetCFG();
+            var dominators = method.Analyses.GetDominators();
+            var loops = method.Analyses.GetLoops();
+            int numBlocks = method.Blocks.Count;
+
+            new SplitBlockTransformation().Transform(irContext.Methods);
+
+            Assert.Equal(numBlocks + 1, method.Blocks.Count);
+            Assert.NotSame(cfg, method.Analyses.GetCFG());
+            Assert.NotSame(dominators, method.Analyses.GetDominators());
+            Assert.NotSame(loops, method.Analyses.GetLoops());
+            Assert.Equal(method.Blocks.Count, method.Analyses.GetCFG().Count);
+        }
+    }
+}
@@ -1,4 +1,5 @@
-﻿using ILGPU.Runtime;
+﻿using ILGPU.IR.Values;
+using ILGPU.Runtime;
 using System;
 using System.Diagnostics;
 using System.Diagnostics.CodeAnalysis;
@@ -537,6 +538,91 @@ namespace ILGPU.Tests
             Verify(buffer.View, expected);
         }
 
+        internal static void ArrayViewGuardedLoopKernel(
+            Index1D index,
+            ArrayView1D<int, Stride1D.Dense> data,
+            ArrayView1D<int, Stride1D.Dense> source)
+        {
+            var view = source.AsContiguous();
+            int sum = 0;
+            for (int i = 0; i < view.IntLength; ++i)
+                sum += view[i];
+            if (index < view.IntLength)
+                sum += view[index];
+            data[index] = sum;
+        }
+
+        [Theory]
+        [InlineData(1)]
+        [InlineData(17)]
+        [InlineData(1025)]
+        [KernelMethod(nameof(ArrayViewGuardedLoopKernel))]
+        public void ArrayViewGuardedLoop(int length)
+        {
+            using var buffer = Accelerator.Allocate1D<int>(length);
+            var sourceData = Enumerable.Range(0, length).ToArray();
+            int sum = sourceData.Sum();
+            using (var source = Accelerator.Allocate1D<int>(length))
+            {
+                source.CopyFromCPU(Accelerator.DefaultStream, sourceData);
+                Execute(length, buffer.View, source.View);
+            }
+
+            var expected = sourceData.Select(x => sum + x).ToArray();
+            Verify(buffer.View, expected);
+        }
+
+        internal static void ArrayViewGuardedAccessKernel(
+            Index1D index,
+            ArrayView1D<int, Stride1D.Dense> data,
+            ArrayView1D<int, Stride1D.Dense> source)
+        {
+            var sourceView = source.AsContiguous();
+            var dataView = data.AsContiguous();
+            int sum = 0;
+            for (int i = 0; i < sourceView.IntLength; ++i)
+                sum += sourceView[i];
+            int targetIndex = index;
+            if (targetIndex >= 0 && targetIndex < dataView.IntLength)
+                dataView[targetIndex] = sum;
+        }
+
+        [Fact]
+        [KernelMethod(nameof(ArrayViewGuardedAccessKernel))]
+        public void ArrayViewGuardedAccess()
+        {
+            const int Length = 64;
+
+            // Collect all remaining bounds checks of the optimized kernel
+            int numAssertions = 0;
+            InspectKernel((kernelContext, kernelMethod) =>
+            {
+                foreach (var method in kernelContext.Methods)
+                {
+                    method.Blocks.ForEachValue<DebugAssertOperation>(
+                        _ => ++numAssertions);
+                }
+            });
+
+            // Debug builds keep all bounds checks, while all others must have been
+            // proven to be redundant
+            if (TestContext.OptimizationLevel < OptimizationLevel.O1)
+                Assert.True(numAssertions > 0);
+            else
+                Assert.Equal(0, numAssertions);
+
+            using var buffer = Accelerator.Allocate1D<int>(Length);
+            var sourceData = Enumerable.Range(0, Length).ToArray();
+            using (var source = Accelerator.Allocate1D<int>(Length))
+            {
+                source.CopyFromCPU(Accelerator.DefaultStream, sourceData);
+                Execute(Length, buffer.View, source.View);
+            }
+
+            var expected = Enumerable.Repeat(sourceData.Sum(), Length).ToArray();
+            Verify(buffer.View, expected);
+        }
+
         internal static void ArrayViewGetVariableViewKernel(
             Index1D index,
             ArrayView1D<int, Stride1D.Dense> data,
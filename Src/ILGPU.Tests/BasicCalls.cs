@@ -1,6 +1,9 @@
-﻿using ILGPU.Runtime;
+﻿using ILGPU.IR.Values;
+using ILGPU.Runtime;
 using ILGPU.Util;
+using System.Collections.Generic;
 using System.Linq;
+using System.Reflection;
 using System.Runtime.CompilerServices;
 using Xunit;
 using Xunit.Abstractions;
@@ -36,6 +39,99 @@ namespace ILGPU.Tests
             Verify(buffer.View, expected);
         }
 
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        internal static int CallGraphLevel5(int value) => value * 3 + 1;
+
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        internal static int CallGraphLevel4A(int value) =>
+            CallGraphLevel5(value) + CallGraphLevel5(value + 4);
+
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        internal static int CallGraphLevel4B(int value) =>
+            CallGraphLevel5(value) - CallGraphLevel5(value + 4);
+
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        internal static int CallGraphLevel3A(int value) =>
+            CallGraphLevel4A(value) + CallGraphLevel4B(value + 3);
+
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        internal static int CallGraphLevel3B(int value) =>
+            CallGraphLevel4A(value) - CallGraphLevel4B(value + 3);
+
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        internal static int CallGraphLevel2A(int value) =>
+            CallGraphLevel3A(value) + CallGraphLevel3B(value + 2);
+
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        internal static int CallGraphLevel2B(int value) =>
+            CallGraphLevel3A(value) - CallGraphLevel3B(value + 2);
+
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        internal static int CallGraphLevel1A(int value) =>
+            CallGraphLevel2A(value) + CallGraphLevel2B(value + 1);
+
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        internal static int CallGraphLevel1B(int value) =>
+            CallGraphLevel2A(value) - CallGraphLevel2B(value + 1);
+
+        internal static void DeepCallGraphKernel(
+            Index1D index,
+            ArrayView1D<int, Stride1D.Dense> data)
+        {
+            data[index] = CallGraphLevel1A(index) + CallGraphLevel1B(index);
+        }
+
+        [Fact]
+        [KernelMethod(nameof(DeepCallGraphKernel))]
+        public void DeepCallGraph()
+        {
+            using var buffer = Accelerator.Allocate1D<int>(Length);
+            Execute(buffer.Length, buffer.View);
+
+            var expected = Enumerable.Range(0, Length).Select(x =>
+                CallGraphLevel1A(x) + CallGraphLevel1B(x)).ToArray();
+            Verify(buffer.View, expected);
+        }
+
+        /// <summary>
+        /// Generates IR for the deep call graph kernel using a new context and
+        /// returns a summary of all generated methods.
+        /// </summary>
+        private static (string Name, int NumBlocks, int NumValues)[]
+            GenerateDeepCallGraph(bool parallel)
+        {
+            var kernel = typeof(BasicCalls).GetMethod(
+                nameof(DeepCallGraphKernel),
+                BindingFlags.NonPublic | BindingFlags.Static);
+            using var context = Context.Create(builder =>
+                builder.ParallelCodeGeneration(parallel));
+            using var phase = context.BeginCodeGeneration();
+            using (var frontendPhase = phase.BeginFrontendCodeGeneration())
+                frontendPhase.GenerateCode(kernel);
+            Assert.False(phase.IsFaulted, phase.LastException?.ToString());
+
+            return phase.IRContext.Methods
+                .Select(method =>
+                {
+                    int numValues = 0;
+                    method.Blocks.ForEachValue<Value>(_ => ++numValues);
+                    return (method.Source?.ToString(), method.Blocks.Count, numValues);
+                })
+                .OrderBy(entry => entry.Item1)
+                .ThenBy(entry => entry.Item2)
+                .ThenBy(entry => entry.Item3)
+                .ToArray();
+        }
+
+        [Fact]
+        public void DeepCallGraphParallelFrontend()
+        {
+            var expected = GenerateDeepCallGraph(false);
+            Assert.True(expected.Length > 9);
+            for (int i = 0; i < 4; ++i)
+                Assert.Equal(expected, GenerateDeepCallGraph(true));
+        }
+
         [MethodImpl(MethodImplOptions.NoInlining)]
         internal static Parent GetStructureValue() =>
             new Parent()
@@ -116,6 +212,66 @@ namespace ILGPU.Tests
             Verify(buffer.View, expected);
         }
 
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        internal static int StoreValue(
+            ArrayView1D<int, Stride1D.Dense> data,
+            int index,
+            int unused,
+            int scale)
+        {
+            data[index] = index * scale;
+            return data[index];
+        }
+
+        internal static void DeadArgumentCallKernel(
+            Index1D index,
+            ArrayView1D<int, Stride1D.Dense> data)
+        {
+            StoreValue(data, index, index + 1, 3);
+        }
+
+        [Fact]
+        [KernelMethod(nameof(DeadArgumentCallKernel))]
+        public void DeadArgumentCall()
+        {
+            using var buffer = Accelerator.Allocate1D<int>(Length);
+            Execute(buffer.Length, buffer.View);
+
+            var expected = Enumerable.Range(0, Length).Select(x => x * 3).ToArray();
+            Verify(buffer.View, expected);
+        }
+
+        [Fact]
+        [KernelMethod(nameof(DeadArgumentCallKernel))]
+        public void DeadArgumentCallIR()
+        {
+            // Collect the signatures of all StoreValue methods that are actually
+            // called by the kernel (which may be specialized clones in O2)
+            var signatures = new List<(string[] Parameters, bool ReturnsVoid)>();
+            InspectKernel((kernelContext, kernelMethod) =>
+                kernelMethod.Blocks.ForEachValue<MethodCall>(call =>
+                {
+                    var method = call.Target;
+                    if (method.Source?.Name != nameof(StoreValue))
+                        return;
+                    signatures.Add((
+                        method.Parameters.Select(param => param.Name).ToArray(),
+                        method.ReturnType.IsVoidType));
+                }));
+
+            // Debug builds do not run any interprocedural optimizations
+            if (TestContext.OptimizationLevel < OptimizationLevel.O1)
+                return;
+
+            Assert.NotEmpty(signatures);
+            foreach (var (parameters, returnsVoid) in signatures)
+            {
+                Assert.DoesNotContain("unused", parameters);
+                Assert.DoesNotContain("scale", parameters);
+                Assert.True(returnsVoid);
+            }
+        }
+
         internal struct Parent
         {
             public int First;
@@ -350,6 +350,38 @@ namespace ILGPU.Tests
             Verify(buffer2.View, Enumerable.Repeat(23, Length).ToArray());
         }
 
+        internal static void IfRepeatedConditionsKernel(
+            Index1D index,
+            ArrayView1D<int, Stride1D.Dense> data,
+            int c)
+        {
+            bool isInRange = index < c;
+            int value = 0;
+            if (isInRange)
+                value = data[index] + 1;
+            if (index < c)
+                value *= 2;
+            if (isInRange)
+                data[index] = value;
+            else
+                data[index] = -1;
+        }
+
+        [Theory]
+        [InlineData(0)]
+        [InlineData(7)]
+        [InlineData(Length)]
+        [KernelMethod(nameof(IfRepeatedConditionsKernel))]
+        public void IfRepeatedConditions(int c)
+        {
+            var source = Enumerable.Range(0, Length).ToArray();
+            using var buffer = Accelerator.Allocate1D(source);
+            Execute(buffer.Length, buffer.View, c);
+
+            var expected = source.Select(x => x < c ? (x + 1) * 2 : -1).ToArray();
+            Verify(buffer.View, expected);
+        }
+
         internal static void SwitchWithConstantConditionKernel(
             Index1D index,
             ArrayView1D<int, Stride1D.Dense> data)
@@ -3,8 +3,11 @@ using ILGPU.Frontend.DebugInformation;
 using ILGPU.Runtime;
 using System;
 using System.Diagnostics.CodeAnalysis;
+using System.IO;
 using System.Linq;
 using System.Reflection;
+using System.Reflection.Metadata;
+using System.Reflection.Metadata.Ecma335;
 using Xunit;
 using Xunit.Abstractions;
 
@@ -97,5 +100,68 @@ namespace ILGPU.Tests
             var disassembler = new Disassembler(method, SequencePointEnumerator.Empty);
             disassembler.Disassemble();
         }
+
+        /// <summary>
+        /// Tests that sequence points resolved lazily on demand are equal to the
+        /// sequence points of all method debug-information rows of the PDB file.
+        /// </summary>
+        [Fact]
+        public void LazySequencePoints()
+        {
+            var assembly = typeof(DisassemblerTests).Assembly;
+            var pdbFileName = Path.ChangeExtension(assembly.Location, ".pdb");
+
+            using var manager = new DebugInformationManager();
+            Assert.True(manager.TryLoadSymbols(
+                assembly,
+                pdbFileName,
+                out var assemblyDebugInformation));
+
+            using var pdbStream = File.OpenRead(pdbFileName);
+            using var readerProvider =
+                MetadataReaderProvider.FromPortablePdbStream(pdbStream);
+            var reader = readerProvider.GetMetadataReader();
+
+            int numMethods = 0;
+            foreach (var handle in reader.MethodDebugInformation)
+            {
+                var definitionHandle = handle.ToDefinitionHandle();
+                var metadataToken = MetadataTokens.GetToken(definitionHandle);
+                if (!assemblyDebugInformation.TryResolveMethod(
+                    metadataToken,
+                    out var method))
+                {
+                    continue;
+                }
+
+                var expected = reader.GetMethodDebugInformation(handle)
+                    .GetSequencePoints()
+                    .Where(point => !point.IsHidden && !point.Document.IsNil)
+                    .Select(point => (
+                        reader.GetString(reader.GetDocument(point.Document).Name),
+                        point.Offset,
+                        point.StartColumn,
+                        point.EndColumn,
+                        point.StartLine,
+                        point.EndLine))
+                    .ToArray();
+
+                Assert.True(manager.TryLoadDebugInformation(
+                    method,
+                    out var methodDebugInformation));
+                var sequencePoints = methodDebugInformation.SequencePoints
+                    .Select(point => (
+                        point.FileName,
+                        point.Offset,
+                        point.StartColumn,
+                        point.EndColumn,
+                        point.StartLine,
+                        point.EndLine))
+                    .ToArray();
+                Assert.Equal(expected, sequencePoints);
+                ++numMethods;
+            }
+            Assert.True(numMethods > 0);
+        }
     }
 }
@@ -1,5 +1,6 @@
 ﻿using ILGPU.Backends;
 using ILGPU.Backends.EntryPoints;
+using ILGPU.IR;
 using ILGPU.Runtime;
 using ILGPU.Util;
 using System;
@@ -15,6 +16,41 @@ namespace ILGPU.Tests
     /// </summary>
     public abstract class TestBase : DisposeBase
     {
+        #region Nested Types
+
+        /// <summary>
+        /// A backend hook that passes the optimized kernel IR to an inspector.
+        /// </summary>
+        private readonly struct InspectionHook : IBackendHook
+        {
+            public InspectionHook(Action<IRContext, Method> inspector)
+            {
+                Inspector = inspector;
+            }
+
+            /// <summary>
+            /// Returns the inspector to invoke.
+            /// </summary>
+            public Action<IRContext, Method> Inspector { get; }
+
+            /// <summary cref="IBackendHook.FinishedCodeGeneration"/>
+            public void FinishedCodeGeneration(IRContext context, Method entryPoint) { }
+
+            /// <summary cref="IBackendHook.InitializedKernelContext"/>
+            public void InitializedKernelContext(
+                IRContext kernelContext,
+                Method kernelMethod)
+            { }
+
+            /// <summary cref="IBackendHook.OptimizedKernelContext"/>
+            public void OptimizedKernelContext(
+                IRContext kernelContext,
+                Method kernelMethod) =>
+                Inspector(kernelContext, kernelMethod);
+        }
+
+        #endregion
+
         #region Static
 
         /// <summary>
@@ -149,6 +185,55 @@ namespace ILGPU.Tests
             stream.Synchronize();
         }
 
+        /// <summary>
+        /// Compiles the specified kernel and passes its final IR to the given
+        /// inspector. Note that the inspector must not throw any assertion
+        /// exceptions, as they would be wrapped by the compiler. Collect all
+        /// information and verify it afterwards instead.
+        /// </summary>
+        /// <param name="kernel">The kernel method.</param>
+        /// <param name="inspector">The IR inspector.</param>
+        public void InspectKernel(
+            MethodInfo kernel,
+            Action<IRContext, Method> inspector)
+        {
+            Output.WriteLine($"Compiling '{kernel.Name}'");
+            InspectKernel(Accelerator, kernel, inspector);
+        }
+
+        /// <summary>
+        /// Compiles the specified kernel using the backend of the given accelerator
+        /// and passes its final IR to the given inspector. Kernels without an
+        /// index parameter are compiled as explicitly grouped kernels.
+        /// </summary>
+        /// <param name="accelerator">The accelerator to compile the kernel for.</param>
+        /// <param name="kernel">The kernel method.</param>
+        /// <param name="inspector">The IR inspector.</param>
+        public static void InspectKernel(
+            Accelerator accelerator,
+            MethodInfo kernel,
+            Action<IRContext, Method> inspector)
+        {
+            var backend = accelerator.GetBackend();
+            var parameters = kernel.GetParameters();
+            var entryPoint = parameters.Length > 0 &&
+                typeof(IIndex).IsAssignableFrom(parameters[0].ParameterType)
+                ? EntryPointDescription.FromImplicitlyGroupedKernel(kernel)
+                : EntryPointDescription.FromExplicitlyGroupedKernel(kernel);
+            backend.Compile(
+                entryPoint,
+                new KernelSpecialization(),
+                new InspectionHook(inspector));
+        }
+
+        /// <summary>
+        /// Compiles an implicitly linked kernel and passes its final IR to the given
+        /// inspector.
+        /// </summary>
+        /// <param name="inspector">The IR inspector.</param>
+        public void InspectKernel(Action<IRContext, Method> inspector) =>
+            InspectKernel(KernelMethodAttribute.GetKernelMethod(null), inspector);
+
         /// <summary>
         /// Executes an implicitly linked kernel with the given arguments.
         /// </summary>
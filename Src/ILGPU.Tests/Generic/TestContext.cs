@@ -9,6 +9,10 @@ namespace ILGPU.Tests
     /// </summary>
     public abstract class TestContext : DisposeBase
     {
+        private readonly OptimizationLevel optimizationLevel;
+        private readonly Action<Context.Builder> prepareContext;
+        private readonly Func<Context, Accelerator> createAccelerator;
+
         /// <summary>
         /// Constructs a new context provider.
         /// </summary>
@@ -23,15 +27,12 @@ namespace ILGPU.Tests
             Action<Context.Builder> prepareContext,
             Func<Context, Accelerator> createAccelerator)
         {
-            Context = Context.Create(builder =>
-                prepareContext(
-                    builder
-                    .Assertions()
-                    .Arrays(ArrayMode.InlineMutableStaticArrays)
-                    .Verify()
-                    .Optimize(level)
-                    .Profiling()));
-            Accelerator = createAccelerator(Context);
+            optimizationLevel = level;
+            this.prepareContext = prepareContext;
+            this.createAccelerator = createAccelerator;
+
+            Context = CreateContext(_ => { });
+            Accelerator = CreateAccelerator(Context);
         }
 
         /// <summary>
@@ -50,6 +51,37 @@ namespace ILGPU.Tests
         /// </summary>
         public Accelerator Accelerator { get; }
 
+        /// <summary>
+        /// Creates a new context that uses the configuration of this test context.
+        /// </summary>
+        /// <param name="configure">
+        /// Applies additional test-specific settings to the context.
+        /// </param>
+        /// <returns>The created context.</returns>
+        public Context CreateContext(Action<Context.Builder> configure) =>
+            Context.Create(builder =>
+            {
+                prepareContext(
+                    builder
+                    .Assertions()
+                    .Arrays(ArrayMode.InlineMutableStaticArrays)
+                    .Verify()
+                    .Optimize(optimizationLevel)
+                    .Profiling());
+                configure(builder);
+            });
+
+        /// <summary>
+        /// Creates a new accelerator of the configured kind in the given context.
+        /// </summary>
+        /// <param name="context">
+        /// The parent context, which has been created via
+        /// <see cref="CreateContext(Action{Context.Builder})"/>.
+        /// </param>
+        /// <returns>The created accelerator.</returns>
+        public Accelerator CreateAccelerator(Context context) =>
+            createAccelerator(context);
+
         /// <summary>
         /// Ensures a clean test scenario.
         /// </summary>
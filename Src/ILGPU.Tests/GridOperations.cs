@@ -1,4 +1,5 @@
 ﻿using ILGPU.Runtime;
+using ILGPU.Runtime.CPU;
 using System;
 using System.Collections.Generic;
 using System.Diagnostics;
@@ -171,5 +172,47 @@ namespace ILGPU.Tests
                 }
             }
         }
+
+        internal static void GridSchedulingKernel(ArrayView1D<int, Stride1D.Dense> data)
+        {
+            var sharedValue = SharedMemory.Allocate<int>(1);
+            if (Group.IdxX == 0)
+                sharedValue[0] = Grid.IdxX;
+            Group.Barrier();
+            data[Grid.GlobalIndex.X] = sharedValue[0] * Group.DimX + Group.IdxX;
+        }
+
+        [SkippableTheory]
+        [InlineData(CPUGroupScheduling.Static, 1)]
+        [InlineData(CPUGroupScheduling.Dynamic, 1)]
+        [InlineData(CPUGroupScheduling.Dynamic, 3)]
+        [InlineData(CPUGroupScheduling.Guided, 1)]
+        [InlineData(CPUGroupScheduling.Guided, 4)]
+        [KernelMethod(nameof(GridSchedulingKernel))]
+        public void GridScheduling(CPUGroupScheduling scheduling, int chunkSize)
+        {
+            var cpuAccelerator = Accelerator as CPUAccelerator;
+            Skip.If(cpuAccelerator is null);
+
+            cpuAccelerator.GroupScheduling = scheduling;
+            cpuAccelerator.GroupChunkSize = chunkSize;
+            try
+            {
+                const int NumGroups = 97;
+                int groupSize = Math.Min(4, Accelerator.MaxNumThreadsPerGroup);
+                using var buffer = Accelerator.Allocate1D<int>(groupSize * NumGroups);
+                Execute(new KernelConfig(NumGroups, groupSize), buffer.View);
+
+                var expected = new int[buffer.Length];
+                for (int i = 0; i < expected.Length; ++i)
+                    expected[i] = i;
+                Verify(buffer.View, expected);
+            }
+            finally
+            {
+                cpuAccelerator.GroupScheduling = CPUGroupScheduling.Static;
+                cpuAccelerator.GroupChunkSize = 1;
+            }
+        }
     }
 }
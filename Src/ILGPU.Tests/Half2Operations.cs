@@ -0,0 +1,80 @@
+﻿using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace ILGPU.Tests
+{
+    public abstract class Half2Operations : TestBase
+    {
+        protected Half2Operations(ITestOutputHelper output, TestContext testContext)
+            : base(output, testContext)
+        { }
+
+        private const int Length = 1024;
+
+        internal static void Half2ArithmeticKernel(
+            Index1D index,
+            ArrayView1D<Half2, Stride1D.Dense> first,
+            ArrayView1D<Half2, Stride1D.Dense> second,
+            ArrayView1D<Half2, Stride1D.Dense> result)
+        {
+            var a = first[index];
+            var b = second[index];
+            result[index] = Half2.Fma(a + b, a - b, -(a * b));
+        }
+
+        private static Half2 CreateValue(int index) =>
+            new Half2((Half)(index % 8 * 0.25f), (Half)(-(index % 8) * 0.5f));
+
+        [Fact]
+        [KernelMethod(nameof(Half2ArithmeticKernel))]
+        public void Half2Arithmetic()
+        {
+            var first = Enumerable.Range(0, Length).Select(CreateValue).ToArray();
+            var second = Enumerable.Range(0, Length)
+                .Select(t => CreateValue(t + 7))
+                .ToArray();
+            using var firstBuffer = Accelerator.Allocate1D(first);
+            using var secondBuffer = Accelerator.Allocate1D(second);
+            using var result = Accelerator.Allocate1D<Half2>(Length);
+            Execute(Length, firstBuffer.View, secondBuffer.View, result.View);
+
+            // All operands are exactly representable and all intermediate results
+            // remain exact in half precision
+            var expected = Enumerable.Range(0, Length).Select(i =>
+            {
+                var a = first[i];
+                var b = second[i];
+                return Half2.Fma(a + b, a - b, -(a * b));
+            }).ToArray();
+            Verify(result.View, expected);
+        }
+
+        [Fact]
+        public void Half2Lanes()
+        {
+            var value = new Half2((Half)1.5f, (Half)(-2.0f));
+            Assert.Equal((Half)1.5f, value.X);
+            Assert.Equal((Half)(-2.0f), value.Y);
+            Assert.Equal(new Half2((Half)1.5f, (Half)2.0f), Half2.Abs(value));
+            Assert.Equal(new Half2((Half)(-1.5f), (Half)2.0f), -value);
+            Assert.Equal(-1.5f, Half2.Dot(value, new Half2((Half)1.0f)));
+        }
+
+        [Fact]
+        public void Half2Equality()
+        {
+            // Equals compares raw bits, whereas == follows IEEE 754
+            var nan = new Half2((Half)float.NaN);
+            Assert.True(nan.Equals(nan));
+            Assert.False(nan == nan);
+            Assert.Equal(nan.GetHashCode(), new Half2((Half)float.NaN).GetHashCode());
+
+            var zero = new Half2((Half)0.0f);
+            var negativeZero = -zero;
+            Assert.True(zero == negativeZero);
+            Assert.False(zero.Equals(negativeZero));
+            Assert.False(zero.Equals((object)negativeZero));
+        }
+    }
+}
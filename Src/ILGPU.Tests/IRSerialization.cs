@@ -0,0 +1,145 @@
+﻿using ILGPU.Backends.EntryPoints;
+using ILGPU.IR;
+using ILGPU.IR.Values;
+using ILGPU.Runtime;
+using System;
+using System.IO;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace ILGPU.Tests
+{
+    public abstract class IRSerialization : TestBase
+    {
+        private const int Length = 64;
+
+        protected IRSerialization(ITestOutputHelper output, TestContext testContext)
+            : base(output, testContext)
+        { }
+
+        public static TheoryData<Type, string> IRSerializationData =>
+            new TheoryData<Type, string>
+        {
+            { typeof(BasicCalls), nameof(BasicCalls.NestedCallKernel) },
+            { typeof(BasicCalls), nameof(BasicCalls.NestedStructureCallKernel) },
+            { typeof(BasicCalls), nameof(BasicCalls.MultiReturnKernel) },
+            { typeof(BasicLoops), nameof(BasicLoops.NestedForCounterKernel) },
+            { typeof(BasicLoops), nameof(BasicLoops.NestedBreakContinueKernel) },
+            { typeof(BasicSwitches), nameof(BasicSwitches.BasicSwitchKernel) },
+            { typeof(ArrayViews), nameof(ArrayViews.ArrayViewGuardedLoopKernel) },
+            { typeof(ArrayViews), nameof(ArrayViews.ArrayViewGetSubViewKernel) },
+            { typeof(DebugTests), nameof(DebugTests.DebugAssertMessageKernel) },
+        };
+
+        /// <summary>
+        /// Pre-compiles the given kernel into an optimized IR method.
+        /// </summary>
+        private Method PreCompile(Type type, string kernelName) =>
+            Accelerator.GetBackend().PreCompileKernelMethod(
+                EntryPointDescription.FromImplicitlyGroupedKernel(
+                    GetKernelMethod(type, kernelName, null)));
+
+        private static byte[] Serialize(Method method)
+        {
+            using var stream = new MemoryStream();
+            IRSerializer.Serialize(stream, method);
+            return stream.ToArray();
+        }
+
+        private static int CountValues(Method method)
+        {
+            int count = 0;
+            method.Blocks.ForEachValue<Value>(_ => ++count);
+            return count;
+        }
+
+        [Theory]
+        [MemberData(nameof(IRSerializationData))]
+        public void RoundTripKernels(Type type, string kernelName)
+        {
+            var method = PreCompile(type, kernelName);
+            var data = Serialize(method);
+
+            using var irContext = new IRContext(Context);
+            using var stream = new MemoryStream(data);
+            var deserialized = IRSerializer.Deserialize(stream, irContext);
+
+            Assert.Equal(stream.Length, stream.Position);
+            Assert.Equal(method.Blocks.Count, deserialized.Blocks.Count);
+            Assert.Equal(method.NumParameters, deserialized.NumParameters);
+            Assert.Equal(CountValues(method), CountValues(deserialized));
+            Assert.Equal(
+                method.ReturnType.ToString(),
+                deserialized.ReturnType.ToString());
+
+            // A second round trip has to produce exactly the same binary image
+            Assert.Equal(data, Serialize(deserialized));
+
+            // The deserialized IR has to be a valid input for all backends
+            Accelerator.GetBackend().Compile(
+                deserialized,
+                EntryPointDescription.FromImplicitlyGroupedKernel(
+                    GetKernelMethod(type, kernelName, null)),
+                new KernelSpecialization());
+        }
+
+        [Fact]
+        public void RoundTripExecution()
+        {
+            var kernel = GetKernelMethod(
+                typeof(BasicCalls),
+                nameof(BasicCalls.NestedCallKernel),
+                null);
+            var entryPoint = EntryPointDescription.FromImplicitlyGroupedKernel(kernel);
+            var backend = Accelerator.GetBackend();
+            var data = Serialize(backend.PreCompileKernelMethod(entryPoint));
+
+            using var irContext = new IRContext(Context);
+            using var stream = new MemoryStream(data);
+            var deserialized = IRSerializer.Deserialize(stream, irContext);
+            var compiled = backend.Compile(
+                deserialized,
+                entryPoint,
+                new KernelSpecialization());
+
+            using var buffer = Accelerator.Allocate1D<int>(Length);
+            using var kernelStream = Accelerator.CreateStream();
+            using var acceleratorKernel = Accelerator.LoadKernel(compiled);
+            acceleratorKernel.Launch(
+                kernelStream,
+                new Index1D(Length),
+                buffer.View);
+            kernelStream.Synchronize();
+
+            var expected = Enumerable.Repeat(42, Length).ToArray();
+            Verify(buffer.View, expected);
+        }
+
+        [Fact]
+        public void InvalidIRHeader()
+        {
+            using var irContext = new IRContext(Context);
+            using var stream = new MemoryStream(new byte[16]);
+            var exception = Assert.Throws<InvalidDataException>(() =>
+                IRSerializer.Deserialize(stream, irContext));
+            Assert.DoesNotContain("version", exception.Message);
+        }
+
+        [Fact]
+        public void TruncatedIRData()
+        {
+            var data = Serialize(PreCompile(
+                typeof(BasicLoops),
+                nameof(BasicLoops.NestedForCounterKernel)));
+
+            using var irContext = new IRContext(Context);
+            for (int length = 0; length < data.Length; length += 7)
+            {
+                using var stream = new MemoryStream(data, 0, length);
+                Assert.Throws<InvalidDataException>(() =>
+                    IRSerializer.Deserialize(stream, irContext));
+            }
+        }
+    }
+}
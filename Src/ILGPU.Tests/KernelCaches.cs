@@ -0,0 +1,189 @@
+﻿using ILGPU.Runtime;
+using System;
+using System.Linq;
+using System.Runtime.CompilerServices;
+using System.Threading.Tasks;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace ILGPU.Tests
+{
+    public abstract class KernelCaches : TestBase
+    {
+        protected KernelCaches(ITestOutputHelper output, TestContext testContext)
+            : base(output, testContext)
+        { }
+
+        private const int Length = 32;
+
+        internal static void FirstCacheKernel(
+            Index1D index,
+            ArrayView1D<int, Stride1D.Dense> data)
+        {
+            data[index] = index.X;
+        }
+
+        internal static void SecondCacheKernel(
+            Index1D index,
+            ArrayView1D<int, Stride1D.Dense> data)
+        {
+            data[index] = index.X * 2;
+        }
+
+        internal static void SpecializedCacheKernel(
+            Index1D index,
+            ArrayView1D<int, Stride1D.Dense> data,
+            SpecializedValue<int> value)
+        {
+            data[index] = index.X + value;
+        }
+
+        private Context CreateContext(int maxNumKernels, long maxSize) =>
+            TestContext.CreateContext(builder =>
+                builder.KernelCacheLimits(maxNumKernels, maxSize));
+
+        private static void LaunchAndVerify(
+            Accelerator accelerator,
+            Action<Index1D, ArrayView1D<int, Stride1D.Dense>> kernel,
+            Func<int, int> expected)
+        {
+            using var buffer = accelerator.Allocate1D<int>(Length);
+            kernel(Length, buffer.View);
+            accelerator.Synchronize();
+            Assert.Equal(
+                Enumerable.Range(0, Length).Select(expected).ToArray(),
+                buffer.GetAsArray1D());
+        }
+
+        /// <summary>
+        /// Loads the given kernel without keeping a reference to it.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        private static WeakReference LoadWeakKernel(
+            Accelerator accelerator,
+            Action<Index1D, ArrayView1D<int, Stride1D.Dense>> kernelMethod)
+        {
+            var kernel = accelerator.LoadAutoGroupedKernel(kernelMethod);
+            return new WeakReference(kernel.Target);
+        }
+
+        [Fact]
+        public void KernelCacheCountEviction()
+        {
+            using var context = CreateContext(1, long.MaxValue);
+            using var accelerator = TestContext.CreateAccelerator(context);
+            var initial = accelerator.LoadedKernelCacheStatistics;
+
+            var first = accelerator.LoadAutoGroupedStreamKernel<
+                Index1D,
+                ArrayView1D<int, Stride1D.Dense>>(FirstCacheKernel);
+            var second = accelerator.LoadAutoGroupedStreamKernel<
+                Index1D,
+                ArrayView1D<int, Stride1D.Dense>>(SecondCacheKernel);
+
+            var statistics = accelerator.LoadedKernelCacheStatistics;
+            Assert.Equal(1, statistics.NumEntries);
+            Assert.Equal(initial.NumEvictions + 1, statistics.NumEvictions);
+            Assert.Equal(1, accelerator.CompiledKernelCacheStatistics.NumEntries);
+
+            // Evicted kernels remain usable by their callers
+            LaunchAndVerify(accelerator, first, i => i);
+            LaunchAndVerify(accelerator, second, i => i * 2);
+
+            // Reloading an evicted kernel misses the cache and evicts the other one
+            var reloaded = accelerator.LoadAutoGroupedStreamKernel<
+                Index1D,
+                ArrayView1D<int, Stride1D.Dense>>(FirstCacheKernel);
+            LaunchAndVerify(accelerator, reloaded, i => i);
+            statistics = accelerator.LoadedKernelCacheStatistics;
+            Assert.Equal(1, statistics.NumEntries);
+            Assert.Equal(initial.NumEvictions + 2, statistics.NumEvictions);
+            Assert.Equal(initial.NumMisses + 3, statistics.NumMisses);
+        }
+
+        [Fact]
+        public void KernelCacheSizeEviction()
+        {
+            using var context = CreateContext(16, 1);
+            using var accelerator = TestContext.CreateAccelerator(context);
+            var initial = accelerator.CompiledKernelCacheStatistics;
+
+            accelerator.LoadAutoGroupedStreamKernel<
+                Index1D,
+                ArrayView1D<int, Stride1D.Dense>>(FirstCacheKernel);
+            var statistics = accelerator.CompiledKernelCacheStatistics;
+            Assert.Equal(1, statistics.NumEntries);
+            Assert.True(statistics.Size > 0);
+
+            // Every new kernel exceeds the size limit and evicts the previous one
+            accelerator.LoadAutoGroupedStreamKernel<
+                Index1D,
+                ArrayView1D<int, Stride1D.Dense>>(SecondCacheKernel);
+            statistics = accelerator.CompiledKernelCacheStatistics;
+            Assert.Equal(1, statistics.NumEntries);
+            Assert.Equal(initial.NumEvictions + 1, statistics.NumEvictions);
+            Assert.Equal(1, accelerator.LoadedKernelCacheStatistics.NumEntries);
+        }
+
+        [Fact]
+        public void KernelCacheReclamation()
+        {
+            using var context = CreateContext(1, long.MaxValue);
+            using var accelerator = TestContext.CreateAccelerator(context);
+
+            // The cache keeps its most recent kernel alive
+            var firstKernel = LoadWeakKernel(accelerator, FirstCacheKernel);
+            GC.Collect();
+            GC.WaitForPendingFinalizers();
+            Assert.True(firstKernel.IsAlive);
+
+            // Evicted kernels are released and reclaimed once unreferenced
+            var secondKernel = LoadWeakKernel(accelerator, SecondCacheKernel);
+            GC.Collect();
+            GC.WaitForPendingFinalizers();
+            GC.Collect();
+            Assert.False(firstKernel.IsAlive);
+            Assert.True(secondKernel.IsAlive);
+        }
+
+        [Fact]
+        public void SpecializationCacheEviction()
+        {
+            const int NumValues = 4;
+            const int NumThreads = 4;
+            const int NumLaunches = 16;
+
+            using var context = TestContext.CreateContext(builder =>
+                builder.SpecializationCacheLimit(1));
+            using var accelerator = TestContext.CreateAccelerator(context);
+            var kernel = accelerator.LoadAutoGroupedKernel<
+                Index1D,
+                ArrayView1D<int, Stride1D.Dense>,
+                SpecializedValue<int>>(SpecializedCacheKernel);
+
+            // Evicted specialized kernels are disposed while other threads launch
+            Parallel.For(0, NumThreads, thread =>
+            {
+                using var stream = accelerator.CreateStream();
+                using var buffer = accelerator.Allocate1D<int>(Length);
+                for (int i = 0; i < NumLaunches; ++i)
+                {
+                    int value = (thread + i) % NumValues;
+                    kernel(
+                        stream,
+                        Length,
+                        buffer.View,
+                        new SpecializedValue<int>(value));
+                    stream.Synchronize();
+                    Assert.Equal(
+                        Enumerable.Range(value, Length).ToArray(),
+                        buffer.GetAsArray1D(stream));
+                }
+            });
+
+            var statistics = accelerator.SpecializationCacheStatistics;
+            Assert.Equal(1, statistics.NumEntries);
+            Assert.True(statistics.NumEvictions > 0);
+        }
+    }
+}
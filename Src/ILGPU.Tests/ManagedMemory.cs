@@ -0,0 +1,148 @@
+﻿using ILGPU.Runtime;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace ILGPU.Tests
+{
+    public abstract class ManagedMemory : TestBase
+    {
+        protected ManagedMemory(ITestOutputHelper output, TestContext testContext)
+            : base(output, testContext)
+        { }
+
+        private const int Length = 4096;
+        private const int PageSize = 256;
+        private const int PageLength = PageSize / sizeof(int);
+
+        internal static void IncrementKernel(
+            Index1D index,
+            ArrayView1D<int, Stride1D.Dense> data)
+        {
+            data[index] += 1;
+        }
+
+        [Fact]
+        [KernelMethod(nameof(IncrementKernel))]
+        public void ManagedRoundTrip()
+        {
+            using var buffer = Accelerator.AllocateManaged1D<int>(Length);
+            var span = buffer.GetHostSpan(0, Length, ManagedMemoryAccess.Write);
+            for (int i = 0; i < Length; ++i)
+                span[i] = i;
+
+            Execute(Length, buffer.GetView(ManagedMemoryAccess.ReadWrite));
+
+            var expected = Enumerable.Range(1, Length).ToArray();
+            var result = buffer.GetHostSpan(0, Length, ManagedMemoryAccess.Read);
+            Assert.Equal(expected, result.ToArray());
+        }
+
+        [Fact]
+        [KernelMethod(nameof(IncrementKernel))]
+        public void ManagedPartialUpdate()
+        {
+            using var buffer = Accelerator.AllocateManaged1D<int>(
+                Length,
+                PageSize,
+                false);
+            Assert.False(buffer.IsMapped);
+            var span = buffer.GetHostSpan(0, Length, ManagedMemoryAccess.Write);
+            span.Fill(0);
+            Execute(Length, buffer.GetView(ManagedMemoryAccess.ReadWrite));
+
+            // Modify a single element on the host, which leaves the remaining pages
+            // on the accelerator
+            var element = buffer.GetHostSpan(100, 1, ManagedMemoryAccess.ReadWrite);
+            element[0] = 42;
+            Assert.Equal(1, buffer.NumHostDirtyPages);
+            Assert.Equal(buffer.NumPages - 1, buffer.NumDeviceDirtyPages);
+
+            Execute(Length, buffer.GetView(ManagedMemoryAccess.ReadWrite));
+
+            var expected = Enumerable.Repeat(2, Length).ToArray();
+            expected[100] = 43;
+            var result = buffer.GetHostSpan(0, Length, ManagedMemoryAccess.Read);
+            Assert.Equal(expected, result.ToArray());
+            Assert.Equal(0, buffer.NumHostDirtyPages);
+        }
+
+        [Fact]
+        public void ManagedMapping()
+        {
+            using var mapped = Accelerator.AllocateManaged1D<int>(Length);
+            using var unmapped = Accelerator.AllocateManaged1D<int>(
+                Length,
+                PageSize,
+                false);
+            Assert.Equal(
+                Accelerator.AcceleratorType == AcceleratorType.CPU,
+                mapped.IsMapped);
+            Assert.False(unmapped.IsMapped);
+            Assert.Equal(Length / PageLength, unmapped.NumPages);
+        }
+
+        [Fact]
+        [KernelMethod(nameof(IncrementKernel))]
+        public void ManagedWriteOnlyMigration()
+        {
+            using var buffer = Accelerator.AllocateManaged1D<int>(
+                Length,
+                PageSize,
+                false);
+            var span = buffer.GetHostSpan(0, Length, ManagedMemoryAccess.Write);
+            span.Fill(0);
+            Assert.Equal(buffer.NumPages, buffer.NumHostDirtyPages);
+
+            // Reading on the accelerator transfers all pages from the host
+            Execute(Length, buffer.GetView(ManagedMemoryAccess.ReadWrite));
+            Assert.Equal(0, buffer.NumHostDirtyPages);
+            Assert.Equal(buffer.NumPages, buffer.NumDeviceDirtyPages);
+
+            // Overwriting a whole page on the host skips its transfer, which leaves
+            // the stale host contents in place
+            var page = buffer.GetHostSpan(0, PageLength, ManagedMemoryAccess.Write);
+            Assert.All(page.ToArray(), value => Assert.Equal(0, value));
+            page.Fill(10);
+
+            // Overwriting a part of a page transfers the whole page first
+            var element = buffer.GetHostSpan(
+                PageLength + 1,
+                1,
+                ManagedMemoryAccess.Write);
+            element[0] = 20;
+            Assert.Equal(2, buffer.NumHostDirtyPages);
+            Assert.Equal(buffer.NumPages - 2, buffer.NumDeviceDirtyPages);
+
+            var expected = Enumerable.Repeat(1, Length).ToArray();
+            for (int i = 0; i < PageLength; ++i)
+                expected[i] = 10;
+            expected[PageLength + 1] = 20;
+            var result = buffer.GetHostSpan(0, Length, ManagedMemoryAccess.Read);
+            Assert.Equal(expected, result.ToArray());
+            Assert.Equal(2, buffer.NumHostDirtyPages);
+            Assert.Equal(0, buffer.NumDeviceDirtyPages);
+
+            // Overwriting a whole page on the accelerator skips its transfer, while
+            // all remaining host-dirty pages are transferred on the next read
+            buffer.GetView(
+                Accelerator.DefaultStream,
+                0,
+                PageLength,
+                ManagedMemoryAccess.Write);
+            Assert.Equal(1, buffer.NumHostDirtyPages);
+            Assert.Equal(1, buffer.NumDeviceDirtyPages);
+
+            Execute(Length, buffer.GetView(ManagedMemoryAccess.ReadWrite));
+            Assert.Equal(0, buffer.NumHostDirtyPages);
+            Assert.Equal(buffer.NumPages, buffer.NumDeviceDirtyPages);
+
+            // The first page still holds the previous accelerator contents
+            expected = Enumerable.Repeat(2, Length).ToArray();
+            expected[PageLength + 1] = 21;
+            result = buffer.GetHostSpan(0, Length, ManagedMemoryAccess.Read);
+            Assert.Equal(expected, result.ToArray());
+            Assert.Equal(0, buffer.NumDeviceDirtyPages);
+        }
+    }
+}
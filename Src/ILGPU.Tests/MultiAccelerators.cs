@@ -0,0 +1,231 @@
+﻿using ILGPU.Runtime;
+using System;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace ILGPU.Tests
+{
+    public abstract class MultiAccelerators : TestBase
+    {
+        protected MultiAccelerators(ITestOutputHelper output, TestContext testContext)
+            : base(output, testContext)
+        { }
+
+        public static TheoryData<object> TestDataLength => new TheoryData<object>
+        {
+            { 1 },
+            { 33 },
+            { 1025 },
+        };
+
+        internal static void OffsetKernel(
+            Index1D index,
+            ArrayView1D<int, Stride1D.Dense> data,
+            int offset)
+        {
+            data[index] = index.X + offset;
+        }
+
+        internal static void AtomicCountKernel(
+            Index1D index,
+            ArrayView1D<int, Stride1D.Dense> counts)
+        {
+            Atomic.Add(ref counts[index.X % counts.IntLength], 1);
+        }
+
+        internal static void RowKernel(
+            Index2D index,
+            ArrayView1D<int, Stride1D.Dense> data,
+            int rowOffset,
+            int rowLength)
+        {
+            data[index.Y * rowLength + index.X] =
+                (index.Y + rowOffset) * rowLength + index.X;
+        }
+
+        /// <summary>
+        /// Runs the given test on a multi accelerator that combines the current test
+        /// accelerator with two separate accelerators of the same kind.
+        /// </summary>
+        private void RunMultiAccelerator(Action<MultiAccelerator> test)
+        {
+            using var context = TestContext.CreateContext(_ => { });
+            using var first = TestContext.CreateAccelerator(context);
+            using var second = TestContext.CreateAccelerator(context);
+            using var multi = new MultiAccelerator(
+                new[] { Accelerator, first, second },
+                new double[] { 1.0, 2.0, 1.0 });
+            try
+            {
+                // Not every device supports peer access, in which case all transfers
+                // have to be staged through the host
+                multi.EnablePeerAccess();
+                test(multi);
+            }
+            finally
+            {
+                foreach (var accelerator in multi.Accelerators)
+                {
+                    foreach (var other in multi.Accelerators)
+                    {
+                        if (accelerator != other)
+                            accelerator.DisablePeerAccess(other);
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Loads the given kernel on every accelerator of the given multi accelerator.
+        /// </summary>
+        private static TKernel[] LoadKernels<TKernel>(
+            MultiAccelerator multi,
+            Func<Accelerator, TKernel> loader) =>
+            multi.Accelerators.Select(loader).ToArray();
+
+        [Theory]
+        [MemberData(nameof(TestDataLength))]
+        public void MultiAcceleratorConcat(int length) => RunMultiAccelerator(multi =>
+        {
+            var partitions = multi.Partition(length, 4);
+            Assert.Equal(length, partitions.Sum(t => t.Length));
+
+            using var buffers = multi.Allocate<int>(partitions);
+            var kernels = LoadKernels(multi, accelerator =>
+                accelerator.LoadAutoGroupedKernel<
+                    Index1D,
+                    ArrayView1D<int, Stride1D.Dense>,
+                    int>(OffsetKernel));
+            multi.Run(partitions, partition =>
+                kernels[partition.Index](
+                    partition.Stream,
+                    partition.Extent,
+                    buffers.GetView(partition),
+                    (int)partition.Offset));
+
+            var result = new int[length];
+            buffers.Gather(result);
+            Assert.Equal(Enumerable.Range(0, length).ToArray(), result);
+        });
+
+        [Fact]
+        public void MultiAcceleratorExtentOverflow()
+        {
+            using var multi = new MultiAccelerator(new[] { Accelerator });
+            var partition = Assert.Single(multi.Partition(int.MaxValue + 1L));
+            Assert.Throws<OverflowException>(() => partition.Extent);
+
+            partition = Assert.Single(
+                multi.Partition(new LongIndex2D(int.MaxValue + 1L, 1)));
+            Assert.Throws<OverflowException>(() => partition.Extent2D);
+        }
+
+        [Theory]
+        [MemberData(nameof(TestDataLength))]
+        public void MultiAcceleratorPartition2D(int length) =>
+            RunMultiAccelerator(multi =>
+            {
+                const int RowLength = 7;
+                var partitions = multi.Partition(new LongIndex2D(RowLength, length));
+                Assert.Equal(length, partitions.Sum(t => t.Length));
+                foreach (var partition in partitions)
+                {
+                    Assert.Equal(RowLength, partition.RowLength);
+                    Assert.Equal(
+                        new Index2D(RowLength, (int)partition.Length),
+                        partition.Extent2D);
+                }
+
+                using var buffers = multi.Allocate<int>(partitions);
+                var kernels = LoadKernels(multi, accelerator =>
+                    accelerator.LoadAutoGroupedKernel<
+                        Index2D,
+                        ArrayView1D<int, Stride1D.Dense>,
+                        int,
+                        int>(RowKernel));
+                multi.Run(partitions, partition =>
+                    kernels[partition.Index](
+                        partition.Stream,
+                        partition.Extent2D,
+                        buffers.GetView(partition),
+                        (int)partition.Offset,
+                        RowLength));
+
+                var result = new int[length * RowLength];
+                buffers.Gather(result);
+                Assert.Equal(
+                    Enumerable.Range(0, length * RowLength).ToArray(),
+                    result);
+            });
+
+        [Theory]
+        [MemberData(nameof(TestDataLength))]
+        public void MultiAcceleratorDynamicReduce(int length) =>
+            RunMultiAccelerator(multi =>
+            {
+                const int NumCounts = 4;
+                using var counts = multi.AllocateReplicated<int>(NumCounts);
+                for (int i = 0; i < counts.Count; ++i)
+                    counts[i].MemSetToZero();
+                foreach (var accelerator in multi.Accelerators)
+                    accelerator.Synchronize();
+
+                var kernels = LoadKernels(multi, accelerator =>
+                    accelerator.LoadAutoGroupedKernel<
+                        Index1D,
+                        ArrayView1D<int, Stride1D.Dense>>(AtomicCountKernel));
+                multi.RunDynamic(length, 16, chunk =>
+                    kernels[chunk.Index](
+                        chunk.Stream,
+                        chunk.Extent,
+                        counts.GetView(chunk)));
+
+                var result = new int[NumCounts];
+                counts.Reduce(result, (a, b) => a + b);
+                Assert.Equal(length, result.Sum());
+            });
+
+        [Theory]
+        [MemberData(nameof(TestDataLength))]
+        public void MultiAcceleratorExchange(int length) => RunMultiAccelerator(multi =>
+        {
+            using var buffers = multi.AllocateReplicated<int>(length);
+            var kernels = LoadKernels(multi, accelerator =>
+                accelerator.LoadAutoGroupedKernel<
+                    Index1D,
+                    ArrayView1D<int, Stride1D.Dense>,
+                    int>(OffsetKernel));
+            multi.Run(buffers.Partitions, partition =>
+                kernels[partition.Index](
+                    partition.Stream,
+                    partition.Extent,
+                    buffers.GetView(partition),
+                    partition.Index * length));
+
+            // Move the upper half of each buffer into the lower half of the buffer
+            // of the next accelerator, which covers copies from and to the test
+            // accelerator as well as copies between the additional accelerators
+            int half = length / 2;
+            for (int i = 0; i < multi.Count && half > 0; ++i)
+            {
+                buffers.Exchange(
+                    i,
+                    length - half,
+                    (i + 1) % multi.Count,
+                    0,
+                    half);
+            }
+
+            for (int i = 0; i < multi.Count; ++i)
+            {
+                int source = (i + multi.Count - 1) % multi.Count;
+                var expected = Enumerable.Range(0, length).Select(j =>
+                    j < half
+                    ? source * length + length - half + j
+                    : i * length + j).ToArray();
+                Assert.Equal(expected, buffers[i].GetAsArray1D());
+            }
+        });
+    }
+}
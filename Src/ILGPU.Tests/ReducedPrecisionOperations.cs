@@ -0,0 +1,213 @@
+﻿using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace ILGPU.Tests
+{
+    public abstract class ReducedPrecisionOperations : TestBase
+    {
+        protected ReducedPrecisionOperations(
+            ITestOutputHelper output,
+            TestContext testContext)
+            : base(output, testContext)
+        { }
+
+        private const int Length = 1024;
+
+        internal static void BFloat16ScaleKernel(
+            Index1D index,
+            ArrayView1D<float, Stride1D.Dense> source,
+            ArrayView1D<BFloat16, Stride1D.Dense> target)
+        {
+            var value = (BFloat16)source[index];
+            target[index] = value * (BFloat16)2.0f;
+        }
+
+        [Fact]
+        [KernelMethod(nameof(BFloat16ScaleKernel))]
+        public void BFloat16Scale()
+        {
+            var source = Enumerable.Range(0, Length)
+                .Select(t => (t - Length / 2) * 1.37f)
+                .ToArray();
+            using var sourceBuffer = Accelerator.Allocate1D(source);
+            using var target = Accelerator.Allocate1D<BFloat16>(Length);
+            Execute(Length, sourceBuffer.View, target.View);
+
+            var expected = source
+                .Select(t => (BFloat16)t * (BFloat16)2.0f)
+                .ToArray();
+            Verify(target.View, expected);
+        }
+
+        internal static float ComputeBFloat16(BFloat16 first, BFloat16 second)
+        {
+            var result = first < second ? first - second : -(first / second);
+            if (BFloat16.IsNaN(result) || BFloat16.IsInfinity(result))
+                result = (BFloat16)0.0f;
+            return BFloat16.Abs(result) + (first == second ? 1.0f : 0.0f);
+        }
+
+        internal static void BFloat16ArithmeticKernel(
+            Index1D index,
+            ArrayView1D<BFloat16, Stride1D.Dense> first,
+            ArrayView1D<BFloat16, Stride1D.Dense> second,
+            ArrayView1D<float, Stride1D.Dense> target)
+        {
+            target[index] = ComputeBFloat16(first[index], second[index]);
+        }
+
+        [Fact]
+        [KernelMethod(nameof(BFloat16ArithmeticKernel))]
+        public void BFloat16Arithmetic()
+        {
+            var first = Enumerable.Range(0, Length)
+                .Select(t => (BFloat16)((t - Length / 2) * 0.75f))
+                .ToArray();
+            var second = Enumerable.Range(0, Length)
+                .Select(t => (BFloat16)(t % 17 - 8))
+                .ToArray();
+            using var firstBuffer = Accelerator.Allocate1D(first);
+            using var secondBuffer = Accelerator.Allocate1D(second);
+            using var target = Accelerator.Allocate1D<float>(Length);
+            Execute(Length, firstBuffer.View, secondBuffer.View, target.View);
+
+            var expected = Enumerable.Range(0, Length)
+                .Select(i => ComputeBFloat16(first[i], second[i]))
+                .ToArray();
+            Verify(target.View, expected);
+        }
+
+        [Theory]
+        [InlineData(1.0f, 0x3F80)]
+        [InlineData(-2.0f, 0xC000)]
+        [InlineData(1.00390625f, 0x3F80)]
+        [InlineData(1.01171875f, 0x3F82)]
+        [InlineData(float.PositiveInfinity, 0x7F80)]
+        [InlineData(float.NaN, 0x7FC0)]
+        public void BFloat16Conversion(float value, int rawValue)
+        {
+            var converted = (float)(BFloat16)value;
+            var expected = Interop.IntAsFloat((uint)rawValue << 16);
+            if (float.IsNaN(value))
+                Assert.True(float.IsNaN(converted));
+            else
+                Assert.Equal(expected, converted);
+        }
+
+        private const int LocalLength = 4;
+
+        internal static BFloat16 SumBFloat16(float value)
+        {
+            BFloat16 sum = default;
+            for (int i = 0; i < LocalLength; ++i)
+                sum += (BFloat16)(value + (LocalLength - 1 - i));
+            return sum;
+        }
+
+        internal static void BFloat16LocalArrayKernel(
+            Index1D index,
+            ArrayView1D<float, Stride1D.Dense> source,
+            ArrayView1D<BFloat16, Stride1D.Dense> target)
+        {
+            var values = LocalMemory.Allocate<BFloat16>(LocalLength);
+            for (int i = 0; i < LocalLength; ++i)
+                values[i] = (BFloat16)(source[index] + i);
+
+            BFloat16 sum = default;
+            for (int i = 0; i < LocalLength; ++i)
+                sum += values[LocalLength - 1 - i];
+            target[index] = sum;
+        }
+
+        [Fact]
+        [KernelMethod(nameof(BFloat16LocalArrayKernel))]
+        public void BFloat16LocalArray()
+        {
+            var source = Enumerable.Range(0, Length)
+                .Select(t => (t - Length / 2) * 0.37f)
+                .ToArray();
+            using var sourceBuffer = Accelerator.Allocate1D(source);
+            using var target = Accelerator.Allocate1D<BFloat16>(Length);
+            Execute(Length, sourceBuffer.View, target.View);
+
+            var expected = source.Select(SumBFloat16).ToArray();
+            Verify(target.View, expected);
+        }
+
+        internal static void BFloat16ThreadValuesKernel(
+            ArrayView1D<BFloat16, Stride1D.Dense> source,
+            ArrayView1D<BFloat16, Stride1D.Dense> shuffled,
+            ArrayView1D<BFloat16, Stride1D.Dense> broadcasted)
+        {
+            var idx = Grid.GlobalIndex.X;
+            var value = source[idx];
+            shuffled[idx] = Warp.Shuffle(value, Warp.WarpSize - 1);
+            broadcasted[idx] = Group.Broadcast(value, Group.DimX - 1);
+        }
+
+        [Fact]
+        [KernelMethod(nameof(BFloat16ThreadValuesKernel))]
+        public void BFloat16ThreadValues()
+        {
+            const int NumGroups = 4;
+
+            // Use groups that consist of a single warp each
+            int warpSize = Accelerator.WarpSize;
+            int length = NumGroups * warpSize;
+            var source = Enumerable.Range(0, length)
+                .Select(t => (BFloat16)((t - length / 2) * 0.75f))
+                .ToArray();
+            using var sourceBuffer = Accelerator.Allocate1D(source);
+            using var shuffled = Accelerator.Allocate1D<BFloat16>(length);
+            using var broadcasted = Accelerator.Allocate1D<BFloat16>(length);
+            Execute(
+                new KernelConfig(NumGroups, warpSize),
+                sourceBuffer.View,
+                shuffled.View,
+                broadcasted.View);
+
+            var expected = Enumerable.Range(0, length)
+                .Select(i => source[i / warpSize * warpSize + warpSize - 1])
+                .ToArray();
+            Verify(shuffled.View, expected);
+            Verify(broadcasted.View, expected);
+        }
+
+        internal static void Dot4Kernel(
+            Index1D index,
+            ArrayView1D<int, Stride1D.Dense> first,
+            ArrayView1D<int, Stride1D.Dense> second,
+            ArrayView1D<int, Stride1D.Dense> target)
+        {
+            target[index] = IntrinsicMath.Dot4(first[index], second[index], index);
+        }
+
+        [Fact]
+        [KernelMethod(nameof(Dot4Kernel))]
+        public void Dot4()
+        {
+            var first = Enumerable.Range(0, Length)
+                .Select(t => IntrinsicMath.Pack4(
+                    (sbyte)t,
+                    (sbyte)-t,
+                    (sbyte)(t * 3),
+                    (sbyte)(t >> 2)))
+                .ToArray();
+            var second = first.Select(t => t * 7 + 13).ToArray();
+            using var firstBuffer = Accelerator.Allocate1D(first);
+            using var secondBuffer = Accelerator.Allocate1D(second);
+            using var target = Accelerator.Allocate1D<int>(Length);
+            Execute(Length, firstBuffer.View, secondBuffer.View, target.View);
+
+            var expected = Enumerable.Range(0, Length).Select(i =>
+            {
+                int result = i;
+                for (int j = 0; j < 32; j += 8)
+                    result += (sbyte)(first[i] >> j) * (sbyte)(second[i] >> j);
+                return result;
+            }).ToArray();
+            Verify(target.View, expected);
+        }
+    }
+}
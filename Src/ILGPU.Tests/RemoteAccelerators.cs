@@ -0,0 +1,128 @@
+﻿using ILGPU.Runtime;
+using ILGPU.Runtime.Remote;
+using System;
+using System.Linq;
+using System.Net;
+using System.Net.Sockets;
+using System.Reflection;
+using System.Threading.Tasks;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace ILGPU.Tests
+{
+    public abstract class RemoteAccelerators : TestBase
+    {
+        protected RemoteAccelerators(ITestOutputHelper output, TestContext testContext)
+            : base(output, testContext)
+        { }
+
+        public static TheoryData<object> TestDataLength => new TheoryData<object>
+        {
+            { 1 },
+            { 1025 },
+            { 1 << 19 },
+        };
+
+        internal static void ScaleKernel(
+            Index1D index,
+            ArrayView1D<int, Stride1D.Dense> source,
+            ArrayView<int> target,
+            int factor)
+        {
+            target[index] = source[index] * factor;
+        }
+
+        /// <summary>
+        /// Runs a remote worker hosting the current accelerator on a local socket and
+        /// invokes the given action with a connected remote accelerator.
+        /// </summary>
+        private void RunRemote(Action<RemoteAccelerator> action) =>
+            RunRemote(new[] { typeof(RemoteAccelerators).Assembly }, action);
+
+        /// <summary>
+        /// Runs a remote worker that accepts kernels of the given assemblies.
+        /// </summary>
+        private void RunRemote(
+            Assembly[] kernelAssemblies,
+            Action<RemoteAccelerator> action)
+        {
+            var listener = new TcpListener(IPAddress.Loopback, 0);
+            listener.Start();
+            try
+            {
+                var worker = Task.Run(() =>
+                {
+                    using var socket = listener.AcceptTcpClient();
+                    using var remoteWorker = new RemoteWorker(
+                        Accelerator,
+                        socket.GetStream(),
+                        kernelAssemblies);
+                    remoteWorker.Run();
+                });
+
+                using (var client = new TcpClient())
+                {
+                    client.Connect(
+                        IPAddress.Loopback,
+                        ((IPEndPoint)listener.LocalEndpoint).Port);
+                    using var remote = RemoteDevice.Connect(client.GetStream())
+                        .CreateRemoteAccelerator(Context);
+                    action(remote);
+                }
+                worker.Wait();
+            }
+            finally
+            {
+                listener.Stop();
+            }
+        }
+
+        [Theory]
+        [MemberData(nameof(TestDataLength))]
+        public void RemoteLaunch(int length)
+        {
+            var data = Enumerable.Range(0, length).ToArray();
+            RunRemote(remote =>
+            {
+                Assert.Equal(AcceleratorType.Remote, remote.AcceleratorType);
+                Assert.Equal(Accelerator.AcceleratorType, remote.RemoteAcceleratorType);
+
+                using var source = remote.Allocate1D<int>(length);
+                using var target = remote.Allocate1D<int>(length);
+                source.CopyFromCPU(data);
+                var kernel = remote.LoadAutoGroupedStreamKernel<
+                    Index1D,
+                    ArrayView1D<int, Stride1D.Dense>,
+                    ArrayView<int>,
+                    int>(ScaleKernel);
+                kernel(length, source.View, target.View.BaseView, 3);
+                remote.Synchronize();
+
+                var expected = data.Select(t => t * 3).ToArray();
+                Assert.Equal(expected, target.GetAsArray1D());
+            });
+        }
+
+        [Fact]
+        public void RemoteError()
+        {
+            // The worker does not accept kernels of the test assembly
+            RunRemote(Array.Empty<Assembly>(), remote =>
+            {
+                Assert.Throws<RemoteException>(() =>
+                    remote.LoadAutoGroupedStreamKernel<
+                        Index1D,
+                        ArrayView1D<int, Stride1D.Dense>,
+                        ArrayView<int>,
+                        int>(ScaleKernel));
+
+                // The worker remains usable after reporting the error
+                using var buffer = remote.Allocate1D<int>(1);
+                buffer.MemSetToZero();
+                remote.Synchronize();
+                Assert.Equal(new[] { 0 }, buffer.GetAsArray1D());
+            });
+        }
+    }
+}
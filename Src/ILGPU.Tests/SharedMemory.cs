@@ -1,4 +1,8 @@
-﻿using ILGPU.Runtime;
+﻿using ILGPU.IR;
+using ILGPU.IR.Types;
+using ILGPU.IR.Values;
+using ILGPU.Runtime;
+using System.Collections.Generic;
 using System.Diagnostics.CodeAnalysis;
 using System.Linq;
 using System.Runtime.CompilerServices;
@@ -116,6 +120,127 @@ namespace ILGPU.Tests
             Verify(buffer.View, expected);
         }
 
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        private static int LoadNextValue(ArrayView<int> view) =>
+            view[(Group.IdxX + 1) % Group.DimX];
+
+        internal static void SharedMemoryMixedCallsKernel(
+            ArrayView1D<int, Stride1D.Dense> data)
+        {
+            var sharedMemory = ILGPU.SharedMemory.Allocate1D<int>(1024);
+            sharedMemory[Group.IdxX] = Group.IdxX;
+            Group.Barrier();
+
+            var idx = Grid.GlobalIndex.X;
+            int value = LoadNextValue(sharedMemory.AsContiguous());
+            data[idx] = value;
+            Group.Barrier();
+
+            var groupView = data.AsContiguous().SubView(idx - Group.IdxX, Group.DimX);
+            int nextValue = LoadNextValue(groupView);
+            Group.Barrier();
+            data[idx] = value + nextValue;
+        }
+
+        [Theory]
+        [InlineData(1)]
+        [InlineData(10)]
+        [InlineData(32)]
+        [KernelMethod(nameof(SharedMemoryMixedCallsKernel))]
+        public void SharedMemoryMixedCalls(int groupMultiplier)
+        {
+            using var buffer = Accelerator.Allocate1D<int>(2 * groupMultiplier);
+            var index = new KernelConfig(groupMultiplier, 2);
+            Execute(index, buffer.View);
+
+            var expected = new int[buffer.Length];
+            for (int i = 0; i < buffer.Length; i += 2)
+            {
+                expected[i] = 1;
+                expected[i + 1] = 1;
+            }
+
+            Verify(buffer.View, expected);
+        }
+
+        [Fact]
+        [KernelMethod(nameof(SharedMemoryMixedCallsKernel))]
+        public void SharedMemoryMixedCallsIR()
+        {
+            // Collect the pointer address spaces of all called LoadNextValue methods
+            var targets = new List<MemoryAddressSpace[]>();
+            InspectKernel((kernelContext, kernelMethod) =>
+                kernelMethod.Blocks.ForEachValue<MethodCall>(call =>
+                {
+                    if (call.Target.Source?.Name != nameof(LoadNextValue))
+                        return;
+                    var addressSpaces = new List<MemoryAddressSpace>();
+                    foreach (var param in call.Target.Parameters)
+                    {
+                        if (param.Type is AddressSpaceType addressSpaceType)
+                            addressSpaces.Add(addressSpaceType.AddressSpace);
+                        if (!(param.Type is StructureType structureType))
+                            continue;
+                        foreach (var fieldType in structureType.Fields)
+                        {
+                            if (fieldType is AddressSpaceType fieldAddressSpaceType)
+                                addressSpaces.Add(fieldAddressSpaceType.AddressSpace);
+                        }
+                    }
+                    targets.Add(addressSpaces.ToArray());
+                }));
+
+            // Call targets are specialized in O2 only
+            if (TestContext.OptimizationLevel < OptimizationLevel.O2)
+                return;
+
+            // The shared-memory call must invoke a clone that operates on
+            // non-generic address spaces only
+            Assert.Contains(
+                targets,
+                addressSpaces =>
+                    addressSpaces.Contains(MemoryAddressSpace.Shared) &&
+                    !addressSpaces.Contains(MemoryAddressSpace.Generic));
+        }
+
+        internal static void SharedMemoryMixedTypesKernel(
+            ArrayView1D<long, Stride1D.Dense> data)
+        {
+            var bytes = ILGPU.SharedMemory.Allocate1D<byte>(3);
+            var longs = ILGPU.SharedMemory.Allocate1D<long>(2);
+            ref var value = ref ILGPU.SharedMemory.Allocate<short>();
+            if (Group.IsFirstThread)
+            {
+                bytes[0] = 1;
+                bytes[1] = 2;
+                bytes[2] = 3;
+                longs[0] = 1L << 40;
+                longs[1] = -1;
+                value = 42;
+            }
+            Group.Barrier();
+
+            var idx = Grid.GlobalIndex.X;
+            data[idx] = bytes[0] + bytes[1] + bytes[2] + longs[0] + longs[1] + value;
+        }
+
+        [Theory]
+        [InlineData(1)]
+        [InlineData(10)]
+        [InlineData(32)]
+        [KernelMethod(nameof(SharedMemoryMixedTypesKernel))]
+        public void SharedMemoryMixedTypes(int groupMultiplier)
+        {
+            using var buffer = Accelerator.Allocate1D<long>(4 * groupMultiplier);
+            var index = new KernelConfig(groupMultiplier, 4);
+            Execute(index, buffer.View);
+
+            var expected = Enumerable.Repeat(
+                (1L << 40) + 47,
+                (int)buffer.Length).ToArray();
+            Verify(buffer.View, expected);
+        }
+
         [MethodImpl(MethodImplOptions.NoInlining)]
         private static int DynamicSharedMemoryNested()
         {
@@ -1,5 +1,8 @@
 ﻿using ILGPU.Runtime;
 using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading.Tasks;
 using Xunit;
 using Xunit.Abstractions;
 
@@ -96,5 +99,189 @@ namespace ILGPU.Tests
             var expected = new T[] { value };
             Verify(buffer.View, expected);
         }
+
+        internal static void TieredSpecializationKernel(
+            Index1D index,
+            ArrayView1D<int, Stride1D.Dense> data,
+            SpecializedValue<int> value)
+        {
+            data[index] = value + index.X;
+        }
+
+        private const int TieredLength = 32;
+
+        /// <summary>
+        /// The maximum number of launches until a tiered kernel has to be
+        /// specialized, which is bounded by the largest threshold used below.
+        /// </summary>
+        private const int MaxNumTieredLaunches = 3;
+
+        private Context CreateTieredContext(
+            int threshold,
+            int maxNumSpecializations) =>
+            TestContext.CreateContext(builder =>
+                builder.TieredSpecialization(threshold, maxNumSpecializations));
+
+        private static Action<
+            AcceleratorStream,
+            Index1D,
+            ArrayView1D<int, Stride1D.Dense>,
+            SpecializedValue<int>> LoadTieredKernel(Accelerator accelerator) =>
+            accelerator.LoadAutoGroupedKernel<
+                Index1D,
+                ArrayView1D<int, Stride1D.Dense>,
+                SpecializedValue<int>>(TieredSpecializationKernel);
+
+        /// <summary>
+        /// Launches the tiered kernel until the specialized kernel for the given
+        /// value is used and verifies the results of all launches.
+        /// </summary>
+        private static void LaunchUntilSpecialized(
+            Accelerator accelerator,
+            MemoryBuffer1D<int, Stride1D.Dense> buffer,
+            int value)
+        {
+            var failures = new List<Exception>();
+            void OnFailure(object sender, Exception e)
+            {
+                lock (failures)
+                    failures.Add(e);
+            }
+
+            var kernel = LoadTieredKernel(accelerator);
+            var expected = Enumerable.Range(value, TieredLength).ToArray();
+            bool specialized = false;
+            accelerator.SpecializationFailed += OnFailure;
+            try
+            {
+                for (int i = 0; i < MaxNumTieredLaunches && !specialized; ++i)
+                {
+                    long numHits = accelerator.SpecializationCacheStatistics.NumHits;
+                    buffer.MemSetToZero();
+                    kernel(
+                        accelerator.DefaultStream,
+                        TieredLength,
+                        buffer.View,
+                        new SpecializedValue<int>(value));
+                    accelerator.Synchronize();
+                    Assert.Equal(expected, buffer.GetAsArray1D());
+
+                    // Wait for a specialization that might have been scheduled by
+                    // this launch before launching the kernel again
+                    specialized =
+                        accelerator.SpecializationCacheStatistics.NumHits > numHits;
+                    accelerator.WaitForSpecializations();
+                }
+            }
+            finally
+            {
+                accelerator.SpecializationFailed -= OnFailure;
+            }
+            Assert.Empty(failures);
+            Assert.True(specialized);
+        }
+
+        [Fact]
+        public void TieredSpecialization()
+        {
+            using var context = CreateTieredContext(2, 16);
+            using var accelerator = TestContext.CreateAccelerator(context);
+            using var buffer = accelerator.Allocate1D<int>(TieredLength);
+            var kernel = LoadTieredKernel(accelerator);
+
+            // The first launch is below the threshold and uses the generic kernel
+            kernel(
+                accelerator.DefaultStream,
+                TieredLength,
+                buffer.View,
+                new SpecializedValue<int>(3));
+            accelerator.Synchronize();
+            Assert.Equal(
+                Enumerable.Range(3, TieredLength).ToArray(),
+                buffer.GetAsArray1D());
+
+            var statistics = accelerator.SpecializationCacheStatistics;
+            Assert.Equal(0, statistics.NumHits);
+            Assert.Equal(1, statistics.NumMisses);
+            Assert.Equal(0, statistics.NumEntries);
+
+            LaunchUntilSpecialized(accelerator, buffer, 3);
+            statistics = accelerator.SpecializationCacheStatistics;
+            Assert.Equal(1, statistics.NumEntries);
+            Assert.Equal(0, statistics.NumEvictions);
+        }
+
+        [Fact]
+        public void TieredSpecializationRace()
+        {
+            const int NumValues = 4;
+            const int NumThreads = 8;
+            const int NumLaunches = 32;
+
+            using var context = CreateTieredContext(1, 16);
+            using var accelerator = TestContext.CreateAccelerator(context);
+            var kernel = LoadTieredKernel(accelerator);
+
+            // Launch the same values from several threads while their specialized
+            // kernels are being promoted in the background
+            Parallel.For(0, NumThreads, thread =>
+            {
+                using var stream = accelerator.CreateStream();
+                using var buffer = accelerator.Allocate1D<int>(TieredLength);
+                for (int i = 0; i < NumLaunches; ++i)
+                {
+                    int value = (thread + i) % NumValues;
+                    kernel(
+                        stream,
+                        TieredLength,
+                        buffer.View,
+                        new SpecializedValue<int>(value));
+                    stream.Synchronize();
+                    Assert.Equal(
+                        Enumerable.Range(value, TieredLength).ToArray(),
+                        buffer.GetAsArray1D(stream));
+                }
+            });
+
+            var statistics = accelerator.SpecializationCacheStatistics;
+            Assert.Equal(
+                NumThreads * NumLaunches,
+                statistics.NumHits + statistics.NumMisses);
+
+            using (var buffer = accelerator.Allocate1D<int>(TieredLength))
+            {
+                for (int value = 0; value < NumValues; ++value)
+                    LaunchUntilSpecialized(accelerator, buffer, value);
+            }
+
+            // Every value is promoted exactly once
+            statistics = accelerator.SpecializationCacheStatistics;
+            Assert.Equal(NumValues, statistics.NumEntries);
+            Assert.Equal(0, statistics.NumEvictions);
+        }
+
+        [Fact]
+        public void TieredSpecializationBound()
+        {
+            const int MaxNumSpecializations = 2;
+            const int NumValues = 5;
+
+            using var context = CreateTieredContext(1, MaxNumSpecializations);
+            using var accelerator = TestContext.CreateAccelerator(context);
+            using var buffer = accelerator.Allocate1D<int>(TieredLength);
+
+            for (int value = 0; value < NumValues; ++value)
+            {
+                LaunchUntilSpecialized(accelerator, buffer, value);
+                var statistics = accelerator.SpecializationCacheStatistics;
+                Assert.True(statistics.NumEntries <= MaxNumSpecializations);
+            }
+
+            var finalStatistics = accelerator.SpecializationCacheStatistics;
+            Assert.Equal(MaxNumSpecializations, finalStatistics.NumEntries);
+            Assert.Equal(
+                NumValues - MaxNumSpecializations,
+                finalStatistics.NumEvictions);
+        }
     }
 }
@@ -0,0 +1,119 @@
+﻿using ILGPU.IR;
+using ILGPU.IR.Types;
+using System;
+using System.IO;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace ILGPU.Tests
+{
+    public abstract class TypeSerialization : TestBase
+    {
+        protected TypeSerialization(ITestOutputHelper output, TestContext testContext)
+            : base(output, testContext)
+        { }
+
+        public static TheoryData<Type> TypeSerializationData => new TheoryData<Type>
+        {
+            { typeof(bool) },
+            { typeof(sbyte) },
+            { typeof(short) },
+            { typeof(int) },
+            { typeof(long) },
+            { typeof(Half) },
+            { typeof(float) },
+            { typeof(double) },
+            { typeof(EmptyStruct) },
+            { typeof(TestStruct) },
+            { typeof(TestStruct<TestStruct<byte>>) },
+            { typeof(TestStruct<int, TestStruct<float, long>>) },
+            { typeof(SmallCustomSizeStruct) },
+            { typeof(DeepStructure<int>) },
+            { typeof(ArrayView<int>) },
+            { typeof(ArrayView<TestStruct<short, double>>) },
+            { typeof(int[]) },
+            { typeof(int[,]) },
+        };
+
+        [Theory]
+        [MemberData(nameof(TypeSerializationData))]
+        public void RoundTripTypes(Type type)
+        {
+            using var irContext = new IRContext(Context);
+            var typeNode = irContext.CreateType(type);
+
+            using var stream = new MemoryStream();
+            IRTypeSerializer.Serialize(stream, new TypeNode[] { typeNode, typeNode });
+
+            stream.Position = 0;
+            using var targetContext = new IRContext(Context);
+            var types = IRTypeSerializer.Deserialize(stream, targetContext.TypeContext);
+
+            Assert.Equal(2, types.Length);
+            Assert.Equal(typeNode, types[0]);
+            Assert.Same(types[0], types[1]);
+            Assert.Equal(typeNode.Size, types[0].Size);
+            Assert.Equal(typeNode.Alignment, types[0].Alignment);
+        }
+
+        [Fact]
+        public void InvalidTypeData()
+        {
+            using var stream = new MemoryStream(new byte[16]);
+            using var irContext = new IRContext(Context);
+            Assert.Throws<InvalidDataException>(() =>
+                IRTypeSerializer.Deserialize(stream, irContext.TypeContext));
+        }
+
+        private byte[] SerializeInt32Type()
+        {
+            using var irContext = new IRContext(Context);
+            using var stream = new MemoryStream();
+            IRTypeSerializer.Serialize(
+                stream,
+                new TypeNode[] { irContext.CreateType(typeof(int)) });
+            return stream.ToArray();
+        }
+
+        [Fact]
+        public void InvalidTypeHeader()
+        {
+            var data = SerializeInt32Type();
+            data[0] ^= 0xff;
+
+            using var stream = new MemoryStream(data);
+            using var irContext = new IRContext(Context);
+            var exception = Assert.Throws<InvalidDataException>(() =>
+                IRTypeSerializer.Deserialize(stream, irContext.TypeContext));
+            Assert.DoesNotContain("version", exception.Message);
+        }
+
+        [Fact]
+        public void UnsupportedTypeVersion()
+        {
+            var data = SerializeInt32Type();
+            BitConverter.GetBytes(1337).CopyTo(data, 4);
+
+            using var stream = new MemoryStream(data);
+            using var irContext = new IRContext(Context);
+            var exception = Assert.Throws<InvalidDataException>(() =>
+                IRTypeSerializer.Deserialize(stream, irContext.TypeContext));
+            Assert.Contains("1337", exception.Message);
+        }
+
+        [Theory]
+        [InlineData(-1)]
+        [InlineData(1000)]
+        public void InvalidTypeEnumValue(int basicValueType)
+        {
+            // Layout: magic, version, number of types, type kind, basic value type
+            var data = SerializeInt32Type();
+            BitConverter.GetBytes(basicValueType).CopyTo(data, 13);
+
+            using var stream = new MemoryStream(data);
+            using var irContext = new IRContext(Context);
+            Assert.Throws<InvalidDataException>(() =>
+                IRTypeSerializer.Deserialize(stream, irContext.TypeContext));
+        }
+    }
+}
@@ -0,0 +1,375 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: BFloat16.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.Frontend.Intrinsic;
+using ILGPU.IR.Values;
+using System;
+#if !DEBUG
+using System.Diagnostics;
+#endif
+using System.Runtime.CompilerServices;
+
+namespace ILGPU
+{
+    /// <summary>
+    /// A brain floating point value with 16 bit precision. It consists of the upper
+    /// 16 bits of a single precision value: a sign bit, 8 exponent bits and 7
+    /// mantissa bits.
+    /// </summary>
+    /// <remarks>
+    /// Brain floats are primitive IR values of type
+    /// <see cref="BasicValueType.BFloat16"/>. All arithmetic operations are carried
+    /// out in single precision. Since both formats share the same exponent range,
+    /// conversions reduce to shifts and a rounding step on all accelerators.
+    /// </remarks>
+    [Serializable]
+    public readonly struct BFloat16 : IEquatable<BFloat16>, IComparable<BFloat16>
+    {
+        #region Constants
+
+        /// <summary>
+        /// The canonical quiet NaN representation.
+        /// </summary>
+        private const ushort NaNValue = 0x7FC0;
+
+        /// <summary>
+        /// The sign bit.
+        /// </summary>
+        private const ushort SignMask = 0x8000;
+
+        /// <summary>
+        /// Represents 0.
+        /// </summary>
+        public static readonly BFloat16 Zero = new BFloat16(0);
+
+        /// <summary>
+        /// Represents 1.
+        /// </summary>
+        public static readonly BFloat16 One = new BFloat16(0x3F80);
+
+        #endregion
+
+        #region Static
+
+        /// <summary>
+        /// Returns the absolute value of the given value.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>The absolute value.</returns>
+        [MathIntrinsic(MathIntrinsicKind.Abs)]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static BFloat16 Abs(BFloat16 value) =>
+            new BFloat16((ushort)(value.RawValue & ~SignMask));
+
+        /// <summary>
+        /// Returns true if the given value represents a NaN value.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>True, if the given value represents a NaN value.</returns>
+        [MathIntrinsic(MathIntrinsicKind.IsNaNF)]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static bool IsNaN(BFloat16 value) =>
+            (value.RawValue & 0x7FFF) > 0x7F80;
+
+        /// <summary>
+        /// Returns true if the given value represents infinity.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>True, if the given value represents infinity.</returns>
+        [MathIntrinsic(MathIntrinsicKind.IsInfF)]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static bool IsInfinity(BFloat16 value) =>
+            (value.RawValue & 0x7FFF) == 0x7F80;
+
+        /// <summary>
+        /// Converts the given float into a brain float by rounding to the nearest
+        /// even value.
+        /// </summary>
+        /// <param name="value">The float to convert.</param>
+        /// <returns>The converted value.</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static BFloat16 ConvertFloatToBFloat16(float value)
+        {
+            uint bits = Interop.FloatAsInt(value);
+            if ((bits & 0x7FFFFFFFU) > 0x7F800000U)
+                return new BFloat16(NaNValue);
+            uint rounding = 0x7FFFU + ((bits >> 16) & 1U);
+            return new BFloat16((ushort)((bits + rounding) >> 16));
+        }
+
+        /// <summary>
+        /// Converts the given brain float into a float.
+        /// </summary>
+        /// <param name="value">The value to convert.</param>
+        /// <returns>The converted float.</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static float ConvertBFloat16ToFloat(BFloat16 value) =>
+            Interop.IntAsFloat((uint)value.RawValue << 16);
+
+        #endregion
+
+        #region Instance
+
+        /// <summary>
+        /// Constructs a new brain float.
+        /// </summary>
+        /// <param name="rawValue">The underlying raw value.</param>
+        internal BFloat16(ushort rawValue)
+        {
+            RawValue = rawValue;
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Represents the raw value.
+        /// </summary>
+#if !DEBUG
+        [DebuggerBrowsable(DebuggerBrowsableState.Never)]
+#endif
+        internal ushort RawValue { get; }
+
+        #endregion
+
+        #region IEquatable
+
+        /// <summary>
+        /// Returns true if the given value is equal to the current value.
+        /// </summary>
+        /// <param name="other">The other value.</param>
+        /// <returns>True, if the given value is equal to the current value.</returns>
+        public readonly bool Equals(BFloat16 other) => this == other;
+
+        #endregion
+
+        #region IComparable
+
+        /// <summary>
+        /// Compares this value to the given one.
+        /// </summary>
+        /// <param name="other">The other value.</param>
+        /// <returns>The result of the comparison.</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public readonly int CompareTo(BFloat16 other) =>
+            ((float)this).CompareTo(other);
+
+        #endregion
+
+        #region Object
+
+        /// <summary>
+        /// Returns true if the given object is equal to the current value.
+        /// </summary>
+        /// <param name="obj">The other object.</param>
+        /// <returns>True, if the given object is equal to the current value.</returns>
+        public readonly override bool Equals(object obj) =>
+            obj is BFloat16 other && Equals(other);
+
+        /// <summary>
+        /// Returns the hash code of this value.
+        /// </summary>
+        /// <returns>The hash code of this value.</returns>
+        public readonly override int GetHashCode() => RawValue;
+
+        /// <summary>
+        /// Returns the string representation of this value.
+        /// </summary>
+        /// <returns>The string representation of this value.</returns>
+        public readonly override string ToString() => ((float)this).ToString();
+
+        #endregion
+
+        #region Operators
+
+        /// <summary>
+        /// Negates the given value.
+        /// </summary>
+        /// <param name="value">The value to negate.</param>
+        /// <returns>The negated value.</returns>
+        [MathIntrinsic(MathIntrinsicKind.Neg)]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static BFloat16 operator -(BFloat16 value) =>
+            new BFloat16((ushort)(value.RawValue ^ SignMask));
+
+        /// <summary>
+        /// Adds two values.
+        /// </summary>
+        /// <param name="first">The first value.</param>
+        /// <param name="second">The second value.</param>
+        /// <returns>The resulting value.</returns>
+        [MathIntrinsic(MathIntrinsicKind.Add)]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static BFloat16 operator +(BFloat16 first, BFloat16 second) =>
+            (BFloat16)((float)first + second);
+
+        /// <summary>
+        /// Subtracts two values.
+        /// </summary>
+        /// <param name="first">The first value.</param>
+        /// <param name="second">The second value.</param>
+        /// <returns>The resulting value.</returns>
+        [MathIntrinsic(MathIntrinsicKind.Sub)]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static BFloat16 operator -(BFloat16 first, BFloat16 second) =>
+            (BFloat16)((float)first - second);
+
+        /// <summary>
+        /// Multiplies two values.
+        /// </summary>
+        /// <param name="first">The first value.</param>
+        /// <param name="second">The second value.</param>
+        /// <returns>The resulting value.</returns>
+        [MathIntrinsic(MathIntrinsicKind.Mul)]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static BFloat16 operator *(BFloat16 first, BFloat16 second) =>
+            (BFloat16)((float)first * second);
+
+        /// <summary>
+        /// Divides two values.
+        /// </summary>
+        /// <param name="first">The first value.</param>
+        /// <param name="second">The second value.</param>
+        /// <returns>The resulting value.</returns>
+        [MathIntrinsic(MathIntrinsicKind.Div)]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static BFloat16 operator /(BFloat16 first, BFloat16 second) =>
+            (BFloat16)((float)first / second);
+
+        /// <summary>
+        /// Returns true if the first and second value represent the same value.
+        /// </summary>
+        /// <param name="first">The first value.</param>
+        /// <param name="second">The second value.</param>
+        /// <returns>True, if the first and second value are the same.</returns>
+        [CompareIntrinisc(CompareKind.Equal)]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static bool operator ==(BFloat16 first, BFloat16 second) =>
+            (float)first == second;
+
+        /// <summary>
+        /// Returns true if the first and second value do not represent the same
+        /// value.
+        /// </summary>
+        /// <param name="first">The first value.</param>
+        /// <param name="second">The second value.</param>
+        /// <returns>True, if the first and second value are not the same.</returns>
+        [CompareIntrinisc(CompareKind.NotEqual, CompareFlags.UnsignedOrUnordered)]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static bool operator !=(BFloat16 first, BFloat16 second) =>
+            (float)first != second;
+
+        /// <summary>
+        /// Returns true if the first value is smaller than the second one.
+        /// </summary>
+        /// <param name="first">The first value.</param>
+        /// <param name="second">The second value.</param>
+        /// <returns>True, if the first value is smaller than the second one.</returns>
+        [CompareIntrinisc(CompareKind.LessThan)]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static bool operator <(BFloat16 first, BFloat16 second) =>
+            (float)first < second;
+
+        /// <summary>
+        /// Returns true if the first value is smaller than or equal to the second
+        /// one.
+        /// </summary>
+        /// <param name="first">The first value.</param>
+        /// <param name="second">The second value.</param>
+        /// <returns>True, if the first value is smaller than or equal to the
+        /// second one.</returns>
+        [CompareIntrinisc(CompareKind.LessEqual)]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static bool operator <=(BFloat16 first, BFloat16 second) =>
+            (float)first <= second;
+
+        /// <summary>
+        /// Returns true if the first value is greater than the second one.
+        /// </summary>
+        /// <param name="first">The first value.</param>
+        /// <param name="second">The second value.</param>
+        /// <returns>True, if the first value is greater than the second one.</returns>
+        [CompareIntrinisc(CompareKind.GreaterThan)]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static bool operator >(BFloat16 first, BFloat16 second) =>
+            (float)first > second;
+
+        /// <summary>
+        /// Returns true if the first value is greater than or equal to the second
+        /// one.
+        /// </summary>
+        /// <param name="first">The first value.</param>
+        /// <param name="second">The second value.</param>
+        /// <returns>True, if the first value is greater than or equal to the
+        /// second one.</returns>
+        [CompareIntrinisc(CompareKind.GreaterEqual)]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static bool operator >=(BFloat16 first, BFloat16 second) =>
+            (float)first >= second;
+
+        /// <summary>
+        /// Implicitly converts a brain float to a float.
+        /// </summary>
+        /// <param name="value">The value to convert.</param>
+        [ConvertIntrinisc]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static implicit operator float(BFloat16 value) =>
+            ConvertBFloat16ToFloat(value);
+
+        /// <summary>
+        /// Implicitly converts a brain float to a double.
+        /// </summary>
+        /// <param name="value">The value to convert.</param>
+        [ConvertIntrinisc]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static implicit operator double(BFloat16 value) =>
+            (float)value;
+
+        /// <summary>
+        /// Explicitly converts a float to a brain float.
+        /// </summary>
+        /// <param name="value">The float to convert.</param>
+        [ConvertIntrinisc]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static explicit operator BFloat16(float value) =>
+            ConvertFloatToBFloat16(value);
+
+        /// <summary>
+        /// Explicitly converts a double to a brain float.
+        /// </summary>
+        /// <param name="value">The double to convert.</param>
+        [ConvertIntrinisc]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static explicit operator BFloat16(double value) =>
+            (BFloat16)(float)value;
+
+        /// <summary>
+        /// Explicitly converts a half to a brain float.
+        /// </summary>
+        /// <param name="value">The half to convert.</param>
+        [ConvertIntrinisc]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static explicit operator BFloat16(Half value) =>
+            (BFloat16)(float)value;
+
+        /// <summary>
+        /// Explicitly converts a brain float to a half.
+        /// </summary>
+        /// <param name="value">The value to convert.</param>
+        [ConvertIntrinisc]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static explicit operator Half(BFloat16 value) =>
+            (Half)(float)value;
+
+        #endregion
+    }
+}
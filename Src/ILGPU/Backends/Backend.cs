@@ -61,7 +61,12 @@ namespace ILGPU.Backends
         /// <summary>
         /// An OpenCL source backend.
         /// </summary>
-        OpenCL
+        OpenCL,
+
+        /// <summary>
+        /// A backend that serializes kernels for remote workers.
+        /// </summary>
+        Remote
     }
 
     /// <summary>
@@ -809,6 +814,15 @@ namespace ILGPU.Backends
                 var specializer = new IntrinsicSpecializer<TDelegate>(IntrinsicProvider);
                 var lowerThreadIntrinsics = new LowerThreadIntrinsics();
 
+                // Brain floats are lowered to raw 16-bit integers on all accelerators
+                // except for the IL backend, which uses the managed implementation
+                var transformations = ImmutableArray.CreateBuilder<Transformation>(4);
+                if (BackendType != BackendType.IL)
+                    transformations.Add(new LowerBFloat16());
+                transformations.Add(lowerThreadIntrinsics);
+                transformations.Add(resolver);
+                transformations.Add(specializer);
+
                 // Perform two general passes to specialize ILGPU-specific intrinsic
                 // functions that are invoked by other specialized functions.
                 // TODO: determine the number of passes automatically
@@ -817,7 +831,7 @@ namespace ILGPU.Backends
                 {
                     builder.Add(Transformer.Create(
                             TransformerConfiguration.Transformed,
-                            lowerThreadIntrinsics, resolver, specializer));
+                            transformations.ToImmutable()));
                 }
 
                 createTransformers(builder);
@@ -238,6 +238,14 @@ namespace ILGPU.Backends
         /// </remarks>
         public KernelInfo Info { get; }
 
+        /// <summary>
+        /// Returns the approximate size of the generated code in bytes.
+        /// </summary>
+        /// <remarks>
+        /// This size is used to bound the kernel caches of an accelerator.
+        /// </remarks>
+        public virtual long CodeSize => 0;
+
         #endregion
 
         #region Object
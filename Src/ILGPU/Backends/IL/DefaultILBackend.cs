@@ -10,27 +10,79 @@
 // ---------------------------------------------------------------------------------------
 
 using ILGPU.Backends.EntryPoints;
+using ILGPU.IR;
+using ILGPU.IR.Analyses;
+using ILGPU.IR.Types;
+using ILGPU.Resources;
 using ILGPU.Runtime.CPU;
 using ILGPU.Util;
+using System;
+using System.Collections.Generic;
 using System.Collections.Immutable;
+using System.Reflection;
 using System.Reflection.Emit;
+using System.Runtime.CompilerServices;
 
 namespace ILGPU.Backends.IL
 {
     /// <summary>
-    /// The default IL backend that uses the original kernel method.
+    /// The default IL backend that invokes a method generated from the optimized IR
+    /// kernel or the original kernel method.
     /// </summary>
     public class DefaultILBackend : ILBackend
     {
+        #region Nested Types
+
+        /// <summary>
+        /// A method that has been generated from an IR kernel.
+        /// </summary>
+        private sealed class IRKernel
+        {
+            /// <summary>
+            /// The generated method or null, if the kernel cannot be lowered to IL.
+            /// </summary>
+            public MethodInfo Method { get; set; }
+
+            /// <summary>
+            /// True, if the generated method reads the hidden runtime contexts.
+            /// </summary>
+            public bool UsesRuntimeContexts { get; set; }
+
+            /// <summary>
+            /// The reason why the kernel cannot be lowered to IL (if any).
+            /// </summary>
+            public Exception Error { get; set; }
+        }
+
+        #endregion
+
         #region Instance
 
+        /// <summary>
+        /// Caches generated IR kernels, since a kernel may be invoked by both the
+        /// single-index and the range execution method.
+        /// </summary>
+        private readonly ConditionalWeakTable<Method, IRKernel> irKernels =
+            new ConditionalWeakTable<Method, IRKernel>();
+
         /// <summary>
         /// Constructs a new IL backend.
         /// </summary>
         /// <param name="context">The context to use.</param>
         protected internal DefaultILBackend(Context context)
             : base(context, new CPUCapabilityContext(), 1, new ILArgumentMapper(context))
-        { }
+        {
+            TypeGenerator = new ILTypeGenerator(context.RuntimeSystem);
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Returns the type generator to map IR types to managed types.
+        /// </summary>
+        internal ILTypeGenerator TypeGenerator { get; }
 
         #endregion
 
@@ -47,6 +99,28 @@ namespace ILGPU.Backends.IL
             in ILLocal index,
             ImmutableArray<ILLocal> locals)
         {
+            var kernelMode = Context.Properties.CPUKernelMode;
+            Exception irError = null;
+            if (kernelMode != CPUKernelMode.ManagedKernels &&
+                TryGenerateIRKernelCall(
+                    entryPoint,
+                    backendContext,
+                    emitter,
+                    index,
+                    locals,
+                    out irError))
+            {
+                return;
+            }
+            if (kernelMode == CPUKernelMode.IRKernels)
+            {
+                throw new NotSupportedException(
+                    string.Format(
+                        ErrorMessages.NotSupportedIRKernel,
+                        entryPoint.MethodInfo.Name),
+                    irError);
+            }
+
             // Load placeholder 'this' argument to satisfy IL evaluation stack
             if (entryPoint.MethodInfo.IsNotCapturingLambda())
                 emitter.Emit(OpCodes.Ldnull);
@@ -61,8 +135,237 @@ namespace ILGPU.Backends.IL
             foreach (var local in locals)
                 emitter.Emit(LocalOperation.Load, local);
 
-            // Invoke kernel
-            emitter.EmitCall(entryPoint.MethodInfo);
+            // Invoke kernel, which records all branch directions if the current
+            // context uses an instrumentation profile
+            var kernelMethod = entryPoint.MethodInfo;
+            var profile = Context.Properties.InstrumentationProfile;
+            if (profile != null)
+                kernelMethod = ILBranchInstrumentation.Instrument(kernelMethod, profile);
+            emitter.EmitCall(kernelMethod);
+        }
+
+        /// <summary>
+        /// Tries to generate a call to a method that has been generated from the
+        /// optimized IR kernel.
+        /// </summary>
+        /// <returns>True, if the IR-based kernel call has been emitted.</returns>
+        /// <remarks>
+        /// Kernels compiled with O0, instrumented kernels and kernels that use
+        /// constructs without an IL lowering keep invoking the original kernel method,
+        /// unless <see cref="CPUKernelMode.IRKernels"/> is used.
+        /// </remarks>
+        private bool TryGenerateIRKernelCall<TEmitter>(
+            EntryPoint entryPoint,
+            in BackendContext backendContext,
+            TEmitter emitter,
+            in ILLocal index,
+            ImmutableArray<ILLocal> locals,
+            out Exception error)
+            where TEmitter : struct, IILEmitter
+        {
+            error = null;
+            if (Context.Properties.OptimizationLevel < OptimizationLevel.O1 ||
+                Context.Properties.InstrumentationProfile != null ||
+                entryPoint.MethodInfo.IsNotCapturingLambda())
+            {
+                return false;
+            }
+
+            // Collect all kernel arguments and check their compatibility before
+            // emitting any instructions
+            var kernel = backendContext.KernelMethod;
+            var sources = new List<ILLocal>(locals.Length + 1);
+            if (entryPoint.IsImplictlyGrouped)
+                sources.Add(index);
+            sources.AddRange(locals);
+            if (sources.Count != kernel.NumParameters)
+                return false;
+
+            var argumentLeaves = new List<FieldInfo[]>[sources.Count];
+            for (int i = 0, e = sources.Count; i < e; ++i)
+            {
+                argumentLeaves[i] = new List<FieldInfo[]>();
+                GatherLeaves(
+                    ArgumentMapper.GetMappedType(sources[i].VariableType),
+                    ImmutableArray<FieldInfo>.Empty,
+                    argumentLeaves[i]);
+                if (!IsCompatible(
+                    argumentLeaves[i],
+                    sources[i].VariableType,
+                    kernel.Parameters[i].ParameterType))
+                {
+                    return false;
+                }
+            }
+
+            if (!irKernels.TryGetValue(kernel, out var irKernel))
+            {
+                irKernel = GenerateIRKernel(backendContext);
+                irKernels.Add(kernel, irKernel);
+            }
+            if (irKernel.Method is null)
+            {
+                error = irKernel.Error;
+                return false;
+            }
+
+            // Resolve the runtime contexts once per invocation and pass them as
+            // hidden arguments to avoid thread-static lookups inside the kernel
+            if (irKernel.UsesRuntimeContexts)
+            {
+                emitter.EmitCall(ILCodeGenerator.GetThreadContextMethod);
+                emitter.EmitCall(ILCodeGenerator.GetGroupContextMethod);
+            }
+            else
+            {
+                emitter.Emit(OpCodes.Ldnull);
+                emitter.Emit(OpCodes.Ldnull);
+            }
+
+            // Convert all arguments into their flat IR representations
+            for (int i = 0, e = sources.Count; i < e; ++i)
+            {
+                var mapped = ArgumentMapper.MapLocal(emitter, sources[i]);
+                var leaves = argumentLeaves[i];
+                if (!(kernel.Parameters[i].ParameterType is StructureType structType))
+                {
+                    EmitLoadLeaf(emitter, mapped, leaves[0]);
+                    continue;
+                }
+
+                var flat = emitter.DeclareLocal(TypeGenerator[structType]);
+                for (int j = 0, leaf = 0, e2 = structType.NumFields; j < e2; ++j)
+                {
+                    if (structType.Fields[j].IsPaddingType)
+                        continue;
+                    emitter.Emit(LocalOperation.LoadAddress, flat);
+                    EmitLoadLeaf(emitter, mapped, leaves[leaf++]);
+                    emitter.Emit(
+                        OpCodes.Stfld,
+                        TypeGenerator.GetField(structType, j));
+                }
+                emitter.Emit(LocalOperation.Load, flat);
+            }
+            emitter.EmitCall(irKernel.Method);
+            return true;
+        }
+
+        /// <summary>
+        /// Generates a method from the IR kernel of the given backend context.
+        /// </summary>
+        private IRKernel GenerateIRKernel(in BackendContext backendContext)
+        {
+            var result = new IRKernel();
+            try
+            {
+                var callees = new List<(Method, Allocas)>(backendContext.Count);
+                foreach (var entry in backendContext)
+                    callees.Add(entry);
+                result.Method = ILCodeGenerator.GenerateKernel(
+                    this,
+                    TypeGenerator,
+                    backendContext.KernelMethod,
+                    backendContext.KernelAllocas,
+                    callees,
+                    out bool usesRuntimeContexts);
+                result.UsesRuntimeContexts = usesRuntimeContexts;
+            }
+            catch (Exception e) when (
+                e is NotSupportedException ||
+                e is InvalidCodeGenerationException)
+            {
+                result.Method = null;
+                result.Error = e;
+            }
+            return result;
+        }
+
+        /// <summary>
+        /// Gathers the field chains of all scalar leaves of the given mapped type.
+        /// </summary>
+        private void GatherLeaves(
+            Type type,
+            ImmutableArray<FieldInfo> chain,
+            List<FieldInfo[]> leaves)
+        {
+            if (type.IsPointer || type.IsILGPUPrimitiveType() || type.IsEnum)
+            {
+                leaves.Add(chain.ToArray());
+                return;
+            }
+            var typeInfo = ArgumentMapper.TypeContext.GetTypeInfo(type);
+            foreach (var field in typeInfo.Fields)
+                GatherLeaves(field.FieldType, chain.Add(field), leaves);
+        }
+
+        /// <summary>
+        /// Returns the managed type of the given leaf.
+        /// </summary>
+        private static Type GetLeafType(Type rootType, FieldInfo[] leaf) =>
+            leaf.Length > 0 ? leaf[leaf.Length - 1].FieldType : rootType;
+
+        /// <summary>
+        /// Returns true if the given leaves can be converted into the given IR
+        /// parameter type.
+        /// </summary>
+        private bool IsCompatible(
+            List<FieldInfo[]> leaves,
+            Type sourceType,
+            TypeNode parameterType)
+        {
+            var rootType = ArgumentMapper.GetMappedType(sourceType);
+            if (!(parameterType is StructureType structType))
+            {
+                return leaves.Count == 1 && IsCompatible(
+                    GetLeafType(rootType, leaves[0]),
+                    parameterType);
+            }
+
+            int leaf = 0;
+            foreach (var fieldType in structType.Fields)
+            {
+                if (fieldType.IsPaddingType)
+                    continue;
+                if (leaf >= leaves.Count ||
+                    !IsCompatible(GetLeafType(rootType, leaves[leaf++]), fieldType))
+                {
+                    return false;
+                }
+            }
+            return leaf == leaves.Count;
+        }
+
+        /// <summary>
+        /// Returns true if the given managed leaf type matches the IR type.
+        /// </summary>
+        private static bool IsCompatible(Type leafType, TypeNode irType)
+        {
+            if (leafType.IsPointer)
+                return irType.IsPointerType;
+            if (leafType.IsEnum)
+                leafType = leafType.GetEnumUnderlyingType();
+            return irType is PrimitiveType primitiveType &&
+                primitiveType.BasicValueType == leafType.GetBasicValueType();
+        }
+
+        /// <summary>
+        /// Loads the value of the given leaf of the given local.
+        /// </summary>
+        private static void EmitLoadLeaf<TEmitter>(
+            TEmitter emitter,
+            ILLocal local,
+            FieldInfo[] leaf)
+            where TEmitter : struct, IILEmitter
+        {
+            if (leaf.Length < 1)
+            {
+                emitter.Emit(LocalOperation.Load, local);
+                return;
+            }
+            emitter.Emit(LocalOperation.LoadAddress, local);
+            for (int i = 0, e = leaf.Length - 1; i < e; ++i)
+                emitter.Emit(OpCodes.Ldflda, leaf[i]);
+            emitter.Emit(OpCodes.Ldfld, leaf[leaf.Length - 1]);
         }
 
         #endregion
@@ -11,6 +11,7 @@
 
 using ILGPU.Backends.EntryPoints;
 using ILGPU.Backends.PointerViews;
+using System;
 using System.Diagnostics;
 using System.IO;
 
@@ -79,6 +80,29 @@ namespace ILGPU.Backends.IL
                 entryPoint.Parameters);
         }
 
+        /// <summary>
+        /// Returns the compatible representation of the given kernel parameter type.
+        /// </summary>
+        /// <param name="type">The kernel parameter type.</param>
+        /// <returns>The mapped type.</returns>
+        internal Type GetMappedType(Type type) => MapType(type);
+
+        /// <summary>
+        /// Emits code that converts the value of the given local into its compatible
+        /// representation.
+        /// </summary>
+        /// <typeparam name="TILEmitter">The emitter type.</typeparam>
+        /// <param name="emitter">The current emitter.</param>
+        /// <param name="source">The source local.</param>
+        /// <returns>The local holding the mapped value.</returns>
+        internal ILLocal MapLocal<TILEmitter>(in TILEmitter emitter, ILLocal source)
+            where TILEmitter : struct, IILEmitter
+        {
+            var target = emitter.DeclareLocal(MapType(source.VariableType));
+            MapInstance(emitter, new LocalSource(source), new LocalTarget(target));
+            return target;
+        }
+
         #endregion
     }
 }
@@ -12,7 +12,9 @@
 using ILGPU.Backends.EntryPoints;
 using ILGPU.Backends.IL.Transformations;
 using ILGPU.IR;
+using ILGPU.IR.Analyses;
 using ILGPU.IR.Transformations;
+using ILGPU.IR.Values;
 using ILGPU.Resources;
 using ILGPU.Runtime;
 using ILGPU.Runtime.CPU;
@@ -151,50 +153,201 @@ namespace ILGPU.Backends.IL
                 out ConstructorInfo taskConstructor,
                 out ImmutableArray<FieldInfo> taskArgumentMapping);
 
-            MethodInfo kernelMethod;
-            using (var scopedLock = RuntimeSystem.DefineRuntimeMethod(
-                typeof(void),
-                CPUAcceleratorTask.ExecuteParameterTypes,
-                out var methodEmitter))
+            var kernelMethod = GenerateExecuteMethod(
+                entryPoint,
+                backendContext,
+                taskType,
+                taskArgumentMapping,
+                false,
+                out int codeSize);
+            MethodInfo rangeKernelMethod = null;
+            if (CanExecuteRanges(entryPoint, backendContext))
             {
-                var emitter = new ILEmitter(methodEmitter.ILGenerator);
-
-                // Generate CPU runtime startup code and initialize all locals
-                GenerateStartupCode(
+                rangeKernelMethod = GenerateExecuteMethod(
                     entryPoint,
-                    emitter,
+                    backendContext,
                     taskType,
-                    out var taskLocal,
-                    out var indexLocal);
-                var locals = GenerateLocals(
-                    emitter,
                     taskArgumentMapping,
-                    taskLocal);
-
-                // Generate the actual kernel code
-                GenerateCode(
-                    entryPoint,
-                    backendContext,
-                    emitter,
-                    taskLocal,
-                    indexLocal,
-                    locals);
-
-                // Finish building
-                emitter.Emit(OpCodes.Ret);
-                emitter.Finish();
-                kernelMethod = methodEmitter.Finish();
+                    true,
+                    out int rangeCodeSize);
+                codeSize += rangeCodeSize;
             }
 
             return new ILCompiledKernel(
                 Context,
                 entryPoint,
                 kernelMethod,
+                rangeKernelMethod,
+                GetStaticSharedMemorySize(backendContext.SharedAllocations),
+                codeSize,
                 taskType,
                 taskConstructor,
                 taskArgumentMapping);
         }
 
+        /// <summary>
+        /// Computes the size in bytes of all static shared-memory allocations that
+        /// have to be preallocated by each CPU multiprocessor.
+        /// </summary>
+        /// <param name="sharedAllocations">The static shared allocations.</param>
+        /// <returns>The required shared-memory size in bytes.</returns>
+        /// <remarks>
+        /// Each allocation is aligned to a multiple of its element size at runtime.
+        /// Hence, we reserve additional bytes for the alignment of each allocation.
+        /// </remarks>
+        private static int GetStaticSharedMemorySize(
+            in AllocaKindInformation sharedAllocations)
+        {
+            int size = 0;
+            foreach (var allocaInfo in sharedAllocations)
+                size += allocaInfo.TotalSize + allocaInfo.ElementSize - 1;
+            return size;
+        }
+
+        /// <summary>
+        /// Generates a method that executes the kernel for a single linear index or
+        /// for a whole range of linear indices.
+        /// </summary>
+        /// <param name="entryPoint">The desired entry point.</param>
+        /// <param name="backendContext">The current backend context.</param>
+        /// <param name="taskType">The custom task type.</param>
+        /// <param name="taskArgumentMapping">The task-argument mapping.</param>
+        /// <param name="isRange">
+        /// True, if the method processes a range of indices in a loop.
+        /// </param>
+        /// <param name="codeSize">The size of the generated IL code in bytes.</param>
+        /// <returns>The generated method.</returns>
+        private MethodInfo GenerateExecuteMethod(
+            EntryPoint entryPoint,
+            in BackendContext backendContext,
+            Type taskType,
+            ImmutableArray<FieldInfo> taskArgumentMapping,
+            bool isRange,
+            out int codeSize)
+        {
+            using var scopedLock = RuntimeSystem.DefineRuntimeMethod(
+                typeof(void),
+                isRange
+                    ? CPUAcceleratorTask.ExecuteRangeParameterTypes
+                    : CPUAcceleratorTask.ExecuteParameterTypes,
+                out var methodEmitter);
+            var emitter = new ILEmitter(methodEmitter.ILGenerator);
+
+            // Generate CPU runtime startup code and initialize all locals
+            GenerateStartupCode(
+                entryPoint,
+                emitter,
+                taskType,
+                out var taskLocal,
+                out var indexLocal,
+                out var linearIndexLocal);
+            var locals = GenerateLocals(
+                emitter,
+                taskArgumentMapping,
+                taskLocal);
+
+            // Hoist all task-related loads out of the loop over all indices
+            var headerLabel = emitter.DeclareLabel();
+            var bodyLabel = emitter.DeclareLabel();
+            if (isRange)
+            {
+                emitter.Emit(OpCodes.Br, headerLabel);
+                emitter.MarkLabel(bodyLabel);
+            }
+
+            // Generate the actual kernel code
+            GenerateIndexCode(
+                entryPoint,
+                emitter,
+                taskType,
+                taskLocal,
+                indexLocal,
+                linearIndexLocal);
+            GenerateCode(
+                entryPoint,
+                backendContext,
+                emitter,
+                taskLocal,
+                indexLocal,
+                locals);
+
+            if (isRange)
+            {
+                // Advance to the next index
+                emitter.Emit(LocalOperation.Load, linearIndexLocal);
+                emitter.Emit(OpCodes.Ldc_I4_1);
+                emitter.Emit(OpCodes.Add);
+                emitter.Emit(LocalOperation.Store, linearIndexLocal);
+
+                emitter.MarkLabel(headerLabel);
+                emitter.Emit(LocalOperation.Load, linearIndexLocal);
+                emitter.Emit(ArgumentOperation.Load, CPUAcceleratorTask.EndIndex);
+                emitter.Emit(OpCodes.Blt, bodyLabel);
+            }
+
+            // Finish building
+            emitter.Emit(OpCodes.Ret);
+            emitter.Finish();
+            codeSize = methodEmitter.ILGenerator.ILOffset;
+            return methodEmitter.Finish();
+        }
+
+        /// <summary>
+        /// Returns true if the given kernel can process whole ranges of indices
+        /// without simulating individual groups. This requires an implicitly grouped
+        /// kernel that neither uses shared memory nor any group or warp semantics.
+        /// </summary>
+        /// <param name="entryPoint">The desired entry point.</param>
+        /// <param name="backendContext">The current backend context.</param>
+        /// <returns>True, if the kernel can process ranges of indices.</returns>
+        private static bool CanExecuteRanges(
+            EntryPoint entryPoint,
+            in BackendContext backendContext)
+        {
+            if (!entryPoint.IsImplictlyGrouped ||
+                !CanExecuteRanges(
+                    backendContext.KernelMethod,
+                    backendContext.KernelAllocas))
+            {
+                return false;
+            }
+            foreach (var (method, allocas) in backendContext)
+            {
+                if (!CanExecuteRanges(method, allocas))
+                    return false;
+            }
+            return true;
+        }
+
+        /// <summary>
+        /// Returns true if the given method does not depend on group or warp
+        /// semantics.
+        /// </summary>
+        private static bool CanExecuteRanges(Method method, Allocas allocas)
+        {
+            if (allocas.SharedAllocations.Length > 0 ||
+                allocas.DynamicSharedAllocations.Length > 0)
+            {
+                return false;
+            }
+            foreach (Value value in method.Blocks.Values)
+            {
+                switch (value)
+                {
+                    case DeviceConstantDimensionValue _:
+                    case LaneIdxValue _:
+                    case DynamicMemoryLengthValue _:
+                    case Barrier _:
+                    case PredicateBarrier _:
+                    case Broadcast _:
+                    case WarpShuffle _:
+                    case SubWarpShuffle _:
+                        return false;
+                }
+            }
+            return true;
+        }
+
         /// <summary>
         /// Generates the actual kernel code.
         /// </summary>
@@ -214,7 +367,7 @@ namespace ILGPU.Backends.IL
             in ILLocal task,
             in ILLocal index,
             ImmutableArray<ILLocal> locals)
-            where TEmitter : IILEmitter;
+            where TEmitter : struct, IILEmitter;
 
         #endregion
 
@@ -348,12 +501,14 @@ namespace ILGPU.Backends.IL
         /// <param name="taskType">The created task.</param>
         /// <param name="task">The created strongly typed task local.</param>
         /// <param name="index">The index dimension local (for implicit kernels).</param>
+        /// <param name="linearIndex">The local holding the linear index.</param>
         private static void GenerateStartupCode<TEmitter>(
             EntryPoint entryPoint,
             TEmitter emitter,
             Type taskType,
             out ILLocal task,
-            out ILLocal index)
+            out ILLocal index,
+            out ILLocal linearIndex)
             where TEmitter : IILEmitter
         {
             // Cast generic task type to actual task type
@@ -362,11 +517,35 @@ namespace ILGPU.Backends.IL
             emitter.Emit(OpCodes.Castclass, taskType);
             emitter.Emit(LocalOperation.Store, task);
 
-            // Construct launch index from linear index
+            // Load the (first) linear index
+            linearIndex = emitter.DeclareLocal(typeof(int));
+            emitter.Emit(ArgumentOperation.Load, CPUAcceleratorTask.LinearIndex);
+            emitter.Emit(LocalOperation.Store, linearIndex);
+
+            // Declare the launch index
             index = emitter.DeclareLocal(entryPoint.KernelIndexType);
             emitter.Emit(LocalOperation.LoadAddress, index);
             emitter.Emit(OpCodes.Initobj, index.VariableType);
+        }
 
+        /// <summary>
+        /// Generates code that constructs the launch index from the linear index.
+        /// </summary>
+        /// <param name="entryPoint">The entry point.</param>
+        /// <param name="emitter">The current code generator.</param>
+        /// <param name="taskType">The created task.</param>
+        /// <param name="task">The strongly typed task local.</param>
+        /// <param name="index">The index dimension local (for implicit kernels).</param>
+        /// <param name="linearIndex">The local holding the linear index.</param>
+        private static void GenerateIndexCode<TEmitter>(
+            EntryPoint entryPoint,
+            TEmitter emitter,
+            Type taskType,
+            ILLocal task,
+            ILLocal index,
+            ILLocal linearIndex)
+            where TEmitter : IILEmitter
+        {
             if (entryPoint.IsExplicitlyGrouped)
                 return;
 
@@ -377,21 +556,21 @@ namespace ILGPU.Backends.IL
                 case IndexType.Index1D:
                     // Ignore the task local and construct a new 1D instance
                     emitter.Emit(OpCodes.Pop);
-                    emitter.Emit(ArgumentOperation.Load, CPUAcceleratorTask.LinearIndex);
+                    emitter.Emit(LocalOperation.Load, linearIndex);
                     emitter.EmitNewObject(Index1D.MainConstructor);
                     break;
                 case IndexType.Index2D:
                     // Convert to 2D index
                     emitter.EmitCall(
                         CPUAcceleratorTask.GetTotalUserDimXYGetter(taskType));
-                    emitter.Emit(ArgumentOperation.Load, CPUAcceleratorTask.LinearIndex);
+                    emitter.Emit(LocalOperation.Load, linearIndex);
                     emitter.EmitCall(Reconstruct2DIndexMethod);
                     break;
                 case IndexType.Index3D:
                     // Convert to 3D index
                     emitter.EmitCall(
                         CPUAcceleratorTask.GetTotalUserDimGetter(taskType));
-                    emitter.Emit(ArgumentOperation.Load, CPUAcceleratorTask.LinearIndex);
+                    emitter.Emit(LocalOperation.Load, linearIndex);
                     emitter.EmitCall(Reconstruct3DIndexMethod);
                     break;
                 default:
@@ -0,0 +1,601 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: ILBranchInstrumentation.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.Resources;
+using ILGPU.Runtime;
+using System;
+using System.Collections.Generic;
+using System.Reflection;
+using System.Reflection.Emit;
+
+namespace ILGPU.Backends.IL
+{
+    /// <summary>
+    /// Creates copies of kernel methods that record the execution counts of all
+    /// conditional branches in a <see cref="KernelProfile"/>.
+    /// </summary>
+    static class ILBranchInstrumentation
+    {
+        #region Nested Types
+
+        /// <summary>
+        /// A decoded IL instruction.
+        /// </summary>
+        private readonly struct Instruction
+        {
+            /// <summary>
+            /// Constructs a new instruction.
+            /// </summary>
+            /// <param name="offset">The IL offset.</param>
+            /// <param name="opCode">The operation code.</param>
+            /// <param name="operandOffset">The IL offset of the operand.</param>
+            /// <param name="targets">All branch targets.</param>
+            public Instruction(
+                int offset,
+                OpCode opCode,
+                int operandOffset,
+                int[] targets)
+            {
+                Offset = offset;
+                OpCode = opCode;
+                OperandOffset = operandOffset;
+                Targets = targets;
+            }
+
+            /// <summary>
+            /// Returns the IL offset.
+            /// </summary>
+            public int Offset { get; }
+
+            /// <summary>
+            /// Returns the operation code.
+            /// </summary>
+            public OpCode OpCode { get; }
+
+            /// <summary>
+            /// Returns the IL offset of the operand.
+            /// </summary>
+            public int OperandOffset { get; }
+
+            /// <summary>
+            /// Returns the absolute IL offsets of all branch targets (if any).
+            /// </summary>
+            public int[] Targets { get; }
+
+            /// <summary>
+            /// Returns true if this is a conditional branch with a single target.
+            /// </summary>
+            public bool IsConditionalBranch =>
+                OpCode.FlowControl == FlowControl.Cond_Branch &&
+                OpCode.OperandType != OperandType.InlineSwitch;
+        }
+
+        /// <summary>
+        /// A source method and its declared instrumented copy.
+        /// </summary>
+        private sealed class InstrumentedMethod
+        {
+            /// <summary>
+            /// Constructs a new instrumented method.
+            /// </summary>
+            /// <param name="source">The source method.</param>
+            /// <param name="body">The source method body.</param>
+            /// <param name="il">The IL byte code of the source method.</param>
+            /// <param name="instructions">All decoded instructions.</param>
+            /// <param name="target">The instrumented method to emit.</param>
+            public InstrumentedMethod(
+                MethodInfo source,
+                MethodBody body,
+                byte[] il,
+                List<Instruction> instructions,
+                DynamicMethod target)
+            {
+                Source = source;
+                Body = body;
+                IL = il;
+                Instructions = instructions;
+                Target = target;
+            }
+
+            /// <summary>
+            /// Returns the source method.
+            /// </summary>
+            public MethodInfo Source { get; }
+
+            /// <summary>
+            /// Returns the source method body.
+            /// </summary>
+            public MethodBody Body { get; }
+
+            /// <summary>
+            /// Returns the IL byte code of the source method.
+            /// </summary>
+            public byte[] IL { get; }
+
+            /// <summary>
+            /// Returns all decoded instructions.
+            /// </summary>
+            public List<Instruction> Instructions { get; }
+
+            /// <summary>
+            /// Returns the instrumented method.
+            /// </summary>
+            public DynamicMethod Target { get; }
+        }
+
+        #endregion
+
+        #region Static
+
+        /// <summary>
+        /// All single-byte operation codes.
+        /// </summary>
+        private static readonly OpCode[] OneByteOpCodes = new OpCode[0x100];
+
+        /// <summary>
+        /// All two-byte operation codes starting with 0xFE.
+        /// </summary>
+        private static readonly OpCode[] TwoByteOpCodes = new OpCode[0x100];
+
+        /// <summary>
+        /// Maps short branch operations to their long forms.
+        /// </summary>
+        private static readonly Dictionary<OpCode, OpCode> LongBranches =
+            new Dictionary<OpCode, OpCode>();
+
+        /// <summary>
+        /// The method that records a single branch execution.
+        /// </summary>
+        private static readonly MethodInfo RecordBranchMethod =
+            typeof(KernelProfile).GetMethod(
+                nameof(KernelProfile.RecordBranch),
+                BindingFlags.NonPublic | BindingFlags.Static);
+
+        /// <summary>
+        /// Initializes all operation code tables.
+        /// </summary>
+        static ILBranchInstrumentation()
+        {
+            var byName = new Dictionary<string, OpCode>();
+            foreach (var field in typeof(OpCodes).GetFields(
+                BindingFlags.Public | BindingFlags.Static))
+            {
+                var opCode = (OpCode)field.GetValue(null);
+                byName[opCode.Name] = opCode;
+                ushort value = unchecked((ushort)opCode.Value);
+                if (opCode.Size == 1)
+                    OneByteOpCodes[value] = opCode;
+                else
+                    TwoByteOpCodes[value & 0xff] = opCode;
+            }
+
+            foreach (var opCode in byName.Values)
+            {
+                if (opCode.OperandType == OperandType.ShortInlineBrTarget)
+                    LongBranches[opCode] = byName[opCode.Name.Replace(".s", "")];
+            }
+        }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Creates an exception that indicates an unsupported kernel method.
+        /// </summary>
+        /// <param name="method">The kernel method.</param>
+        /// <returns>The created exception.</returns>
+        private static NotSupportedException GetNotSupportedException(
+            MethodBase method) =>
+            new NotSupportedException(string.Format(
+                RuntimeErrorMessages.NotSupportedKernelInstrumentation,
+                method.Name));
+
+        /// <summary>
+        /// Decodes all instructions of the given IL byte code.
+        /// </summary>
+        /// <param name="il">The IL byte code.</param>
+        /// <param name="instructions">All decoded instructions.</param>
+        /// <returns>True, if all instructions could be decoded.</returns>
+        private static bool TryDecode(byte[] il, out List<Instruction> instructions)
+        {
+            instructions = new List<Instruction>();
+            for (int pos = 0; pos < il.Length;)
+            {
+                int offset = pos;
+                var opCode = il[pos] == 0xFE
+                    ? TwoByteOpCodes[il[pos + 1]]
+                    : OneByteOpCodes[il[pos]];
+                pos += opCode.Size;
+
+                int operandOffset = pos;
+                int[] targets = null;
+                switch (opCode.OperandType)
+                {
+                    case OperandType.InlineNone:
+                        break;
+                    case OperandType.ShortInlineBrTarget:
+                        pos += 1;
+                        targets = new int[] { pos + (sbyte)il[operandOffset] };
+                        break;
+                    case OperandType.InlineBrTarget:
+                        pos += 4;
+                        targets = new int[]
+                        {
+                            pos + BitConverter.ToInt32(il, operandOffset)
+                        };
+                        break;
+                    case OperandType.InlineSwitch:
+                        int numTargets = BitConverter.ToInt32(il, pos);
+                        pos += 4 + numTargets * 4;
+                        targets = new int[numTargets];
+                        for (int i = 0; i < numTargets; ++i)
+                        {
+                            targets[i] = pos + BitConverter.ToInt32(
+                                il,
+                                operandOffset + 4 + i * 4);
+                        }
+                        break;
+                    case OperandType.ShortInlineI:
+                    case OperandType.ShortInlineVar:
+                        pos += 1;
+                        break;
+                    case OperandType.InlineVar:
+                        pos += 2;
+                        break;
+                    case OperandType.InlineI8:
+                    case OperandType.InlineR:
+                        pos += 8;
+                        break;
+                    case OperandType.InlineSig:
+                        return false;
+                    default:
+                        pos += 4;
+                        break;
+                }
+                instructions.Add(new Instruction(
+                    offset,
+                    opCode,
+                    operandOffset,
+                    targets));
+            }
+            return true;
+        }
+
+        /// <summary>
+        /// Resolves a member token in the context of the given source method.
+        /// </summary>
+        /// <param name="method">The source method.</param>
+        /// <param name="token">The member token.</param>
+        /// <returns>The resolved member.</returns>
+        private static MemberInfo ResolveMember(MethodBase method, int token) =>
+            method.Module.ResolveMember(
+                token,
+                method.DeclaringType.IsGenericType
+                    ? method.DeclaringType.GetGenericArguments()
+                    : null,
+                method.IsGenericMethod
+                    ? method.GetGenericArguments()
+                    : null);
+
+        /// <summary>
+        /// Returns true if the given callee of the given kernel method should be
+        /// instrumented as well.
+        /// </summary>
+        /// <param name="kernelMethod">The kernel method.</param>
+        /// <param name="callee">The called method.</param>
+        /// <returns>True, if the callee should be instrumented.</returns>
+        /// <remarks>
+        /// Only methods that are declared in the assembly of the kernel are
+        /// instrumented. All other methods (including all ILGPU intrinsics and
+        /// framework methods) are invoked without any modifications.
+        /// </remarks>
+        private static bool CanInstrumentCallee(
+            MethodInfo kernelMethod,
+            MethodInfo callee) =>
+            callee.Module.Assembly == kernelMethod.Module.Assembly &&
+            !callee.IsAbstract &&
+            !callee.ContainsGenericParameters &&
+            (callee.CallingConvention & CallingConventions.VarArgs) == 0;
+
+        /// <summary>
+        /// Decodes the given method and declares its instrumented copy.
+        /// </summary>
+        /// <param name="method">The method to instrument.</param>
+        /// <returns>
+        /// The declared method, or null if the method cannot be instrumented.
+        /// </returns>
+        private static InstrumentedMethod TryDeclare(MethodInfo method)
+        {
+            var body = method.GetMethodBody();
+            if (body is null || body.ExceptionHandlingClauses.Count > 0)
+                return null;
+            var il = body.GetILAsByteArray();
+            if (!TryDecode(il, out var instructions))
+                return null;
+
+            var parameters = method.GetParameters();
+            int parameterOffset = method.IsStatic ? 0 : 1;
+            var parameterTypes = new Type[parameters.Length + parameterOffset];
+            if (!method.IsStatic)
+            {
+                parameterTypes[0] = method.DeclaringType.IsValueType
+                    ? method.DeclaringType.MakeByRefType()
+                    : method.DeclaringType;
+            }
+            for (int i = 0, e = parameters.Length; i < e; ++i)
+                parameterTypes[i + parameterOffset] = parameters[i].ParameterType;
+
+            var target = new DynamicMethod(
+                method.Name,
+                method.ReturnType,
+                parameterTypes,
+                method.Module,
+                true);
+            return new InstrumentedMethod(method, body, il, instructions, target);
+        }
+
+        /// <summary>
+        /// Emits a call that records a single branch execution.
+        /// </summary>
+        /// <param name="generator">The target generator.</param>
+        /// <param name="index">The registration index of the counters.</param>
+        /// <param name="counter">The counter index.</param>
+        private static void EmitRecordBranch(
+            ILGenerator generator,
+            int index,
+            int counter)
+        {
+            generator.Emit(OpCodes.Ldc_I4, index);
+            generator.Emit(OpCodes.Ldc_I4, counter);
+            generator.Emit(OpCodes.Call, RecordBranchMethod);
+        }
+
+        /// <summary>
+        /// Emits a token operand that is resolved in the context of the source
+        /// method. Direct calls to instrumented methods are redirected to their
+        /// instrumented copies.
+        /// </summary>
+        private static void EmitTokenOperand(
+            ILGenerator generator,
+            OpCode opCode,
+            MethodBase method,
+            int token,
+            Dictionary<MethodInfo, InstrumentedMethod> methods)
+        {
+            var member = opCode.OperandType == OperandType.InlineString
+                ? null
+                : ResolveMember(method, token);
+            switch (member)
+            {
+                case null:
+                    generator.Emit(opCode, method.Module.ResolveString(token));
+                    break;
+                case Type type:
+                    generator.Emit(opCode, type);
+                    break;
+                case FieldInfo field:
+                    generator.Emit(opCode, field);
+                    break;
+                case ConstructorInfo constructor:
+                    generator.Emit(opCode, constructor);
+                    break;
+                case MethodInfo methodInfo:
+                    if (opCode == OpCodes.Call &&
+                        methods.TryGetValue(methodInfo, out var callee) &&
+                        callee != null)
+                    {
+                        methodInfo = callee.Target;
+                    }
+                    generator.Emit(opCode, methodInfo);
+                    break;
+                default:
+                    throw GetNotSupportedException(method);
+            }
+        }
+
+        /// <summary>
+        /// Declares instrumented copies of all methods that are directly or
+        /// indirectly called by the given kernel method.
+        /// </summary>
+        /// <param name="kernel">The instrumented kernel method.</param>
+        /// <param name="methods">
+        /// Maps all visited methods to their instrumented copies, or to null if they
+        /// cannot be instrumented.
+        /// </param>
+        /// <returns>All declared methods including the kernel method.</returns>
+        private static List<InstrumentedMethod> DeclareCallees(
+            InstrumentedMethod kernel,
+            Dictionary<MethodInfo, InstrumentedMethod> methods)
+        {
+            var result = new List<InstrumentedMethod>();
+            var toProcess = new Stack<InstrumentedMethod>();
+            toProcess.Push(kernel);
+            while (toProcess.Count > 0)
+            {
+                var current = toProcess.Pop();
+                result.Add(current);
+                foreach (var instruction in current.Instructions)
+                {
+                    if (instruction.OpCode != OpCodes.Call)
+                        continue;
+                    var token = BitConverter.ToInt32(
+                        current.IL,
+                        instruction.OperandOffset);
+                    if (!(ResolveMember(current.Source, token) is MethodInfo callee) ||
+                        methods.ContainsKey(callee))
+                    {
+                        continue;
+                    }
+
+                    var instrumented = CanInstrumentCallee(kernel.Source, callee)
+                        ? TryDeclare(callee)
+                        : null;
+                    methods.Add(callee, instrumented);
+                    if (instrumented != null)
+                        toProcess.Push(instrumented);
+                }
+            }
+            return result;
+        }
+
+        /// <summary>
+        /// Emits the body of the given instrumented method.
+        /// </summary>
+        /// <param name="method">The instrumented method.</param>
+        /// <param name="profile">The profile to record the counts in.</param>
+        /// <param name="methods">Maps all visited methods to their copies.</param>
+        private static void EmitBody(
+            InstrumentedMethod method,
+            KernelProfile profile,
+            Dictionary<MethodInfo, InstrumentedMethod> methods)
+        {
+            var il = method.IL;
+            var instructions = method.Instructions;
+
+            // Register all conditional branches
+            var branchOffsets = new List<int>();
+            foreach (var instruction in instructions)
+            {
+                if (instruction.IsConditionalBranch)
+                    branchOffsets.Add(instruction.Offset);
+            }
+            int index = profile.RegisterMethod(
+                method.Source,
+                branchOffsets,
+                out var slots);
+
+            var generator = method.Target.GetILGenerator();
+            foreach (var local in method.Body.LocalVariables)
+                generator.DeclareLocal(local.LocalType, local.IsPinned);
+
+            // Define labels for all branch targets
+            var labels = new Dictionary<int, Label>();
+            foreach (var instruction in instructions)
+            {
+                if (instruction.Targets is null)
+                    continue;
+                foreach (var target in instruction.Targets)
+                {
+                    if (!labels.ContainsKey(target))
+                        labels.Add(target, generator.DefineLabel());
+                }
+            }
+
+            // Emit all instructions
+            foreach (var instruction in instructions)
+            {
+                if (labels.TryGetValue(instruction.Offset, out var label))
+                    generator.MarkLabel(label);
+
+                var opCode = instruction.OpCode;
+                int operand = instruction.OperandOffset;
+                switch (opCode.OperandType)
+                {
+                    case OperandType.InlineNone:
+                        generator.Emit(opCode);
+                        break;
+                    case OperandType.ShortInlineBrTarget:
+                    case OperandType.InlineBrTarget:
+                        if (LongBranches.TryGetValue(opCode, out var longOpCode))
+                            opCode = longOpCode;
+                        var target = labels[instruction.Targets[0]];
+                        if (!instruction.IsConditionalBranch)
+                        {
+                            generator.Emit(opCode, target);
+                            break;
+                        }
+
+                        // Record the branch direction before jumping to its target
+                        int counter = slots[instruction.Offset] * 2;
+                        var takenLabel = generator.DefineLabel();
+                        var nextLabel = generator.DefineLabel();
+                        generator.Emit(opCode, takenLabel);
+                        EmitRecordBranch(generator, index, counter + 1);
+                        generator.Emit(OpCodes.Br, nextLabel);
+                        generator.MarkLabel(takenLabel);
+                        EmitRecordBranch(generator, index, counter);
+                        generator.Emit(OpCodes.Br, target);
+                        generator.MarkLabel(nextLabel);
+                        break;
+                    case OperandType.InlineSwitch:
+                        var targets = new Label[instruction.Targets.Length];
+                        for (int i = 0, e = targets.Length; i < e; ++i)
+                            targets[i] = labels[instruction.Targets[i]];
+                        generator.Emit(opCode, targets);
+                        break;
+                    case OperandType.ShortInlineI:
+                        if (opCode == OpCodes.Ldc_I4_S)
+                            generator.Emit(opCode, (sbyte)il[operand]);
+                        else
+                            generator.Emit(opCode, il[operand]);
+                        break;
+                    case OperandType.ShortInlineVar:
+                        generator.Emit(opCode, il[operand]);
+                        break;
+                    case OperandType.InlineVar:
+                        generator.Emit(opCode, BitConverter.ToInt16(il, operand));
+                        break;
+                    case OperandType.InlineI:
+                        generator.Emit(opCode, BitConverter.ToInt32(il, operand));
+                        break;
+                    case OperandType.InlineI8:
+                        generator.Emit(opCode, BitConverter.ToInt64(il, operand));
+                        break;
+                    case OperandType.ShortInlineR:
+                        generator.Emit(opCode, BitConverter.ToSingle(il, operand));
+                        break;
+                    case OperandType.InlineR:
+                        generator.Emit(opCode, BitConverter.ToDouble(il, operand));
+                        break;
+                    default:
+                        EmitTokenOperand(
+                            generator,
+                            opCode,
+                            method.Source,
+                            BitConverter.ToInt32(il, operand),
+                            methods);
+                        break;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Creates an instrumented copy of the given kernel method that records the
+        /// execution counts of all conditional branches in the given profile.
+        /// </summary>
+        /// <param name="method">The kernel method to instrument.</param>
+        /// <param name="profile">The profile to record the counts in.</param>
+        /// <returns>The instrumented kernel method.</returns>
+        /// <remarks>
+        /// All methods that are directly called by the kernel method or by one of
+        /// its instrumented callees and that are declared in the assembly of the
+        /// kernel are instrumented as well. Kernel methods that contain exception
+        /// handlers or indirect calls are not supported. Callees of this kind are
+        /// invoked without instrumentation.
+        /// </remarks>
+        public static MethodInfo Instrument(MethodInfo method, KernelProfile profile)
+        {
+            var kernel = TryDeclare(method) ?? throw GetNotSupportedException(method);
+            var methods = new Dictionary<MethodInfo, InstrumentedMethod>()
+            {
+                { method, kernel }
+            };
+
+            // Declare all methods before emitting any bodies to redirect all calls
+            foreach (var instrumented in DeclareCallees(kernel, methods))
+                EmitBody(instrumented, profile, methods);
+            return kernel.Target;
+        }
+
+        #endregion
+    }
+}
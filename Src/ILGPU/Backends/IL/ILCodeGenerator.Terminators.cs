@@ -0,0 +1,51 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: ILCodeGenerator.Terminators.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.IR.Values;
+using System.Reflection.Emit;
+
+namespace ILGPU.Backends.IL
+{
+    partial class ILCodeGenerator
+    {
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(ReturnTerminator)"/>
+        public void GenerateCode(ReturnTerminator returnTerminator)
+        {
+            if (!returnTerminator.IsVoidReturn)
+                Load(returnTerminator.ReturnValue);
+            Emitter.Emit(OpCodes.Ret);
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(UnconditionalBranch)"/>
+        public void GenerateCode(UnconditionalBranch branch) =>
+            EmitBranch(branch.Target);
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(IfBranch)"/>
+        public void GenerateCode(IfBranch branch)
+        {
+            Load(branch.Condition);
+            Emitter.Emit(OpCodes.Brtrue, blockLookup[branch.TrueTarget]);
+            EmitBranch(branch.FalseTarget);
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(SwitchBranch)"/>
+        public void GenerateCode(SwitchBranch branch)
+        {
+            var caseLabels = new ILLabel[branch.NumCasesWithoutDefault];
+            for (int i = 0; i < caseLabels.Length; ++i)
+                caseLabels[i] = blockLookup[branch.GetCaseTarget(i)];
+
+            Load(branch.Condition);
+            Emitter.EmitSwitch(caseLabels);
+            EmitBranch(branch.DefaultBlock);
+        }
+    }
+}
@@ -0,0 +1,1029 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: ILCodeGenerator.Values.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.Frontend.Intrinsic;
+using ILGPU.IR;
+using ILGPU.IR.Types;
+using ILGPU.IR.Values;
+using ILGPU.Runtime.CPU;
+using ILGPU.Util;
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Linq;
+using System.Reflection;
+using System.Reflection.Emit;
+using System.Threading;
+
+namespace ILGPU.Backends.IL
+{
+    partial class ILCodeGenerator
+    {
+        #region Static
+
+        /// <summary>
+        /// Maps math intrinsics to their managed CPU implementations.
+        /// </summary>
+        private static readonly Dictionary<
+            (MathIntrinsicKind, ArithmeticBasicValueType),
+            MethodInfo> MathFunctions = CreateMathFunctions();
+
+        /// <summary>
+        /// Maps atomic intrinsics to their managed CPU implementations.
+        /// </summary>
+        private static readonly Dictionary<
+            (AtomicIntrinsicKind, ArithmeticBasicValueType),
+            MethodInfo> AtomicFunctions = CreateAtomicFunctions();
+
+        /// <summary>
+        /// The <see cref="CPURuntimeThreadContext.GridIndex"/> getter.
+        /// </summary>
+        private static readonly MethodInfo GridIndexGetter =
+            GetContextGetter(
+                typeof(CPURuntimeThreadContext),
+                nameof(CPURuntimeThreadContext.GridIndex));
+
+        /// <summary>
+        /// The <see cref="CPURuntimeThreadContext.GroupIndex"/> getter.
+        /// </summary>
+        private static readonly MethodInfo GroupIndexGetter =
+            GetContextGetter(
+                typeof(CPURuntimeThreadContext),
+                nameof(CPURuntimeThreadContext.GroupIndex));
+
+        /// <summary>
+        /// The <see cref="CPURuntimeThreadContext.LaneIndex"/> getter.
+        /// </summary>
+        private static readonly MethodInfo LaneIndexGetter =
+            GetContextGetter(
+                typeof(CPURuntimeThreadContext),
+                nameof(CPURuntimeThreadContext.LaneIndex));
+
+        /// <summary>
+        /// The <see cref="CPURuntimeGroupContext.GridDimension"/> getter.
+        /// </summary>
+        private static readonly MethodInfo GridDimensionGetter =
+            GetContextGetter(
+                typeof(CPURuntimeGroupContext),
+                nameof(CPURuntimeGroupContext.GridDimension));
+
+        /// <summary>
+        /// The <see cref="CPURuntimeGroupContext.GroupDimension"/> getter.
+        /// </summary>
+        private static readonly MethodInfo GroupDimensionGetter =
+            GetContextGetter(
+                typeof(CPURuntimeGroupContext),
+                nameof(CPURuntimeGroupContext.GroupDimension));
+
+        /// <summary>
+        /// All component getters of <see cref="Index3D"/>.
+        /// </summary>
+        private static readonly MethodInfo[] Index3DComponentGetters =
+        {
+            GetContextGetter(typeof(Index3D), nameof(Index3D.X)),
+            GetContextGetter(typeof(Index3D), nameof(Index3D.Y)),
+            GetContextGetter(typeof(Index3D), nameof(Index3D.Z)),
+        };
+
+        /// <summary>
+        /// The <see cref="Trace.Assert(bool, string)"/> method.
+        /// </summary>
+        private static readonly MethodInfo AssertMethod =
+            typeof(Trace).GetMethod(
+                nameof(Trace.Assert),
+                new Type[] { typeof(bool), typeof(string) });
+
+        /// <summary>
+        /// The implicit conversion from <see cref="Half"/> to <see cref="float"/>.
+        /// </summary>
+        private static readonly MethodInfo HalfToFloatMethod =
+            typeof(Half).GetMethods(BindingFlags.Public | BindingFlags.Static)
+            .First(method =>
+                method.Name == "op_Implicit" && method.ReturnType == typeof(float));
+
+        /// <summary>
+        /// The explicit conversion from <see cref="float"/> to <see cref="Half"/>.
+        /// </summary>
+        private static readonly MethodInfo FloatToHalfMethod =
+            typeof(Half).GetMethod("op_Explicit", new Type[] { typeof(float) });
+
+        /// <summary>
+        /// The implicit conversion from <see cref="BFloat16"/> to <see cref="float"/>.
+        /// </summary>
+        private static readonly MethodInfo BFloat16ToFloatMethod =
+            typeof(BFloat16).GetMethods(BindingFlags.Public | BindingFlags.Static)
+            .First(method =>
+                method.Name == "op_Implicit" && method.ReturnType == typeof(float));
+
+        /// <summary>
+        /// The explicit conversion from <see cref="float"/> to <see cref="BFloat16"/>.
+        /// </summary>
+        private static readonly MethodInfo FloatToBFloat16Method =
+            typeof(BFloat16).GetMethod("op_Explicit", new Type[] { typeof(float) });
+
+        /// <summary>
+        /// The <see cref="Thread.MemoryBarrier"/> method.
+        /// </summary>
+        private static readonly MethodInfo MemoryBarrierMethod =
+            typeof(Thread).GetMethod(nameof(Thread.MemoryBarrier));
+
+        /// <summary>
+        /// Scans all math classes for CPU implementations of math intrinsics.
+        /// </summary>
+        private static Dictionary<
+            (MathIntrinsicKind, ArithmeticBasicValueType),
+            MethodInfo> CreateMathFunctions()
+        {
+            var result = new Dictionary<
+                (MathIntrinsicKind, ArithmeticBasicValueType),
+                MethodInfo>();
+            var sourceTypes = new Type[]
+            {
+                typeof(IntrinsicMath),
+                typeof(IntrinsicMath.CPUOnly),
+                typeof(Half),
+                typeof(BFloat16),
+            };
+            foreach (var sourceType in sourceTypes)
+            {
+                foreach (var method in sourceType.GetMethods(
+                    BindingFlags.Public | BindingFlags.Static))
+                {
+                    var attribute = method.GetCustomAttribute<MathIntrinsicAttribute>();
+                    var parameters = method.GetParameters();
+                    if (attribute is null || parameters.Length < 1)
+                        continue;
+                    var key = (
+                        attribute.IntrinsicKind,
+                        parameters[0].ParameterType.GetArithmeticBasicValueType());
+                    if (!result.ContainsKey(key))
+                        result.Add(key, method);
+                }
+            }
+            return result;
+        }
+
+        /// <summary>
+        /// Scans the atomic class for CPU implementations of atomic intrinsics.
+        /// </summary>
+        private static Dictionary<
+            (AtomicIntrinsicKind, ArithmeticBasicValueType),
+            MethodInfo> CreateAtomicFunctions()
+        {
+            var result = new Dictionary<
+                (AtomicIntrinsicKind, ArithmeticBasicValueType),
+                MethodInfo>();
+            foreach (var method in typeof(Atomic).GetMethods(
+                BindingFlags.Public | BindingFlags.Static))
+            {
+                var attribute = method.GetCustomAttribute<AtomicIntrinsicAttribute>();
+                var parameters = method.GetParameters();
+                if (attribute is null || parameters.Length < 2)
+                    continue;
+                var key = (
+                    attribute.IntrinsicKind,
+                    parameters[1].ParameterType.GetArithmeticBasicValueType());
+                if (!result.ContainsKey(key))
+                    result.Add(key, method);
+            }
+            return result;
+        }
+
+        /// <summary>
+        /// Resolves the public instance getter of the given property.
+        /// </summary>
+        private static MethodInfo GetContextGetter(Type type, string propertyName) =>
+            type.GetProperty(
+                propertyName,
+                BindingFlags.Public | BindingFlags.Instance).GetGetMethod();
+
+        /// <summary>
+        /// Resolves a public generic method by its name and number of parameters.
+        /// </summary>
+        private static MethodInfo GetGenericMethod(
+            Type type,
+            string name,
+            int numParameters,
+            Type typeArgument) =>
+            type.GetMethods(BindingFlags.Public | BindingFlags.Static)
+            .First(method =>
+                method.Name == name &&
+                method.IsGenericMethodDefinition &&
+                method.GetParameters().Length == numParameters)
+            .MakeGenericMethod(typeArgument);
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Emits a call to the CPU implementation of the given math intrinsic.
+        /// </summary>
+        private void EmitMathFunction(
+            Value value,
+            MathIntrinsicKind kind,
+            ArithmeticBasicValueType type)
+        {
+            if (!MathFunctions.TryGetValue((kind, type), out var method))
+                throw GetNotSupportedException(value);
+            foreach (Value operand in value)
+                Load(operand);
+            Emitter.EmitCall(method);
+            Store(value);
+        }
+
+        /// <summary>
+        /// Emits an arithmetic operation that might check for overflows.
+        /// </summary>
+        private void EmitArithmetic(
+            ArithmeticValue value,
+            OpCode opCode,
+            OpCode overflowCode,
+            OpCode unsignedOverflowCode)
+        {
+            if (value.CanOverflow && value.IsIntOperation)
+            {
+                Emitter.Emit(value.IsUnsigned
+                    ? unsignedOverflowCode
+                    : overflowCode);
+            }
+            else
+            {
+                Emitter.Emit(opCode);
+            }
+        }
+
+        /// <summary>
+        /// Emits a primitive constant.
+        /// </summary>
+        private void EmitPrimitiveValue(PrimitiveValue value)
+        {
+            switch (value.BasicValueType)
+            {
+                case BasicValueType.Int1:
+                case BasicValueType.Int8:
+                case BasicValueType.Int16:
+                case BasicValueType.Int32:
+                    Emitter.EmitConstant(value.Int32Value);
+                    break;
+                case BasicValueType.Int64:
+                    Emitter.EmitConstant(value.Int64Value);
+                    break;
+                case BasicValueType.Float16:
+                    Emitter.EmitConstant(value.Int16Value);
+                    Emitter.EmitCall(typeof(Interop).GetMethod(
+                        nameof(Interop.IntAsFloat),
+                        new Type[] { typeof(ushort) }));
+                    break;
+                case BasicValueType.Float32:
+                    Emitter.EmitConstant(value.Float32Value);
+                    break;
+                case BasicValueType.Float64:
+                    Emitter.EmitConstant(value.Float64Value);
+                    break;
+                case BasicValueType.BFloat16:
+                    Emitter.EmitConstant((float)value.BFloat16Value);
+                    Emitter.EmitCall(FloatToBFloat16Method);
+                    break;
+                default:
+                    throw GetNotSupportedException(value);
+            }
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(MethodCall)"/>
+        public void GenerateCode(MethodCall methodCall)
+        {
+            if (!methods.TryGetValue(methodCall.Target, out var target))
+                throw GetNotSupportedException(methodCall);
+            Emitter.Emit(ArgumentOperation.Load, ThreadContextArgument);
+            Emitter.Emit(ArgumentOperation.Load, GroupContextArgument);
+            foreach (Value argument in methodCall)
+                Load(argument);
+            Emitter.EmitCall(target);
+            if (!methodCall.Type.IsVoidType)
+                Store(methodCall);
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(PhiValue)"/>
+        public void GenerateCode(PhiValue phiValue) { }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(Parameter)"/>
+        public void GenerateCode(Parameter parameter) { }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(UnaryArithmeticValue)"/>
+        public void GenerateCode(UnaryArithmeticValue value)
+        {
+            var operandType = value.Value.BasicValueType;
+            if (!IsReducedFloat(operandType))
+            {
+                switch (value.Kind)
+                {
+                    case UnaryArithmeticKind.Neg:
+                        Load(value.Value);
+                        Emitter.Emit(OpCodes.Neg);
+                        Store(value);
+                        return;
+                    case UnaryArithmeticKind.Not:
+                        Load(value.Value);
+                        if (operandType == BasicValueType.Int1)
+                        {
+                            Emitter.Emit(OpCodes.Ldc_I4_0);
+                            Emitter.Emit(OpCodes.Ceq);
+                        }
+                        else
+                        {
+                            Emitter.Emit(OpCodes.Not);
+                        }
+                        Store(value);
+                        return;
+                }
+            }
+
+            EmitMathFunction(
+                value,
+                (MathIntrinsicKind)value.Kind,
+                operandType.GetArithmeticBasicValueType(value.IsUnsigned));
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(BinaryArithmeticValue)"/>
+        public void GenerateCode(BinaryArithmeticValue value)
+        {
+            var operandType = value.Left.BasicValueType;
+            if (!IsReducedFloat(operandType) &&
+                TryGenerateBinaryOperation(value))
+            {
+                Store(value);
+                return;
+            }
+
+            EmitMathFunction(
+                value,
+                MathIntrinsicKind._BinaryFunctions + 1 + (int)value.Kind,
+                operandType.GetArithmeticBasicValueType(value.IsUnsigned));
+        }
+
+        /// <summary>
+        /// Tries to emit a binary operation that has a direct IL equivalent.
+        /// </summary>
+        private bool TryGenerateBinaryOperation(BinaryArithmeticValue value)
+        {
+            bool isUnsigned = value.IsUnsigned;
+            switch (value.Kind)
+            {
+                case BinaryArithmeticKind.Add:
+                    Load(value.Left);
+                    Load(value.Right);
+                    EmitArithmetic(
+                        value,
+                        OpCodes.Add,
+                        OpCodes.Add_Ovf,
+                        OpCodes.Add_Ovf_Un);
+                    return true;
+                case BinaryArithmeticKind.Sub:
+                    Load(value.Left);
+                    Load(value.Right);
+                    EmitArithmetic(
+                        value,
+                        OpCodes.Sub,
+                        OpCodes.Sub_Ovf,
+                        OpCodes.Sub_Ovf_Un);
+                    return true;
+                case BinaryArithmeticKind.Mul:
+                    Load(value.Left);
+                    Load(value.Right);
+                    EmitArithmetic(
+                        value,
+                        OpCodes.Mul,
+                        OpCodes.Mul_Ovf,
+                        OpCodes.Mul_Ovf_Un);
+                    return true;
+                case BinaryArithmeticKind.Div:
+                case BinaryArithmeticKind.Rem:
+                    Load(value.Left, isUnsigned);
+                    Load(value.Right, isUnsigned);
+                    bool isDiv = value.Kind == BinaryArithmeticKind.Div;
+                    Emitter.Emit(isUnsigned && value.IsIntOperation
+                        ? isDiv ? OpCodes.Div_Un : OpCodes.Rem_Un
+                        : isDiv ? OpCodes.Div : OpCodes.Rem);
+                    return true;
+                case BinaryArithmeticKind.And:
+                case BinaryArithmeticKind.Or:
+                case BinaryArithmeticKind.Xor:
+                    Load(value.Left);
+                    Load(value.Right);
+                    Emitter.Emit(value.Kind switch
+                    {
+                        BinaryArithmeticKind.And => OpCodes.And,
+                        BinaryArithmeticKind.Or => OpCodes.Or,
+                        _ => OpCodes.Xor,
+                    });
+                    return true;
+                case BinaryArithmeticKind.Shl:
+                case BinaryArithmeticKind.Shr:
+                    bool isShl = value.Kind == BinaryArithmeticKind.Shl;
+                    Load(value.Left, isUnsigned);
+                    Load(value.Right);
+                    if (value.Right.BasicValueType == BasicValueType.Int64)
+                        Emitter.Emit(OpCodes.Conv_I4);
+                    Emitter.Emit(isShl
+                        ? OpCodes.Shl
+                        : isUnsigned ? OpCodes.Shr_Un : OpCodes.Shr);
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(TernaryArithmeticValue)"/>
+        public void GenerateCode(TernaryArithmeticValue value)
+        {
+            if (value.Kind != TernaryArithmeticKind.MultiplyAdd ||
+                IsReducedFloat(value.BasicValueType))
+            {
+                throw GetNotSupportedException(value);
+            }
+
+            Load(value.First);
+            Load(value.Second);
+            Emitter.Emit(OpCodes.Mul);
+            Load(value.Third);
+            Emitter.Emit(OpCodes.Add);
+            Store(value);
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(CompareValue)"/>
+        public void GenerateCode(CompareValue value)
+        {
+            var operandType = value.Left.BasicValueType;
+            bool isFloat = operandType.IsFloat();
+            bool isUnsignedOrUnordered = value.IsUnsignedOrUnordered;
+
+            Load(value.Left, isUnsignedOrUnordered);
+            EmitWidenReducedFloat(operandType);
+            Load(value.Right, isUnsignedOrUnordered);
+            EmitWidenReducedFloat(operandType);
+
+            // Note that inverted float comparisons flip their ordering semantics
+            bool negate = false;
+            switch (value.Kind)
+            {
+                case CompareKind.Equal:
+                    if (isFloat && isUnsignedOrUnordered)
+                        throw GetNotSupportedException(value);
+                    Emitter.Emit(OpCodes.Ceq);
+                    break;
+                case CompareKind.NotEqual:
+                    if (isFloat && !isUnsignedOrUnordered)
+                        throw GetNotSupportedException(value);
+                    Emitter.Emit(OpCodes.Ceq);
+                    negate = true;
+                    break;
+                case CompareKind.LessThan:
+                    Emitter.Emit(isUnsignedOrUnordered ? OpCodes.Clt_Un : OpCodes.Clt);
+                    break;
+                case CompareKind.GreaterThan:
+                    Emitter.Emit(isUnsignedOrUnordered ? OpCodes.Cgt_Un : OpCodes.Cgt);
+                    break;
+                case CompareKind.LessEqual:
+                    Emitter.Emit(isUnsignedOrUnordered != isFloat
+                        ? OpCodes.Cgt_Un
+                        : OpCodes.Cgt);
+                    negate = true;
+                    break;
+                case CompareKind.GreaterEqual:
+                    Emitter.Emit(isUnsignedOrUnordered != isFloat
+                        ? OpCodes.Clt_Un
+                        : OpCodes.Clt);
+                    negate = true;
+                    break;
+                default:
+                    throw GetNotSupportedException(value);
+            }
+
+            if (negate)
+            {
+                Emitter.Emit(OpCodes.Ldc_I4_0);
+                Emitter.Emit(OpCodes.Ceq);
+            }
+            Store(value);
+        }
+
+        /// <summary>
+        /// Returns true if the given type is a reduced precision float that is
+        /// represented by a managed structure.
+        /// </summary>
+        private static bool IsReducedFloat(BasicValueType type) =>
+            type == BasicValueType.Float16 || type == BasicValueType.BFloat16;
+
+        /// <summary>
+        /// Widens a reduced precision float on top of the evaluation stack to a
+        /// single precision float.
+        /// </summary>
+        /// <param name="type">The type of the value on the evaluation stack.</param>
+        /// <returns>The type of the value after widening.</returns>
+        private BasicValueType EmitWidenReducedFloat(BasicValueType type)
+        {
+            switch (type)
+            {
+                case BasicValueType.Float16:
+                    Emitter.EmitCall(HalfToFloatMethod);
+                    return BasicValueType.Float32;
+                case BasicValueType.BFloat16:
+                    Emitter.EmitCall(BFloat16ToFloatMethod);
+                    return BasicValueType.Float32;
+                default:
+                    return type;
+            }
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(ConvertValue)"/>
+        public void GenerateCode(ConvertValue value)
+        {
+            if (value.CanOverflow)
+                throw GetNotSupportedException(value);
+
+            var sourceType = value.Value.BasicValueType;
+            bool isSourceUnsigned = value.IsSourceUnsigned ||
+                sourceType == BasicValueType.Int1;
+            Load(value.Value, isSourceUnsigned);
+            sourceType = EmitWidenReducedFloat(sourceType);
+
+            bool isSourceFloat = sourceType.IsFloat();
+            switch (value.BasicValueType)
+            {
+                case BasicValueType.Int1:
+                    if (isSourceFloat)
+                    {
+                        Emitter.Emit(OpCodes.Conv_R8);
+                        Emitter.EmitConstant(0.0);
+                    }
+                    else if (sourceType == BasicValueType.Int64)
+                    {
+                        Emitter.EmitConstant(0L);
+                    }
+                    else
+                    {
+                        Emitter.Emit(OpCodes.Ldc_I4_0);
+                    }
+                    Emitter.Emit(isSourceFloat ? OpCodes.Ceq : OpCodes.Cgt_Un);
+                    if (isSourceFloat)
+                    {
+                        Emitter.Emit(OpCodes.Ldc_I4_0);
+                        Emitter.Emit(OpCodes.Ceq);
+                    }
+                    break;
+                case BasicValueType.Int8:
+                    Emitter.Emit(value.IsResultUnsigned
+                        ? OpCodes.Conv_U1
+                        : OpCodes.Conv_I1);
+                    break;
+                case BasicValueType.Int16:
+                    Emitter.Emit(value.IsResultUnsigned
+                        ? OpCodes.Conv_U2
+                        : OpCodes.Conv_I2);
+                    break;
+                case BasicValueType.Int32:
+                    Emitter.Emit(value.IsResultUnsigned
+                        ? OpCodes.Conv_U4
+                        : OpCodes.Conv_I4);
+                    break;
+                case BasicValueType.Int64:
+                    Emitter.Emit(isSourceFloat && value.IsResultUnsigned ||
+                        !isSourceFloat && isSourceUnsigned
+                        ? OpCodes.Conv_U8
+                        : OpCodes.Conv_I8);
+                    break;
+                case BasicValueType.Float16:
+                case BasicValueType.Float32:
+                case BasicValueType.Float64:
+                case BasicValueType.BFloat16:
+                    if (!isSourceFloat && isSourceUnsigned)
+                        Emitter.Emit(OpCodes.Conv_R_Un);
+                    if (value.BasicValueType == BasicValueType.Float64)
+                    {
+                        Emitter.Emit(OpCodes.Conv_R8);
+                        break;
+                    }
+                    Emitter.Emit(OpCodes.Conv_R4);
+                    if (value.BasicValueType == BasicValueType.Float16)
+                        Emitter.EmitCall(FloatToHalfMethod);
+                    else if (value.BasicValueType == BasicValueType.BFloat16)
+                        Emitter.EmitCall(FloatToBFloat16Method);
+                    break;
+                default:
+                    throw GetNotSupportedException(value);
+            }
+            Store(value);
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(IntAsPointerCast)"/>
+        public void GenerateCode(IntAsPointerCast cast)
+        {
+            Load(cast.Value);
+            Emitter.Emit(OpCodes.Conv_U);
+            Store(cast);
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(PointerAsIntCast)"/>
+        public void GenerateCode(PointerAsIntCast cast)
+        {
+            Load(cast.Value);
+            Emitter.Emit(cast.TargetBasicValueType == BasicValueType.Int64
+                ? OpCodes.Conv_U8
+                : OpCodes.Conv_U4);
+            Store(cast);
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(PointerCast)"/>
+        public void GenerateCode(PointerCast cast)
+        {
+            Load(cast.Value);
+            Store(cast);
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(AddressSpaceCast)"/>
+        public void GenerateCode(AddressSpaceCast value)
+        {
+            if (!value.IsPointerCast)
+                throw GetNotSupportedException(value);
+            Load(value.Value);
+            Store(value);
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(FloatAsIntCast)"/>
+        public void GenerateCode(FloatAsIntCast value)
+        {
+            Load(value.Value);
+            Emitter.EmitCall(typeof(Interop).GetMethod(
+                nameof(Interop.FloatAsInt),
+                new Type[] { TypeGenerator[value.Value.Type] }));
+            Store(value);
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(IntAsFloatCast)"/>
+        public void GenerateCode(IntAsFloatCast value)
+        {
+            var sourceType = value.Value.BasicValueType switch
+            {
+                BasicValueType.Int16 => typeof(ushort),
+                BasicValueType.Int32 => typeof(uint),
+                BasicValueType.Int64 => typeof(ulong),
+                _ => throw GetNotSupportedException(value),
+            };
+            Load(value.Value);
+            Emitter.EmitCall(typeof(Interop).GetMethod(
+                nameof(Interop.IntAsFloat),
+                new Type[] { sourceType }));
+            Store(value);
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(Predicate)"/>
+        public void GenerateCode(Predicate predicate)
+        {
+            var falseLabel = Emitter.DeclareLabel();
+            var endLabel = Emitter.DeclareLabel();
+
+            Load(predicate.Condition);
+            Emitter.Emit(OpCodes.Brfalse, falseLabel);
+            Load(predicate.TrueValue);
+            Emitter.Emit(OpCodes.Br, endLabel);
+            Emitter.MarkLabel(falseLabel);
+            Load(predicate.FalseValue);
+            Emitter.MarkLabel(endLabel);
+            Store(predicate);
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(GenericAtomic)"/>
+        public void GenerateCode(GenericAtomic atomic)
+        {
+            if (!AtomicFunctions.TryGetValue(
+                ((AtomicIntrinsicKind)atomic.Kind, atomic.ArithmeticBasicValueType),
+                out var method))
+            {
+                throw GetNotSupportedException(atomic);
+            }
+
+            // Pass the target pointer as managed reference
+            Load(atomic.Target);
+            Load(atomic.Value);
+            Emitter.EmitCall(method);
+            Store(atomic);
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(AtomicCAS)"/>
+        public void GenerateCode(AtomicCAS atomicCAS)
+        {
+            if (!AtomicFunctions.TryGetValue(
+                (
+                    AtomicIntrinsicKind.CompareExchange,
+                    atomicCAS.ArithmeticBasicValueType
+                ),
+                out var method))
+            {
+                throw GetNotSupportedException(atomicCAS);
+            }
+
+            Load(atomicCAS.Target);
+            Load(atomicCAS.CompareValue);
+            Load(atomicCAS.Value);
+            Emitter.EmitCall(method);
+            Store(atomicCAS);
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(Alloca)"/>
+        public void GenerateCode(Alloca alloca)
+        {
+            // All allocations have been set up in the method prologue
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(MemoryBarrier)"/>
+        public void GenerateCode(MemoryBarrier barrier) =>
+            Emitter.EmitCall(MemoryBarrierMethod);
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(Load)"/>
+        public void GenerateCode(Load load)
+        {
+            Load(load.Source);
+            Emitter.Emit(OpCodes.Ldobj, TypeGenerator[load.Type]);
+            Store(load);
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(Store)"/>
+        public void GenerateCode(Store store)
+        {
+            Load(store.Target);
+            Load(store.Value);
+            Emitter.Emit(OpCodes.Stobj, TypeGenerator[store.Value.Type]);
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(LoadElementAddress)"/>
+        public void GenerateCode(LoadElementAddress value)
+        {
+            if (!value.IsPointerAccess)
+                throw GetNotSupportedException(value);
+
+            Load(value.Source);
+            Load(value.Offset);
+            Emitter.Emit(OpCodes.Conv_I);
+            Emitter.EmitConstant(value.ElementType.Size);
+            Emitter.Emit(OpCodes.Mul);
+            Emitter.Emit(OpCodes.Add);
+            Store(value);
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(LoadFieldAddress)"/>
+        public void GenerateCode(LoadFieldAddress value)
+        {
+            Load(value.Source);
+            int offset = value.StructureType.GetOffset(value.FieldSpan.Access);
+            if (offset != 0)
+            {
+                Emitter.EmitConstant(offset);
+                Emitter.Emit(OpCodes.Add);
+            }
+            Store(value);
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(PrimitiveValue)"/>
+        public void GenerateCode(PrimitiveValue value)
+        {
+            // Constants are emitted at their use sites
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(StringValue)"/>
+        public void GenerateCode(StringValue value)
+        {
+            // Strings are emitted at their use sites
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(NullValue)"/>
+        public void GenerateCode(NullValue value)
+        {
+            // Null values are bound to zero-initialized locals
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(StructureValue)"/>
+        public void GenerateCode(StructureValue value)
+        {
+            var structureType = value.StructureType;
+            if (value.Count != structureType.NumFields)
+                throw GetNotSupportedException(value);
+
+            for (int i = 0, e = value.Count; i < e; ++i)
+            {
+                LoadAddress(value);
+                Load(value[i]);
+                Emitter.Emit(OpCodes.Stfld, TypeGenerator.GetField(structureType, i));
+            }
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(GetField)"/>
+        public void GenerateCode(GetField value)
+        {
+            var structureType = value.StructureType;
+            var fieldSpan = value.FieldSpan;
+            if (!fieldSpan.HasSpan)
+            {
+                Load(value.ObjectValue);
+                Emitter.Emit(
+                    OpCodes.Ldfld,
+                    TypeGenerator.GetField(structureType, fieldSpan.Index));
+                Store(value);
+                return;
+            }
+
+            // Copy all fields of the span into the result structure
+            var resultType = value.Type as StructureType;
+            for (int i = 0; i < fieldSpan.Span; ++i)
+            {
+                LoadAddress(value);
+                Load(value.ObjectValue);
+                Emitter.Emit(
+                    OpCodes.Ldfld,
+                    TypeGenerator.GetField(structureType, fieldSpan.Index + i));
+                Emitter.Emit(OpCodes.Stfld, TypeGenerator.GetField(resultType, i));
+            }
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(SetField)"/>
+        public void GenerateCode(SetField value)
+        {
+            var structureType = value.StructureType;
+            var fieldSpan = value.FieldSpan;
+
+            Load(value.ObjectValue);
+            Store(value);
+            if (!fieldSpan.HasSpan)
+            {
+                LoadAddress(value);
+                Load(value.Value);
+                Emitter.Emit(
+                    OpCodes.Stfld,
+                    TypeGenerator.GetField(structureType, fieldSpan.Index));
+                return;
+            }
+
+            var sourceType = value.Value.Type as StructureType;
+            for (int i = 0; i < fieldSpan.Span; ++i)
+            {
+                LoadAddress(value);
+                Load(value.Value);
+                Emitter.Emit(OpCodes.Ldfld, TypeGenerator.GetField(sourceType, i));
+                Emitter.Emit(
+                    OpCodes.Stfld,
+                    TypeGenerator.GetField(structureType, fieldSpan.Index + i));
+            }
+        }
+
+        /// <summary>
+        /// Loads a component of a 3D index from the given hidden context argument
+        /// and binds the result.
+        /// </summary>
+        private void EmitContextIndex(
+            DeviceConstantDimensionValue value,
+            int contextArgument,
+            MethodInfo getter)
+        {
+            var temp = GetTempIndexLocal();
+            usesRuntimeContexts = true;
+            Emitter.Emit(ArgumentOperation.Load, contextArgument);
+            Emitter.EmitCall(getter);
+            Emitter.Emit(LocalOperation.Store, temp);
+            Emitter.Emit(LocalOperation.LoadAddress, temp);
+            Emitter.EmitCall(Index3DComponentGetters[(int)value.Dimension]);
+            Store(value);
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(GridIndexValue)"/>
+        public void GenerateCode(GridIndexValue value) =>
+            EmitContextIndex(value, ThreadContextArgument, GridIndexGetter);
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(GroupIndexValue)"/>
+        public void GenerateCode(GroupIndexValue value) =>
+            EmitContextIndex(value, ThreadContextArgument, GroupIndexGetter);
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(GridDimensionValue)"/>
+        public void GenerateCode(GridDimensionValue value) =>
+            EmitContextIndex(value, GroupContextArgument, GridDimensionGetter);
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(GroupDimensionValue)"/>
+        public void GenerateCode(GroupDimensionValue value) =>
+            EmitContextIndex(value, GroupContextArgument, GroupDimensionGetter);
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(WarpSizeValue)"/>
+        public void GenerateCode(WarpSizeValue value)
+        {
+            Emitter.EmitCall(
+                typeof(Warp).GetProperty(nameof(Warp.WarpSize)).GetGetMethod());
+            Store(value);
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(LaneIdxValue)"/>
+        public void GenerateCode(LaneIdxValue value)
+        {
+            usesRuntimeContexts = true;
+            Emitter.Emit(ArgumentOperation.Load, ThreadContextArgument);
+            Emitter.EmitCall(LaneIndexGetter);
+            Store(value);
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(DynamicMemoryLengthValue)"/>
+        public void GenerateCode(DynamicMemoryLengthValue value) =>
+            throw GetNotSupportedException(value);
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(PredicateBarrier)"/>
+        public void GenerateCode(PredicateBarrier barrier)
+        {
+            Load(barrier.Predicate);
+            Emitter.EmitCall(typeof(Group).GetMethod(barrier.Kind switch
+            {
+                PredicateBarrierKind.PopCount => nameof(Group.BarrierPopCount),
+                PredicateBarrierKind.And => nameof(Group.BarrierAnd),
+                _ => nameof(Group.BarrierOr),
+            }));
+            Store(barrier);
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(Barrier)"/>
+        public void GenerateCode(Barrier barrier) =>
+            Emitter.EmitCall(barrier.Kind == BarrierKind.WarpLevel
+                ? typeof(Warp).GetMethod(nameof(Warp.Barrier))
+                : typeof(Group).GetMethod(nameof(Group.Barrier)));
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(Broadcast)"/>
+        public void GenerateCode(Broadcast broadcast)
+        {
+            Load(broadcast.Variable);
+            Load(broadcast.Origin);
+            Emitter.EmitCall(GetGenericMethod(
+                broadcast.Kind == BroadcastKind.WarpLevel
+                    ? typeof(Warp)
+                    : typeof(Group),
+                nameof(Group.Broadcast),
+                2,
+                TypeGenerator[broadcast.Type]));
+            Store(broadcast);
+        }
+
+        /// <summary>
+        /// Returns the name of the managed shuffle method.
+        /// </summary>
+        private static string GetShuffleMethodName(ShuffleKind kind) =>
+            kind switch
+            {
+                ShuffleKind.Down => nameof(Warp.ShuffleDown),
+                ShuffleKind.Up => nameof(Warp.ShuffleUp),
+                ShuffleKind.Xor => nameof(Warp.ShuffleXor),
+                _ => nameof(Warp.Shuffle),
+            };
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(WarpShuffle)"/>
+        public void GenerateCode(WarpShuffle shuffle)
+        {
+            Load(shuffle.Variable);
+            Load(shuffle.Origin);
+            Emitter.EmitCall(GetGenericMethod(
+                typeof(Warp),
+                GetShuffleMethodName(shuffle.Kind),
+                2,
+                TypeGenerator[shuffle.Type]));
+            Store(shuffle);
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(SubWarpShuffle)"/>
+        public void GenerateCode(SubWarpShuffle shuffle)
+        {
+            Load(shuffle.Variable);
+            Load(shuffle.Origin);
+            Load(shuffle.Width);
+            Emitter.EmitCall(GetGenericMethod(
+                typeof(Warp),
+                GetShuffleMethodName(shuffle.Kind),
+                3,
+                TypeGenerator[shuffle.Type]));
+            Store(shuffle);
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(DebugAssertOperation)"/>
+        public void GenerateCode(DebugAssertOperation debug)
+        {
+            Load(debug.Condition);
+            Load(debug.Message);
+            Emitter.EmitCall(AssertMethod);
+        }
+
+        /// <summary cref="IBackendCodeGenerator.GenerateCode(LanguageEmitValue)"/>
+        public void GenerateCode(LanguageEmitValue emit) =>
+            throw GetNotSupportedException(emit);
+
+        #endregion
+    }
+}
@@ -0,0 +1,468 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: ILCodeGenerator.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.Backends.PointerViews;
+using ILGPU.IR;
+using ILGPU.IR.Analyses;
+using ILGPU.IR.Values;
+using ILGPU.Resources;
+using ILGPU.Runtime.CPU;
+using System;
+using System.Collections.Generic;
+using System.Reflection;
+using System.Reflection.Emit;
+
+namespace ILGPU.Backends.IL
+{
+    /// <summary>
+    /// Generates a dynamic method from an optimized IR method.
+    /// </summary>
+    /// <remarks>
+    /// In contrast to the original kernel method, the generated code benefits from all
+    /// IR-level optimizations (e.g. inlining, specialization and constant folding).
+    /// Unsupported values cause a <see cref="NotSupportedException"/>, which allows
+    /// callers to fall back to the original kernel method.
+    /// Members of this class are not thread safe.
+    /// </remarks>
+    internal sealed partial class ILCodeGenerator : IBackendCodeGenerator
+    {
+        #region Nested Types
+
+        /// <summary>
+        /// Represents a phi binding allocator that does not require any up-front
+        /// allocations, since all phi locals are declared on demand.
+        /// </summary>
+        private readonly struct PhiBindingAllocator : IPhiBindingAllocator
+        {
+            /// <summary>
+            /// Does not perform any operation.
+            /// </summary>
+            public void Process(BasicBlock block, Phis phis) { }
+
+            /// <summary>
+            /// Does not perform any operation.
+            /// </summary>
+            public void Allocate(BasicBlock block, PhiValue phiValue) { }
+        }
+
+        #endregion
+
+        #region Static
+
+        /// <summary>
+        /// The argument index of the hidden thread context.
+        /// </summary>
+        public const int ThreadContextArgument = 0;
+
+        /// <summary>
+        /// The argument index of the hidden group context.
+        /// </summary>
+        public const int GroupContextArgument = 1;
+
+        /// <summary>
+        /// The number of hidden arguments that are passed to all generated methods.
+        /// </summary>
+        /// <remarks>
+        /// Passing the runtime contexts explicitly avoids thread-static lookups in
+        /// all index and dimension queries.
+        /// </remarks>
+        public const int NumHiddenArguments = 2;
+
+        /// <summary>
+        /// The <see cref="CPURuntimeThreadContext.Current"/> getter.
+        /// </summary>
+        public static readonly MethodInfo GetThreadContextMethod =
+            typeof(CPURuntimeThreadContext).GetProperty(
+                nameof(CPURuntimeThreadContext.Current),
+                BindingFlags.Public | BindingFlags.Static).GetGetMethod();
+
+        /// <summary>
+        /// The <see cref="CPURuntimeGroupContext.Current"/> getter.
+        /// </summary>
+        public static readonly MethodInfo GetGroupContextMethod =
+            typeof(CPURuntimeGroupContext).GetProperty(
+                nameof(CPURuntimeGroupContext.Current),
+                BindingFlags.Public | BindingFlags.Static).GetGetMethod();
+
+        /// <summary>
+        /// The generic shared-memory allocation method.
+        /// </summary>
+        private static readonly MethodInfo AllocateSharedMemoryMethod =
+            typeof(SharedMemory).GetMethod(
+                nameof(SharedMemory.Allocate),
+                new Type[] { typeof(int) });
+
+        /// <summary>
+        /// The generic dynamic shared-memory allocation method.
+        /// </summary>
+        private static readonly MethodInfo GetDynamicSharedMemoryMethod =
+            typeof(SharedMemory).GetMethod(nameof(SharedMemory.GetDynamic));
+
+        /// <summary>
+        /// Generates dynamic methods for the kernel and all of its callees.
+        /// </summary>
+        /// <param name="backend">The parent backend.</param>
+        /// <param name="typeGenerator">The type generator to use.</param>
+        /// <param name="kernelMethod">The IR kernel method.</param>
+        /// <param name="kernelAllocas">All allocations of the kernel method.</param>
+        /// <param name="callees">All methods called by the kernel.</param>
+        /// <param name="usesRuntimeContexts">
+        /// True, if the generated code reads the hidden runtime-context arguments.
+        /// </param>
+        /// <returns>The generated kernel method.</returns>
+        /// <exception cref="NotSupportedException">
+        /// If the kernel contains values that cannot be lowered to IL.
+        /// </exception>
+        public static MethodInfo GenerateKernel(
+            ILBackend backend,
+            ILTypeGenerator typeGenerator,
+            Method kernelMethod,
+            Allocas kernelAllocas,
+            List<(Method, Allocas)> callees,
+            out bool usesRuntimeContexts)
+        {
+            var methods = new Dictionary<Method, MethodInfo>(callees.Count + 1);
+            var generators = new List<ILCodeGenerator>(callees.Count + 1)
+            {
+                new ILCodeGenerator(
+                    backend,
+                    typeGenerator,
+                    methods,
+                    kernelMethod,
+                    kernelAllocas)
+            };
+
+            // Declare all methods first to be able to emit calls between them
+            foreach (var (method, allocas) in callees)
+            {
+                generators.Add(new ILCodeGenerator(
+                    backend,
+                    typeGenerator,
+                    methods,
+                    method,
+                    allocas));
+            }
+
+            usesRuntimeContexts = false;
+            foreach (var generator in generators)
+            {
+                generator.GenerateCode();
+                usesRuntimeContexts |= generator.usesRuntimeContexts;
+            }
+            return methods[kernelMethod];
+        }
+
+        /// <summary>
+        /// Creates an exception that reports an unsupported value.
+        /// </summary>
+        private static NotSupportedException GetNotSupportedException(Value value) =>
+            new NotSupportedException(string.Format(
+                ErrorMessages.NotSupportedILValue,
+                value));
+
+        #endregion
+
+        #region Instance
+
+        private readonly Dictionary<Method, MethodInfo> methods;
+        private readonly Dictionary<Value, ILLocal> locals =
+            new Dictionary<Value, ILLocal>();
+        private readonly Dictionary<BasicBlock, ILLabel> blockLookup =
+            new Dictionary<BasicBlock, ILLabel>();
+        private ILLocal? tempIndexLocal;
+        private bool usesRuntimeContexts;
+
+        /// <summary>
+        /// Constructs a new code generator and declares the target method.
+        /// </summary>
+        /// <param name="backend">The parent backend.</param>
+        /// <param name="typeGenerator">The type generator to use.</param>
+        /// <param name="methodMapping">
+        /// The mapping of IR methods to their dynamic methods.
+        /// </param>
+        /// <param name="method">The IR method to generate code for.</param>
+        /// <param name="allocas">All allocations of the method.</param>
+        private ILCodeGenerator(
+            ILBackend backend,
+            ILTypeGenerator typeGenerator,
+            Dictionary<Method, MethodInfo> methodMapping,
+            Method method,
+            Allocas allocas)
+        {
+            if (!method.HasImplementation)
+            {
+                throw new NotSupportedException(string.Format(
+                    ErrorMessages.NotSupportedILValue,
+                    method));
+            }
+
+            Backend = backend;
+            TypeGenerator = typeGenerator;
+            Method = method;
+            Allocas = allocas;
+            methods = methodMapping;
+
+            var parameterTypes = new Type[method.NumParameters + NumHiddenArguments];
+            parameterTypes[ThreadContextArgument] = typeof(CPURuntimeThreadContext);
+            parameterTypes[GroupContextArgument] = typeof(CPURuntimeGroupContext);
+            for (int i = 0, e = method.NumParameters; i < e; ++i)
+            {
+                parameterTypes[i + NumHiddenArguments] =
+                    typeGenerator[method.Parameters[i].ParameterType];
+            }
+
+            using var scopedLock = typeGenerator.RuntimeSystem.DefineRuntimeMethod(
+                typeGenerator[method.ReturnType],
+                parameterTypes,
+                out var methodEmitter);
+            Emitter = new ILEmitter(methodEmitter.ILGenerator);
+            methods.Add(method, methodEmitter.Finish());
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Returns the parent backend.
+        /// </summary>
+        public ILBackend Backend { get; }
+
+        /// <summary>
+        /// Returns the associated type generator.
+        /// </summary>
+        public ILTypeGenerator TypeGenerator { get; }
+
+        /// <summary>
+        /// Returns the current IR method.
+        /// </summary>
+        public Method Method { get; }
+
+        /// <summary>
+        /// Returns all allocations of the current method.
+        /// </summary>
+        public Allocas Allocas { get; }
+
+        /// <summary>
+        /// Returns the underlying IL emitter.
+        /// </summary>
+        public ILEmitter Emitter { get; }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Returns the local variable that holds the given value.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>The associated local variable.</returns>
+        private ILLocal GetLocal(Value value)
+        {
+            if (!locals.TryGetValue(value, out var local))
+            {
+                local = Emitter.DeclareLocal(TypeGenerator[value.Type]);
+                locals.Add(value, local);
+            }
+            return local;
+        }
+
+        /// <summary>
+        /// Loads the given value onto the evaluation stack.
+        /// </summary>
+        /// <param name="value">The value to load.</param>
+        private void Load(Value value)
+        {
+            switch (value)
+            {
+                case Parameter parameter:
+                    Emitter.Emit(
+                        ArgumentOperation.Load,
+                        parameter.Index + NumHiddenArguments);
+                    break;
+                case PrimitiveValue primitiveValue:
+                    EmitPrimitiveValue(primitiveValue);
+                    break;
+                case StringValue stringValue:
+                    Emitter.EmitConstant(stringValue.String);
+                    break;
+                default:
+                    // Note that null and undefined values are never assigned and
+                    // remain zero-initialized
+                    Emitter.Emit(LocalOperation.Load, GetLocal(value));
+                    break;
+            }
+        }
+
+        /// <summary>
+        /// Returns a temporary local to access components of 3D context indices.
+        /// </summary>
+        private ILLocal GetTempIndexLocal()
+        {
+            if (!tempIndexLocal.HasValue)
+                tempIndexLocal = Emitter.DeclareLocal(typeof(Index3D));
+            return tempIndexLocal.Value;
+        }
+
+        /// <summary>
+        /// Loads the given value onto the evaluation stack and extends small integers
+        /// according to the given signedness.
+        /// </summary>
+        /// <param name="value">The value to load.</param>
+        /// <param name="isUnsigned">
+        /// True, if the value is interpreted as unsigned.
+        /// </param>
+        private void Load(Value value, bool isUnsigned)
+        {
+            Load(value);
+            switch (value.BasicValueType)
+            {
+                case BasicValueType.Int8:
+                    Emitter.Emit(isUnsigned ? OpCodes.Conv_U1 : OpCodes.Conv_I1);
+                    break;
+                case BasicValueType.Int16:
+                    Emitter.Emit(isUnsigned ? OpCodes.Conv_U2 : OpCodes.Conv_I2);
+                    break;
+            }
+        }
+
+        /// <summary>
+        /// Loads the address of the local variable that holds the given value.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        private void LoadAddress(Value value) =>
+            Emitter.Emit(LocalOperation.LoadAddress, GetLocal(value));
+
+        /// <summary>
+        /// Stores the top of the evaluation stack into the local of the given value.
+        /// </summary>
+        /// <param name="value">The value to bind.</param>
+        private void Store(Value value) =>
+            Emitter.Emit(LocalOperation.Store, GetLocal(value));
+
+        /// <summary>
+        /// Emits code to allocate all local and shared memory allocations.
+        /// </summary>
+        private void SetupAllocations()
+        {
+            foreach (var allocaInfo in Allocas.LocalAllocations)
+            {
+                Emitter.EmitConstant(allocaInfo.TotalSize);
+                Emitter.Emit(OpCodes.Conv_U);
+                Emitter.Emit(OpCodes.Localloc);
+                Store(allocaInfo.Alloca);
+            }
+
+            // Shared memory is requested in the same order by all group threads
+            foreach (var allocaInfo in Allocas.SharedAllocations)
+            {
+                var elementType = TypeGenerator[allocaInfo.ElementType];
+                Emitter.EmitConstant(allocaInfo.ArraySize);
+                Emitter.EmitCall(
+                    AllocateSharedMemoryMethod.MakeGenericMethod(elementType));
+                StoreViewPointer(allocaInfo.Alloca, elementType);
+            }
+            foreach (var allocaInfo in Allocas.DynamicSharedAllocations)
+            {
+                var elementType = TypeGenerator[allocaInfo.ElementType];
+                Emitter.EmitCall(
+                    GetDynamicSharedMemoryMethod.MakeGenericMethod(elementType));
+                StoreViewPointer(allocaInfo.Alloca, elementType);
+            }
+        }
+
+        /// <summary>
+        /// Converts the array view on top of the evaluation stack into its native
+        /// pointer and binds the pointer to the given allocation.
+        /// </summary>
+        /// <param name="alloca">The allocation.</param>
+        /// <param name="elementType">The managed element type.</param>
+        private void StoreViewPointer(Alloca alloca, Type elementType)
+        {
+            var implementationType = ViewImplementation.GetImplementationType(
+                elementType);
+            Emitter.EmitNewObject(
+                ViewImplementation.GetViewConstructor(implementationType));
+            Emitter.Emit(
+                OpCodes.Ldfld,
+                ViewImplementation.GetPtrField(implementationType));
+            Store(alloca);
+        }
+
+        /// <summary>
+        /// Generates code for all basic blocks.
+        /// </summary>
+        private void GenerateCode()
+        {
+            SetupAllocations();
+
+            // Build branch targets
+            var blocks = Method.Blocks;
+            foreach (var block in blocks)
+                blockLookup.Add(block, Emitter.DeclareLabel());
+
+            // Find all phi nodes and setup the internal mapping
+            var phiBindings = PhiBindings.Create(blocks, new PhiBindingAllocator());
+            var intermediatePhis = new Dictionary<Value, ILLocal>(
+                phiBindings.MaxNumIntermediatePhis);
+
+            foreach (var block in blocks)
+            {
+                Emitter.MarkLabel(blockLookup[block]);
+
+                foreach (var value in block)
+                {
+                    // Custom intrinsic implementations are not supported
+                    if (Backend.IntrinsicProvider.TryGetCodeGenerator(value, out var _))
+                        throw GetNotSupportedException(value);
+                    this.GenerateCodeFor(value);
+                }
+
+                // Wire phi nodes
+                if (phiBindings.TryGetBindings(block, out var bindings))
+                {
+                    intermediatePhis.Clear();
+                    foreach (var (phiValue, value) in bindings)
+                    {
+                        // Move intermediate phi values into temporaries for reuse
+                        if (bindings.IsIntermediate(phiValue))
+                        {
+                            var intermediateLocal = Emitter.DeclareLocal(
+                                TypeGenerator[phiValue.Type]);
+                            Load(phiValue);
+                            Emitter.Emit(LocalOperation.Store, intermediateLocal);
+                            intermediatePhis.Add(phiValue, intermediateLocal);
+                        }
+
+                        if (intermediatePhis.TryGetValue(value, out var sourceLocal))
+                            Emitter.Emit(LocalOperation.Load, sourceLocal);
+                        else
+                            Load(value);
+                        Store(phiValue);
+                    }
+                }
+
+                this.GenerateCodeFor(block.Terminator);
+            }
+
+            Emitter.Finish();
+        }
+
+        /// <summary>
+        /// Emits a branch to the given block.
+        /// </summary>
+        /// <param name="target">The target block.</param>
+        private void EmitBranch(BasicBlock target) =>
+            Emitter.Emit(OpCodes.Br, blockLookup[target]);
+
+        #endregion
+    }
+}
@@ -30,6 +30,15 @@ namespace ILGPU.Backends.IL
         /// <param name="context">The associated context.</param>
         /// <param name="entryPoint">The entry point.</param>
         /// <param name="kernelMethod">The main kernel method.</param>
+        /// <param name="rangeKernelMethod">
+        /// The optional kernel method that processes a range of indices.
+        /// </param>
+        /// <param name="staticSharedMemorySize">
+        /// The size in bytes of all static shared-memory allocations.
+        /// </param>
+        /// <param name="codeSize">
+        /// The size in bytes of the IL code of all kernel methods.
+        /// </param>
         /// <param name="taskType">The custom task type.</param>
         /// <param name="taskConstructor">The custom task constructor.</param>
         /// <param name="taskArgumentMapping">
@@ -39,6 +48,9 @@ namespace ILGPU.Backends.IL
             Context context,
             EntryPoint entryPoint,
             MethodInfo kernelMethod,
+            MethodInfo rangeKernelMethod,
+            int staticSharedMemorySize,
+            int codeSize,
             Type taskType,
             ConstructorInfo taskConstructor,
             ImmutableArray<FieldInfo> taskArgumentMapping)
@@ -47,6 +59,11 @@ namespace ILGPU.Backends.IL
             KernelMethod = kernelMethod;
             ExecutionHandler = (CPUKernelExecutionHandler)KernelMethod.CreateDelegate(
                 typeof(CPUKernelExecutionHandler));
+            RangeExecutionHandler = rangeKernelMethod?.CreateDelegate(
+                typeof(CPUKernelRangeExecutionHandler))
+                as CPUKernelRangeExecutionHandler;
+            StaticSharedMemorySize = staticSharedMemorySize;
+            ILCodeSize = codeSize;
             TaskType = taskType;
             TaskConstructor = taskConstructor;
             TaskArgumentMapping = taskArgumentMapping;
@@ -66,6 +83,25 @@ namespace ILGPU.Backends.IL
         /// </summary>
         public CPUKernelExecutionHandler ExecutionHandler { get; }
 
+        /// <summary>
+        /// Returns a CPU-runtime compatible range-execution handler (if any).
+        /// </summary>
+        public CPUKernelRangeExecutionHandler RangeExecutionHandler { get; }
+
+        /// <summary>
+        /// Returns the size in bytes of all static shared-memory allocations
+        /// including the padding that is required to align each allocation.
+        /// </summary>
+        public int StaticSharedMemorySize { get; }
+
+        /// <summary>
+        /// Returns the size in bytes of the IL code of all kernel methods.
+        /// </summary>
+        private int ILCodeSize { get; }
+
+        /// <summary cref="CompiledKernel.CodeSize"/>
+        public override long CodeSize => ILCodeSize;
+
         /// <summary>
         /// Returns the custom task type to dispatch the kernel.
         /// </summary>
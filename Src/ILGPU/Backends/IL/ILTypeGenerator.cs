@@ -0,0 +1,159 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: ILTypeGenerator.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.IR.Types;
+using ILGPU.Resources;
+using ILGPU.Util;
+using System;
+using System.Collections.Generic;
+using System.Collections.Immutable;
+using System.Reflection;
+
+namespace ILGPU.Backends.IL
+{
+    /// <summary>
+    /// Maps IR types to managed types that can be used in dynamic methods.
+    /// </summary>
+    /// <remarks>
+    /// Structure types are mapped to flat structures with an explicit layout that
+    /// matches the field offsets of the IR type. Pointers are mapped to untyped
+    /// pointers. Members of this class are not thread safe.
+    /// </remarks>
+    internal sealed class ILTypeGenerator
+    {
+        #region Constants
+
+        /// <summary>
+        /// The name format of all structure fields.
+        /// </summary>
+        private const string FieldNameFormat = "Field{0}";
+
+        #endregion
+
+        #region Instance
+
+        /// <summary>
+        /// Maps IR types to managed types.
+        /// </summary>
+        private readonly Dictionary<TypeNode, Type> typeMapping =
+            new Dictionary<TypeNode, Type>();
+
+        /// <summary>
+        /// Maps structure types to the fields of their managed types.
+        /// </summary>
+        private readonly Dictionary<StructureType, ImmutableArray<FieldInfo>>
+            fieldMapping = new Dictionary<StructureType, ImmutableArray<FieldInfo>>();
+
+        /// <summary>
+        /// Constructs a new type generator.
+        /// </summary>
+        /// <param name="runtimeSystem">The parent runtime system.</param>
+        public ILTypeGenerator(RuntimeSystem runtimeSystem)
+        {
+            RuntimeSystem = runtimeSystem;
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Returns the parent runtime system.
+        /// </summary>
+        public RuntimeSystem RuntimeSystem { get; }
+
+        /// <summary>
+        /// Returns the managed type that corresponds to the given IR type.
+        /// </summary>
+        /// <param name="type">The IR type.</param>
+        /// <returns>The corresponding managed type.</returns>
+        public Type this[TypeNode type] => GetManagedType(type);
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Returns the managed type that corresponds to the given IR type.
+        /// </summary>
+        /// <param name="type">The IR type.</param>
+        /// <returns>The corresponding managed type.</returns>
+        public Type GetManagedType(TypeNode type)
+        {
+            if (typeMapping.TryGetValue(type, out var managedType))
+                return managedType;
+
+            managedType = type switch
+            {
+                VoidType _ => typeof(void),
+                PrimitiveType primitiveType =>
+                    primitiveType.BasicValueType.GetManagedType(),
+                PaddingType paddingType =>
+                    paddingType.BasicValueType.GetManagedType(),
+                StringType _ => typeof(string),
+                PointerType _ => typeof(void*),
+                StructureType structureType => CreateStructureType(structureType),
+                _ => throw new NotSupportedException(string.Format(
+                    ErrorMessages.NotSupportedType,
+                    type)),
+            };
+            typeMapping.Add(type, managedType);
+            return managedType;
+        }
+
+        /// <summary>
+        /// Returns the managed field that corresponds to the given field index.
+        /// </summary>
+        /// <param name="structureType">The parent structure type.</param>
+        /// <param name="fieldIndex">The (flat) field index.</param>
+        /// <returns>The managed field.</returns>
+        public FieldInfo GetField(StructureType structureType, int fieldIndex)
+        {
+            GetManagedType(structureType);
+            return fieldMapping[structureType][fieldIndex];
+        }
+
+        /// <summary>
+        /// Creates a flat managed structure with an explicit layout.
+        /// </summary>
+        private Type CreateStructureType(StructureType structureType)
+        {
+            // Resolve all field types first, since this can create nested types
+            var fieldTypes = new Type[structureType.NumFields];
+            for (int i = 0, e = fieldTypes.Length; i < e; ++i)
+                fieldTypes[i] = GetManagedType(structureType.Fields[i]);
+
+            Type managedType;
+            using (var scopedLock = RuntimeSystem.DefineRuntimeStruct(
+                true,
+                out var typeBuilder))
+            {
+                for (int i = 0, e = fieldTypes.Length; i < e; ++i)
+                {
+                    var field = typeBuilder.DefineField(
+                        string.Format(FieldNameFormat, i),
+                        fieldTypes[i],
+                        FieldAttributes.Public);
+                    field.SetOffset(structureType.GetOffset(i));
+                }
+                managedType = typeBuilder.CreateType();
+            }
+
+            var fields = ImmutableArray.CreateBuilder<FieldInfo>(fieldTypes.Length);
+            for (int i = 0, e = fieldTypes.Length; i < e; ++i)
+                fields.Add(managedType.GetField(string.Format(FieldNameFormat, i)));
+            fieldMapping.Add(structureType, fields.MoveToImmutable());
+            return managedType;
+        }
+
+        #endregion
+    }
+}
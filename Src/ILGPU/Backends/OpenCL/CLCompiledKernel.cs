@@ -49,6 +49,9 @@ namespace ILGPU.Backends.OpenCL
         /// </summary>
         public string Source { get; }
 
+        /// <summary cref="CompiledKernel.CodeSize"/>
+        public override long CodeSize => Source.Length;
+
         /// <summary>
         /// Returns the used OpenCL C version.
         /// </summary>
@@ -13,6 +13,7 @@ using ILGPU.AtomicOperations;
 using ILGPU.IR.Intrinsics;
 using ILGPU.IR.Values;
 using System;
+using System.Reflection;
 using System.Runtime.CompilerServices;
 
 namespace ILGPU.Backends.OpenCL
@@ -69,8 +70,63 @@ namespace ILGPU.Backends.OpenCL
                 CreateIntrinsic(
                     nameof(BarrierPopCount),
                     IntrinsicImplementationMode.Redirect));
+
+            // Half2
+            RegisterHalf2(manager, "op_Addition", "AddLanes");
+            RegisterHalf2(manager, "op_Subtraction", "SubLanes");
+            RegisterHalf2(manager, "op_Multiply", "MulLanes");
+            RegisterHalf2(manager, nameof(Half2.Fma), "FmaLanes");
+
+            // Dot products
+            RegisterDotProduct(
+                manager,
+                typeof(int),
+                nameof(IntrinsicMath.Dot4S32Lanes));
+            RegisterDotProduct(
+                manager,
+                typeof(uint),
+                nameof(IntrinsicMath.Dot4U32Lanes));
         }
 
+        /// <summary>
+        /// Registers a packed <see cref="Half2"/> operation that processes both lanes
+        /// separately.
+        /// </summary>
+        /// <param name="manager">The target implementation manager.</param>
+        /// <param name="operationName">The name of the Half2 operation.</param>
+        /// <param name="lanesName">The name of the lane-wise implementation.</param>
+        private static void RegisterHalf2(
+            IntrinsicImplementationManager manager,
+            string operationName,
+            string lanesName) =>
+            manager.RegisterMethod(
+                typeof(Half2).GetMethod(
+                    operationName,
+                    BindingFlags.Public | BindingFlags.Static),
+                new CLIntrinsic(
+                    typeof(Half2),
+                    lanesName,
+                    IntrinsicImplementationMode.Redirect));
+
+        /// <summary>
+        /// Registers a packed dot product that uses a scalar emulation.
+        /// </summary>
+        /// <param name="manager">The target implementation manager.</param>
+        /// <param name="type">The element type of the dot product.</param>
+        /// <param name="lanesName">The name of the scalar implementation.</param>
+        private static void RegisterDotProduct(
+            IntrinsicImplementationManager manager,
+            Type type,
+            string lanesName) =>
+            manager.RegisterMethod(
+                typeof(IntrinsicMath).GetMethod(
+                    nameof(IntrinsicMath.Dot4),
+                    new Type[] { type, type, type }),
+                new CLIntrinsic(
+                    typeof(IntrinsicMath),
+                    lanesName,
+                    IntrinsicImplementationMode.Redirect));
+
         #endregion
 
         #region Atomics
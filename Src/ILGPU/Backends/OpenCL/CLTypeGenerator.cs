@@ -73,7 +73,8 @@ namespace ILGPU.Backends.OpenCL
                 "long",
                 "half",
                 "float",
-                "double");
+                "double",
+                "ushort");
 
         /// <summary>
         /// Maps arithmetic-basic value types to OpenCL language types.
@@ -92,7 +93,8 @@ namespace ILGPU.Backends.OpenCL
                 "uchar",
                 "ushort",
                 "uint",
-                "ulong");
+                "ulong",
+                "ushort");
 
         /// <summary>
         /// Maps arithmetic-basic value types to atomic OpenCL language types.
@@ -111,7 +113,8 @@ namespace ILGPU.Backends.OpenCL
                 null,
                 null,
                 "atomic_uint",
-                "atomic_ulong");
+                "atomic_ulong",
+                null);
 
         /// <summary>
         /// Resolves the given basic-value type to an OpenCL type name.
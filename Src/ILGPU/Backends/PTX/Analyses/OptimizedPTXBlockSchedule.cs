@@ -41,17 +41,24 @@ namespace ILGPU.Backends.PTX.Analyses
             /// <summary>
             /// Returns all successors in the default order except for
             /// <see cref="IfBranch"/> terminators. The successors of these terminators
-            /// will be reversed to invert all if branch targets.
+            /// will be reversed to invert all if branch targets. Likely branch targets
+            /// are always placed first to become implicit successors.
             /// </summary>
             [MethodImpl(MethodImplOptions.AggressiveInlining)]
             public readonly ReadOnlySpan<BasicBlock> GetSuccessors(BasicBlock basicBlock)
             {
                 var successors = basicBlock.Successors;
-                if (basicBlock.Terminator is IfBranch ifBranch && ifBranch.IsInverted)
+                if (basicBlock.Terminator is IfBranch ifBranch &&
+                    successors.Length == 2)
                 {
-                    var tempList = successors.ToInlineList();
-                    tempList.Reverse();
-                    successors = tempList;
+                    var (trueTarget, _) = ifBranch.NotInvertedBranchTargets;
+                    var firstTarget = ifBranch.LikelyTarget ?? trueTarget;
+                    if (successors[0] != firstTarget)
+                    {
+                        var tempList = successors.ToInlineList();
+                        tempList.Reverse();
+                        successors = tempList;
+                    }
                 }
                 return successors;
             }
@@ -149,17 +156,24 @@ namespace ILGPU.Backends.PTX.Analyses
             /// <summary>
             /// Returns all successors in the default order except for
             /// <see cref="IfBranch"/> terminators. The successors of these terminators
-            /// will be reversed to invert all if branch targets.
+            /// will be reversed to invert all if branch targets. Likely branch targets
+            /// are always placed first to become implicit successors.
             /// </summary>
             [MethodImpl(MethodImplOptions.AggressiveInlining)]
             public readonly ReadOnlySpan<BasicBlock> GetSuccessors(BasicBlock basicBlock)
             {
                 var successors = basicBlock.Successors;
-                if (basicBlock.Terminator is IfBranch ifBranch && ifBranch.IsInverted)
+                if (basicBlock.Terminator is IfBranch ifBranch &&
+                    successors.Length == 2)
                 {
-                    var tempList = successors.ToInlineList();
-                    tempList.Reverse();
-                    successors = tempList;
+                    var (trueTarget, _) = ifBranch.NotInvertedBranchTargets;
+                    var firstTarget = ifBranch.LikelyTarget ?? trueTarget;
+                    if (successors[0] != firstTarget)
+                    {
+                        var tempList = successors.ToInlineList();
+                        tempList.Reverse();
+                        successors = tempList;
+                    }
                 }
                 return successors;
             }
@@ -180,7 +194,8 @@ namespace ILGPU.Backends.PTX.Analyses
             this BasicBlockCollection<TOrder, TDirection> blocks)
             where TOrder : struct, ITraversalOrder
             where TDirection : struct, IControlFlowDirection =>
-            CreateSchedule(blocks.ChangeOrder<PreOrder, Forwards>());
+            CreateSchedule(
+                blocks.Traverse<PreOrder, Forwards, SuccessorProvider>(default));
 
         /// <summary>
         /// Creates a schedule from an already existing schedule.
@@ -72,9 +72,11 @@ namespace ILGPU.Backends.PTX
                     command.AppendLabel(targetLabel);
                 }
 
-                // Jump to false target in the else case
-                using (var command = BeginCommand(PTXInstructions.BranchOperation))
+                // Jump to false target in the else case unless it is placed next,
+                // which is the case for likely false targets
+                if (!Schedule.IsImplicitSuccessor(branch.BasicBlock, falseTarget))
                 {
+                    using var command = BeginCommand(PTXInstructions.BranchOperation);
                     var targetLabel = blockLookup[falseTarget];
                     command.AppendLabel(targetLabel);
                 }
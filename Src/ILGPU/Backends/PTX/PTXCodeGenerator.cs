@@ -229,7 +229,7 @@ namespace ILGPU.Backends.PTX
             ImmutableArray.Create(
                 default, "pred",
                 "b8", "b16", "b32", "b64",
-                "f16", "f32", "f64");
+                "f16", "f32", "f64", "b16");
 
         /// <summary>
         /// Maps basic types to constant-loading target basic types.
@@ -240,7 +240,8 @@ namespace ILGPU.Backends.PTX
                 default, BasicValueType.Int1,
                 BasicValueType.Int16, BasicValueType.Int16,
                 BasicValueType.Int32, BasicValueType.Int64,
-                BasicValueType.Int16, BasicValueType.Float32, BasicValueType.Float64);
+                BasicValueType.Int16, BasicValueType.Float32, BasicValueType.Float64,
+                BasicValueType.Int16);
 
         /// <summary>
         /// Maps basic types to constant-loading target basic types.
@@ -251,7 +252,8 @@ namespace ILGPU.Backends.PTX
                 default, BasicValueType.Int8,
                 BasicValueType.Int8, BasicValueType.Int16,
                 BasicValueType.Int32, BasicValueType.Int64,
-                BasicValueType.Int16, BasicValueType.Float32, BasicValueType.Float64);
+                BasicValueType.Int16, BasicValueType.Float32, BasicValueType.Float64,
+                BasicValueType.Int16);
 
         /// <summary>
         /// Resolves the PTX suffix for the given basic value type.
@@ -46,6 +46,9 @@ namespace ILGPU.Backends.PTX
         /// </summary>
         public string PTXAssembly { get; }
 
+        /// <summary cref="CompiledKernel.CodeSize"/>
+        public override long CodeSize => PTXAssembly.Length;
+
         #endregion
     }
 }
@@ -14,6 +14,7 @@ using ILGPU.IR.Intrinsics;
 using ILGPU.IR.Values;
 using ILGPU.Runtime.Cuda;
 using System;
+using System.Reflection;
 using System.Runtime.CompilerServices;
 
 namespace ILGPU.Backends.PTX
@@ -95,6 +96,8 @@ namespace ILGPU.Backends.PTX
             RegisterWarpShuffles(manager);
             RegisterFP16(manager);
             RegisterBitFunctions(manager);
+            RegisterHalf2(manager);
+            RegisterDotProducts(manager);
         }
 
         #endregion
@@ -222,5 +225,202 @@ namespace ILGPU.Backends.PTX
             IntrinsicMath.BitOperations.TrailingZeroCount(value);
 
         #endregion
+
+        #region Half2
+
+        /// <summary>
+        /// Registers all packed <see cref="Half2"/> intrinsics with the given manager.
+        /// </summary>
+        /// <param name="manager">The target implementation manager.</param>
+        private static void RegisterHalf2(IntrinsicImplementationManager manager)
+        {
+            RegisterHalf2(manager, "op_Addition", nameof(AddHalf2), "AddLanes");
+            RegisterHalf2(manager, "op_Subtraction", nameof(SubHalf2), "SubLanes");
+            RegisterHalf2(manager, "op_Multiply", nameof(MulHalf2), "MulLanes");
+            RegisterHalf2(manager, nameof(Half2.Fma), nameof(FmaHalf2), "FmaLanes");
+        }
+
+        /// <summary>
+        /// Registers a packed <see cref="Half2"/> operation that uses <c>f16x2</c>
+        /// instructions on sm_53 and higher and processes both lanes separately on
+        /// older architectures.
+        /// </summary>
+        /// <param name="manager">The target implementation manager.</param>
+        /// <param name="operationName">The name of the Half2 operation.</param>
+        /// <param name="packedName">The name of the packed implementation.</param>
+        /// <param name="lanesName">The name of the lane-wise implementation.</param>
+        private static void RegisterHalf2(
+            IntrinsicImplementationManager manager,
+            string operationName,
+            string packedName,
+            string lanesName)
+        {
+            var operation = typeof(Half2).GetMethod(
+                operationName,
+                BindingFlags.Public | BindingFlags.Static);
+            manager.RegisterMethod(
+                operation,
+                new PTXIntrinsic(
+                    PTXIntrinsicsType,
+                    packedName,
+                    IntrinsicImplementationMode.Redirect,
+                    CudaArchitecture.SM_53));
+            manager.RegisterMethod(
+                operation,
+                new PTXIntrinsic(
+                    typeof(Half2),
+                    lanesName,
+                    IntrinsicImplementationMode.Redirect,
+                    null,
+                    CudaArchitecture.SM_53));
+        }
+
+        /// <summary>
+        /// Adds two packed values using a single <c>f16x2</c> instruction.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static Half2 AddHalf2(Half2 first, Half2 second)
+        {
+            CudaAsm.Emit(
+                "add.rn.f16x2 %0, %1, %2;",
+                out uint result,
+                first.RawValue,
+                second.RawValue);
+            return new Half2(result);
+        }
+
+        /// <summary>
+        /// Subtracts two packed values using a single <c>f16x2</c> instruction.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static Half2 SubHalf2(Half2 first, Half2 second)
+        {
+            CudaAsm.Emit(
+                "sub.rn.f16x2 %0, %1, %2;",
+                out uint result,
+                first.RawValue,
+                second.RawValue);
+            return new Half2(result);
+        }
+
+        /// <summary>
+        /// Multiplies two packed values using a single <c>f16x2</c> instruction.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static Half2 MulHalf2(Half2 first, Half2 second)
+        {
+            CudaAsm.Emit(
+                "mul.rn.f16x2 %0, %1, %2;",
+                out uint result,
+                first.RawValue,
+                second.RawValue);
+            return new Half2(result);
+        }
+
+        /// <summary>
+        /// Computes a packed fused multiply-add using a single <c>f16x2</c>
+        /// instruction.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static Half2 FmaHalf2(Half2 first, Half2 second, Half2 third)
+        {
+            CudaAsm.Emit(
+                "fma.rn.f16x2 %0, %1, %2, %3;",
+                out uint result,
+                first.RawValue,
+                second.RawValue,
+                third.RawValue);
+            return new Half2(result);
+        }
+
+        #endregion
+
+        #region Dot Products
+
+        /// <summary>
+        /// Registers all packed dot-product intrinsics with the given manager.
+        /// </summary>
+        /// <param name="manager">The target implementation manager.</param>
+        private static void RegisterDotProducts(IntrinsicImplementationManager manager)
+        {
+            RegisterDotProduct(
+                manager,
+                typeof(int),
+                nameof(Dot4S32),
+                nameof(IntrinsicMath.Dot4S32Lanes));
+            RegisterDotProduct(
+                manager,
+                typeof(uint),
+                nameof(Dot4U32),
+                nameof(IntrinsicMath.Dot4U32Lanes));
+        }
+
+        /// <summary>
+        /// Registers a packed dot product that uses <c>dp4a</c> instructions on
+        /// sm_61 and higher and a scalar emulation on older architectures.
+        /// </summary>
+        /// <param name="manager">The target implementation manager.</param>
+        /// <param name="type">The element type of the dot product.</param>
+        /// <param name="packedName">The name of the packed implementation.</param>
+        /// <param name="lanesName">The name of the scalar implementation.</param>
+        private static void RegisterDotProduct(
+            IntrinsicImplementationManager manager,
+            Type type,
+            string packedName,
+            string lanesName)
+        {
+            var operation = typeof(IntrinsicMath).GetMethod(
+                nameof(IntrinsicMath.Dot4),
+                new Type[] { type, type, type });
+            manager.RegisterMethod(
+                operation,
+                new PTXIntrinsic(
+                    PTXIntrinsicsType,
+                    packedName,
+                    IntrinsicImplementationMode.Redirect,
+                    CudaArchitecture.SM_61));
+            manager.RegisterMethod(
+                operation,
+                new PTXIntrinsic(
+                    typeof(IntrinsicMath),
+                    lanesName,
+                    IntrinsicImplementationMode.Redirect,
+                    null,
+                    CudaArchitecture.SM_61));
+        }
+
+        /// <summary>
+        /// Computes a signed packed dot product using a single <c>dp4a</c>
+        /// instruction.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static int Dot4S32(int first, int second, int accumulator)
+        {
+            CudaAsm.Emit(
+                "dp4a.s32.s32 %0, %1, %2, %3;",
+                out int result,
+                first,
+                second,
+                accumulator);
+            return result;
+        }
+
+        /// <summary>
+        /// Computes an unsigned packed dot product using a single <c>dp4a</c>
+        /// instruction.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static uint Dot4U32(uint first, uint second, uint accumulator)
+        {
+            CudaAsm.Emit(
+                "dp4a.u32.u32 %0, %1, %2, %3;",
+                out uint result,
+                first,
+                second,
+                accumulator);
+            return result;
+        }
+
+        #endregion
     }
 }
@@ -103,7 +103,8 @@ namespace ILGPU.Backends.PTX
                 default, PTXRegisterKind.Predicate,
                 PTXRegisterKind.Int16, PTXRegisterKind.Int16,
                 PTXRegisterKind.Int32, PTXRegisterKind.Int64,
-                PTXRegisterKind.Int16, PTXRegisterKind.Float32, PTXRegisterKind.Float64);
+                PTXRegisterKind.Int16, PTXRegisterKind.Float32, PTXRegisterKind.Float64,
+                PTXRegisterKind.Int16);
 
         /// <summary>
         /// Maps basic value types to their PTX-specific parameter-type counterparts.
@@ -113,7 +114,8 @@ namespace ILGPU.Backends.PTX
                 default, BasicValueType.Int32,
                 BasicValueType.Int8, BasicValueType.Int16,
                 BasicValueType.Int32, BasicValueType.Int64,
-                BasicValueType.Int16, BasicValueType.Float32, BasicValueType.Float64);
+                BasicValueType.Int16, BasicValueType.Float32, BasicValueType.Float64,
+                BasicValueType.Int16);
 
         /// <summary>
         /// Declares all register kinds for which register declarations have to be
@@ -0,0 +1,65 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: RemoteBackend.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.Backends.EntryPoints;
+using ILGPU.IR;
+using ILGPU.Runtime;
+using ILGPU.Runtime.Remote;
+using System.IO;
+
+namespace ILGPU.Backends.Remote
+{
+    /// <summary>
+    /// Represents a backend that serializes kernels for remote workers.
+    /// </summary>
+    /// <remarks>
+    /// This backend does not generate any target code. Instead, it stores the
+    /// optimized IR of each kernel that is sent to a <see cref="RemoteWorker"/>,
+    /// which performs the actual code generation using the backend of its local
+    /// accelerator.
+    /// </remarks>
+    public sealed class RemoteBackend : Backend
+    {
+        #region Instance
+
+        /// <summary>
+        /// Constructs a new remote backend.
+        /// </summary>
+        /// <param name="context">The context to use.</param>
+        /// <param name="capabilities">The capabilities of the remote device.</param>
+        public RemoteBackend(Context context, RemoteCapabilityContext capabilities)
+            : base(context, capabilities, BackendType.Remote, null)
+        { }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Serializes the given kernel into a <see cref="RemoteCompiledKernel"/>.
+        /// </summary>
+        protected override CompiledKernel Compile(
+            EntryPoint entryPoint,
+            in BackendContext backendContext,
+            in KernelSpecialization specialization)
+        {
+            using var stream = new MemoryStream();
+            IRSerializer.Serialize(stream, backendContext.KernelMethod);
+            return new RemoteCompiledKernel(
+                Context,
+                entryPoint,
+                backendContext.KernelInfo,
+                stream.ToArray());
+        }
+
+        #endregion
+    }
+}
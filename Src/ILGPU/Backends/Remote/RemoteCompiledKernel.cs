@@ -0,0 +1,76 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: RemoteCompiledKernel.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.Backends.EntryPoints;
+using ILGPU.IR;
+using System.Collections.Immutable;
+using System.IO;
+
+namespace ILGPU.Backends.Remote
+{
+    /// <summary>
+    /// Represents a kernel in serialized IR form that is compiled by a remote worker.
+    /// </summary>
+    public sealed class RemoteCompiledKernel : CompiledKernel
+    {
+        #region Instance
+
+        private readonly byte[] irData;
+
+        /// <summary>
+        /// Constructs a new remote compiled kernel.
+        /// </summary>
+        /// <param name="context">The associated context.</param>
+        /// <param name="entryPoint">The entry point.</param>
+        /// <param name="info">Detailed kernel information.</param>
+        /// <param name="irData">
+        /// The kernel method serialized via <see cref="IRSerializer"/>.
+        /// </param>
+        public RemoteCompiledKernel(
+            Context context,
+            EntryPoint entryPoint,
+            KernelInfo info,
+            byte[] irData)
+            : base(context, entryPoint, info)
+        {
+            this.irData = irData;
+            IRData = ImmutableArray.Create(irData);
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Returns the serialized IR of the kernel method.
+        /// </summary>
+        public ImmutableArray<byte> IRData { get; }
+
+        /// <summary cref="CompiledKernel.CodeSize"/>
+        public override long CodeSize => IRData.Length;
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Writes the length-prefixed serialized IR.
+        /// </summary>
+        /// <param name="writer">The target writer.</param>
+        internal void WriteIR(BinaryWriter writer)
+        {
+            writer.Write(irData.Length);
+            writer.Write(irData);
+        }
+
+        #endregion
+    }
+}
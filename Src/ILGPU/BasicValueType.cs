@@ -60,6 +60,11 @@ namespace ILGPU
         /// Represents a 64-bit float.
         /// </summary>
         Float64,
+
+        /// <summary>
+        /// Represents a 16-bit brain float.
+        /// </summary>
+        BFloat16,
     }
 
     /// <summary>
@@ -131,5 +136,10 @@ namespace ILGPU
         /// Represents a 64-bit unsigned integer.
         /// </summary>
         UInt64,
+
+        /// <summary>
+        /// Represents a 16-bit brain float.
+        /// </summary>
+        BFloat16,
     }
 }
@@ -143,6 +143,18 @@ namespace ILGPU
                 return this;
             }
 
+            /// <summary>
+            /// Specifies whether the frontend generates code for different methods in
+            /// parallel using the shared .Net thread pool.
+            /// </summary>
+            /// <param name="enable">True, to enable parallel code generation.</param>
+            /// <returns>The current builder instance.</returns>
+            public Builder ParallelCodeGeneration(bool enable)
+            {
+                EnableParallelCodeGenerationInFrontend = enable;
+                return this;
+            }
+
             /// <summary>
             /// Enables fast generation of fast math methods using the math mode provided.
             /// </summary>
@@ -249,6 +261,119 @@ namespace ILGPU
                 return this;
             }
 
+            /// <summary>
+            /// Specifies the specialization mode.
+            /// </summary>
+            /// <param name="mode">The specialization mode to use.</param>
+            /// <returns>The current builder instance.</returns>
+            public Builder Specialization(SpecializationMode mode)
+            {
+                SpecializationMode = mode;
+                return this;
+            }
+
+            /// <summary>
+            /// Turns on <see cref="SpecializationMode.Tiered"/> specialization.
+            /// </summary>
+            /// <param name="threshold">
+            /// The number of launches with the same specialization values after which
+            /// a specialized kernel is compiled in the background.
+            /// </param>
+            /// <param name="maxNumSpecializations">
+            /// The maximum number of specialization values tracked per kernel.
+            /// </param>
+            /// <returns>The current builder instance.</returns>
+            public Builder TieredSpecialization(
+                int threshold,
+                int maxNumSpecializations)
+            {
+                if (threshold < 1)
+                    throw new ArgumentOutOfRangeException(nameof(threshold));
+                SpecializationThreshold = threshold;
+                return Specialization(SpecializationMode.Tiered).
+                    SpecializationCacheLimit(maxNumSpecializations);
+            }
+
+            /// <summary>
+            /// Specifies the maximum number of specialization values per kernel that
+            /// are cached.
+            /// </summary>
+            /// <param name="maxNumSpecializations">
+            /// The maximum number of cached specialization values per kernel.
+            /// </param>
+            /// <returns>The current builder instance.</returns>
+            public Builder SpecializationCacheLimit(int maxNumSpecializations)
+            {
+                if (maxNumSpecializations < 1)
+                {
+                    throw new ArgumentOutOfRangeException(
+                        nameof(maxNumSpecializations));
+                }
+                MaxNumSpecializations = maxNumSpecializations;
+                return this;
+            }
+
+            /// <summary>
+            /// Specifies the limits of all kernel caches of an accelerator.
+            /// </summary>
+            /// <param name="maxNumKernels">
+            /// The maximum number of kernels in each cache.
+            /// </param>
+            /// <param name="maxSize">
+            /// The maximum accumulated code size of each cache in bytes.
+            /// </param>
+            /// <returns>The current builder instance.</returns>
+            public Builder KernelCacheLimits(int maxNumKernels, long maxSize)
+            {
+                if (maxNumKernels < 1)
+                    throw new ArgumentOutOfRangeException(nameof(maxNumKernels));
+                if (maxSize < 0)
+                    throw new ArgumentOutOfRangeException(nameof(maxSize));
+                MaxNumCachedKernels = maxNumKernels;
+                MaxKernelCacheSize = maxSize;
+                return this;
+            }
+
+            /// <summary>
+            /// Instruments all kernels that are launched on a CPU accelerator to
+            /// record the execution counts of their conditional branches.
+            /// </summary>
+            /// <param name="profile">The profile to record the counts in.</param>
+            /// <returns>The current builder instance.</returns>
+            /// <remarks>
+            /// Instrumented kernels are significantly slower and should only be
+            /// used to collect profiles using representative inputs.
+            /// </remarks>
+            public Builder InstrumentKernels(KernelProfile profile)
+            {
+                InstrumentationProfile = profile ??
+                    throw new ArgumentNullException(nameof(profile));
+                return this;
+            }
+
+            /// <summary>
+            /// Uses the given profile to guide the optimization of all kernels.
+            /// </summary>
+            /// <param name="profile">The recorded kernel profile.</param>
+            /// <returns>The current builder instance.</returns>
+            public Builder ProfileGuidedOptimization(KernelProfile profile)
+            {
+                OptimizationProfile = profile ??
+                    throw new ArgumentNullException(nameof(profile));
+                return this;
+            }
+
+            /// <summary>
+            /// Specifies how kernels are executed on CPU accelerators.
+            /// </summary>
+            /// <param name="kernelMode">The CPU kernel mode to use.</param>
+            /// <returns>The current builder instance.</returns>
+            public Builder CPUKernels(CPUKernelMode kernelMode)
+            {
+                CPUKernelMode = kernelMode;
+                return this;
+            }
+
             /// <summary>
             /// Converts this builder instance into a context instance.
             /// </summary>
@@ -517,6 +517,8 @@ namespace ILGPU
             DefautltILBackend.ClearCache(mode);
             RuntimeSystem.ClearCache(mode);
 
+            ILFrontend.DisassemblyCache.ClearCache(mode);
+
             base.ClearCache(mode);
         }
 
@@ -1,4 +1,5 @@
-﻿using System.Collections.Generic;
+﻿using ILGPU.Runtime;
+using System.Collections.Generic;
 using System.Diagnostics;
 using System.Diagnostics.CodeAnalysis;
 
@@ -231,6 +232,58 @@ namespace ILGPU
         Disabled,
     }
 
+    /// <summary>
+    /// Specifies how kernels with <see cref="Runtime.SpecializedValue{T}"/> parameters
+    /// are compiled for new specialization values.
+    /// </summary>
+    public enum SpecializationMode
+    {
+        /// <summary>
+        /// A specialized kernel is compiled synchronously on the launching thread the
+        /// first time a new combination of specialization values is used.
+        /// </summary>
+        /// <remarks>
+        /// This is the default setting.
+        /// </remarks>
+        Default,
+
+        /// <summary>
+        /// Launches use a generic kernel in which all specialized parameters are
+        /// passed as ordinary arguments. Once a combination of specialization values
+        /// becomes hot, a specialized kernel is compiled in the background and used
+        /// by all subsequent launches.
+        /// </summary>
+        Tiered,
+    }
+
+    /// <summary>
+    /// Specifies how kernels are executed on CPU accelerators.
+    /// </summary>
+    public enum CPUKernelMode
+    {
+        /// <summary>
+        /// Kernels are executed using methods generated from their optimized IR.
+        /// Kernels that cannot be generated from their IR invoke their original
+        /// managed kernel methods instead.
+        /// </summary>
+        /// <remarks>
+        /// This is the default setting.
+        /// </remarks>
+        Default,
+
+        /// <summary>
+        /// All kernels invoke their original managed kernel methods.
+        /// </summary>
+        ManagedKernels,
+
+        /// <summary>
+        /// All kernels are executed using methods generated from their optimized IR.
+        /// Kernels that cannot be generated from their IR cause a
+        /// <see cref="System.NotSupportedException"/> during compilation.
+        /// </summary>
+        IRKernels,
+    }
+
     /// <summary>
     /// Internal flags to specificy the behavior of automatic page locking.
     /// </summary>
@@ -320,7 +373,11 @@ namespace ILGPU
         /// different methods in parallel.
         /// </summary>
         /// <remarks>Disabled by default.</remarks>
-        public bool EnableParallelCodeGenerationInFrontend { get; private set; }
+        public bool EnableParallelCodeGenerationInFrontend
+        {
+            get;
+            private protected set;
+        }
 
         /// <summary>
         /// The current optimization level to use.
@@ -375,6 +432,62 @@ namespace ILGPU
         /// <remarks>Disabled by default.</remarks>
         public bool EnableProfiling { get; protected set; }
 
+        /// <summary>
+        /// Defines how dynamically specialized kernels are compiled.
+        /// </summary>
+        /// <remarks><see cref="SpecializationMode.Default"/> by default.</remarks>
+        public SpecializationMode SpecializationMode { get; protected set; } =
+            SpecializationMode.Default;
+
+        /// <summary>
+        /// Returns the number of launches with the same specialization values after
+        /// which a specialized kernel is compiled in
+        /// <see cref="SpecializationMode.Tiered"/> mode.
+        /// </summary>
+        /// <remarks>2 by default.</remarks>
+        public int SpecializationThreshold { get; protected set; } = 2;
+
+        /// <summary>
+        /// Returns the maximum number of specialization values per kernel that are
+        /// cached. The least recently used values are evicted first.
+        /// </summary>
+        /// <remarks>64 by default.</remarks>
+        public int MaxNumSpecializations { get; protected set; } = 64;
+
+        /// <summary>
+        /// Returns the maximum number of entries in each kernel cache of an
+        /// accelerator. The least recently used kernels are evicted first.
+        /// </summary>
+        /// <remarks>1024 by default.</remarks>
+        public int MaxNumCachedKernels { get; protected set; } = 1024;
+
+        /// <summary>
+        /// Returns the maximum accumulated code size in bytes of each kernel cache of
+        /// an accelerator. The least recently used kernels are evicted first.
+        /// </summary>
+        /// <remarks>256 MB by default.</remarks>
+        public long MaxKernelCacheSize { get; protected set; } = 256L << 20;
+
+        /// <summary>
+        /// Returns the profile that records the branch counts of all kernels that
+        /// are launched on a CPU accelerator (if any).
+        /// </summary>
+        /// <remarks>Disabled by default.</remarks>
+        public KernelProfile InstrumentationProfile { get; protected set; }
+
+        /// <summary>
+        /// Returns the profile that guides the optimization of all kernels (if any).
+        /// </summary>
+        /// <remarks>Disabled by default.</remarks>
+        public KernelProfile OptimizationProfile { get; protected set; }
+
+        /// <summary>
+        /// Returns the current CPU kernel mode.
+        /// </summary>
+        /// <remarks><see cref="CPUKernelMode.Default"/> by default.</remarks>
+        public CPUKernelMode CPUKernelMode { get; protected set; } =
+            CPUKernelMode.Default;
+
         #endregion
 
         #region Methods
@@ -429,6 +542,14 @@ namespace ILGPU
                 CachingMode = CachingMode,
                 PageLockingMode = PageLockingMode,
                 EnableProfiling = EnableProfiling,
+                SpecializationMode = SpecializationMode,
+                SpecializationThreshold = SpecializationThreshold,
+                MaxNumSpecializations = MaxNumSpecializations,
+                MaxNumCachedKernels = MaxNumCachedKernels,
+                MaxKernelCacheSize = MaxKernelCacheSize,
+                InstrumentationProfile = InstrumentationProfile,
+                OptimizationProfile = OptimizationProfile,
+                CPUKernelMode = CPUKernelMode,
             };
 
         #endregion
@@ -243,6 +243,11 @@ namespace ILGPU.Frontend
         /// </summary>
         private Location Location { get; set; }
 
+        /// <summary>
+        /// Gets or sets the IL offset of the current instruction.
+        /// </summary>
+        private int InstructionOffset { get; set; }
+
         /// <summary>
         /// Gets or sets the offset for load/store argument instructions in a lambda.
         /// This is used to shift arguments because of the unused 'this' argument.
@@ -329,6 +334,7 @@ namespace ILGPU.Frontend
 
                 // Setup debug information
                 Location = instruction.Location;
+                InstructionOffset = instruction.Offset;
 
                 // Try to generate code for this instruction
                 bool generated;
@@ -44,6 +44,15 @@ namespace ILGPU.Frontend
             Builder.CreateBranch(Location, targets[0]);
         }
 
+        /// <summary>
+        /// Returns the profile-guided likelihood flags of the current branch.
+        /// </summary>
+        /// <returns>The likelihood flags of the current branch.</returns>
+        private IfBranchFlags GetBranchFlags() =>
+            Context.Properties.OptimizationProfile?.GetBranchFlags(
+                Method,
+                InstructionOffset) ?? IfBranchFlags.None;
+
         /// <summary>
         /// Realizes a conditional branch instruction.
         /// </summary>
@@ -60,7 +69,8 @@ namespace ILGPU.Frontend
                 Location,
                 condition,
                 targets[0],
-                targets[1]);
+                targets[1],
+                GetBranchFlags());
         }
 
         /// <summary>
@@ -86,7 +96,8 @@ namespace ILGPU.Frontend
                 Location,
                 condition,
                 targets[0],
-                targets[1]);
+                targets[1],
+                GetBranchFlags());
         }
 
         /// <summary>
@@ -28,7 +28,8 @@ namespace ILGPU.Frontend.DebugInformation
         #region Instance
 
         /// <summary>
-        /// The internal mapping of methods to cached debug information.
+        /// The internal mapping of methods to cached debug information (or null if
+        /// there is no debug information for a particular method).
         /// </summary>
         private readonly Dictionary<MethodBase, MethodDebugInformation>
             debugInformation =
@@ -66,25 +67,14 @@ namespace ILGPU.Frontend.DebugInformation
             Assembly = assembly;
             Modules = ImmutableArray.Create(assembly.GetModules());
 
+            // Note that the default stream options avoid prefetching the whole PDB
+            // file and rely on memory-mapped files for large PDB files. All method
+            // debug information is resolved lazily on demand.
             readerProvider = MetadataReaderProvider.FromPortablePdbStream(
                 pdbStream,
                 MetadataStreamOptions.Default);
             MetadataReader = readerProvider.GetMetadataReader();
-
-            foreach (var methodHandle in MetadataReader.MethodDebugInformation)
-            {
-                var definitionHandle = methodHandle.ToDefinitionHandle();
-                var metadataToken = MetadataTokens.GetToken(definitionHandle);
-                if (TryResolveMethod(metadataToken, out MethodBase method))
-                {
-                    debugInformation.Add(
-                        method,
-                        new MethodDebugInformation(
-                            this,
-                            method,
-                            definitionHandle));
-                }
-            }
+            NumMethodDebugInformationRows = MetadataReader.MethodDebugInformation.Count;
         }
 
         #endregion
@@ -111,6 +101,11 @@ namespace ILGPU.Frontend.DebugInformation
         /// </summary>
         private MetadataReader MetadataReader { get; }
 
+        /// <summary>
+        /// Returns the number of method debug-information rows.
+        /// </summary>
+        private int NumMethodDebugInformationRows { get; }
+
         #endregion
 
         #region Methods
@@ -163,9 +158,39 @@ namespace ILGPU.Frontend.DebugInformation
             {
                 methodBase = methodInfo.GetGenericMethodDefinition();
             }
-            return debugInformation.TryGetValue(
-                methodBase,
-                out methodDebugInformation);
+
+            lock (syncLock)
+            {
+                if (!debugInformation.TryGetValue(
+                    methodBase,
+                    out methodDebugInformation))
+                {
+                    methodDebugInformation = CreateDebugInformation(methodBase);
+                    debugInformation.Add(methodBase, methodDebugInformation);
+                }
+            }
+            return methodDebugInformation != null;
+        }
+
+        /// <summary>
+        /// Creates new debug information for the given method base by mapping its
+        /// metadata token to the corresponding PDB row.
+        /// </summary>
+        /// <param name="methodBase">The method base.</param>
+        /// <returns>The created debug information (or null).</returns>
+        private MethodDebugInformation CreateDebugInformation(MethodBase methodBase)
+        {
+            if (!IsValid || !Modules.Contains(methodBase.Module))
+                return null;
+
+            var handle = MetadataTokens.EntityHandle(methodBase.MetadataToken);
+            if (handle.Kind != HandleKind.MethodDefinition)
+                return null;
+            var definitionHandle = (MethodDefinitionHandle)handle;
+            int rowNumber = MetadataTokens.GetRowNumber(definitionHandle);
+            return rowNumber > 0 && rowNumber <= NumMethodDebugInformationRows
+                ? new MethodDebugInformation(this, methodBase, definitionHandle)
+                : null;
         }
 
         #endregion
@@ -0,0 +1,325 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: DisassemblyCache.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.Frontend.DebugInformation;
+using System;
+using System.Collections.Generic;
+using System.Reflection;
+
+namespace ILGPU.Frontend
+{
+    /// <summary>
+    /// A process-wide cache of disassembled methods that is shared by all frontends
+    /// (and hence by all contexts).
+    /// </summary>
+    /// <remarks>
+    /// The cache is bounded by the total number of cached IL instructions and evicts
+    /// the least recently used methods first. Entries are keyed by the method and
+    /// the availability of debug information, so that contexts with and without
+    /// sequence points never share disassembled methods. Methods of collectible
+    /// assemblies are never cached to allow their load contexts to be unloaded.
+    /// </remarks>
+    public sealed class DisassemblyCache : ICache
+    {
+        #region Nested Types
+
+        /// <summary>
+        /// Identifies a cached disassembled method.
+        /// </summary>
+        private readonly struct CacheKey : IEquatable<CacheKey>
+        {
+            /// <summary>
+            /// Constructs a new cache key.
+            /// </summary>
+            /// <param name="method">The disassembled method.</param>
+            /// <param name="hasDebugInformation">
+            /// True, if the method has been disassembled using debug information.
+            /// </param>
+            public CacheKey(MethodBase method, bool hasDebugInformation)
+            {
+                Method = method;
+                HasDebugInformation = hasDebugInformation;
+            }
+
+            /// <summary>
+            /// Returns the disassembled method.
+            /// </summary>
+            public MethodBase Method { get; }
+
+            /// <summary>
+            /// Returns true if the method has been disassembled using debug
+            /// information.
+            /// </summary>
+            public bool HasDebugInformation { get; }
+
+            /// <summary>
+            /// Returns true if the given key is equal to this one.
+            /// </summary>
+            public bool Equals(CacheKey other) =>
+                Method == other.Method &&
+                HasDebugInformation == other.HasDebugInformation;
+
+            /// <summary>
+            /// Returns true if the given object is equal to this key.
+            /// </summary>
+            public override bool Equals(object obj) =>
+                obj is CacheKey other && Equals(other);
+
+            /// <summary>
+            /// Returns the hash code of this key.
+            /// </summary>
+            public override int GetHashCode() =>
+                Method.GetHashCode() ^ (HasDebugInformation ? 1 : 0);
+        }
+
+        #endregion
+
+        #region Static
+
+        /// <summary>
+        /// Returns the process-wide disassembly cache.
+        /// </summary>
+        public static DisassemblyCache Shared { get; } = new DisassemblyCache();
+
+        /// <summary>
+        /// Returns true if the given method can be cached.
+        /// </summary>
+        private static bool CanCache(MethodBase method)
+        {
+#if !NETFRAMEWORK
+            return !method.Module.Assembly.IsCollectible;
+#else
+            return true;
+#endif
+        }
+
+        #endregion
+
+        #region Constants
+
+        /// <summary>
+        /// The default maximum number of cached IL instructions.
+        /// </summary>
+        public const int DefaultMaxNumInstructions = 1 << 18;
+
+        #endregion
+
+        #region Instance
+
+        /// <summary>
+        /// The internal synchronization object.
+        /// </summary>
+        private readonly object syncLock = new object();
+
+        /// <summary>
+        /// Maps keys to their entries in the LRU list.
+        /// </summary>
+        private readonly Dictionary<
+            CacheKey,
+            LinkedListNode<(CacheKey Key, DisassembledMethod Method)>> entries =
+            new Dictionary<
+                CacheKey,
+                LinkedListNode<(CacheKey, DisassembledMethod)>>();
+
+        /// <summary>
+        /// All entries in least-recently-used order (most recent first).
+        /// </summary>
+        private readonly LinkedList<(CacheKey Key, DisassembledMethod Method)>
+            lruList = new LinkedList<(CacheKey, DisassembledMethod)>();
+
+        /// <summary>
+        /// The maximum number of cached IL instructions.
+        /// </summary>
+        private int maxNumInstructions = DefaultMaxNumInstructions;
+
+        /// <summary>
+        /// The current number of cached IL instructions.
+        /// </summary>
+        private int numInstructions;
+
+        /// <summary>
+        /// Constructs a new disassembly cache.
+        /// </summary>
+        private DisassemblyCache() { }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Gets or sets the maximum number of cached IL instructions.
+        /// </summary>
+        /// <remarks>
+        /// A value of zero disables caching.
+        /// </remarks>
+        public int MaxNumInstructions
+        {
+            get => maxNumInstructions;
+            set
+            {
+                if (value < 0)
+                    throw new ArgumentOutOfRangeException(nameof(value));
+                lock (syncLock)
+                {
+                    maxNumInstructions = value;
+                    Evict();
+                }
+            }
+        }
+
+        /// <summary>
+        /// Returns the number of cached methods.
+        /// </summary>
+        public int Count
+        {
+            get
+            {
+                lock (syncLock)
+                    return entries.Count;
+            }
+        }
+
+        /// <summary>
+        /// Returns the current number of cached IL instructions.
+        /// </summary>
+        public int NumInstructions
+        {
+            get
+            {
+                lock (syncLock)
+                    return numInstructions;
+            }
+        }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Returns a cached disassembled method or disassembles the given method and
+        /// adds it to the cache.
+        /// </summary>
+        /// <param name="method">The method to disassemble.</param>
+        /// <param name="debugInformationManager">
+        /// The debug information manager to load sequence points from (if any).
+        /// </param>
+        /// <param name="compilationStackLocation">
+        /// The source location of the current lookup, which is used to report
+        /// disassembly errors. It is not part of the cached result.
+        /// </param>
+        /// <returns>The disassembled method.</returns>
+        internal DisassembledMethod GetOrDisassemble(
+            MethodBase method,
+            DebugInformationManager debugInformationManager,
+            CompilationStackLocation compilationStackLocation)
+        {
+            MethodDebugInformation debugInformation = null;
+            bool hasDebugInformation = debugInformationManager?.
+                TryLoadDebugInformation(method, out debugInformation) ?? false;
+            var key = new CacheKey(method, hasDebugInformation);
+
+            lock (syncLock)
+            {
+                if (entries.TryGetValue(key, out var node))
+                {
+                    lruList.Remove(node);
+                    lruList.AddFirst(node);
+                    return node.Value.Method;
+                }
+            }
+
+            // Disassemble the method outside of the lock
+            var sequencePoints = hasDebugInformation
+                ? debugInformation.CreateSequencePointEnumerator()
+                : SequencePointEnumerator.Empty;
+            var disassembler = new Disassembler(
+                method,
+                sequencePoints,
+                compilationStackLocation);
+            var disassembledMethod = disassembler.Disassemble();
+            if (!CanCache(method))
+                return disassembledMethod;
+
+            lock (syncLock)
+            {
+                // Check whether another thread has registered the method in the
+                // meantime or whether the method is too large to be cached
+                if (entries.TryGetValue(key, out var node))
+                    return node.Value.Method;
+                if (disassembledMethod.Count > maxNumInstructions)
+                    return disassembledMethod;
+
+                entries.Add(key, lruList.AddFirst((key, disassembledMethod)));
+                numInstructions += disassembledMethod.Count;
+                Evict();
+            }
+            return disassembledMethod;
+        }
+
+        /// <summary>
+        /// Evicts least recently used methods until the cache fits into its bounds.
+        /// </summary>
+        private void Evict()
+        {
+            while (numInstructions > maxNumInstructions)
+                Remove(lruList.Last);
+        }
+
+        /// <summary>
+        /// Removes the given node from the cache.
+        /// </summary>
+        /// <param name="node">The node to remove.</param>
+        private void Remove(
+            LinkedListNode<(CacheKey Key, DisassembledMethod Method)> node)
+        {
+            lruList.Remove(node);
+            entries.Remove(node.Value.Key);
+            numInstructions -= node.Value.Method.Count;
+        }
+
+        /// <summary>
+        /// Clears cached methods.
+        /// </summary>
+        /// <param name="mode">
+        /// The clear mode. <see cref="ClearCacheMode.Normal"/> keeps all methods of
+        /// the ILGPU runtime assembly, while <see cref="ClearCacheMode.Everything"/>
+        /// removes all methods.
+        /// </param>
+        public void ClearCache(ClearCacheMode mode)
+        {
+            lock (syncLock)
+            {
+                if (mode == ClearCacheMode.Everything)
+                {
+                    entries.Clear();
+                    lruList.Clear();
+                    numInstructions = 0;
+                    return;
+                }
+
+                for (var node = lruList.First; node != null;)
+                {
+                    var next = node.Next;
+                    var assembly = node.Value.Key.Method.Module.Assembly;
+                    if (!assembly.FullName.StartsWith(
+                        Context.AssemblyName,
+                        StringComparison.OrdinalIgnoreCase))
+                    {
+                        Remove(node);
+                    }
+                    node = next;
+                }
+            }
+        }
+
+        #endregion
+    }
+}
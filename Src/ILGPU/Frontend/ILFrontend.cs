@@ -14,11 +14,13 @@ using ILGPU.IR;
 using ILGPU.IR.Transformations;
 using ILGPU.Util;
 using System;
+using System.Collections.Concurrent;
 using System.Collections.Generic;
 using System.Diagnostics;
 using System.Diagnostics.CodeAnalysis;
 using System.Reflection;
 using System.Threading;
+using System.Threading.Tasks;
 
 namespace ILGPU.Frontend
 {
@@ -76,22 +78,123 @@ namespace ILGPU.Frontend
             }
         }
 
+        /// <summary>
+        /// Represents the local work queue of a single code-generation worker.
+        /// </summary>
+        /// <remarks>
+        /// The owning worker pushes and pops entries at the back of its queue, while
+        /// idle workers steal entries from the front.
+        /// </remarks>
+        private sealed class WorkerQueue
+        {
+            private readonly LinkedList<ProcessingEntry> entries =
+                new LinkedList<ProcessingEntry>();
+            private int isActive;
+
+            /// <summary>
+            /// Returns true if this queue does not contain any entries.
+            /// </summary>
+            public bool IsEmpty
+            {
+                get
+                {
+                    lock (entries)
+                        return entries.Count < 1;
+                }
+            }
+
+            /// <summary>
+            /// Tries to activate this queue for a new worker.
+            /// </summary>
+            /// <returns>True, if this queue has been activated.</returns>
+            public bool TryActivate() =>
+                Interlocked.CompareExchange(ref isActive, 1, 0) == 0;
+
+            /// <summary>
+            /// Deactivates this queue after its worker has finished.
+            /// </summary>
+            public void Deactivate() => Volatile.Write(ref isActive, 0);
+
+            /// <summary>
+            /// Pushes the given entry to the back of this queue.
+            /// </summary>
+            /// <param name="entry">The entry to push.</param>
+            public void Push(in ProcessingEntry entry)
+            {
+                lock (entries)
+                    entries.AddLast(entry);
+            }
+
+            /// <summary>
+            /// Tries to pop the most recently pushed entry (owning worker only).
+            /// </summary>
+            /// <param name="entry">The popped entry.</param>
+            /// <returns>True, if an entry could be popped.</returns>
+            public bool TryPop(out ProcessingEntry entry)
+            {
+                lock (entries)
+                {
+                    var node = entries.Last;
+                    if (node is null)
+                    {
+                        entry = default;
+                        return false;
+                    }
+                    entry = node.Value;
+                    entries.RemoveLast();
+                    return true;
+                }
+            }
+
+            /// <summary>
+            /// Tries to steal the least recently pushed entry (other workers).
+            /// </summary>
+            /// <param name="entry">The stolen entry.</param>
+            /// <returns>True, if an entry could be stolen.</returns>
+            public bool TrySteal(out ProcessingEntry entry)
+            {
+                lock (entries)
+                {
+                    var node = entries.First;
+                    if (node is null)
+                    {
+                        entry = default;
+                        return false;
+                    }
+                    entry = node.Value;
+                    entries.RemoveFirst();
+                    return true;
+                }
+            }
+
+            /// <summary>
+            /// Removes all entries from this queue.
+            /// </summary>
+            public void Clear()
+            {
+                lock (entries)
+                    entries.Clear();
+            }
+        }
+
         #endregion
 
         #region Instance
 
         private volatile bool running = true;
-        private readonly Thread[] threads;
+        private readonly Action<object> processEntriesDelegate;
         private readonly ManualResetEventSlim driverNotifier;
-        private volatile int activeThreads;
-        private readonly object processingSyncObject = new object();
-        private readonly Stack<ProcessingEntry> processing =
-            new Stack<ProcessingEntry>(1 << 6);
+        private readonly object driverSyncObject = new object();
+        private readonly ConcurrentQueue<ProcessingEntry> globalQueue =
+            new ConcurrentQueue<ProcessingEntry>();
+        private readonly WorkerQueue[] workerQueues;
+        private int activeWorkers;
+        private int numPendingEntries;
 
         private volatile CodeGenerationPhase codeGenerationPhase;
 
         /// <summary>
-        /// Constructs a new frontend with two threads.
+        /// Constructs a new frontend that uses all available processors.
         /// </summary>
         /// <param name="context">The context instance.</param>
         /// <param name="debugInformationManager">
@@ -100,38 +203,37 @@ namespace ILGPU.Frontend
         public ILFrontend(
             Context context,
             DebugInformationManager debugInformationManager)
-            : this(context, debugInformationManager, 2)
+            : this(context, debugInformationManager, Environment.ProcessorCount)
         { }
 
         /// <summary>
-        /// Constructs a new frontend that uses the given number of
-        /// threads for code generation.
+        /// Constructs a new frontend that uses the given maximum number of
+        /// concurrent workers for code generation.
         /// </summary>
         /// <param name="context">The context instance.</param>
         /// <param name="debugInformationManager">
         /// The associated debug information manager.
         /// </param>
-        /// <param name="numThreads">The number of threads.</param>
+        /// <param name="numThreads">The maximum number of concurrent workers.</param>
+        /// <remarks>
+        /// All workers are executed on the shared .Net thread pool.
+        /// </remarks>
         public ILFrontend(
             Context context,
             DebugInformationManager debugInformationManager,
             int numThreads)
         {
+            if (context == null)
+                throw new ArgumentNullException(nameof(context));
             if (numThreads < 1)
                 throw new ArgumentOutOfRangeException(nameof(numThreads));
             DebugInformationManager = debugInformationManager;
-            driverNotifier = new ManualResetEventSlim(false);
-            threads = new Thread[numThreads];
+            MaxNumWorkers = numThreads;
+            workerQueues = new WorkerQueue[numThreads];
             for (int i = 0; i < numThreads; ++i)
-            {
-                var thread = new Thread(DoWork)
-                {
-                    Name = $"ILGPU_{context.InstanceId}_Frontend_{i}",
-                    IsBackground = true,
-                };
-                threads[i] = thread;
-                thread.Start();
-            }
+                workerQueues[i] = new WorkerQueue();
+            driverNotifier = new ManualResetEventSlim(false);
+            processEntriesDelegate = ProcessEntries;
         }
 
         #endregion
@@ -143,6 +245,16 @@ namespace ILGPU.Frontend
         /// </summary>
         public DebugInformationManager DebugInformationManager { get; }
 
+        /// <summary>
+        /// Returns the process-wide cache of all disassembled methods.
+        /// </summary>
+        public DisassemblyCache DisassemblyCache => DisassemblyCache.Shared;
+
+        /// <summary>
+        /// Returns the maximum number of concurrent code-generation workers.
+        /// </summary>
+        public int MaxNumWorkers { get; }
+
         /// <summary>
         /// Returns true if the code generation has failed.
         /// </summary>
@@ -158,82 +270,187 @@ namespace ILGPU.Frontend
         #region Methods
 
         /// <summary>
-        /// The code-generation thread.
+        /// Tries to reserve a new worker slot.
         /// </summary>
-        [SuppressMessage(
-            "Design",
-            "CA1031:Do not catch general exception types",
-            Justification = "Must be caught to propagate errors")]
-        private void DoWork()
+        /// <returns>The reserved worker slot or -1.</returns>
+        private int TryAcquireWorker()
         {
-            var detectedMethods = new Dictionary<MethodBase, CompilationStackLocation>();
-            for (; ; )
+            // Register the worker before checking the running flag to ensure that
+            // a concurrent dispose operation waits for this worker
+            Interlocked.Increment(ref activeWorkers);
+            if (running)
             {
-                ProcessingEntry current;
-                lock (processingSyncObject)
+                for (int i = 0, e = workerQueues.Length; i < e; ++i)
                 {
-                    while (processing.Count < 1 & running)
-                        Monitor.Wait(processingSyncObject);
+                    if (workerQueues[i].TryActivate())
+                        return i;
+                }
+            }
+            ReleaseWorker(-1);
+            return -1;
+        }
 
-                    if (!running)
-                        break;
+        /// <summary>
+        /// Releases a worker slot and wakes up a pending dispose operation once the
+        /// last worker has left.
+        /// </summary>
+        /// <param name="slot">The worker slot to release (if any).</param>
+        private void ReleaseWorker(int slot)
+        {
+            if (slot >= 0)
+                workerQueues[slot].Deactivate();
+            if (Interlocked.Decrement(ref activeWorkers) > 0)
+                return;
+            lock (driverSyncObject)
+                Monitor.PulseAll(driverSyncObject);
+        }
 
-                    ++activeThreads;
-                    current = processing.Pop();
-                }
+        /// <summary>
+        /// Returns true if there is at least one entry left in any queue.
+        /// </summary>
+        private bool HasPendingEntries()
+        {
+            if (!globalQueue.IsEmpty)
+                return true;
+            foreach (var queue in workerQueues)
+            {
+                if (!queue.IsEmpty)
+                    return true;
+            }
+            return false;
+        }
 
-                Debug.Assert(
-                    codeGenerationPhase != null,
-                    "Invalid processing state");
+        /// <summary>
+        /// Pushes a new processing entry and starts a new worker on the thread pool
+        /// if there is a free worker slot.
+        /// </summary>
+        /// <param name="entry">The entry to process.</param>
+        /// <param name="localQueue">
+        /// The local queue of the current worker (if any).
+        /// </param>
+        /// <remarks>
+        /// The caller is responsible for incrementing the number of pending entries.
+        /// </remarks>
+        private void Schedule(in ProcessingEntry entry, WorkerQueue localQueue)
+        {
+            if (localQueue is null)
+                globalQueue.Enqueue(entry);
+            else
+                localQueue.Push(entry);
 
-                detectedMethods.Clear();
-                try
-                {
-                    codeGenerationPhase.GenerateCodeInternal(
-                        current.Method,
-                        current.IsExternalRequest,
-                        current.CompilationStackLocation,
-                        detectedMethods,
-                        out Method method);
-                    current.SetResult(method);
-                }
-                catch (Exception e)
+            int slot = TryAcquireWorker();
+            if (slot >= 0)
+            {
+                Task.Factory.StartNew(
+                    processEntriesDelegate,
+                    slot,
+                    CancellationToken.None,
+                    TaskCreationOptions.DenyChildAttach,
+                    TaskScheduler.Default);
+            }
+        }
+
+        /// <summary>
+        /// Tries to get the next entry to process for the given worker slot.
+        /// </summary>
+        /// <param name="slot">The current worker slot.</param>
+        /// <param name="entry">The next entry.</param>
+        /// <returns>True, if there was an entry to process.</returns>
+        /// <remarks>
+        /// Workers process their local entries first (in a depth-first manner),
+        /// then entries from external requests, and steal entries from the other
+        /// workers otherwise.
+        /// </remarks>
+        private bool TryGetEntry(int slot, out ProcessingEntry entry)
+        {
+            if (workerQueues[slot].TryPop(out entry) ||
+                globalQueue.TryDequeue(out entry))
+            {
+                return true;
+            }
+            for (int i = 1, e = workerQueues.Length; i < e; ++i)
+            {
+                if (workerQueues[(slot + i) % e].TrySteal(out entry))
+                    return true;
+            }
+            return false;
+        }
+
+        /// <summary>
+        /// The code-generation worker that processes entries until there is no
+        /// more work to do.
+        /// </summary>
+        /// <param name="state">The boxed worker slot.</param>
+        private void ProcessEntries(object state)
+        {
+            int slot = (int)state;
+            var detectedMethods = new Dictionary<MethodBase, CompilationStackLocation>();
+            for (; ; )
+            {
+                while (running && TryGetEntry(slot, out var current))
+                    Process(current, workerQueues[slot], detectedMethods);
+
+                // Release our worker slot and check whether new entries have been
+                // pushed in the meantime that would not be processed otherwise
+                ReleaseWorker(slot);
+                if (!HasPendingEntries() || (slot = TryAcquireWorker()) < 0)
+                    break;
+            }
+        }
+
+        /// <summary>
+        /// Processes a single entry and schedules all newly detected methods.
+        /// </summary>
+        /// <param name="current">The current entry to process.</param>
+        /// <param name="localQueue">The local queue of the current worker.</param>
+        /// <param name="detectedMethods">The set of newly detected methods.</param>
+        [SuppressMessage(
+            "Design",
+            "CA1031:Do not catch general exception types",
+            Justification = "Must be caught to propagate errors")]
+        private void Process(
+            in ProcessingEntry current,
+            WorkerQueue localQueue,
+            Dictionary<MethodBase, CompilationStackLocation> detectedMethods)
+        {
+            var phase = codeGenerationPhase;
+            Debug.Assert(phase != null, "Invalid processing state");
+
+            detectedMethods.Clear();
+            try
+            {
+                phase.GenerateCodeInternal(
+                    current.Method,
+                    current.IsExternalRequest,
+                    current.CompilationStackLocation,
+                    detectedMethods,
+                    out Method method);
+                current.SetResult(method);
+
+                // Schedule all dependencies
+                foreach (var detectedMethod in detectedMethods)
                 {
-                    codeGenerationPhase.RecordException(e);
-                    detectedMethods.Clear();
+                    Interlocked.Increment(ref numPendingEntries);
+                    Schedule(
+                        new ProcessingEntry(
+                            detectedMethod.Key,
+                            detectedMethod.Value,
+                            null),
+                        localQueue);
                 }
+            }
+            catch (Exception e)
+            {
+                phase.RecordException(e);
+            }
 
-                // Check dependencies
-                lock (processingSyncObject)
+            // Notify the driver as soon as all scheduled entries have been processed
+            if (Interlocked.Decrement(ref numPendingEntries) == 0)
+            {
+                lock (driverSyncObject)
                 {
-                    --activeThreads;
-
-                    try
-                    {
-                        foreach (var detectedMethod in detectedMethods)
-                        {
-                            processing.Push(new ProcessingEntry(
-                                detectedMethod.Key,
-                                detectedMethod.Value,
-                                null));
-                        }
-                    }
-                    catch (Exception e)
-                    {
-                        codeGenerationPhase.RecordException(e);
-                        detectedMethods.Clear();
-                        processing.Clear();
-                    }
-
-                    if (detectedMethods.Count > 0)
-                    {
-                        Monitor.PulseAll(processingSyncObject);
-                    }
-                    else
-                    {
-                        if (activeThreads == 0 && processing.Count < 1)
-                            driverNotifier.Set();
-                    }
+                    if (Volatile.Read(ref numPendingEntries) == 0)
+                        driverNotifier.Set();
                 }
             }
         }
@@ -246,15 +463,17 @@ namespace ILGPU.Frontend
         internal CodeGenerationResult GenerateCode(MethodBase method)
         {
             var result = new CodeGenerationResult(method);
-            lock (processingSyncObject)
+            lock (driverSyncObject)
             {
+                Interlocked.Increment(ref numPendingEntries);
                 driverNotifier.Reset();
-                processing.Push(new ProcessingEntry(
+            }
+            Schedule(
+                new ProcessingEntry(
                     method,
                     new CompilationStackLocation(new Method.MethodLocation(method)),
-                    result));
-                Monitor.Pulse(processingSyncObject);
-            }
+                    result),
+                null);
             return result;
         }
 
@@ -311,11 +530,20 @@ namespace ILGPU.Frontend
         {
             if (disposing)
             {
+                // Prevent new workers from being started and wait for all in-flight
+                // workers to finish their current entries
                 running = false;
-                lock (processingSyncObject)
-                    Monitor.PulseAll(processingSyncObject);
-                foreach (var thread in threads)
-                    thread.Join();
+                lock (driverSyncObject)
+                {
+                    while (Volatile.Read(ref activeWorkers) > 0)
+                        Monitor.Wait(driverSyncObject);
+                }
+                while (globalQueue.TryDequeue(out _))
+                {
+                    // Discard all remaining entries
+                }
+                foreach (var queue in workerQueues)
+                    queue.Clear();
                 driverNotifier.Dispose();
             }
             base.Dispose(disposing);
@@ -463,14 +691,10 @@ namespace ILGPU.Frontend
                     return;
                 location = generatedMethod;
 
-                SequencePointEnumerator sequencePoints =
-                    DebugInformationManager?.LoadSequencePoints(method)
-                    ?? SequencePointEnumerator.Empty;
-                var disassembler = new Disassembler(
+                var disassembledMethod = Frontend.DisassemblyCache.GetOrDisassemble(
                     method,
-                    sequencePoints,
+                    Frontend.DebugInformationManager,
                     compilationStackLocation);
-                var disassembledMethod = disassembler.Disassemble();
 
                 using (var builder = generatedMethod.CreateBuilder())
                 {
@@ -0,0 +1,305 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: Half2.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.IR.Intrinsics;
+using System;
+#if !DEBUG
+using System.Diagnostics;
+#endif
+using System.Runtime.CompilerServices;
+
+namespace ILGPU
+{
+    /// <summary>
+    /// Two packed half precision floating point values that are stored in a single
+    /// 32 bit word.
+    /// </summary>
+    /// <remarks>
+    /// On Cuda accelerators with sm_53 or higher, additions, subtractions,
+    /// multiplications and fused multiply-adds are mapped to packed <c>f16x2</c>
+    /// instructions that process both lanes at once. All other accelerators process
+    /// both lanes one after another.
+    /// </remarks>
+    [Serializable]
+    public readonly struct Half2 : IEquatable<Half2>
+    {
+        #region Constants
+
+        /// <summary>
+        /// The sign bits of both lanes.
+        /// </summary>
+        private const uint SignMask = 0x80008000U;
+
+        #endregion
+
+        #region Static
+
+        /// <summary>
+        /// Returns the lane-wise absolute value of the given packed value.
+        /// </summary>
+        /// <param name="value">The packed value.</param>
+        /// <returns>The lane-wise absolute value.</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static Half2 Abs(Half2 value) => new Half2(value.RawValue & ~SignMask);
+
+        /// <summary>
+        /// Computes the lane-wise minimum of both packed values.
+        /// </summary>
+        /// <param name="first">The first packed value.</param>
+        /// <param name="second">The second packed value.</param>
+        /// <returns>The lane-wise minimum.</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static Half2 Min(Half2 first, Half2 second) =>
+            new Half2(
+                first.X < second.X ? first.X : second.X,
+                first.Y < second.Y ? first.Y : second.Y);
+
+        /// <summary>
+        /// Computes the lane-wise maximum of both packed values.
+        /// </summary>
+        /// <param name="first">The first packed value.</param>
+        /// <param name="second">The second packed value.</param>
+        /// <returns>The lane-wise maximum.</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static Half2 Max(Half2 first, Half2 second) =>
+            new Half2(
+                first.X > second.X ? first.X : second.X,
+                first.Y > second.Y ? first.Y : second.Y);
+
+        /// <summary>
+        /// Computes the lane-wise fused multiply-add first * second + third.
+        /// </summary>
+        /// <param name="first">The first packed value.</param>
+        /// <param name="second">The second packed value.</param>
+        /// <param name="third">The third packed value.</param>
+        /// <returns>The lane-wise result of first * second + third.</returns>
+        [IntrinsicImplementation]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static Half2 Fma(Half2 first, Half2 second, Half2 third) =>
+            FmaLanes(first, second, third);
+
+        /// <summary>
+        /// Computes the dot product of both packed values.
+        /// </summary>
+        /// <param name="first">The first packed value.</param>
+        /// <param name="second">The second packed value.</param>
+        /// <returns>The dot product in single precision.</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static float Dot(Half2 first, Half2 second)
+        {
+            var product = first * second;
+            return (float)product.X + product.Y;
+        }
+
+        /// <summary>
+        /// Adds both lanes of the given packed values separately.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        internal static Half2 AddLanes(Half2 first, Half2 second) =>
+            new Half2(first.X + second.X, first.Y + second.Y);
+
+        /// <summary>
+        /// Subtracts both lanes of the given packed values separately.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        internal static Half2 SubLanes(Half2 first, Half2 second) =>
+            new Half2(first.X - second.X, first.Y - second.Y);
+
+        /// <summary>
+        /// Multiplies both lanes of the given packed values separately.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        internal static Half2 MulLanes(Half2 first, Half2 second) =>
+            new Half2(first.X * second.X, first.Y * second.Y);
+
+        /// <summary>
+        /// Computes the fused multiply-add of both lanes separately.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        internal static Half2 FmaLanes(Half2 first, Half2 second, Half2 third) =>
+            new Half2(
+                HalfExtensions.FmaFP32(first.X, second.X, third.X),
+                HalfExtensions.FmaFP32(first.Y, second.Y, third.Y));
+
+        #endregion
+
+        #region Instance
+
+        /// <summary>
+        /// Constructs a new packed value.
+        /// </summary>
+        /// <param name="x">The value of the lower lane.</param>
+        /// <param name="y">The value of the upper lane.</param>
+        public Half2(Half x, Half y)
+        {
+            RawValue = x.RawValue | (uint)y.RawValue << 16;
+        }
+
+        /// <summary>
+        /// Constructs a new packed value with both lanes set to the given value.
+        /// </summary>
+        /// <param name="value">The value of both lanes.</param>
+        public Half2(Half value)
+            : this(value, value)
+        { }
+
+        /// <summary>
+        /// Constructs a new packed value.
+        /// </summary>
+        /// <param name="rawValue">The underlying raw value.</param>
+        internal Half2(uint rawValue)
+        {
+            RawValue = rawValue;
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Represents the raw value.
+        /// </summary>
+#if !DEBUG
+        [DebuggerBrowsable(DebuggerBrowsableState.Never)]
+#endif
+        internal uint RawValue { get; }
+
+        /// <summary>
+        /// Returns the value of the lower lane.
+        /// </summary>
+        public Half X => new Half((ushort)RawValue);
+
+        /// <summary>
+        /// Returns the value of the upper lane.
+        /// </summary>
+        public Half Y => new Half((ushort)(RawValue >> 16));
+
+        #endregion
+
+        #region IEquatable
+
+        /// <summary>
+        /// Returns true if the given packed value has the same bit pattern as the
+        /// current one.
+        /// </summary>
+        /// <param name="other">The other packed value.</param>
+        /// <returns>True, if the given value is equal to the current one.</returns>
+        /// <remarks>
+        /// Unlike the <c>==</c> operator, this method treats NaNs with equal bits as
+        /// equal and distinguishes positive from negative zero. This keeps it
+        /// consistent with <see cref="GetHashCode"/>.
+        /// </remarks>
+        public readonly bool Equals(Half2 other) => RawValue == other.RawValue;
+
+        #endregion
+
+        #region Object
+
+        /// <summary>
+        /// Returns true if the given object is equal to the current packed value.
+        /// </summary>
+        /// <param name="obj">The other object.</param>
+        /// <returns>True, if the given object is equal to the current value.</returns>
+        public readonly override bool Equals(object obj) =>
+            obj is Half2 other && Equals(other);
+
+        /// <summary>
+        /// Returns the hash code of this packed value.
+        /// </summary>
+        /// <returns>The hash code of this packed value.</returns>
+        public readonly override int GetHashCode() => (int)RawValue;
+
+        /// <summary>
+        /// Returns the string representation of this packed value.
+        /// </summary>
+        /// <returns>The string representation of this packed value.</returns>
+        public readonly override string ToString() => $"({X}, {Y})";
+
+        #endregion
+
+        #region Operators
+
+        /// <summary>
+        /// Negates both lanes of the given packed value.
+        /// </summary>
+        /// <param name="value">The packed value to negate.</param>
+        /// <returns>The negated packed value.</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static Half2 operator -(Half2 value) =>
+            new Half2(value.RawValue ^ SignMask);
+
+        /// <summary>
+        /// Adds two packed values lane-wise.
+        /// </summary>
+        /// <param name="first">The first packed value.</param>
+        /// <param name="second">The second packed value.</param>
+        /// <returns>The resulting packed value.</returns>
+        [IntrinsicImplementation]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static Half2 operator +(Half2 first, Half2 second) =>
+            AddLanes(first, second);
+
+        /// <summary>
+        /// Subtracts two packed values lane-wise.
+        /// </summary>
+        /// <param name="first">The first packed value.</param>
+        /// <param name="second">The second packed value.</param>
+        /// <returns>The resulting packed value.</returns>
+        [IntrinsicImplementation]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static Half2 operator -(Half2 first, Half2 second) =>
+            SubLanes(first, second);
+
+        /// <summary>
+        /// Multiplies two packed values lane-wise.
+        /// </summary>
+        /// <param name="first">The first packed value.</param>
+        /// <param name="second">The second packed value.</param>
+        /// <returns>The resulting packed value.</returns>
+        [IntrinsicImplementation]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static Half2 operator *(Half2 first, Half2 second) =>
+            MulLanes(first, second);
+
+        /// <summary>
+        /// Divides two packed values lane-wise.
+        /// </summary>
+        /// <param name="first">The first packed value.</param>
+        /// <param name="second">The second packed value.</param>
+        /// <returns>The resulting packed value.</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static Half2 operator /(Half2 first, Half2 second) =>
+            new Half2(first.X / second.X, first.Y / second.Y);
+
+        /// <summary>
+        /// Returns true if both lanes of both packed values are equal according to
+        /// IEEE 754.
+        /// </summary>
+        /// <param name="first">The first packed value.</param>
+        /// <param name="second">The second packed value.</param>
+        /// <returns>True, if both lanes are equal.</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static bool operator ==(Half2 first, Half2 second) =>
+            first.X == second.X && first.Y == second.Y;
+
+        /// <summary>
+        /// Returns true if at least one lane of both packed values differs.
+        /// </summary>
+        /// <param name="first">The first packed value.</param>
+        /// <param name="second">The second packed value.</param>
+        /// <returns>True, if at least one lane differs.</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static bool operator !=(Half2 first, Half2 second) =>
+            !(first == second);
+
+        #endregion
+    }
+}
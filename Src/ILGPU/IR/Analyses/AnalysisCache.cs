@@ -0,0 +1,294 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: AnalysisCache.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.IR.Analyses.ControlFlowDirection;
+using ILGPU.IR.Analyses.TraversalOrders;
+using System;
+using System.Collections.Generic;
+
+namespace ILGPU.IR.Analyses
+{
+    /// <summary>
+    /// Specifies the cached analyses that are preserved by a transformation.
+    /// </summary>
+    [Flags]
+    public enum PreservedAnalyses : int
+    {
+        /// <summary>
+        /// No analyses are preserved (default).
+        /// </summary>
+        None = 0,
+
+        /// <summary>
+        /// The forwards CFG is preserved.
+        /// </summary>
+        CFG = 1 << 0,
+
+        /// <summary>
+        /// The dominator analysis is preserved.
+        /// </summary>
+        Dominators = 1 << 1,
+
+        /// <summary>
+        /// The post dominator analysis is preserved.
+        /// </summary>
+        PostDominators = 1 << 2,
+
+        /// <summary>
+        /// The loops analysis is preserved.
+        /// </summary>
+        Loops = 1 << 3,
+
+        /// <summary>
+        /// All control-flow analyses are preserved.
+        /// </summary>
+        ControlFlow = CFG | Dominators | PostDominators | Loops,
+    }
+
+    /// <summary>
+    /// Caches control-flow analyses of a single method across transformation passes.
+    /// </summary>
+    /// <remarks>
+    /// All cached analyses are invalidated automatically as soon as the block
+    /// structure of the parent method changes. In addition, each transformation
+    /// that has been applied to the parent method invalidates all analyses it does
+    /// not declare as preserved (see <see cref="PreservedAnalyses"/>). Custom
+    /// analyses registered via <see cref="GetOrCreate{TAnalysis}"/> are never
+    /// preserved by transformations.
+    /// </remarks>
+    public sealed class AnalysisCache
+    {
+        #region Static
+
+        /// <summary>
+        /// Maps all built-in analysis types to their preservation flags.
+        /// </summary>
+        private static readonly Dictionary<Type, PreservedAnalyses> AnalysisKinds =
+            new Dictionary<Type, PreservedAnalyses>()
+            {
+                { typeof(CFG<ReversePostOrder, Forwards>), PreservedAnalyses.CFG },
+                { typeof(Dominators<Forwards>), PreservedAnalyses.Dominators },
+                { typeof(Dominators<Backwards>), PreservedAnalyses.PostDominators },
+                {
+                    typeof(Loops<ReversePostOrder, Forwards>),
+                    PreservedAnalyses.Loops
+                },
+            };
+
+        /// <summary>
+        /// Returns true if the given analysis type is preserved.
+        /// </summary>
+        /// <param name="analysisType">The analysis type.</param>
+        /// <param name="preserved">The preserved analyses.</param>
+        /// <returns>True, if the given analysis type is preserved.</returns>
+        private static bool IsPreserved(
+            Type analysisType,
+            PreservedAnalyses preserved) =>
+            AnalysisKinds.TryGetValue(analysisType, out var kind) &&
+            (preserved & kind) == kind;
+
+        /// <summary>
+        /// Creates a new forwards CFG.
+        /// </summary>
+        private static readonly Func<Method, CFG<ReversePostOrder, Forwards>>
+            CFGCreator = method => method.Blocks.CreateCFG();
+
+        /// <summary>
+        /// Creates a new dominator analysis using the cached CFG.
+        /// </summary>
+        private static readonly Func<Method, Dominators<Forwards>>
+            DominatorsCreator = method => method.Analyses.GetCFG().CreateDominators();
+
+        /// <summary>
+        /// Creates a new post dominator analysis.
+        /// </summary>
+        private static readonly Func<Method, Dominators<Backwards>>
+            PostDominatorsCreator = method => method.Blocks.CreatePostDominators();
+
+        /// <summary>
+        /// Creates a new loops analysis using the cached CFG.
+        /// </summary>
+        private static readonly Func<Method, Loops<ReversePostOrder, Forwards>>
+            LoopsCreator = method => method.Analyses.GetCFG().CreateLoops();
+
+        #endregion
+
+        #region Instance
+
+        /// <summary>
+        /// The internal synchronization object.
+        /// </summary>
+        private readonly object syncLock = new object();
+
+        /// <summary>
+        /// Maps analysis types to cached analysis instances.
+        /// </summary>
+        private readonly Dictionary<Type, object> analyses =
+            new Dictionary<Type, object>();
+
+        /// <summary>
+        /// The control-flow version of the parent method the cached analyses belong to.
+        /// </summary>
+        private int controlFlowVersion;
+
+        /// <summary>
+        /// Constructs a new analysis cache.
+        /// </summary>
+        /// <param name="method">The parent method.</param>
+        internal AnalysisCache(Method method)
+        {
+            Method = method;
+            controlFlowVersion = method.ControlFlowVersion;
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Returns the parent method.
+        /// </summary>
+        public Method Method { get; }
+
+        /// <summary>
+        /// Returns the number of valid cached analyses.
+        /// </summary>
+        public int Count
+        {
+            get
+            {
+                lock (syncLock)
+                {
+                    ValidateCache();
+                    return analyses.Count;
+                }
+            }
+        }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Clears all cached analyses if the block structure of the parent method has
+        /// changed.
+        /// </summary>
+        private void ValidateCache()
+        {
+            int currentVersion = Method.ControlFlowVersion;
+            if (controlFlowVersion == currentVersion)
+                return;
+            analyses.Clear();
+            controlFlowVersion = currentVersion;
+        }
+
+        /// <summary>
+        /// Returns a cached analysis of the given type or creates and caches a new
+        /// one using the given creator.
+        /// </summary>
+        /// <typeparam name="TAnalysis">The analysis type.</typeparam>
+        /// <param name="creator">The creator to create new analysis instances.</param>
+        /// <returns>The cached or created analysis.</returns>
+        public TAnalysis GetOrCreate<TAnalysis>(Func<Method, TAnalysis> creator)
+            where TAnalysis : class
+        {
+            if (creator is null)
+                throw new ArgumentNullException(nameof(creator));
+
+            lock (syncLock)
+            {
+                ValidateCache();
+                if (analyses.TryGetValue(typeof(TAnalysis), out var analysis))
+                    return analysis as TAnalysis;
+            }
+
+            // Create the analysis outside of the lock since it might query other
+            // (dependent) analyses from this cache
+            var result = creator(Method);
+            lock (syncLock)
+            {
+                ValidateCache();
+                if (analyses.TryGetValue(typeof(TAnalysis), out var analysis))
+                    return analysis as TAnalysis;
+                analyses.Add(typeof(TAnalysis), result);
+            }
+            return result;
+        }
+
+        /// <summary>
+        /// Returns the cached forwards CFG of the parent method.
+        /// </summary>
+        /// <returns>The cached CFG.</returns>
+        public CFG<ReversePostOrder, Forwards> GetCFG() => GetOrCreate(CFGCreator);
+
+        /// <summary>
+        /// Returns the cached dominator analysis of the parent method.
+        /// </summary>
+        /// <returns>The cached dominator analysis.</returns>
+        public Dominators<Forwards> GetDominators() => GetOrCreate(DominatorsCreator);
+
+        /// <summary>
+        /// Returns the cached post dominator analysis of the parent method.
+        /// </summary>
+        /// <returns>The cached post dominator analysis.</returns>
+        public Dominators<Backwards> GetPostDominators() =>
+            GetOrCreate(PostDominatorsCreator);
+
+        /// <summary>
+        /// Returns the cached loops analysis of the parent method.
+        /// </summary>
+        /// <returns>The cached loops analysis.</returns>
+        public Loops<ReversePostOrder, Forwards> GetLoops() => GetOrCreate(LoopsCreator);
+
+        /// <summary>
+        /// Invalidates a cached analysis of the given type.
+        /// </summary>
+        /// <typeparam name="TAnalysis">The analysis type.</typeparam>
+        public void Invalidate<TAnalysis>()
+            where TAnalysis : class
+        {
+            lock (syncLock)
+                analyses.Remove(typeof(TAnalysis));
+        }
+
+        /// <summary>
+        /// Invalidates all cached analyses that are not preserved.
+        /// </summary>
+        /// <param name="preserved">The preserved analyses.</param>
+        public void Invalidate(PreservedAnalyses preserved)
+        {
+            lock (syncLock)
+            {
+                if (analyses.Count < 1)
+                    return;
+                var toRemove = new List<Type>(analyses.Count);
+                foreach (var analysisType in analyses.Keys)
+                {
+                    if (!IsPreserved(analysisType, preserved))
+                        toRemove.Add(analysisType);
+                }
+                foreach (var analysisType in toRemove)
+                    analyses.Remove(analysisType);
+            }
+        }
+
+        /// <summary>
+        /// Invalidates all cached analyses.
+        /// </summary>
+        public void InvalidateAll()
+        {
+            lock (syncLock)
+                analyses.Clear();
+        }
+
+        #endregion
+    }
+}
@@ -0,0 +1,225 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: BranchConditions.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.IR.Analyses.ControlFlowDirection;
+using ILGPU.IR.Values;
+using System.Collections.Generic;
+
+namespace ILGPU.IR.Analyses
+{
+    /// <summary>
+    /// Determines branch conditions that are known to hold in a particular block.
+    /// </summary>
+    public static class BranchConditions
+    {
+        #region Nested Types
+
+        /// <summary>
+        /// Enumerates all conditions of dominating if branches that are known to hold
+        /// in a block.
+        /// </summary>
+        public struct Enumerator
+        {
+            /// <summary>
+            /// Constructs a new condition enumerator.
+            /// </summary>
+            /// <param name="dominators">The parent dominators.</param>
+            /// <param name="block">The block to get the conditions for.</param>
+            internal Enumerator(Dominators<Forwards> dominators, BasicBlock block)
+            {
+                Dominators = dominators;
+                Block = block;
+                CurrentBlock = block;
+                Current = default;
+            }
+
+            /// <summary>
+            /// Returns the parent dominators.
+            /// </summary>
+            public Dominators<Forwards> Dominators { get; }
+
+            /// <summary>
+            /// Returns the block to get the conditions for.
+            /// </summary>
+            public BasicBlock Block { get; }
+
+            /// <summary>
+            /// Returns the current dominator.
+            /// </summary>
+            private BasicBlock CurrentBlock { get; set; }
+
+            /// <summary>
+            /// Returns the current condition and its known value.
+            /// </summary>
+            public (Value Condition, bool Value) Current { get; private set; }
+
+            /// <summary>
+            /// Returns true if <see cref="Block"/> can only be reached via the edge
+            /// from the source block to the given target block.
+            /// </summary>
+            private readonly bool IsReachedVia(BasicBlock source, BasicBlock target) =>
+                target.Predecessors.Length == 1 &&
+                target.Predecessors[0] == source &&
+                Dominators.Dominates(target, Block);
+
+            /// <summary>
+            /// Moves the enumerator forward to the next dominating condition.
+            /// </summary>
+            /// <returns>True, if there is a next condition.</returns>
+            public bool MoveNext()
+            {
+                while (true)
+                {
+                    var dominator = Dominators.GetImmediateDominator(CurrentBlock);
+                    if (dominator == CurrentBlock)
+                        return false;
+                    CurrentBlock = dominator;
+
+                    if (!(dominator.Terminator is IfBranch branch) ||
+                        branch.TrueTarget == branch.FalseTarget)
+                    {
+                        continue;
+                    }
+
+                    if (IsReachedVia(dominator, branch.TrueTarget))
+                    {
+                        Current = (branch.Condition.Resolve(), true);
+                        return true;
+                    }
+                    if (IsReachedVia(dominator, branch.FalseTarget))
+                    {
+                        Current = (branch.Condition.Resolve(), false);
+                        return true;
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// An enumerable of dominating branch conditions.
+        /// </summary>
+        public readonly struct Enumerable
+        {
+            /// <summary>
+            /// Constructs a new condition enumerable.
+            /// </summary>
+            /// <param name="dominators">The parent dominators.</param>
+            /// <param name="block">The block to get the conditions for.</param>
+            internal Enumerable(Dominators<Forwards> dominators, BasicBlock block)
+            {
+                Dominators = dominators;
+                Block = block;
+            }
+
+            /// <summary>
+            /// Returns the parent dominators.
+            /// </summary>
+            public Dominators<Forwards> Dominators { get; }
+
+            /// <summary>
+            /// Returns the block to get the conditions for.
+            /// </summary>
+            public BasicBlock Block { get; }
+
+            /// <summary>
+            /// Returns a new condition enumerator.
+            /// </summary>
+            public readonly Enumerator GetEnumerator() =>
+                new Enumerator(Dominators, Block);
+        }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Returns all conditions of dominating if branches that are known to hold in
+        /// the given block, starting with the closest dominator. A condition holds if
+        /// the block can only be reached via a single edge of its branch.
+        /// </summary>
+        /// <param name="dominators">The dominators of the parent method.</param>
+        /// <param name="block">The block to get the conditions for.</param>
+        /// <returns>An enumerable of all known conditions and their values.</returns>
+        public static Enumerable GetDominatingConditions(
+            this Dominators<Forwards> dominators,
+            BasicBlock block) =>
+            new Enumerable(dominators, block);
+
+        /// <summary>
+        /// Returns true if the given block can only be reached via an edge of a
+        /// dominating if branch that is unlikely to be taken according to its
+        /// profile-guided branch hints.
+        /// </summary>
+        /// <param name="dominators">The dominators of the parent method.</param>
+        /// <param name="block">The block to test.</param>
+        /// <returns>True, if the given block is unlikely to be executed.</returns>
+        public static bool IsCold(this Dominators<Forwards> dominators, BasicBlock block)
+        {
+            for (var current = block; ; )
+            {
+                var dominator = dominators.GetImmediateDominator(current);
+                if (dominator == current)
+                    return false;
+                current = dominator;
+
+                if (!(dominator.Terminator is IfBranch branch) ||
+                    branch.TrueTarget == branch.FalseTarget)
+                {
+                    continue;
+                }
+                var likelyTarget = branch.LikelyTarget;
+                if (likelyTarget is null)
+                    continue;
+
+                var unlikelyTarget = likelyTarget == branch.TrueTarget
+                    ? branch.FalseTarget
+                    : branch.TrueTarget;
+                if (unlikelyTarget.Predecessors.Length == 1 &&
+                    unlikelyTarget.Predecessors[0] == dominator &&
+                    dominators.Dominates(unlikelyTarget, block))
+                {
+                    return true;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Returns all blocks of the given method that are unlikely to be executed
+        /// according to the profile-guided hints of its if branches.
+        /// </summary>
+        /// <param name="method">The method.</param>
+        /// <returns>The set of all cold blocks.</returns>
+        public static HashSet<BasicBlock> GetColdBlocks(Method method)
+        {
+            var coldBlocks = new HashSet<BasicBlock>();
+
+            // Avoid computing dominators for methods without any hints
+            bool hasHints = false;
+            foreach (var block in method.Blocks)
+            {
+                hasHints |= block.Terminator is IfBranch branch &&
+                    branch.LikelyTarget != null;
+            }
+            if (!hasHints)
+                return coldBlocks;
+
+            var dominators = method.Analyses.GetDominators();
+            foreach (var block in method.Blocks)
+            {
+                if (dominators.IsCold(block))
+                    coldBlocks.Add(block);
+            }
+            return coldBlocks;
+        }
+
+        #endregion
+    }
+}
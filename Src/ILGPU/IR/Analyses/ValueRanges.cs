@@ -0,0 +1,693 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: ValueRanges.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.IR.Analyses.ControlFlowDirection;
+using ILGPU.IR.Types;
+using ILGPU.IR.Values;
+using ILGPU.Util;
+using System;
+using System.Collections.Generic;
+
+namespace ILGPU.IR.Analyses
+{
+    /// <summary>
+    /// Represents a closed interval of signed integer values.
+    /// </summary>
+    public readonly struct ValueRange : IEquatable<ValueRange>
+    {
+        #region Static
+
+        /// <summary>
+        /// The empty range that does not contain any value.
+        /// </summary>
+        public static readonly ValueRange Empty =
+            new ValueRange(long.MaxValue, long.MinValue);
+
+        /// <summary>
+        /// The full range that contains all 64-bit values.
+        /// </summary>
+        public static readonly ValueRange Full =
+            new ValueRange(long.MinValue, long.MaxValue);
+
+        /// <summary>
+        /// Returns the full range of all values of the given type.
+        /// </summary>
+        /// <param name="type">The basic value type.</param>
+        /// <returns>The full range of the given type.</returns>
+        public static ValueRange GetFull(BasicValueType type) =>
+            type switch
+            {
+                BasicValueType.Int1 => new ValueRange(0, 1),
+                BasicValueType.Int8 => new ValueRange(sbyte.MinValue, sbyte.MaxValue),
+                BasicValueType.Int16 => new ValueRange(short.MinValue, short.MaxValue),
+                BasicValueType.Int32 => new ValueRange(int.MinValue, int.MaxValue),
+                _ => Full,
+            };
+
+        /// <summary>
+        /// Returns the full unsigned range of all values of the given type.
+        /// </summary>
+        /// <param name="type">The basic value type.</param>
+        /// <returns>The full unsigned range of the given type.</returns>
+        public static ValueRange GetFullUnsigned(BasicValueType type) =>
+            type switch
+            {
+                BasicValueType.Int1 => new ValueRange(0, 1),
+                BasicValueType.Int8 => new ValueRange(0, byte.MaxValue),
+                BasicValueType.Int16 => new ValueRange(0, ushort.MaxValue),
+                BasicValueType.Int32 => new ValueRange(0, uint.MaxValue),
+                _ => Full,
+            };
+
+        /// <summary>
+        /// Creates a range that contains the given value only.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>The created range.</returns>
+        public static ValueRange Create(long value) => new ValueRange(value, value);
+
+        /// <summary>
+        /// Creates a range from the given bounds. If one of the bounds overflows the
+        /// value range of the given type, the full range of the type is returned.
+        /// </summary>
+        /// <param name="min">The lower bound (null if it overflows).</param>
+        /// <param name="max">The upper bound (null if it overflows).</param>
+        /// <param name="type">The basic value type of the result.</param>
+        /// <returns>The created range.</returns>
+        private static ValueRange Create(long? min, long? max, BasicValueType type)
+        {
+            var full = GetFull(type);
+            return min.HasValue && max.HasValue &&
+                min.Value >= full.Min && max.Value <= full.Max
+                ? new ValueRange(min.Value, max.Value)
+                : full;
+        }
+
+        /// <summary>
+        /// Adds both values and returns null in the case of an overflow.
+        /// </summary>
+        private static long? Add(long first, long second)
+        {
+            long result = first + second;
+            return ((first ^ result) & (second ^ result)) < 0
+                ? default(long?)
+                : result;
+        }
+
+        /// <summary>
+        /// Subtracts both values and returns null in the case of an overflow.
+        /// </summary>
+        private static long? Sub(long first, long second)
+        {
+            long result = first - second;
+            return ((first ^ second) & (first ^ result)) < 0
+                ? default(long?)
+                : result;
+        }
+
+        /// <summary>
+        /// Multiplies both values and returns null in the case of an overflow.
+        /// </summary>
+        private static long? Mul(long first, long second)
+        {
+            if (first == 0L || second == 0L)
+                return 0L;
+            if (first == long.MinValue || second == long.MinValue)
+            {
+                return first == 1L ? second :
+                    second == 1L ? first :
+                    default(long?);
+            }
+            long result = first * second;
+            return result / second != first ? default(long?) : result;
+        }
+
+        #endregion
+
+        #region Instance
+
+        /// <summary>
+        /// Constructs a new range.
+        /// </summary>
+        /// <param name="min">The inclusive lower bound.</param>
+        /// <param name="max">The inclusive upper bound.</param>
+        public ValueRange(long min, long max)
+        {
+            Min = min;
+            Max = max;
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Returns the inclusive lower bound.
+        /// </summary>
+        public long Min { get; }
+
+        /// <summary>
+        /// Returns the inclusive upper bound.
+        /// </summary>
+        public long Max { get; }
+
+        /// <summary>
+        /// Returns true if this range does not contain any value.
+        /// </summary>
+        public bool IsEmpty => Min > Max;
+
+        /// <summary>
+        /// Returns true if this range contains non-negative values only.
+        /// </summary>
+        public bool IsNonNegative => !IsEmpty && Min >= 0;
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Returns the smallest range that contains both ranges.
+        /// </summary>
+        /// <param name="other">The other range.</param>
+        /// <returns>The union of both ranges.</returns>
+        public ValueRange Union(ValueRange other) =>
+            IsEmpty ? other :
+            other.IsEmpty ? this :
+            new ValueRange(Math.Min(Min, other.Min), Math.Max(Max, other.Max));
+
+        /// <summary>
+        /// Returns the intersection of both ranges.
+        /// </summary>
+        /// <param name="other">The other range.</param>
+        /// <returns>The intersection of both ranges.</returns>
+        public ValueRange Intersect(ValueRange other)
+        {
+            var result = new ValueRange(
+                Math.Max(Min, other.Min),
+                Math.Min(Max, other.Max));
+            return result.IsEmpty ? Empty : result;
+        }
+
+        /// <summary>
+        /// Widens this range to the bounds of the given type in all directions in
+        /// which the other range exceeds this range.
+        /// </summary>
+        /// <param name="other">The other range.</param>
+        /// <param name="type">The basic value type of both ranges.</param>
+        /// <returns>The widened range.</returns>
+        public ValueRange Widen(ValueRange other, BasicValueType type)
+        {
+            if (IsEmpty || other.IsEmpty)
+                return Union(other);
+            var full = GetFull(type);
+            return new ValueRange(
+                other.Min < Min ? full.Min : Min,
+                other.Max > Max ? full.Max : Max);
+        }
+
+        /// <summary>
+        /// Restricts this range to all values that satisfy the given comparison with
+        /// a value of the other range.
+        /// </summary>
+        /// <param name="kind">The kind of the comparison.</param>
+        /// <param name="other">The range of the right operand.</param>
+        /// <returns>The refined range.</returns>
+        public ValueRange Refine(CompareKind kind, ValueRange other)
+        {
+            if (IsEmpty || other.IsEmpty)
+                return this;
+            return kind switch
+            {
+                CompareKind.Equal => Intersect(other),
+                CompareKind.LessThan => other.Max == long.MinValue
+                    ? Empty
+                    : Intersect(new ValueRange(long.MinValue, other.Max - 1)),
+                CompareKind.LessEqual =>
+                    Intersect(new ValueRange(long.MinValue, other.Max)),
+                CompareKind.GreaterThan => other.Min == long.MaxValue
+                    ? Empty
+                    : Intersect(new ValueRange(other.Min + 1, long.MaxValue)),
+                CompareKind.GreaterEqual =>
+                    Intersect(new ValueRange(other.Min, long.MaxValue)),
+                _ => this,
+            };
+        }
+
+        /// <summary>
+        /// Returns true if the given comparison holds for all values of this range
+        /// and all values of the other range.
+        /// </summary>
+        /// <param name="kind">The kind of the comparison.</param>
+        /// <param name="other">The range of the right operand.</param>
+        /// <returns>True, if the comparison always holds.</returns>
+        public bool Satisfies(CompareKind kind, ValueRange other)
+        {
+            if (IsEmpty || other.IsEmpty)
+                return false;
+            return kind switch
+            {
+                CompareKind.Equal => Min == Max && other.Min == other.Max &&
+                    Min == other.Min,
+                CompareKind.NotEqual => Max < other.Min || Min > other.Max,
+                CompareKind.LessThan => Max < other.Min,
+                CompareKind.LessEqual => Max <= other.Min,
+                CompareKind.GreaterThan => Min > other.Max,
+                CompareKind.GreaterEqual => Min >= other.Max,
+                _ => false,
+            };
+        }
+
+        /// <summary>
+        /// Computes the range of a binary operation.
+        /// </summary>
+        /// <param name="kind">The arithmetic kind.</param>
+        /// <param name="other">The range of the right operand.</param>
+        /// <param name="type">The basic value type of the result.</param>
+        /// <returns>The computed range.</returns>
+        public ValueRange Apply(
+            BinaryArithmeticKind kind,
+            ValueRange other,
+            BasicValueType type)
+        {
+            if (IsEmpty || other.IsEmpty)
+                return Empty;
+
+            bool nonNegative = IsNonNegative && other.IsNonNegative;
+            switch (kind)
+            {
+                case BinaryArithmeticKind.Add:
+                    return Create(Add(Min, other.Min), Add(Max, other.Max), type);
+                case BinaryArithmeticKind.Sub:
+                    return Create(Sub(Min, other.Max), Sub(Max, other.Min), type);
+                case BinaryArithmeticKind.Mul:
+                    var p1 = Mul(Min, other.Min);
+                    var p2 = Mul(Min, other.Max);
+                    var p3 = Mul(Max, other.Min);
+                    var p4 = Mul(Max, other.Max);
+                    if (!p1.HasValue || !p2.HasValue || !p3.HasValue || !p4.HasValue)
+                        return GetFull(type);
+                    return Create(
+                        Math.Min(
+                            Math.Min(p1.Value, p2.Value),
+                            Math.Min(p3.Value, p4.Value)),
+                        Math.Max(
+                            Math.Max(p1.Value, p2.Value),
+                            Math.Max(p3.Value, p4.Value)),
+                        type);
+                case BinaryArithmeticKind.Div when nonNegative && other.Min > 0:
+                    return new ValueRange(Min / other.Max, Max / other.Min);
+                case BinaryArithmeticKind.Rem when nonNegative && other.Min > 0:
+                    return new ValueRange(0, Math.Min(Max, other.Max - 1));
+                case BinaryArithmeticKind.And when IsNonNegative || other.IsNonNegative:
+                    return new ValueRange(
+                        0,
+                        IsNonNegative && other.IsNonNegative
+                        ? Math.Min(Max, other.Max)
+                        : IsNonNegative ? Max : other.Max);
+                case BinaryArithmeticKind.Shr when nonNegative && other.Max < 64:
+                    return new ValueRange(Min >> (int)other.Max, Max >> (int)other.Min);
+                case BinaryArithmeticKind.Min:
+                    return new ValueRange(
+                        Math.Min(Min, other.Min),
+                        Math.Min(Max, other.Max));
+                case BinaryArithmeticKind.Max:
+                    return new ValueRange(
+                        Math.Max(Min, other.Min),
+                        Math.Max(Max, other.Max));
+                default:
+                    return GetFull(type);
+            }
+        }
+
+        #endregion
+
+        #region IEquatable
+
+        /// <summary>
+        /// Returns true if the given range is equal to this range.
+        /// </summary>
+        /// <param name="other">The other range.</param>
+        /// <returns>True, if the given range is equal to this range.</returns>
+        public bool Equals(ValueRange other) =>
+            Min == other.Min && Max == other.Max;
+
+        #endregion
+
+        #region Object
+
+        /// <summary>
+        /// Returns true if the given object is equal to this range.
+        /// </summary>
+        /// <param name="obj">The other object.</param>
+        /// <returns>True, if the given object is equal to this range.</returns>
+        public override bool Equals(object obj) =>
+            obj is ValueRange other && Equals(other);
+
+        /// <summary>
+        /// Returns the hash code of this range.
+        /// </summary>
+        /// <returns>The hash code of this range.</returns>
+        public override int GetHashCode() => Min.GetHashCode() ^ Max.GetHashCode();
+
+        /// <summary>
+        /// Returns the string representation of this range.
+        /// </summary>
+        /// <returns>The string representation of this range.</returns>
+        public override string ToString() =>
+            IsEmpty ? "[]" : $"[{Min}, {Max}]";
+
+        #endregion
+
+        #region Operators
+
+        /// <summary>
+        /// Returns true if the first and second range are the same.
+        /// </summary>
+        /// <param name="first">The first range.</param>
+        /// <param name="second">The second range.</param>
+        /// <returns>True, if the first and second range are the same.</returns>
+        public static bool operator ==(ValueRange first, ValueRange second) =>
+            first.Equals(second);
+
+        /// <summary>
+        /// Returns true if the first and second range are not the same.
+        /// </summary>
+        /// <param name="first">The first range.</param>
+        /// <param name="second">The second range.</param>
+        /// <returns>True, if the first and second range are not the same.</returns>
+        public static bool operator !=(ValueRange first, ValueRange second) =>
+            !first.Equals(second);
+
+        #endregion
+    }
+
+    /// <summary>
+    /// An interval analysis that computes the ranges of all signed integer values of a
+    /// method. Ranges are derived from constants, grid and group intrinsics, arithmetic
+    /// operations, loop inductions and dominating branch conditions.
+    /// </summary>
+    /// <remarks>
+    /// Loop-carried phi values are widened to the bounds of their types as soon as
+    /// their ranges grow. Operands of arithmetic operations are refined using all
+    /// comparisons of dominating branches, which allows the analysis to derive
+    /// non-negative loop counters from guarded increments.
+    /// </remarks>
+    public sealed class ValueRanges : ValueFixPointAnalysis<ValueRange, Forwards>
+    {
+        #region Static
+
+        /// <summary>
+        /// Applies a new range analysis to the given method.
+        /// </summary>
+        /// <param name="method">The method to analyze.</param>
+        /// <returns>The created range analysis.</returns>
+        public static ValueRanges Create(Method method)
+        {
+            var ranges = new ValueRanges(method.Analyses.GetDominators());
+            ranges.AnalyzeRanges(method);
+            return ranges;
+        }
+
+        /// <summary>
+        /// Tries to normalize the given integer comparison such that the given value
+        /// is the left operand.
+        /// </summary>
+        /// <param name="compare">The compare operation.</param>
+        /// <param name="holds">True, if the comparison is known to hold.</param>
+        /// <param name="value">The value to normalize the comparison for.</param>
+        /// <param name="kind">The normalized compare kind.</param>
+        /// <param name="other">The other operand.</param>
+        /// <returns>True, if the comparison could be normalized.</returns>
+        private static bool TryNormalize(
+            CompareValue compare,
+            bool holds,
+            Value value,
+            out CompareKind kind,
+            out Value other)
+        {
+            kind = compare.Kind;
+            other = null;
+
+            var flags = compare.Flags;
+            var left = compare.Left.Resolve();
+            var right = compare.Right.Resolve();
+            if (flags != CompareFlags.None || !left.BasicValueType.IsInt())
+                return false;
+
+            if (left == value)
+            {
+                other = right;
+            }
+            else if (right == value)
+            {
+                other = left;
+                kind = CompareValue.SwapOperands(
+                    kind,
+                    left.BasicValueType,
+                    right.BasicValueType,
+                    ref flags);
+            }
+            else
+            {
+                return false;
+            }
+
+            if (!holds)
+            {
+                kind = CompareValue.Invert(
+                    kind,
+                    left.BasicValueType,
+                    right.BasicValueType,
+                    ref flags);
+            }
+            return flags == CompareFlags.None;
+        }
+
+        /// <summary>
+        /// Tries to determine the range of constants and device intrinsics.
+        /// </summary>
+        /// <param name="value">The IR value.</param>
+        /// <returns>The determined range (if any).</returns>
+        private static ValueRange? TryGetConstantRange(Value value) =>
+            value switch
+            {
+                PrimitiveValue primitive when primitive.IsInt =>
+                    ValueRange.Create(primitive.BasicValueType switch
+                    {
+                        BasicValueType.Int1 => primitive.Int1Value ? 1L : 0L,
+                        BasicValueType.Int8 => primitive.Int8Value,
+                        BasicValueType.Int16 => primitive.Int16Value,
+                        BasicValueType.Int32 => primitive.Int32Value,
+                        _ => primitive.Int64Value,
+                    }),
+                GridIndexValue _ => new ValueRange(0, int.MaxValue - 1),
+                GroupIndexValue _ => new ValueRange(0, int.MaxValue - 1),
+                LaneIdxValue _ => new ValueRange(0, int.MaxValue - 1),
+                GridDimensionValue _ => new ValueRange(1, int.MaxValue),
+                GroupDimensionValue _ => new ValueRange(1, int.MaxValue),
+                WarpSizeValue _ => new ValueRange(1, int.MaxValue),
+                _ => default(ValueRange?),
+            };
+
+        #endregion
+
+        #region Instance
+
+        /// <summary>
+        /// True, if the current analysis iteration has changed a value range.
+        /// </summary>
+        private bool changed;
+
+        /// <summary>
+        /// Constructs a new range analysis.
+        /// </summary>
+        /// <param name="dominators">The dominators of the method to analyze.</param>
+        private ValueRanges(Dominators<Forwards> dominators)
+            : base(defaultValue: ValueRange.Full)
+        {
+            Dominators = dominators;
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Returns the dominators of the analyzed method.
+        /// </summary>
+        public Dominators<Forwards> Dominators { get; }
+
+        /// <summary>
+        /// Returns the computed value mapping.
+        /// </summary>
+        public AnalysisValueMapping<ValueRange> Values { get; private set; }
+
+        /// <summary>
+        /// Returns the range of the given value.
+        /// </summary>
+        /// <param name="value">The IR value.</param>
+        /// <returns>The determined range.</returns>
+        public ValueRange this[Value value] =>
+            Values.TryGetValue(value, out var data)
+            ? data.Data
+            : ValueRange.GetFull(value.BasicValueType);
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Performs the fix point iteration until all ranges are stable.
+        /// </summary>
+        /// <param name="method">The method to analyze.</param>
+        private void AnalyzeRanges(Method method)
+        {
+            var valueMapping = new Dictionary<Value, AnalysisValue<ValueRange>>(
+                method.NumParameters);
+            foreach (var param in method.Parameters)
+                valueMapping[param] = CreateValue(param.Type);
+            Values = new AnalysisValueMapping<ValueRange>(valueMapping);
+
+            // Values that are used in non-adjacent blocks might not be revisited by a
+            // single analysis run. We reuse the current mapping until it is stable.
+            var returnMapping = AnalysisReturnValueMapping.Create<ValueRange>();
+            do
+            {
+                changed = false;
+                Analyze(method.Blocks, Values, returnMapping);
+            }
+            while (changed);
+        }
+
+        /// <summary>
+        /// Returns the range of the given value in the given block while taking all
+        /// dominating branch conditions into account.
+        /// </summary>
+        /// <param name="value">The IR value.</param>
+        /// <param name="block">The block in which the value is used.</param>
+        /// <returns>The refined range.</returns>
+        public ValueRange GetRange(Value value, BasicBlock block)
+        {
+            var range = this[value];
+            if (!value.BasicValueType.IsInt())
+                return range;
+
+            var conditions = Dominators.GetDominatingConditions(block);
+            foreach (var (condition, holds) in conditions)
+            {
+                if (condition is CompareValue compare &&
+                    TryNormalize(compare, holds, value, out var kind, out var other))
+                {
+                    range = range.Refine(kind, this[other]);
+                }
+            }
+            return range;
+        }
+
+        /// <summary>
+        /// Computes the current range of the given primitive value.
+        /// </summary>
+        private ValueRange ComputeRange(Value value)
+        {
+            var type = value.BasicValueType;
+            switch (value)
+            {
+                case ConvertValue convert when
+                    type.IsInt() && convert.Value.BasicValueType.IsInt():
+                    var sourceType = convert.Value.BasicValueType;
+                    var source = GetRange(convert.Value, value.BasicBlock);
+                    if (source.IsEmpty)
+                        return source;
+                    if (convert.IsSourceUnsigned && source.Min < 0)
+                        source = ValueRange.GetFullUnsigned(sourceType);
+                    var target = ValueRange.GetFull(type);
+                    return source.Min >= target.Min && source.Max <= target.Max
+                        ? source
+                        : target;
+                case UnaryArithmeticValue unary when
+                    unary.Kind == UnaryArithmeticKind.Neg && type.IsInt():
+                    return ValueRange.Create(0).Apply(
+                        BinaryArithmeticKind.Sub,
+                        GetRange(unary.Value, value.BasicBlock),
+                        type);
+                case BinaryArithmeticValue binary when
+                    type.IsInt() && type != BasicValueType.Int1:
+                    var left = GetRange(binary.Left, value.BasicBlock);
+                    var right = GetRange(binary.Right, value.BasicBlock);
+                    if (binary.IsUnsigned &&
+                        (!left.IsNonNegative || !right.IsNonNegative))
+                    {
+                        return ValueRange.GetFull(type);
+                    }
+                    return left.Apply(binary.Kind, right, type);
+                default:
+                    return TryGetConstantRange(value) ?? ValueRange.GetFull(type);
+            }
+        }
+
+        /// <summary>
+        /// Creates the initial range of the given value.
+        /// </summary>
+        protected override AnalysisValue<ValueRange> CreateData(Value node) =>
+            CreateValue(TryGetConstantRange(node) ?? ValueRange.Empty, node.Type);
+
+        /// <summary>
+        /// Returns the union of both ranges.
+        /// </summary>
+        protected override ValueRange Merge(ValueRange first, ValueRange second) =>
+            first.Union(second);
+
+        /// <summary>
+        /// Provides the full range of all primitive types.
+        /// </summary>
+        protected override AnalysisValue<ValueRange>? TryProvide(TypeNode typeNode) =>
+            typeNode is PrimitiveType primitiveType
+            ? CreateValue(ValueRange.GetFull(primitiveType.BasicValueType), typeNode)
+            : default(AnalysisValue<ValueRange>?);
+
+        /// <summary>
+        /// Computes the range of the given value. All non-primitive values are
+        /// unconstrained.
+        /// </summary>
+        protected override AnalysisValue<ValueRange>? TryMerge<TContext>(
+            Value value,
+            TContext context)
+        {
+            if (!(value.Type is PrimitiveType))
+                return CreateValue(value.Type);
+            var range = context[value].Data.Union(ComputeRange(value));
+            return CreateValue(range, value.Type);
+        }
+
+        /// <summary>
+        /// Updates the given value and widens the ranges of all phi values that have
+        /// changed to ensure termination.
+        /// </summary>
+        protected override bool Update<TContext>(Value node, TContext context)
+        {
+            var oldValue = context[node];
+            if (!base.Update(node, context))
+                return false;
+
+            if (node is PhiValue && node.Type is PrimitiveType)
+            {
+                var widened = oldValue.Data.Widen(
+                    context[node].Data,
+                    node.BasicValueType);
+                context[node] = CreateValue(widened, node.Type);
+            }
+            changed = true;
+            return true;
+        }
+
+        #endregion
+    }
+}
@@ -540,13 +540,13 @@ namespace ILGPU.IR
             var newTerminator = CompactTerminator();
             newTerminator.GC();
 
-            var newValues = new List<ValueReference>(Count);
-            foreach (Value value in values)
+            // Refresh all values in place to avoid allocating new value lists
+            for (int i = 0, e = values.Count; i < e; ++i)
             {
+                Value value = values[i];
                 value.GC();
-                newValues.Add(value);
+                values[i] = value;
             }
-            values = newValues;
         }
 
         /// <summary>
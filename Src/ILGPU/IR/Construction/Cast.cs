@@ -182,6 +182,9 @@ namespace ILGPU.IR.Construction
                     BasicValueType.Float64 => CreatePrimitiveValue(
                         location,
                         Interop.FloatAsInt(primitive.Float64Value)),
+                    BasicValueType.BFloat16 => CreatePrimitiveValue(
+                        location,
+                        Interop.FloatAsInt(primitive.BFloat16Value)),
                     _ => throw location.GetNotSupportedException(
                         ErrorMessages.NotSupportedFloatIntCast,
                         primitiveType),
@@ -193,6 +196,7 @@ namespace ILGPU.IR.Construction
                 BasicValueType.Float16 => BasicValueType.Int16,
                 BasicValueType.Float32 => BasicValueType.Int32,
                 BasicValueType.Float64 => BasicValueType.Int64,
+                BasicValueType.BFloat16 => BasicValueType.Int16,
                 _ => throw location.GetNotSupportedException(
                     ErrorMessages.NotSupportedFloatIntCast,
                     primitiveType),
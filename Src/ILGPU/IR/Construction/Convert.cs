@@ -200,6 +200,27 @@ namespace ILGPU.IR.Construction
             {
                 var targetBasicValueType = targetType.BasicValueType;
 
+                // Fold brain floats via their single precision values
+                if (value.BasicValueType == BasicValueType.BFloat16)
+                {
+                    return CreateConvert(
+                        location,
+                        CreatePrimitiveValue(location, (float)value.BFloat16Value),
+                        targetType,
+                        flags);
+                }
+                else if (targetBasicValueType == BasicValueType.BFloat16)
+                {
+                    var floatValue = CreateConvert(
+                        location,
+                        value,
+                        GetPrimitiveType(BasicValueType.Float32),
+                        flags).ResolveAs<PrimitiveValue>();
+                    return CreatePrimitiveValue(
+                        location,
+                        (BFloat16)floatValue.Float32Value);
+                }
+
                 switch (value.BasicValueType)
                 {
                     case BasicValueType.Int1:
@@ -318,9 +318,20 @@ namespace ILGPU.IR
                 var returnType = typeConverter.ConvertType(
                     BaseContext,
                     Method.ReturnType);
-                Method.Declaration = Method.Declaration.Specialize(returnType);
+                UpdateReturnType(returnType);
             }
 
+            /// <summary>
+            /// Updates the return type.
+            /// </summary>
+            /// <param name="returnType">The new return type.</param>
+            /// <remarks>
+            /// CAUTION: All return terminators and call sites have to be adapted
+            /// accordingly.
+            /// </remarks>
+            public void UpdateReturnType(TypeNode returnType) =>
+                Method.Declaration = Method.Declaration.Specialize(returnType);
+
             /// <summary>
             /// Converts all parameter types.
             /// </summary>
@@ -600,7 +611,7 @@ namespace ILGPU.IR
                     block.PropagateSuccessors();
 
                 // Apply changes to the method
-                Method.blocks = newBlocks.AsImmutable();
+                Method.UpdateBlocks(newBlocks.AsImmutable());
                 return newBlocks;
             }
 
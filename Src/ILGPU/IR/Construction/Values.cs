@@ -97,6 +97,8 @@ namespace ILGPU.IR.Construction
                     CreatePrimitiveValue(location, (float)value),
                 ArithmeticBasicValueType.Float64 =>
                     CreatePrimitiveValue(location, (double)value),
+                ArithmeticBasicValueType.BFloat16 =>
+                    CreatePrimitiveValue(location, (BFloat16)value),
                 _ => type == typeof(string)
                     ? CreatePrimitiveValue(location, (string)value)
                     : throw location.GetArgumentException(nameof(value))
@@ -244,6 +246,18 @@ namespace ILGPU.IR.Construction
                 BasicValueType.Float16,
                 value.RawValue));
 
+        /// <summary>
+        /// Creates a primitive <see cref="BFloat16"/> value.
+        /// </summary>
+        /// <param name="location">The current location.</param>
+        /// <param name="value">The value.</param>
+        /// <returns>The created primitive value.</returns>
+        public PrimitiveValue CreatePrimitiveValue(Location location, BFloat16 value) =>
+            Append(new PrimitiveValue(
+                GetInitializer(location),
+                BasicValueType.BFloat16,
+                value.RawValue));
+
         /// <summary>
         /// Creates a primitive <see cref="float"/> value.
         /// </summary>
@@ -328,6 +342,8 @@ namespace ILGPU.IR.Construction
                     CreatePrimitiveValue(location, Convert.ToSingle(value)),
                 ArithmeticBasicValueType.Float64 =>
                     CreatePrimitiveValue(location, Convert.ToDouble(value)),
+                ArithmeticBasicValueType.BFloat16 =>
+                    CreatePrimitiveValue(location, (BFloat16)value),
                 _ => value == null
                     ? CreateNull(location, CreateType(type))
                     : CreateObjectValue(location, value),
@@ -97,6 +97,7 @@ namespace ILGPU.IR
         private readonly Action<Method> gcDelegate;
 
         private readonly MethodMapping<Method> methods = new MethodMapping<Method>();
+        private int methodsVersion;
 
         /// <summary>
         /// Constructs a new IR context.
@@ -297,9 +298,32 @@ namespace ILGPU.IR
             created = true;
             method = DeclareNewMethod_Sync(declaration, out var handle);
             methods.Register(handle, method);
+            ++methodsVersion;
             return method;
         }
 
+        /// <summary>
+        /// Removes the given method from this context.
+        /// </summary>
+        /// <param name="method">The method to remove.</param>
+        /// <returns>True, if the method has been removed.</returns>
+        /// <remarks>
+        /// CAUTION: The method must not be referenced by any other method in this
+        /// context.
+        /// </remarks>
+        internal bool Remove(Method method)
+        {
+            Debug.Assert(method != null, "Invalid method");
+
+            // Remove the method sync using a write scope
+            using var writeScope = irLock.EnterWriteScope();
+
+            if (!methods.Remove(method.Handle))
+                return false;
+            ++methodsVersion;
+            return true;
+        }
+
         /// <summary>
         /// Declares a new method (sync).
         /// </summary>
@@ -476,7 +500,13 @@ namespace ILGPU.IR
             // Apply all transformations
             foreach (var transform in transformer.Transformations)
             {
+                int version = methodsVersion;
                 transform.Transform(toTransform);
+
+                // Include all methods that have been created or removed by the
+                // current transformation (e.g. specialized method clones)
+                if (version != methodsVersion)
+                    toTransform = GetMethodCollection_Sync(configuration.Predicate);
                 Verifier.Verify(toTransform);
             }
 
@@ -517,6 +547,7 @@ namespace ILGPU.IR
             using var writeScope = irLock.EnterWriteScope();
 
             methods.Clear();
+            ++methodsVersion;
         }
 
         #endregion
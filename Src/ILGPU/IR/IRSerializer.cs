@@ -0,0 +1,1593 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: IRSerializer.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.IR.Analyses;
+using ILGPU.IR.Construction;
+using ILGPU.IR.Types;
+using ILGPU.IR.Values;
+using ILGPU.Resources;
+using System;
+using System.Collections.Generic;
+using System.Collections.Immutable;
+using System.IO;
+using System.Reflection;
+using System.Text;
+using static ILGPU.IR.Types.IRTypeSerializer;
+using static ILGPU.Util.FormatString;
+using FormatArray = System.Collections.Immutable.ImmutableArray<
+    ILGPU.Util.FormatString.FormatExpression>;
+using ValueList = ILGPU.Util.InlineList<ILGPU.IR.Values.ValueReference>;
+
+namespace ILGPU.IR
+{
+    /// <summary>
+    /// Serializes and deserializes complete IR methods (including all called methods)
+    /// using a compact and versioned binary format.
+    /// </summary>
+    /// <remarks>
+    /// A serialized method consists of a type table (see
+    /// <see cref="IRTypeSerializer"/>), a method table that contains the declarations
+    /// of all transitively referenced methods and the bodies of all methods that have
+    /// an implementation. External and intrinsic methods are stored as references to
+    /// their managed source methods, which are resolved via reflection during
+    /// deserialization. This allows the deserialized IR to bind to all intrinsic
+    /// implementations of the current backends.
+    /// </remarks>
+    public static class IRSerializer
+    {
+        #region Nested Types
+
+        /// <summary>
+        /// Identifies the kind of a serialized location.
+        /// </summary>
+        private enum SerializedLocationKind : byte
+        {
+            Unknown,
+            File,
+        }
+
+        /// <summary>
+        /// Identifies the kind of a serialized managed member.
+        /// </summary>
+        private enum SerializedMemberKind : byte
+        {
+            Type,
+            Method,
+            Field,
+        }
+
+        /// <summary>
+        /// Writes all method declarations and method bodies.
+        /// </summary>
+        private sealed class MethodWriter
+        {
+            #region Instance
+
+            private readonly Dictionary<Method, int> methods =
+                new Dictionary<Method, int>();
+            private readonly Dictionary<BasicBlock, int> blocks =
+                new Dictionary<BasicBlock, int>();
+            private readonly Dictionary<Value, int> values =
+                new Dictionary<Value, int>();
+
+            /// <summary>
+            /// Constructs a new method writer.
+            /// </summary>
+            /// <param name="writer">The target writer.</param>
+            /// <param name="references">All methods to serialize.</param>
+            public MethodWriter(BinaryWriter writer, in References references)
+            {
+                Writer = writer;
+                foreach (var method in references)
+                {
+                    methods.Add(method, Methods.Count);
+                    Methods.Add(method);
+                }
+            }
+
+            #endregion
+
+            #region Properties
+
+            /// <summary>
+            /// Returns the underlying writer.
+            /// </summary>
+            public BinaryWriter Writer { get; }
+
+            /// <summary>
+            /// Returns the type table of all referenced types.
+            /// </summary>
+            public IRTypeSerializer.TypeTable Types { get; } =
+                new IRTypeSerializer.TypeTable();
+
+            /// <summary>
+            /// Returns all methods in method-table order.
+            /// </summary>
+            public List<Method> Methods { get; } = new List<Method>();
+
+            #endregion
+
+            #region Methods
+
+            /// <summary>
+            /// Writes all method declarations and bodies.
+            /// </summary>
+            public void Write()
+            {
+                Writer.Write(Methods.Count);
+                foreach (var method in Methods)
+                    WriteDeclaration(method);
+                foreach (var method in Methods)
+                {
+                    if (method.HasImplementation)
+                        WriteBody(method);
+                }
+            }
+
+            /// <summary>
+            /// Writes a type reference.
+            /// </summary>
+            private void WriteType(TypeNode type) =>
+                Writer.Write(Types.Register(type));
+
+            /// <summary>
+            /// Writes the declaration of the given method.
+            /// </summary>
+            private void WriteDeclaration(Method method)
+            {
+                Writer.Write(method.Handle.Name);
+                WriteEnum(Writer, method.Flags);
+                WriteEnum(
+                    Writer,
+                    method.TransformationFlags & MethodTransformationFlags.Transformed);
+                WriteType(method.ReturnType);
+                Writer.Write(method.HasSource);
+                if (method.HasSource)
+                    WriteMember(Writer, method.Source);
+                else if (!method.HasImplementation)
+                {
+                    // External methods without a managed source cannot be bound again
+                    throw new NotSupportedException(string.Format(
+                        ErrorMessages.NotSupportedIRSerialization,
+                        method));
+                }
+                Writer.Write(method.HasImplementation);
+            }
+
+            /// <summary>
+            /// Writes the body of the given method.
+            /// </summary>
+            private void WriteBody(Method method)
+            {
+                blocks.Clear();
+                values.Clear();
+
+                // Write all parameters
+                Writer.Write(method.NumParameters);
+                foreach (var param in method.Parameters)
+                {
+                    values.Add(param, values.Count);
+                    WriteType(param.Type);
+                    WriteOptionalString(Writer, param.Name);
+                }
+
+                // Write all blocks
+                var methodBlocks = method.Blocks;
+                Writer.Write(methodBlocks.Count);
+                foreach (var block in methodBlocks)
+                {
+                    blocks.Add(block, blocks.Count);
+                    WriteLocation(Writer, block.Location);
+                    WriteOptionalString(Writer, block.Name);
+                }
+
+                // Declare all phi values in advance to support back edges
+                var phis = new List<PhiValue>();
+                foreach (var block in methodBlocks)
+                {
+                    int numPhis = 0;
+                    foreach (Value value in block)
+                    {
+                        if (value is PhiValue)
+                            ++numPhis;
+                    }
+                    Writer.Write(numPhis);
+                    foreach (Value value in block)
+                    {
+                        if (!(value is PhiValue phiValue))
+                            continue;
+                        values.Add(phiValue, values.Count);
+                        phis.Add(phiValue);
+                        WriteType(phiValue.PhiType);
+                        WriteLocation(Writer, phiValue.Location);
+                    }
+                }
+
+                // Write all values and terminators
+                foreach (var block in methodBlocks)
+                {
+                    foreach (Value value in block)
+                        WriteValue(value);
+                    WriteTerminator(block.Terminator.ResolveAs<TerminatorValue>());
+                }
+
+                // Write all phi arguments
+                foreach (var phi in phis)
+                {
+                    Writer.Write(phi.Count);
+                    for (int i = 0, e = phi.Count; i < e; ++i)
+                    {
+                        Writer.Write(blocks[phi.Sources[i]]);
+                        Writer.Write(GetValueId(phi[i]));
+                    }
+                }
+            }
+
+            /// <summary>
+            /// Returns the identifier of an already written value.
+            /// </summary>
+            private int GetValueId(Value value)
+            {
+                value = value.Resolve();
+                return value is UndefinedValue ? -1 : values[value];
+            }
+
+            /// <summary>
+            /// Writes the given value and all of its operands that have not been
+            /// written so far.
+            /// </summary>
+            /// <param name="value">The value to write.</param>
+            private void WriteValue(Value value)
+            {
+                value = value.Resolve();
+                if (value is UndefinedValue || values.ContainsKey(value))
+                    return;
+
+                // Ensure that all operands have been written before
+                foreach (var operand in value.Nodes)
+                    WriteValue(operand);
+
+                WriteEnum(Writer, value.ValueKind);
+                WriteLocation(Writer, value.Location);
+                WriteOperands(value);
+                WriteValueData(value);
+                values.Add(value, values.Count);
+            }
+
+            /// <summary>
+            /// Writes all operand references of the given value.
+            /// </summary>
+            private void WriteOperands(Value value)
+            {
+                Writer.Write(value.Count);
+                foreach (var operand in value.Nodes)
+                    Writer.Write(GetValueId(operand));
+            }
+
+            /// <summary>
+            /// Writes all value-specific data of the given value that is not covered
+            /// by its operands.
+            /// </summary>
+            private void WriteValueData(Value value)
+            {
+                switch (value)
+                {
+                    case UnaryArithmeticValue unary:
+                        WriteEnum(Writer, unary.Kind);
+                        WriteEnum(Writer, unary.Flags);
+                        break;
+                    case BinaryArithmeticValue binary:
+                        WriteEnum(Writer, binary.Kind);
+                        WriteEnum(Writer, binary.Flags);
+                        break;
+                    case TernaryArithmeticValue ternary:
+                        WriteEnum(Writer, ternary.Kind);
+                        WriteEnum(Writer, ternary.Flags);
+                        break;
+                    case CompareValue compare:
+                        WriteEnum(Writer, compare.Kind);
+                        WriteEnum(Writer, compare.Flags);
+                        break;
+                    case ConvertValue convert:
+                        WriteType(convert.Type);
+                        WriteEnum(Writer, convert.Flags);
+                        break;
+                    case PointerCast pointerCast:
+                        WriteType(pointerCast.TargetElementType);
+                        break;
+                    case ViewCast viewCast:
+                        WriteType(viewCast.TargetElementType);
+                        break;
+                    case AddressSpaceCast addressSpaceCast:
+                        WriteEnum(Writer, addressSpaceCast.TargetAddressSpace);
+                        break;
+                    case PointerAsIntCast pointerAsIntCast:
+                        WriteEnum(Writer, pointerAsIntCast.TargetBasicValueType);
+                        break;
+                    case NullValue nullValue:
+                        WriteType(nullValue.Type);
+                        break;
+                    case PrimitiveValue primitive:
+                        WriteEnum(Writer, primitive.BasicValueType);
+                        Writer.Write(primitive.RawValue);
+                        break;
+                    case StringValue stringValue:
+                        Writer.Write(stringValue.String);
+                        Writer.Write(stringValue.Encoding.CodePage);
+                        break;
+                    case DeviceConstantDimensionValue dimensionValue:
+                        WriteEnum(Writer, dimensionValue.Dimension);
+                        break;
+                    case DynamicMemoryLengthValue lengthValue:
+                        WriteType(lengthValue.ElementType);
+                        WriteEnum(Writer, lengthValue.AddressSpace);
+                        break;
+                    case Alloca alloca:
+                        WriteType(alloca.AllocaType);
+                        WriteEnum(Writer, alloca.AddressSpace);
+                        break;
+                    case MemoryBarrier barrier:
+                        WriteEnum(Writer, barrier.Kind);
+                        break;
+                    case MethodCall call:
+                        Writer.Write(methods[call.Target]);
+                        break;
+                    case StructureValue structureValue:
+                        WriteType(structureValue.StructureType);
+                        break;
+                    case GetField getField:
+                        WriteFieldSpan(getField.FieldSpan);
+                        break;
+                    case SetField setField:
+                        WriteFieldSpan(setField.FieldSpan);
+                        break;
+                    case LoadFieldAddress loadFieldAddress:
+                        WriteFieldSpan(loadFieldAddress.FieldSpan);
+                        break;
+                    case GetViewLength getViewLength:
+                        WriteEnum(Writer, getViewLength.LengthType);
+                        break;
+                    case NewArray newArray:
+                        WriteType(newArray.Type);
+                        break;
+                    case GenericAtomic atomic:
+                        WriteEnum(Writer, atomic.Kind);
+                        WriteEnum(Writer, atomic.Flags);
+                        break;
+                    case AtomicCAS atomicCAS:
+                        WriteEnum(Writer, atomicCAS.Flags);
+                        break;
+                    case PredicateBarrier predicateBarrier:
+                        WriteEnum(Writer, predicateBarrier.Kind);
+                        break;
+                    case Barrier barrier:
+                        WriteEnum(Writer, barrier.Kind);
+                        break;
+                    case Broadcast broadcast:
+                        WriteEnum(Writer, broadcast.Kind);
+                        break;
+                    case ShuffleOperation shuffle:
+                        WriteEnum(Writer, shuffle.Kind);
+                        break;
+                    case HandleValue handle:
+                        WriteMember(Writer, handle.Handle as MemberInfo ??
+                            throw new NotSupportedException(string.Format(
+                                ErrorMessages.NotSupportedIRSerialization,
+                                handle.Handle)));
+                        break;
+                    case WriteToOutput writeToOutput:
+                        WriteExpressions(writeToOutput.Expressions);
+                        break;
+                    case LanguageEmitValue emitValue:
+                        WriteEnum(Writer, emitValue.LanguageKind);
+                        Writer.Write(emitValue.HasOutput);
+                        WriteExpressions(emitValue.Expressions);
+                        break;
+                    case Predicate _:
+                    case IntAsPointerCast _:
+                    case ArrayToViewCast _:
+                    case FloatAsIntCast _:
+                    case IntAsFloatCast _:
+                    case AcceleratorTypeValue _:
+                    case WarpSizeValue _:
+                    case LaneIdxValue _:
+                    case Load _:
+                    case Store _:
+                    case SubViewValue _:
+                    case LoadElementAddress _:
+                    case LoadArrayElementAddress _:
+                    case NewView _:
+                    case AlignViewTo _:
+                    case GetArrayLength _:
+                    case DebugAssertOperation _:
+                        // All information is stored in the operands
+                        break;
+                    default:
+                        throw new NotSupportedException(string.Format(
+                            ErrorMessages.NotSupportedIRSerialization,
+                            value));
+                }
+            }
+
+            /// <summary>
+            /// Writes the given terminator and all of its operands.
+            /// </summary>
+            private void WriteTerminator(TerminatorValue terminator)
+            {
+                foreach (var operand in terminator.Nodes)
+                    WriteValue(operand);
+
+                WriteEnum(Writer, terminator.ValueKind);
+                WriteLocation(Writer, terminator.Location);
+                WriteOperands(terminator);
+                switch (terminator)
+                {
+                    case ReturnTerminator _:
+                        break;
+                    case UnconditionalBranch branch:
+                        Writer.Write(blocks[branch.Target]);
+                        break;
+                    case IfBranch ifBranch:
+                        Writer.Write(blocks[ifBranch.TrueTarget]);
+                        Writer.Write(blocks[ifBranch.FalseTarget]);
+                        WriteEnum(Writer, ifBranch.Flags);
+                        break;
+                    case SwitchBranch switchBranch:
+                        Writer.Write(switchBranch.NumTargets);
+                        foreach (var target in switchBranch.Targets)
+                            Writer.Write(blocks[target]);
+                        break;
+                    default:
+                        throw new NotSupportedException(string.Format(
+                            ErrorMessages.NotSupportedIRSerialization,
+                            terminator));
+                }
+            }
+
+            /// <summary>
+            /// Writes a field span.
+            /// </summary>
+            private void WriteFieldSpan(FieldSpan fieldSpan)
+            {
+                Writer.Write(fieldSpan.Index);
+                Writer.Write(fieldSpan.Span);
+            }
+
+            /// <summary>
+            /// Writes an array of format expressions.
+            /// </summary>
+            private void WriteExpressions(FormatArray expressions)
+            {
+                Writer.Write(expressions.Length);
+                foreach (var expression in expressions)
+                {
+                    Writer.Write(expression.HasArgument);
+                    if (expression.HasArgument)
+                        Writer.Write(expression.Argument);
+                    else
+                        Writer.Write(expression.String);
+                }
+            }
+
+            #endregion
+        }
+
+        /// <summary>
+        /// Reads all method declarations and method bodies.
+        /// </summary>
+        private sealed class MethodReader
+        {
+            #region Instance
+
+            private readonly List<BasicBlock.Builder> blocks =
+                new List<BasicBlock.Builder>();
+            private readonly List<Value> values = new List<Value>();
+
+            /// <summary>
+            /// Constructs a new method reader.
+            /// </summary>
+            /// <param name="reader">The source reader.</param>
+            /// <param name="context">The target context.</param>
+            /// <param name="types">The deserialized type table.</param>
+            /// <param name="assemblyResolver">
+            /// The assembly resolver to use (if any).
+            /// </param>
+            public MethodReader(
+                BinaryReader reader,
+                IRContext context,
+                TypeNode[] types,
+                Func<AssemblyName, Assembly> assemblyResolver)
+            {
+                Reader = reader;
+                Context = context;
+                Types = types;
+                AssemblyResolver = assemblyResolver;
+            }
+
+            #endregion
+
+            #region Properties
+
+            /// <summary>
+            /// Returns the underlying reader.
+            /// </summary>
+            public BinaryReader Reader { get; }
+
+            /// <summary>
+            /// Returns the target context.
+            /// </summary>
+            public IRContext Context { get; }
+
+            /// <summary>
+            /// Returns the deserialized type table.
+            /// </summary>
+            public TypeNode[] Types { get; }
+
+            /// <summary>
+            /// Returns the assembly resolver (if any).
+            /// </summary>
+            public Func<AssemblyName, Assembly> AssemblyResolver { get; }
+
+            /// <summary>
+            /// Returns all methods in method-table order.
+            /// </summary>
+            public Method[] Methods { get; private set; }
+
+            #endregion
+
+            #region Methods
+
+            /// <summary>
+            /// Reads all method declarations and bodies.
+            /// </summary>
+            public void Read()
+            {
+                int numMethods = ReadCount(Reader);
+                if (numMethods < 1)
+                    throw GetInvalidDataException();
+                Methods = new Method[numMethods];
+                var transformationFlags = new MethodTransformationFlags[numMethods];
+                for (int i = 0; i < numMethods; ++i)
+                    Methods[i] = ReadDeclaration(out transformationFlags[i]);
+
+                for (int i = 0; i < numMethods; ++i)
+                {
+                    var method = Methods[i];
+                    if (!method.HasImplementation)
+                        continue;
+
+                    var builder = method.CreateBuilder();
+                    try
+                    {
+                        ReadBody(builder);
+                    }
+                    catch
+                    {
+                        // Incomplete methods cannot be finalized by their builders
+                        GC.SuppressFinalize(builder);
+                        throw;
+                    }
+                    builder.Dispose();
+                    method.AddTransformationFlags(transformationFlags[i]);
+                }
+            }
+
+            /// <summary>
+            /// Reads a type reference.
+            /// </summary>
+            private TypeNode ReadType() => ReadTypeReference(Reader, Types);
+
+            /// <summary>
+            /// Reads a type reference of a specific type.
+            /// </summary>
+            private T ReadType<T>()
+                where T : TypeNode =>
+                ReadType() as T ?? throw GetInvalidDataException();
+
+            /// <summary>
+            /// Reads a method declaration and declares the method.
+            /// </summary>
+            private Method ReadDeclaration(
+                out MethodTransformationFlags transformationFlags)
+            {
+                var name = Reader.ReadString();
+                var flags = ReadEnum<MethodFlags>(Reader);
+                transformationFlags = ReadEnum<MethodTransformationFlags>(Reader);
+                var returnType = ReadType();
+                var source = Reader.ReadBoolean()
+                    ? ReadMember(Reader, AssemblyResolver) as MethodBase ??
+                        throw GetInvalidDataException()
+                    : null;
+                bool hasImplementation = Reader.ReadBoolean();
+                bool isExternal = (flags &
+                    (MethodFlags.External | MethodFlags.Intrinsic)) !=
+                    MethodFlags.None;
+                if (hasImplementation == isExternal || string.IsNullOrEmpty(name))
+                    throw GetInvalidDataException();
+
+                // Bind external and intrinsic methods to their managed sources
+                if (!hasImplementation)
+                {
+                    if (source is null)
+                        throw GetInvalidDataException();
+                    var external = Context.Declare(source, out _);
+                    return !external.HasImplementation
+                        ? external
+                        : throw GetInvalidDataException();
+                }
+
+                var declaration = new MethodDeclaration(
+                    MethodHandle.Create(name),
+                    returnType,
+                    source,
+                    flags);
+                var method = Context.Declare(declaration, out _);
+                method.RemoveFlags(method.Flags & ~flags);
+                return method;
+            }
+
+            /// <summary>
+            /// Reads the body of the current method.
+            /// </summary>
+            /// <param name="builder">The builder of the current method.</param>
+            private void ReadBody(Method.Builder builder)
+            {
+                blocks.Clear();
+                values.Clear();
+
+                // Read all parameters
+                int numParameters = ReadCount(Reader);
+                for (int i = 0; i < numParameters; ++i)
+                {
+                    var paramType = ReadType();
+                    values.Add(builder.AddParameter(
+                        paramType,
+                        ReadOptionalString(Reader)));
+                }
+
+                // Read all blocks
+                int numBlocks = ReadCount(Reader);
+                if (numBlocks < 1)
+                    throw GetInvalidDataException();
+                for (int i = 0; i < numBlocks; ++i)
+                {
+                    var location = ReadLocation(Reader);
+                    var name = ReadOptionalString(Reader);
+                    blocks.Add(i < 1
+                        ? builder.EntryBlockBuilder
+                        : builder.CreateBasicBlock(location, name));
+                }
+
+                // Declare all phi values
+                var phis = new List<PhiValue.Builder>();
+                foreach (var block in blocks)
+                {
+                    int numPhis = ReadCount(Reader);
+                    for (int i = 0; i < numPhis; ++i)
+                    {
+                        var phiType = ReadType();
+                        var phiBuilder = block.CreatePhi(ReadLocation(Reader), phiType);
+                        phis.Add(phiBuilder);
+                        values.Add(phiBuilder.PhiValue);
+                    }
+                }
+
+                // Read all values and terminators
+                foreach (var block in blocks)
+                {
+                    while (ReadValue(block)) { }
+                }
+
+                // Seal all phi values
+                foreach (var phi in phis)
+                {
+                    int numArguments = ReadCount(Reader);
+                    for (int i = 0; i < numArguments; ++i)
+                    {
+                        var source = ReadBlock();
+                        phi.AddArgument(source.BasicBlock, ReadValueReference());
+                    }
+                    phi.Seal();
+                }
+            }
+
+            /// <summary>
+            /// Reads a reference to a block of the current method.
+            /// </summary>
+            private BasicBlock.Builder ReadBlock()
+            {
+                int index = Reader.ReadInt32();
+                return index >= 0 && index < blocks.Count
+                    ? blocks[index]
+                    : throw GetInvalidDataException();
+            }
+
+            /// <summary>
+            /// Reads a reference to a value that has already been read.
+            /// </summary>
+            private Value ReadValueReference()
+            {
+                int id = Reader.ReadInt32();
+                if (id == -1)
+                    return Context.UndefinedValue;
+                return id >= 0 && id < values.Count
+                    ? values[id]
+                    : throw GetInvalidDataException();
+            }
+
+            /// <summary>
+            /// Reads all operands of the current value.
+            /// </summary>
+            private ValueList ReadOperands()
+            {
+                int numOperands = ReadCount(Reader);
+                var operands = ValueList.Create(numOperands);
+                for (int i = 0; i < numOperands; ++i)
+                    operands.Add(ReadValueReference());
+                return operands;
+            }
+
+            /// <summary>
+            /// Reads a single value or terminator into the given block.
+            /// </summary>
+            /// <param name="block">The current block builder.</param>
+            /// <returns>False, if a terminator has been read.</returns>
+            private bool ReadValue(BasicBlock.Builder block)
+            {
+                var kind = ReadEnum<ValueKind>(Reader);
+                var location = ReadLocation(Reader);
+                var operands = ReadOperands();
+
+                Value Operand(int index) =>
+                    index < operands.Count
+                    ? operands[index].Resolve()
+                    : throw GetInvalidDataException();
+                void ExpectOperands(int count)
+                {
+                    if (operands.Count != count)
+                        throw GetInvalidDataException();
+                }
+
+                Value value;
+                switch (kind)
+                {
+                    case ValueKind.UnaryArithmetic:
+                        ExpectOperands(1);
+                        value = block.CreateArithmetic(
+                            location,
+                            Operand(0),
+                            ReadEnum<UnaryArithmeticKind>(Reader),
+                            ReadEnum<ArithmeticFlags>(Reader));
+                        break;
+                    case ValueKind.BinaryArithmetic:
+                        ExpectOperands(2);
+                        value = block.CreateArithmetic(
+                            location,
+                            Operand(0),
+                            Operand(1),
+                            ReadEnum<BinaryArithmeticKind>(Reader),
+                            ReadEnum<ArithmeticFlags>(Reader));
+                        break;
+                    case ValueKind.TernaryArithmetic:
+                        ExpectOperands(3);
+                        value = block.CreateArithmetic(
+                            location,
+                            Operand(0),
+                            Operand(1),
+                            Operand(2),
+                            ReadEnum<TernaryArithmeticKind>(Reader),
+                            ReadEnum<ArithmeticFlags>(Reader));
+                        break;
+                    case ValueKind.Compare:
+                        ExpectOperands(2);
+                        value = block.CreateCompare(
+                            location,
+                            Operand(0),
+                            Operand(1),
+                            ReadEnum<CompareKind>(Reader),
+                            ReadEnum<CompareFlags>(Reader));
+                        break;
+                    case ValueKind.Convert:
+                        ExpectOperands(1);
+                        value = block.CreateConvert(
+                            location,
+                            Operand(0),
+                            ReadType<PrimitiveType>(),
+                            ReadEnum<ConvertFlags>(Reader));
+                        break;
+                    case ValueKind.Predicate:
+                        ExpectOperands(3);
+                        value = block.CreatePredicate(
+                            location,
+                            Operand(0),
+                            Operand(1),
+                            Operand(2));
+                        break;
+                    case ValueKind.PointerCast:
+                        ExpectOperands(1);
+                        value = block.CreatePointerCast(
+                            location,
+                            Operand(0),
+                            ReadType());
+                        break;
+                    case ValueKind.AddressSpaceCast:
+                        ExpectOperands(1);
+                        value = block.CreateAddressSpaceCast(
+                            location,
+                            Operand(0),
+                            ReadEnum<MemoryAddressSpace>(Reader));
+                        break;
+                    case ValueKind.ViewCast:
+                        ExpectOperands(1);
+                        value = block.CreateViewCast(
+                            location,
+                            Operand(0),
+                            ReadType());
+                        break;
+                    case ValueKind.ArrayToViewCast:
+                        ExpectOperands(1);
+                        value = block.CreateArrayToViewCast(location, Operand(0));
+                        break;
+                    case ValueKind.IntAsPointerCast:
+                        ExpectOperands(1);
+                        value = block.CreateIntAsPointerCast(location, Operand(0));
+                        break;
+                    case ValueKind.PointerAsIntCast:
+                        ExpectOperands(1);
+                        value = block.CreatePointerAsIntCast(
+                            location,
+                            Operand(0),
+                            ReadEnum<BasicValueType>(Reader));
+                        break;
+                    case ValueKind.FloatAsIntCast:
+                        ExpectOperands(1);
+                        value = block.CreateFloatAsIntCast(location, Operand(0));
+                        break;
+                    case ValueKind.IntAsFloatCast:
+                        ExpectOperands(1);
+                        value = block.CreateIntAsFloatCast(location, Operand(0));
+                        break;
+                    case ValueKind.Null:
+                        ExpectOperands(0);
+                        value = block.CreateNull(location, ReadType());
+                        break;
+                    case ValueKind.Primitive:
+                        ExpectOperands(0);
+                        value = block.CreatePrimitiveValue(
+                            location,
+                            ReadEnum<BasicValueType>(Reader),
+                            Reader.ReadInt64());
+                        break;
+                    case ValueKind.String:
+                        ExpectOperands(0);
+                        var @string = Reader.ReadString();
+                        value = block.CreatePrimitiveValue(
+                            location,
+                            @string,
+                            ReadEncoding(Reader));
+                        break;
+                    case ValueKind.AcceleratorType:
+                        ExpectOperands(0);
+                        value = block.CreateAcceleratorTypeValue(location);
+                        break;
+                    case ValueKind.GridIndex:
+                        ExpectOperands(0);
+                        value = block.CreateGridIndexValue(
+                            location,
+                            ReadEnum<DeviceConstantDimension3D>(Reader));
+                        break;
+                    case ValueKind.GroupIndex:
+                        ExpectOperands(0);
+                        value = block.CreateGroupIndexValue(
+                            location,
+                            ReadEnum<DeviceConstantDimension3D>(Reader));
+                        break;
+                    case ValueKind.GridDimension:
+                        ExpectOperands(0);
+                        value = block.CreateGridDimensionValue(
+                            location,
+                            ReadEnum<DeviceConstantDimension3D>(Reader));
+                        break;
+                    case ValueKind.GroupDimension:
+                        ExpectOperands(0);
+                        value = block.CreateGroupDimensionValue(
+                            location,
+                            ReadEnum<DeviceConstantDimension3D>(Reader));
+                        break;
+                    case ValueKind.WarpSize:
+                        ExpectOperands(0);
+                        value = block.CreateWarpSizeValue(location);
+                        break;
+                    case ValueKind.LaneIdx:
+                        ExpectOperands(0);
+                        value = block.CreateLaneIdxValue(location);
+                        break;
+                    case ValueKind.DynamicMemoryLength:
+                        ExpectOperands(0);
+                        value = block.CreateDynamicMemoryLengthValue(
+                            location,
+                            ReadType(),
+                            ReadEnum<MemoryAddressSpace>(Reader));
+                        break;
+                    case ValueKind.Alloca:
+                        ExpectOperands(1);
+                        value = block.CreateAlloca(
+                            location,
+                            ReadType(),
+                            ReadEnum<MemoryAddressSpace>(Reader),
+                            Operand(0));
+                        break;
+                    case ValueKind.MemoryBarrier:
+                        ExpectOperands(0);
+                        value = block.CreateMemoryBarrier(
+                            location,
+                            ReadEnum<MemoryBarrierKind>(Reader));
+                        break;
+                    case ValueKind.Load:
+                        ExpectOperands(1);
+                        value = block.CreateLoad(location, Operand(0));
+                        break;
+                    case ValueKind.Store:
+                        ExpectOperands(2);
+                        value = block.CreateStore(location, Operand(0), Operand(1));
+                        break;
+                    case ValueKind.MethodCall:
+                        int targetIndex = Reader.ReadInt32();
+                        if (targetIndex < 0 || targetIndex >= Methods.Length)
+                            throw GetInvalidDataException();
+                        var target = Methods[targetIndex];
+                        if (target.NumParameters != operands.Count)
+                            throw GetInvalidDataException();
+                        value = block.CreateCall(location, target, ref operands);
+                        break;
+                    case ValueKind.Structure:
+                        var structureBuilder = block.CreateStructure(
+                            location,
+                            ReadType<StructureType>());
+                        foreach (var operand in operands)
+                            structureBuilder.Add(operand);
+                        value = structureBuilder.Seal();
+                        break;
+                    case ValueKind.GetField:
+                        ExpectOperands(1);
+                        value = block.CreateGetField(
+                            location,
+                            Operand(0),
+                            ReadFieldSpan(Reader));
+                        break;
+                    case ValueKind.SetField:
+                        ExpectOperands(2);
+                        value = block.CreateSetField(
+                            location,
+                            Operand(0),
+                            ReadFieldSpan(Reader),
+                            Operand(1));
+                        break;
+                    case ValueKind.NewView:
+                        ExpectOperands(2);
+                        value = block.CreateNewView(location, Operand(0), Operand(1));
+                        break;
+                    case ValueKind.GetViewLength:
+                        ExpectOperands(1);
+                        value = block.CreateGetViewLength(
+                            location,
+                            Operand(0),
+                            ReadEnum<BasicValueType>(Reader));
+                        break;
+                    case ValueKind.AlignViewTo:
+                        ExpectOperands(2);
+                        value = block.CreateAlignViewTo(
+                            location,
+                            Operand(0),
+                            Operand(1));
+                        break;
+                    case ValueKind.SubView:
+                        ExpectOperands(3);
+                        value = block.CreateSubViewValue(
+                            location,
+                            Operand(0),
+                            Operand(1),
+                            Operand(2));
+                        break;
+                    case ValueKind.Array:
+                        value = block.FinishNewArray(
+                            location,
+                            ReadType<ArrayType>(),
+                            ref operands);
+                        break;
+                    case ValueKind.GetArrayLength:
+                        ExpectOperands(2);
+                        value = block.CreateGetArrayLength(
+                            location,
+                            Operand(0),
+                            Operand(1));
+                        break;
+                    case ValueKind.LoadElementAddress:
+                        ExpectOperands(2);
+                        value = block.CreateLoadElementAddress(
+                            location,
+                            Operand(0),
+                            Operand(1));
+                        break;
+                    case ValueKind.LoadArrayElementAddress:
+                        if (operands.Count < 2)
+                            throw GetInvalidDataException();
+                        value = block.FinishLoadArrayElementAddress(
+                            location,
+                            ref operands);
+                        break;
+                    case ValueKind.LoadFieldAddress:
+                        ExpectOperands(1);
+                        value = block.CreateLoadFieldAddress(
+                            location,
+                            Operand(0),
+                            ReadFieldSpan(Reader));
+                        break;
+                    case ValueKind.GenericAtomic:
+                        ExpectOperands(2);
+                        value = block.CreateAtomic(
+                            location,
+                            Operand(0),
+                            Operand(1),
+                            ReadEnum<AtomicKind>(Reader),
+                            ReadEnum<AtomicFlags>(Reader));
+                        break;
+                    case ValueKind.AtomicCAS:
+                        ExpectOperands(3);
+                        value = block.CreateAtomicCAS(
+                            location,
+                            Operand(0),
+                            Operand(1),
+                            Operand(2),
+                            ReadEnum<AtomicFlags>(Reader));
+                        break;
+                    case ValueKind.PredicateBarrier:
+                        ExpectOperands(1);
+                        value = block.CreateBarrier(
+                            location,
+                            Operand(0),
+                            ReadEnum<PredicateBarrierKind>(Reader));
+                        break;
+                    case ValueKind.Barrier:
+                        ExpectOperands(0);
+                        value = block.CreateBarrier(
+                            location,
+                            ReadEnum<BarrierKind>(Reader));
+                        break;
+                    case ValueKind.Broadcast:
+                        ExpectOperands(2);
+                        value = block.CreateBroadcast(
+                            location,
+                            Operand(0),
+                            Operand(1),
+                            ReadEnum<BroadcastKind>(Reader));
+                        break;
+                    case ValueKind.WarpShuffle:
+                        ExpectOperands(2);
+                        value = block.CreateShuffle(
+                            location,
+                            Operand(0),
+                            Operand(1),
+                            ReadEnum<ShuffleKind>(Reader));
+                        break;
+                    case ValueKind.SubWarpShuffle:
+                        ExpectOperands(3);
+                        value = block.CreateShuffle(
+                            location,
+                            Operand(0),
+                            Operand(1),
+                            Operand(2),
+                            ReadEnum<ShuffleKind>(Reader));
+                        break;
+                    case ValueKind.DebugAssert:
+                        ExpectOperands(2);
+                        value = block.CreateDebugAssert(
+                            location,
+                            Operand(0),
+                            Operand(1));
+                        break;
+                    case ValueKind.WriteToOutput:
+                        value = block.CreateWriteToOutput(
+                            location,
+                            ReadExpressions(Reader, operands.Count),
+                            ref operands);
+                        break;
+                    case ValueKind.Handle:
+                        ExpectOperands(0);
+                        value = block.CreateRuntimeHandle(
+                            location,
+                            ReadMember(Reader, AssemblyResolver));
+                        break;
+                    case ValueKind.LanguageEmit:
+                        if (ReadEnum<LanguageKind>(Reader) != LanguageKind.PTX)
+                            throw GetInvalidDataException();
+                        bool hasOutput = Reader.ReadBoolean();
+                        value = block.CreateLanguageEmitPTX(
+                            location,
+                            ReadExpressions(Reader, operands.Count),
+                            hasOutput,
+                            ref operands);
+                        break;
+                    case ValueKind.Return:
+                        ExpectOperands(1);
+                        block.CreateReturn(location, Operand(0));
+                        return false;
+                    case ValueKind.UnconditionalBranch:
+                        ExpectOperands(0);
+                        block.CreateBranch(location, ReadBlock().BasicBlock);
+                        return false;
+                    case ValueKind.IfBranch:
+                        ExpectOperands(1);
+                        var trueTarget = ReadBlock();
+                        var falseTarget = ReadBlock();
+                        block.CreateIfBranch(
+                            location,
+                            Operand(0),
+                            trueTarget.BasicBlock,
+                            falseTarget.BasicBlock,
+                            ReadEnum<IfBranchFlags>(Reader));
+                        return false;
+                    case ValueKind.SwitchBranch:
+                        ExpectOperands(1);
+                        int numTargets = ReadCount(Reader);
+                        if (numTargets < 1)
+                            throw GetInvalidDataException();
+                        var switchBuilder = block.CreateSwitchBranch(
+                            location,
+                            Operand(0),
+                            numTargets);
+                        for (int i = 0; i < numTargets; ++i)
+                            switchBuilder.Add(ReadBlock().BasicBlock);
+                        switchBuilder.Seal();
+                        return false;
+                    default:
+                        // Parameters and phi values are never stored as values
+                        throw GetInvalidDataException();
+                }
+
+                values.Add(value);
+                return true;
+            }
+
+            #endregion
+        }
+
+        #endregion
+
+        #region Constants
+
+        /// <summary>
+        /// The current version of the binary IR format.
+        /// </summary>
+        public const int FormatVersion = 1;
+
+        /// <summary>
+        /// The magic header value ('ILIR').
+        /// </summary>
+        private const int Magic = 0x52494C49;
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Serializes the given method and all methods it (transitively) calls into
+        /// the given stream.
+        /// </summary>
+        /// <param name="stream">The target stream.</param>
+        /// <param name="method">The method to serialize.</param>
+        /// <remarks>
+        /// The method and its callees must not be modified while they are being
+        /// serialized.
+        /// </remarks>
+        public static void Serialize(Stream stream, Method method)
+        {
+            if (stream is null)
+                throw new ArgumentNullException(nameof(stream));
+            if (method is null)
+                throw new ArgumentNullException(nameof(method));
+            if (!method.HasImplementation)
+                throw new ArgumentOutOfRangeException(nameof(method));
+
+            var references = References.CreateRecursive(
+                method.Blocks,
+                new MethodCollections.AllMethods());
+
+            // Write all methods first to collect all referenced types. Note that
+            // the entry method is always the first method in the table.
+            using var methodStream = new MemoryStream();
+            IRTypeSerializer.TypeTable types;
+            using (var methodWriter = new BinaryWriter(
+                methodStream,
+                Encoding.UTF8,
+                true))
+            {
+                var methods = new MethodWriter(methodWriter, references);
+                methods.Write();
+                types = methods.Types;
+            }
+
+            using var writer = new BinaryWriter(stream, Encoding.UTF8, true);
+            WriteHeader(writer, Magic, FormatVersion);
+            WriteTypeTable(writer, types);
+            writer.Write((int)methodStream.Length);
+            writer.Flush();
+            methodStream.Position = 0;
+            methodStream.CopyTo(stream);
+        }
+
+        /// <summary>
+        /// Deserializes a method (and all methods it calls) from the given stream
+        /// into the given context.
+        /// </summary>
+        /// <param name="stream">The source stream.</param>
+        /// <param name="context">The target context.</param>
+        /// <returns>The deserialized method.</returns>
+        /// <remarks>
+        /// External and intrinsic methods are bound to existing declarations of
+        /// their managed source methods. All other methods are declared as new
+        /// methods in the target context.
+        /// </remarks>
+        public static Method Deserialize(Stream stream, IRContext context) =>
+            Deserialize(stream, context, null);
+
+        /// <summary>
+        /// Deserializes a method (and all methods it calls) from the given stream
+        /// into the given context while resolving all referenced assemblies with the
+        /// given resolver.
+        /// </summary>
+        /// <param name="stream">The source stream.</param>
+        /// <param name="context">The target context.</param>
+        /// <param name="assemblyResolver">
+        /// Resolves the assemblies of all referenced managed types. If the resolver
+        /// returns null, deserialization fails instead of loading the assembly. A
+        /// null resolver uses the default assembly-loading logic.
+        /// </param>
+        /// <returns>The deserialized method.</returns>
+        public static Method Deserialize(
+            Stream stream,
+            IRContext context,
+            Func<AssemblyName, Assembly> assemblyResolver)
+        {
+            if (stream is null)
+                throw new ArgumentNullException(nameof(stream));
+            if (context is null)
+                throw new ArgumentNullException(nameof(context));
+
+            using var reader = new BinaryReader(stream, Encoding.UTF8, true);
+            try
+            {
+                ReadHeader(reader, Magic, FormatVersion);
+                var types = ReadTypeTable(reader, context.TypeContext);
+
+                // Read the whole method section in advance to detect truncated
+                // streams before any method is built
+                int methodSectionLength = ReadCount(reader);
+                var methodSection = reader.ReadBytes(methodSectionLength);
+                if (methodSection.Length != methodSectionLength)
+                    throw GetInvalidDataException();
+
+                using var methodStream = new MemoryStream(methodSection, false);
+                using var methodSectionReader = new BinaryReader(
+                    methodStream,
+                    Encoding.UTF8);
+                var methodReader = new MethodReader(
+                    methodSectionReader,
+                    context,
+                    types,
+                    assemblyResolver);
+                methodReader.Read();
+                if (methodStream.Position != methodStream.Length)
+                    throw GetInvalidDataException();
+
+                var method = methodReader.Methods[0];
+                foreach (var deserialized in methodReader.Methods)
+                {
+                    if (deserialized.HasImplementation)
+                        context.Verifier.Verify(deserialized);
+                }
+                return method;
+            }
+            catch (EndOfStreamException e)
+            {
+                throw GetInvalidDataException(e);
+            }
+            catch (DecoderFallbackException e)
+            {
+                throw GetInvalidDataException(e);
+            }
+        }
+
+        #endregion
+
+        #region Locations
+
+        /// <summary>
+        /// Writes the given location.
+        /// </summary>
+        /// <remarks>
+        /// Only file locations are preserved. All other locations are stored as
+        /// unknown locations.
+        /// </remarks>
+        private static void WriteLocation(BinaryWriter writer, Location location)
+        {
+            if (location is CompilationStackLocation stackLocation &&
+                stackLocation.TryGetLocation(out FileLocation stackFileLocation))
+            {
+                location = stackFileLocation;
+            }
+
+            if (location is FileLocation fileLocation)
+            {
+                writer.Write((byte)SerializedLocationKind.File);
+                writer.Write(fileLocation.FileName);
+                writer.Write(fileLocation.StartColumn);
+                writer.Write(fileLocation.EndColumn);
+                writer.Write(fileLocation.StartLine);
+                writer.Write(fileLocation.EndLine);
+            }
+            else
+            {
+                writer.Write((byte)SerializedLocationKind.Unknown);
+            }
+        }
+
+        /// <summary>
+        /// Reads a location.
+        /// </summary>
+        private static Location ReadLocation(BinaryReader reader)
+        {
+            switch ((SerializedLocationKind)reader.ReadByte())
+            {
+                case SerializedLocationKind.Unknown:
+                    return Location.Unknown;
+                case SerializedLocationKind.File:
+                    var fileName = reader.ReadString();
+                    int startColumn = reader.ReadInt32();
+                    int endColumn = reader.ReadInt32();
+                    int startLine = reader.ReadInt32();
+                    int endLine = reader.ReadInt32();
+                    if (string.IsNullOrEmpty(fileName) ||
+                        (startColumn | endColumn | startLine | endLine) < 0)
+                    {
+                        throw GetInvalidDataException();
+                    }
+                    return new FileLocation(
+                        fileName,
+                        startColumn,
+                        endColumn,
+                        startLine,
+                        endLine);
+                default:
+                    throw GetInvalidDataException();
+            }
+        }
+
+        #endregion
+
+        #region Managed Members
+
+        /// <summary>
+        /// Writes a reference to a managed type, method or field.
+        /// </summary>
+        /// <remarks>
+        /// Methods and fields are identified by their declaring type, their metadata
+        /// token and the version id of their module. This ensures that a
+        /// deserialized reference never binds to a member of a different build of
+        /// the same assembly.
+        /// </remarks>
+        private static void WriteMember(BinaryWriter writer, MemberInfo member)
+        {
+            switch (member)
+            {
+                case Type type:
+                    writer.Write((byte)SerializedMemberKind.Type);
+                    WriteManagedType(writer, type);
+                    break;
+                case MethodBase method:
+                    writer.Write((byte)SerializedMemberKind.Method);
+                    WriteManagedType(writer, method.DeclaringType);
+                    writer.Write(method.Module.ModuleVersionId.ToByteArray());
+                    writer.Write(method.MetadataToken);
+                    var genericArguments = method.IsGenericMethod
+                        ? method.GetGenericArguments()
+                        : Array.Empty<Type>();
+                    writer.Write(genericArguments.Length);
+                    foreach (var argument in genericArguments)
+                        WriteManagedType(writer, argument);
+                    break;
+                case FieldInfo field:
+                    writer.Write((byte)SerializedMemberKind.Field);
+                    WriteManagedType(writer, field.DeclaringType);
+                    writer.Write(field.Module.ModuleVersionId.ToByteArray());
+                    writer.Write(field.MetadataToken);
+                    break;
+                default:
+                    throw new NotSupportedException(string.Format(
+                        ErrorMessages.NotSupportedIRSerialization,
+                        member));
+            }
+        }
+
+        /// <summary>
+        /// Writes a reference to a closed managed type.
+        /// </summary>
+        private static void WriteManagedType(BinaryWriter writer, Type type)
+        {
+            var typeName = type?.AssemblyQualifiedName ??
+                throw new NotSupportedException(string.Format(
+                    ErrorMessages.NotSupportedIRSerialization,
+                    type));
+            writer.Write(typeName);
+        }
+
+        /// <summary>
+        /// Reads a reference to a managed type, method or field.
+        /// </summary>
+        private static MemberInfo ReadMember(
+            BinaryReader reader,
+            Func<AssemblyName, Assembly> assemblyResolver)
+        {
+            var kind = (SerializedMemberKind)reader.ReadByte();
+            switch (kind)
+            {
+                case SerializedMemberKind.Type:
+                    return ReadManagedType(reader, assemblyResolver);
+                case SerializedMemberKind.Method:
+                case SerializedMemberKind.Field:
+                    var declaringType = ReadManagedType(reader, assemblyResolver);
+                    var moduleVersionId = new Guid(reader.ReadBytes(16));
+                    int token = reader.ReadInt32();
+                    var member = ResolveMember(declaringType, moduleVersionId, token);
+                    if (kind == SerializedMemberKind.Field)
+                        return member as FieldInfo ?? throw GetInvalidDataException();
+
+                    var method = member as MethodBase ??
+                        throw GetInvalidDataException();
+                    int numGenericArguments = ReadCount(reader);
+                    if (numGenericArguments < 1)
+                        return method;
+                    var genericArguments = new Type[numGenericArguments];
+                    for (int i = 0; i < numGenericArguments; ++i)
+                        genericArguments[i] = ReadManagedType(reader, assemblyResolver);
+                    return method is MethodInfo methodInfo &&
+                        methodInfo.IsGenericMethodDefinition &&
+                        methodInfo.GetGenericArguments().Length == numGenericArguments
+                        ? methodInfo.MakeGenericMethod(genericArguments)
+                        : throw GetInvalidDataException();
+                default:
+                    throw GetInvalidDataException();
+            }
+        }
+
+        /// <summary>
+        /// Reads a reference to a closed managed type.
+        /// </summary>
+        private static Type ReadManagedType(
+            BinaryReader reader,
+            Func<AssemblyName, Assembly> assemblyResolver)
+        {
+            var typeName = reader.ReadString();
+            var type = assemblyResolver is null
+                ? Type.GetType(typeName, false)
+                : Type.GetType(typeName, assemblyResolver, null, false);
+            return type ??
+                throw new InvalidDataException(string.Format(
+                    ErrorMessages.CouldNotResolveSerializedMember,
+                    typeName));
+        }
+
+        /// <summary>
+        /// Resolves a method or field of the given type.
+        /// </summary>
+        private static MemberInfo ResolveMember(
+            Type declaringType,
+            Guid moduleVersionId,
+            int metadataToken)
+        {
+            const BindingFlags Flags = BindingFlags.Public | BindingFlags.NonPublic |
+                BindingFlags.Static | BindingFlags.Instance |
+                BindingFlags.DeclaredOnly;
+            foreach (var member in declaringType.GetMembers(Flags))
+            {
+                if (member.MetadataToken == metadataToken &&
+                    member.Module.ModuleVersionId == moduleVersionId)
+                {
+                    return member;
+                }
+            }
+            throw new InvalidDataException(string.Format(
+                ErrorMessages.CouldNotResolveSerializedMember,
+                declaringType.FullName + ":" + metadataToken.ToString("X8")));
+        }
+
+        #endregion
+
+        #region Helpers
+
+        /// <summary>
+        /// Writes a string that may be null.
+        /// </summary>
+        private static void WriteOptionalString(BinaryWriter writer, string value)
+        {
+            writer.Write(value != null);
+            if (value != null)
+                writer.Write(value);
+        }
+
+        /// <summary>
+        /// Reads a string that may be null.
+        /// </summary>
+        private static string ReadOptionalString(BinaryReader reader) =>
+            reader.ReadBoolean() ? reader.ReadString() : null;
+
+        /// <summary>
+        /// Reads a string encoding.
+        /// </summary>
+        private static Encoding ReadEncoding(BinaryReader reader)
+        {
+            int codePage = reader.ReadInt32();
+            try
+            {
+                return Encoding.GetEncoding(codePage);
+            }
+            catch (ArgumentException e)
+            {
+                throw GetInvalidDataException(e);
+            }
+            catch (NotSupportedException e)
+            {
+                throw GetInvalidDataException(e);
+            }
+        }
+
+        /// <summary>
+        /// Reads a field span.
+        /// </summary>
+        private static FieldSpan ReadFieldSpan(BinaryReader reader)
+        {
+            int index = reader.ReadInt32();
+            int span = reader.ReadInt32();
+            if (index < 0 || span < 1)
+                throw GetInvalidDataException();
+            return new FieldSpan(new FieldAccess(index), span);
+        }
+
+        /// <summary>
+        /// Reads an array of format expressions.
+        /// </summary>
+        /// <param name="reader">The source reader.</param>
+        /// <param name="numArguments">The number of available arguments.</param>
+        private static FormatArray ReadExpressions(BinaryReader reader, int numArguments)
+        {
+            int numExpressions = ReadCount(reader);
+            var expressions = ImmutableArray.CreateBuilder<FormatExpression>(
+                numExpressions);
+            for (int i = 0; i < numExpressions; ++i)
+            {
+                if (reader.ReadBoolean())
+                {
+                    int argument = reader.ReadInt32();
+                    if (argument < 0 || argument >= numArguments)
+                        throw GetInvalidDataException();
+                    expressions.Add(new FormatExpression(argument));
+                }
+                else
+                {
+                    expressions.Add(new FormatExpression(reader.ReadString()));
+                }
+            }
+            return expressions.MoveToImmutable();
+        }
+
+        #endregion
+    }
+}
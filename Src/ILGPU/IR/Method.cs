@@ -10,6 +10,7 @@
 // ---------------------------------------------------------------------------------------
 
 using ILGPU.Frontend;
+using ILGPU.IR.Analyses;
 using ILGPU.IR.Analyses.ControlFlowDirection;
 using ILGPU.IR.Analyses.TraversalOrders;
 using ILGPU.IR.Intrinsics;
@@ -386,6 +387,19 @@ namespace ILGPU.IR
         [DebuggerBrowsable(DebuggerBrowsableState.Never)]
         private volatile Builder builder = null;
 
+        /// <summary>
+        /// Stores the current control-flow version that is incremented each time the
+        /// block structure changes.
+        /// </summary>
+        [DebuggerBrowsable(DebuggerBrowsableState.Never)]
+        private int controlFlowVersion;
+
+        /// <summary>
+        /// Stores all cached analyses (if any).
+        /// </summary>
+        [DebuggerBrowsable(DebuggerBrowsableState.Never)]
+        private volatile AnalysisCache analyses;
+
         /// <summary>
         /// Creates a new method instance.
         /// </summary>
@@ -501,6 +515,32 @@ namespace ILGPU.IR
         public BasicBlockCollection<ReversePostOrder, Forwards>.ValueCollection Values =>
             Blocks.Values;
 
+        /// <summary>
+        /// Returns the current control-flow version of this method.
+        /// </summary>
+        /// <remarks>
+        /// This version changes each time the block structure of this method changes.
+        /// </remarks>
+        public int ControlFlowVersion => controlFlowVersion;
+
+        /// <summary>
+        /// Returns the analysis cache of this method.
+        /// </summary>
+        public AnalysisCache Analyses
+        {
+            get
+            {
+                if (analyses is null)
+                {
+                    Interlocked.CompareExchange(
+                        ref analyses,
+                        new AnalysisCache(this),
+                        null);
+                }
+                return analyses;
+            }
+        }
+
         /// <summary>
         /// Returns the current builder.
         /// </summary>
@@ -574,6 +614,23 @@ namespace ILGPU.IR
             Blocks.Dump(textWriter);
         }
 
+        /// <summary>
+        /// Updates the underlying blocks and invalidates all cached analyses.
+        /// </summary>
+        /// <param name="newBlocks">The new blocks.</param>
+        private void UpdateBlocks(ImmutableArray<BasicBlock> newBlocks)
+        {
+            blocks = newBlocks;
+            ++controlFlowVersion;
+        }
+
+        /// <summary>
+        /// Invalidates all cached analyses that are not preserved.
+        /// </summary>
+        /// <param name="preserved">The preserved analyses.</param>
+        internal void InvalidateAnalyses(PreservedAnalyses preserved) =>
+            analyses?.Invalidate(preserved);
+
         /// <summary>
         /// Seals the current parameters.
         /// </summary>
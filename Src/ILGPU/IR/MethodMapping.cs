@@ -258,11 +258,48 @@ namespace ILGPU.IR
                 methods[handle] = index;
 
             }
+
+            // Specialized clones share the source method of their original
+            // method, which remains the primary mapping of the managed method
             var source = data.Source;
-            if (source != null)
+            if (source != null && !managedMethods.ContainsKey(source))
                 managedMethods[source] = handle;
         }
 
+        /// <summary>
+        /// Removes the given handle and its associated data object.
+        /// </summary>
+        /// <param name="handle">The function handle to remove.</param>
+        /// <returns>True, if the handle has been removed.</returns>
+        public bool Remove(MethodHandle handle)
+        {
+            if (!methods.TryGetValue(handle, out int index))
+                return false;
+            var source = dataList[index].Source;
+
+            // Remove the data object and update all subsequent indices
+            methods.Remove(handle);
+            dataList.RemoveAt(index);
+            for (int i = index, e = dataList.Count; i < e; ++i)
+                methods[dataList[i].Handle] = i;
+
+            // Map the source method to a remaining object with the same source
+            if (source != null &&
+                managedMethods.TryGetValue(source, out var sourceHandle) &&
+                sourceHandle == handle)
+            {
+                managedMethods.Remove(source);
+                foreach (var data in dataList)
+                {
+                    if (data.Source != source)
+                        continue;
+                    managedMethods[source] = data.Handle;
+                    break;
+                }
+            }
+            return true;
+        }
+
         /// <summary>
         /// Converts this mapping object into an array.
         /// </summary>
@@ -0,0 +1,439 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: BoundsCheckElimination.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.IR.Analyses;
+using ILGPU.IR.Analyses.ControlFlowDirection;
+using ILGPU.IR.Values;
+using ILGPU.Util;
+using System.Collections.Generic;
+
+namespace ILGPU.IR.Transformations
+{
+    /// <summary>
+    /// Removes debug assertions (e.g. view bounds checks) that are known to hold.
+    /// </summary>
+    /// <remarks>
+    /// Assertion conditions are proven using a <see cref="ValueRanges"/> analysis and
+    /// the conditions of all dominating branches. Conjunctions are simplified by
+    /// removing all proven parts. Assertions that are dominated by an assertion with
+    /// an equivalent condition are removed as well.
+    /// </remarks>
+    public sealed class BoundsCheckElimination : UnorderedTransformation
+    {
+        #region Nested Types
+
+        /// <summary>
+        /// Proves assertion conditions in the scope of a single method.
+        /// </summary>
+        private readonly struct ConditionProver
+        {
+            /// <summary>
+            /// The maximum recursion depth when comparing value trees.
+            /// </summary>
+            private const int MaxEquivalenceDepth = 8;
+
+            /// <summary>
+            /// Constructs a new condition prover.
+            /// </summary>
+            /// <param name="ranges">The range analysis of the parent method.</param>
+            public ConditionProver(ValueRanges ranges)
+            {
+                Ranges = ranges;
+            }
+
+            /// <summary>
+            /// Returns the underlying range analysis.
+            /// </summary>
+            public ValueRanges Ranges { get; }
+
+            /// <summary>
+            /// Returns the dominators of the parent method.
+            /// </summary>
+            public Dominators<Forwards> Dominators =>
+                Ranges.Dominators;
+
+            /// <summary>
+            /// Returns true if both values are guaranteed to compute the same result.
+            /// </summary>
+            public static bool AreEquivalent(Value first, Value second) =>
+                AreEquivalent(first, second, 0);
+
+            /// <summary>
+            /// Returns true if both values are guaranteed to compute the same result.
+            /// </summary>
+            private static bool AreEquivalent(Value first, Value second, int depth)
+            {
+                first = first.Resolve();
+                second = second.Resolve();
+                if (first == second)
+                    return true;
+                if (depth > MaxEquivalenceDepth ||
+                    first.ValueKind != second.ValueKind ||
+                    first.Type != second.Type ||
+                    first.Count != second.Count)
+                {
+                    return false;
+                }
+
+                bool sameAttributes = (first, second) switch
+                {
+                    (PrimitiveValue p1, PrimitiveValue p2) => p1.RawValue == p2.RawValue,
+                    (CompareValue c1, CompareValue c2) =>
+                        c1.Kind == c2.Kind && c1.Flags == c2.Flags,
+                    (BinaryArithmeticValue b1, BinaryArithmeticValue b2) =>
+                        b1.Kind == b2.Kind && b1.Flags == b2.Flags,
+                    (UnaryArithmeticValue u1, UnaryArithmeticValue u2) =>
+                        u1.Kind == u2.Kind && u1.Flags == u2.Flags,
+                    (ConvertValue c1, ConvertValue c2) => c1.Flags == c2.Flags,
+                    (GetViewLength l1, GetViewLength l2) =>
+                        l1.LengthType == l2.LengthType,
+                    (GetField f1, GetField f2) => f1.FieldSpan.Equals(f2.FieldSpan),
+                    _ => false,
+                };
+                if (!sameAttributes)
+                    return false;
+
+                for (int i = 0, e = first.Count; i < e; ++i)
+                {
+                    if (!AreEquivalent(first[i], second[i], depth + 1))
+                        return false;
+                }
+                return true;
+            }
+
+            /// <summary>
+            /// Removes all sign extensions of the given integer value.
+            /// </summary>
+            private static Value StripSignExtensions(Value value)
+            {
+                value = value.Resolve();
+                while (value is ConvertValue convert &&
+                    !convert.IsSourceUnsigned &&
+                    convert.Value.BasicValueType.IsInt() &&
+                    convert.BasicValueType.IsInt() &&
+                    convert.Value.BasicValueType <= convert.BasicValueType)
+                {
+                    value = convert.Value.Resolve();
+                }
+                return value;
+            }
+
+            /// <summary>
+            /// Returns true if both integer operands are known to be equal (modulo sign
+            /// extensions that preserve the signed ordering of all values).
+            /// </summary>
+            private static bool AreEquivalentOperands(Value first, Value second) =>
+                AreEquivalent(
+                    StripSignExtensions(first),
+                    StripSignExtensions(second));
+
+            /// <summary>
+            /// Swaps the operands of the given signed integer compare kind.
+            /// </summary>
+            private static CompareKind SwapOperands(CompareKind kind)
+            {
+                var flags = CompareFlags.None;
+                return CompareValue.SwapOperands(
+                    kind,
+                    BasicValueType.Int32,
+                    BasicValueType.Int32,
+                    ref flags);
+            }
+
+            /// <summary>
+            /// Tries to determine the compare kind of a signed integer comparison
+            /// that is known to evaluate to the given value.
+            /// </summary>
+            private static bool TryGetKnownKind(
+                CompareValue compare,
+                bool holds,
+                out CompareKind kind)
+            {
+                kind = compare.Kind;
+                if (compare.Flags != CompareFlags.None ||
+                    !compare.Left.BasicValueType.IsInt())
+                {
+                    return false;
+                }
+                if (!holds)
+                {
+                    var flags = CompareFlags.None;
+                    kind = CompareValue.Invert(
+                        kind,
+                        BasicValueType.Int32,
+                        BasicValueType.Int32,
+                        ref flags);
+                }
+                return true;
+            }
+
+            /// <summary>
+            /// Returns true if the first compare kind implies the second one.
+            /// </summary>
+            private static bool Implies(CompareKind known, CompareKind kind) =>
+                known == kind ||
+                known switch
+                {
+                    CompareKind.Equal =>
+                        kind == CompareKind.LessEqual || kind == CompareKind.GreaterEqual,
+                    CompareKind.LessThan =>
+                        kind == CompareKind.LessEqual || kind == CompareKind.NotEqual,
+                    CompareKind.GreaterThan =>
+                        kind == CompareKind.GreaterEqual || kind == CompareKind.NotEqual,
+                    _ => false,
+                };
+
+            /// <summary>
+            /// Returns true if the given signed integer comparison is known to hold in
+            /// the given block.
+            /// </summary>
+            private bool IsKnownTrue(CompareValue compare, BasicBlock block)
+            {
+                var left = compare.Left.Resolve();
+                var right = compare.Right.Resolve();
+                if (compare.Flags != CompareFlags.None || !left.BasicValueType.IsInt())
+                    return false;
+
+                // Check the ranges of both operands
+                var leftRange = Ranges.GetRange(left, block);
+                var rightRange = Ranges.GetRange(right, block);
+                if (leftRange.Satisfies(compare.Kind, rightRange))
+                    return true;
+
+                // Check all dominating branch conditions
+                var conditions = Dominators.GetDominatingConditions(block);
+                foreach (var (condition, holds) in conditions)
+                {
+                    if (!(condition is CompareValue known) ||
+                        !TryGetKnownKind(known, holds, out var kind))
+                    {
+                        continue;
+                    }
+
+                    if (AreEquivalentOperands(known.Left, left) &&
+                        AreEquivalentOperands(known.Right, right) &&
+                        Implies(kind, compare.Kind) ||
+                        AreEquivalentOperands(known.Right, left) &&
+                        AreEquivalentOperands(known.Left, right) &&
+                        Implies(SwapOperands(kind), compare.Kind))
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            /// <summary>
+            /// Returns true if the given disjunction represents the upper bounds check
+            /// of a view access (length &lt; 0 || index &lt; length) that is known to
+            /// hold due to a dominating check of the index against the (32-bit or 64-bit)
+            /// length of the same view.
+            /// </summary>
+            private bool IsKnownViewBoundsCheck(
+                Value negativeCheck,
+                Value boundsCheck,
+                BasicBlock block)
+            {
+                if (!(negativeCheck is CompareValue negativeCompare) ||
+                    !(boundsCheck is CompareValue boundsCompare) ||
+                    negativeCompare.Kind != CompareKind.LessThan ||
+                    boundsCompare.Kind != CompareKind.LessThan ||
+                    negativeCompare.Flags != CompareFlags.None ||
+                    boundsCompare.Flags != CompareFlags.None ||
+                    !(negativeCompare.Left.Resolve() is GetViewLength length) ||
+                    !(negativeCompare.Right.Resolve() is PrimitiveValue zero) ||
+                    zero.RawValue != 0L ||
+                    boundsCompare.Right.Resolve() != length)
+                {
+                    return false;
+                }
+
+                // A dominating check index < length32 implies index < length64 if the
+                // 64-bit length is not negative, since the truncated 32-bit length is
+                // always less than or equal to the 64-bit length in this case
+                var index = boundsCompare.Left.Resolve();
+                var conditions = Dominators.GetDominatingConditions(block);
+                foreach (var (condition, holds) in conditions)
+                {
+                    if (condition is CompareValue known &&
+                        TryGetViewLengthCheck(known, holds, index, out var knownLength) &&
+                        AreEquivalent(knownLength.View, length.View))
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            /// <summary>
+            /// Tries to match a comparison of the form index &lt; length.
+            /// </summary>
+            private static bool TryGetViewLengthCheck(
+                CompareValue compare,
+                bool holds,
+                Value index,
+                out GetViewLength length)
+            {
+                length = null;
+                if (!TryGetKnownKind(compare, holds, out var kind))
+                    return false;
+
+                if (kind == CompareKind.LessThan &&
+                    AreEquivalentOperands(compare.Left, index))
+                {
+                    length = compare.Right.Resolve() as GetViewLength;
+                }
+                else if (kind == CompareKind.GreaterThan &&
+                    AreEquivalentOperands(compare.Right, index))
+                {
+                    length = compare.Left.Resolve() as GetViewLength;
+                }
+                return length != null;
+            }
+
+            /// <summary>
+            /// Returns true if the given condition is known to hold in the given block.
+            /// </summary>
+            /// <param name="condition">The condition to prove.</param>
+            /// <param name="block">The block in which the condition is evaluated.</param>
+            /// <returns>True, if the given condition always holds.</returns>
+            public bool IsKnownTrue(Value condition, BasicBlock block)
+            {
+                switch (condition.Resolve())
+                {
+                    case PrimitiveValue primitive:
+                        return primitive.IsBool && primitive.Int1Value;
+                    case CompareValue compare:
+                        return IsKnownTrue(compare, block);
+                    case BinaryArithmeticValue binary when
+                        binary.BasicValueType == BasicValueType.Int1:
+                        var left = binary.Left.Resolve();
+                        var right = binary.Right.Resolve();
+                        return binary.Kind switch
+                        {
+                            BinaryArithmeticKind.And =>
+                                IsKnownTrue(left, block) && IsKnownTrue(right, block),
+                            BinaryArithmeticKind.Or =>
+                                IsKnownTrue(left, block) ||
+                                IsKnownTrue(right, block) ||
+                                IsKnownViewBoundsCheck(left, right, block) ||
+                                IsKnownViewBoundsCheck(right, left, block),
+                            _ => false,
+                        };
+                    default:
+                        return false;
+                }
+            }
+
+            /// <summary>
+            /// Removes all parts of a conjunction that are known to hold.
+            /// </summary>
+            /// <param name="condition">The condition to simplify.</param>
+            /// <param name="block">The block in which the condition is evaluated.</param>
+            /// <returns>
+            /// The simplified condition or null if the whole condition is known to hold.
+            /// </returns>
+            public Value Simplify(Value condition, BasicBlock block)
+            {
+                condition = condition.Resolve();
+                if (IsKnownTrue(condition, block))
+                    return null;
+                if (condition is BinaryArithmeticValue binary &&
+                    binary.Kind == BinaryArithmeticKind.And &&
+                    binary.BasicValueType == BasicValueType.Int1)
+                {
+                    if (IsKnownTrue(binary.Left, block))
+                        return Simplify(binary.Right, block);
+                    if (IsKnownTrue(binary.Right, block))
+                        return Simplify(binary.Left, block);
+                }
+                return condition;
+            }
+        }
+
+        #endregion
+
+        #region Instance
+
+        /// <summary>
+        /// Constructs a new bounds-check elimination transformation.
+        /// </summary>
+        public BoundsCheckElimination() { }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Applies the bounds-check elimination transformation.
+        /// </summary>
+        protected override bool PerformTransformation(Method.Builder builder)
+        {
+            // Gather all assertions in dominance order
+            var assertions = new List<DebugAssertOperation>();
+            foreach (var block in builder.SourceBlocks)
+            {
+                foreach (Value value in block)
+                {
+                    if (value is DebugAssertOperation assertion)
+                        assertions.Add(assertion);
+                }
+            }
+            if (assertions.Count < 1)
+                return false;
+
+            var prover = new ConditionProver(ValueRanges.Create(builder.Method));
+            var dominators = prover.Dominators;
+            var checkedConditions = new List<(BasicBlock Block, Value Condition)>();
+
+            bool applied = false;
+            foreach (var assertion in assertions)
+            {
+                var block = assertion.BasicBlock;
+                var blockBuilder = builder[block];
+                var condition = prover.Simplify(assertion.Condition, block);
+
+                // Check whether this condition has already been asserted before
+                bool isChecked = condition is null;
+                for (int i = 0, e = checkedConditions.Count; i < e && !isChecked; ++i)
+                {
+                    var (checkedBlock, checkedCondition) = checkedConditions[i];
+                    isChecked = dominators.Dominates(checkedBlock, block) &&
+                        ConditionProver.AreEquivalent(checkedCondition, condition);
+                }
+
+                if (isChecked)
+                {
+                    blockBuilder.Remove(assertion);
+                    applied = true;
+                    continue;
+                }
+
+                // Replace the assertion if parts of its condition have been proven
+                if (condition != assertion.Condition.Resolve())
+                {
+                    blockBuilder.SetupInsertPosition(assertion);
+                    blockBuilder.CreateDebugAssert(
+                        assertion.Location,
+                        condition,
+                        assertion.Message);
+                    blockBuilder.Remove(assertion);
+                    applied = true;
+                }
+                checkedConditions.Add((block, condition));
+            }
+
+            return applied;
+        }
+
+        #endregion
+    }
+}
@@ -0,0 +1,743 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: CallTargetSpecializer.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.IR.Analyses;
+using ILGPU.IR.Construction;
+using ILGPU.IR.Types;
+using ILGPU.IR.Values;
+using System;
+using System.Collections.Generic;
+using System.Collections.Immutable;
+using ValueList = ILGPU.Util.InlineList<ILGPU.IR.Values.ValueReference>;
+
+namespace ILGPU.IR.Transformations
+{
+    /// <summary>
+    /// Clones non-inlined call targets per distinct combination of argument address
+    /// spaces and constant arguments.
+    /// </summary>
+    /// <remarks>
+    /// Arguments that are casted from a specific address space into the generic one
+    /// are passed in their original address space to a specialized clone of the
+    /// call target. The clone casts them back into the generic address space, which
+    /// allows subsequent address-space inference passes to use specific memory
+    /// operations inside the clone. This also applies to pointer fields of
+    /// structure arguments, such as lowered views. Similarly, constant arguments are
+    /// propagated into the cloned method bodies. The number of clones per method and
+    /// the size of methods to clone are bounded to avoid code bloat. Methods that
+    /// allocate shared memory are never cloned, and original methods that are no
+    /// longer referenced are removed from the context.
+    /// </remarks>
+    public sealed class CallTargetSpecializer :
+        OrderedTransformation<CallTargetSpecializer.SpecializationProvider>
+    {
+        #region Nested Types
+
+        /// <summary>
+        /// Represents the specialization of a single argument.
+        /// </summary>
+        internal readonly struct ArgumentSpecialization :
+            IEquatable<ArgumentSpecialization>
+        {
+            /// <summary>
+            /// Creates an argument specialization that passes the argument in a
+            /// specific address space.
+            /// </summary>
+            /// <param name="addressSpace">The specific address space.</param>
+            public static ArgumentSpecialization ForAddressSpace(
+                MemoryAddressSpace addressSpace) =>
+                new ArgumentSpecialization(
+                    addressSpace,
+                    null,
+                    default);
+
+            /// <summary>
+            /// Creates an argument specialization that passes all pointer fields of
+            /// a structure argument in specific address spaces.
+            /// </summary>
+            /// <param name="fieldAddressSpaces">
+            /// The address space of each field (generic for unspecialized fields).
+            /// </param>
+            public static ArgumentSpecialization ForFieldAddressSpaces(
+                ImmutableArray<MemoryAddressSpace> fieldAddressSpaces) =>
+                new ArgumentSpecialization(
+                    MemoryAddressSpace.Generic,
+                    null,
+                    fieldAddressSpaces);
+
+            /// <summary>
+            /// Creates an argument specialization that propagates a constant.
+            /// </summary>
+            /// <param name="constant">The constant argument.</param>
+            public static ArgumentSpecialization ForConstant(PrimitiveValue constant) =>
+                new ArgumentSpecialization(
+                    MemoryAddressSpace.Generic,
+                    constant,
+                    default);
+
+            /// <summary>
+            /// Constructs a new argument specialization.
+            /// </summary>
+            /// <param name="addressSpace">The specific address space.</param>
+            /// <param name="constant">The constant argument (if any).</param>
+            /// <param name="fieldAddressSpaces">
+            /// The field address spaces (if any).
+            /// </param>
+            private ArgumentSpecialization(
+                MemoryAddressSpace addressSpace,
+                PrimitiveValue constant,
+                ImmutableArray<MemoryAddressSpace> fieldAddressSpaces)
+            {
+                AddressSpace = addressSpace;
+                FieldAddressSpaces = fieldAddressSpaces;
+                if (constant != null)
+                {
+                    IsConstant = true;
+                    BasicValueType = constant.BasicValueType;
+                    RawValue = constant.RawValue;
+                }
+                else
+                {
+                    IsConstant = false;
+                    BasicValueType = BasicValueType.None;
+                    RawValue = 0;
+                }
+            }
+
+            /// <summary>
+            /// Returns true if this argument is not specialized.
+            /// </summary>
+            public bool IsDefault =>
+                !IsConstant && !IsStructure &&
+                AddressSpace == MemoryAddressSpace.Generic;
+
+            /// <summary>
+            /// Returns true if this argument is specialized to a specific address
+            /// space.
+            /// </summary>
+            public bool IsAddressSpace =>
+                !IsConstant && AddressSpace != MemoryAddressSpace.Generic;
+
+            /// <summary>
+            /// Returns the specific address space.
+            /// </summary>
+            public MemoryAddressSpace AddressSpace { get; }
+
+            /// <summary>
+            /// Returns true if this argument is a structure with specialized pointer
+            /// fields.
+            /// </summary>
+            public bool IsStructure => !FieldAddressSpaces.IsDefault;
+
+            /// <summary>
+            /// Returns the address space of each structure field.
+            /// </summary>
+            public ImmutableArray<MemoryAddressSpace> FieldAddressSpaces { get; }
+
+            /// <summary>
+            /// Returns true if this argument is a constant.
+            /// </summary>
+            public bool IsConstant { get; }
+
+            /// <summary>
+            /// Returns the basic value type of the constant.
+            /// </summary>
+            public BasicValueType BasicValueType { get; }
+
+            /// <summary>
+            /// Returns the raw value of the constant.
+            /// </summary>
+            public long RawValue { get; }
+
+            /// <summary>
+            /// Returns true if the given specialization is equal to this one.
+            /// </summary>
+            public bool Equals(ArgumentSpecialization other)
+            {
+                if (AddressSpace != other.AddressSpace ||
+                    IsConstant != other.IsConstant ||
+                    BasicValueType != other.BasicValueType ||
+                    RawValue != other.RawValue ||
+                    IsStructure != other.IsStructure)
+                {
+                    return false;
+                }
+                if (!IsStructure)
+                    return true;
+                if (FieldAddressSpaces.Length != other.FieldAddressSpaces.Length)
+                    return false;
+                for (int i = 0, e = FieldAddressSpaces.Length; i < e; ++i)
+                {
+                    if (FieldAddressSpaces[i] != other.FieldAddressSpaces[i])
+                        return false;
+                }
+                return true;
+            }
+
+            /// <summary>
+            /// Returns true if the given object is equal to this specialization.
+            /// </summary>
+            public override bool Equals(object obj) =>
+                obj is ArgumentSpecialization other && Equals(other);
+
+            /// <summary>
+            /// Returns the hash code of this specialization.
+            /// </summary>
+            public override int GetHashCode()
+            {
+                int hashCode = ((int)AddressSpace << 8 | (int)BasicValueType) ^
+                    RawValue.GetHashCode();
+                if (IsStructure)
+                {
+                    foreach (var addressSpace in FieldAddressSpaces)
+                        hashCode = hashCode * 5 ^ (int)addressSpace;
+                }
+                return hashCode;
+            }
+        }
+
+        /// <summary>
+        /// Represents a specialization key consisting of the call target and the
+        /// specializations of all arguments.
+        /// </summary>
+        internal readonly struct SpecializationKey : IEquatable<SpecializationKey>
+        {
+            /// <summary>
+            /// Constructs a new specialization key.
+            /// </summary>
+            /// <param name="target">The call target.</param>
+            /// <param name="arguments">All argument specializations.</param>
+            public SpecializationKey(
+                Method target,
+                ImmutableArray<ArgumentSpecialization> arguments)
+            {
+                Target = target;
+                Arguments = arguments;
+            }
+
+            /// <summary>
+            /// Returns the call target.
+            /// </summary>
+            public Method Target { get; }
+
+            /// <summary>
+            /// Returns all argument specializations.
+            /// </summary>
+            public ImmutableArray<ArgumentSpecialization> Arguments { get; }
+
+            /// <summary>
+            /// Returns true if the given key is equal to this one.
+            /// </summary>
+            public bool Equals(SpecializationKey other)
+            {
+                if (Target != other.Target)
+                    return false;
+                for (int i = 0, e = Arguments.Length; i < e; ++i)
+                {
+                    if (!Arguments[i].Equals(other.Arguments[i]))
+                        return false;
+                }
+                return true;
+            }
+
+            /// <summary>
+            /// Returns true if the given object is equal to this key.
+            /// </summary>
+            public override bool Equals(object obj) =>
+                obj is SpecializationKey other && Equals(other);
+
+            /// <summary>
+            /// Returns the hash code of this key.
+            /// </summary>
+            public override int GetHashCode()
+            {
+                int hashCode = Target.GetHashCode();
+                foreach (var argument in Arguments)
+                    hashCode = hashCode * 31 ^ argument.GetHashCode();
+                return hashCode;
+            }
+        }
+
+        /// <summary>
+        /// Caches all created specializations.
+        /// </summary>
+        public sealed class SpecializationProvider
+        {
+            private readonly Dictionary<SpecializationKey, Method> specializations =
+                new Dictionary<SpecializationKey, Method>();
+            private readonly Dictionary<Method, int> numSpecializations =
+                new Dictionary<Method, int>();
+
+            /// <summary>
+            /// Constructs a new specialization provider.
+            /// </summary>
+            /// <param name="context">The parent IR context.</param>
+            internal SpecializationProvider(IRContext context)
+            {
+                Context = context;
+            }
+
+            /// <summary>
+            /// Returns the parent IR context.
+            /// </summary>
+            public IRContext Context { get; }
+
+            /// <summary>
+            /// Tries to get an existing specialization.
+            /// </summary>
+            internal bool TryGetSpecialization(
+                in SpecializationKey key,
+                out Method specialization) =>
+                specializations.TryGetValue(key, out specialization);
+
+            /// <summary>
+            /// Returns the number of specializations of the given method.
+            /// </summary>
+            internal int GetNumSpecializations(Method method) =>
+                numSpecializations.TryGetValue(method, out int count) ? count : 0;
+
+            /// <summary>
+            /// Registers a new specialization.
+            /// </summary>
+            internal void Register(in SpecializationKey key, Method specialization)
+            {
+                specializations.Add(key, specialization);
+                numSpecializations[key.Target] = GetNumSpecializations(key.Target) + 1;
+            }
+
+            /// <summary>
+            /// Removes all specialized call targets that are no longer referenced
+            /// by any method in the parent context.
+            /// </summary>
+            internal void RemoveUnreferencedTargets()
+            {
+                var targets = new List<Method>(numSpecializations.Keys);
+                var referenced = new HashSet<Method>();
+                bool removed = true;
+                while (removed && targets.Count > 0)
+                {
+                    referenced.Clear();
+                    foreach (var method in Context.Methods)
+                    {
+                        method.Blocks.ForEachValue<MethodCall>(
+                            call => referenced.Add(call.Target));
+                    }
+
+                    // Removing a target can release further targets
+                    removed = false;
+                    for (int i = targets.Count - 1; i >= 0; --i)
+                    {
+                        var target = targets[i];
+                        if (referenced.Contains(target))
+                            continue;
+                        Context.Remove(target);
+                        targets.RemoveAt(i);
+                        removed = true;
+                    }
+                }
+            }
+        }
+
+        #endregion
+
+        #region Constants
+
+        /// <summary>
+        /// The default maximum number of specializations per method.
+        /// </summary>
+        public const int DefaultMaxNumSpecializations = 4;
+
+        /// <summary>
+        /// The default maximum number of values of a method to specialize.
+        /// </summary>
+        public const int DefaultMaxMethodSize = 512;
+
+        #endregion
+
+        #region Static
+
+        /// <summary>
+        /// Determines the specialization of the given argument.
+        /// </summary>
+        /// <param name="parameter">The target parameter.</param>
+        /// <param name="argument">The argument value.</param>
+        /// <returns>The argument specialization.</returns>
+        private static ArgumentSpecialization GetArgumentSpecialization(
+            Parameter parameter,
+            Value argument)
+        {
+            switch (argument)
+            {
+                case PrimitiveValue constant:
+                    return ArgumentSpecialization.ForConstant(constant);
+                case AddressSpaceCast cast when
+                    parameter.Type is AddressSpaceType parameterType &&
+                    parameterType.AddressSpace == MemoryAddressSpace.Generic &&
+                    cast.TargetAddressSpace == MemoryAddressSpace.Generic &&
+                    cast.SourceType.AddressSpace != MemoryAddressSpace.Generic:
+                    return ArgumentSpecialization.ForAddressSpace(
+                        cast.SourceType.AddressSpace);
+                case StructureValue structureValue when
+                    parameter.Type is StructureType structureType &&
+                    structureValue.StructureType == structureType:
+                    return GetStructureSpecialization(structureType, structureValue);
+                default:
+                    return default;
+            }
+        }
+
+        /// <summary>
+        /// Determines the specialization of the given structure argument whose
+        /// pointer fields may be casted from specific address spaces.
+        /// </summary>
+        /// <param name="structureType">The structure type.</param>
+        /// <param name="structureValue">The structure argument.</param>
+        /// <returns>The argument specialization.</returns>
+        private static ArgumentSpecialization GetStructureSpecialization(
+            StructureType structureType,
+            StructureValue structureValue)
+        {
+            var fieldAddressSpaces = ImmutableArray.CreateBuilder<MemoryAddressSpace>(
+                structureType.NumFields);
+            bool specialized = false;
+            for (int i = 0, e = structureType.NumFields; i < e; ++i)
+            {
+                // Padding fields cannot be reproduced by a specialized type
+                var fieldType = structureType.Fields[i];
+                if (fieldType.IsPaddingType)
+                    return default;
+
+                var addressSpace = MemoryAddressSpace.Generic;
+                if (fieldType is AddressSpaceType addressSpaceType &&
+                    addressSpaceType.AddressSpace == MemoryAddressSpace.Generic &&
+                    structureValue[i].Resolve() is AddressSpaceCast cast &&
+                    cast.TargetAddressSpace == MemoryAddressSpace.Generic &&
+                    cast.SourceType.AddressSpace != MemoryAddressSpace.Generic)
+                {
+                    addressSpace = cast.SourceType.AddressSpace;
+                    specialized = true;
+                }
+                fieldAddressSpaces.Add(addressSpace);
+            }
+            return specialized
+                ? ArgumentSpecialization.ForFieldAddressSpaces(
+                    fieldAddressSpaces.MoveToImmutable())
+                : default;
+        }
+
+        /// <summary>
+        /// Returns true if the given method allocates shared memory.
+        /// </summary>
+        private static bool AllocatesSharedMemory(Method method)
+        {
+            bool result = false;
+            method.Blocks.ForEachValue<Alloca>(alloca =>
+                result |= alloca.AddressSpace == MemoryAddressSpace.Shared);
+            return result;
+        }
+
+        /// <summary>
+        /// Returns the number of values of the given method.
+        /// </summary>
+        private static int GetMethodSize(Method method)
+        {
+            int size = 0;
+            foreach (var block in method.Blocks)
+                size += block.Count;
+            return size;
+        }
+
+        /// <summary>
+        /// Creates a new specialized clone of the given call target.
+        /// </summary>
+        /// <param name="context">The parent IR context.</param>
+        /// <param name="key">The specialization key.</param>
+        /// <returns>The specialized clone.</returns>
+        private static Method CreateSpecialization(
+            IRContext context,
+            in SpecializationKey key)
+        {
+            var target = key.Target;
+            var declaration = new MethodDeclaration(
+                MethodHandle.Create(target.Handle.Name),
+                target.ReturnType,
+                target.Source,
+                target.Flags & ~MethodFlags.EntryPoint);
+            var method = context.Declare(declaration, out var _);
+
+            using var builder = method.CreateBuilder();
+            var entryBuilder = builder.EntryBlockBuilder;
+            var location = target.Location;
+
+            // Create the parameters of the specialized method and map the original
+            // parameters to their specialized values
+            var parameterArguments = ValueList.Create(target.NumParameters);
+            for (int i = 0, e = target.NumParameters; i < e; ++i)
+            {
+                var parameter = target.Parameters[i];
+                var argument = key.Arguments[i];
+                if (argument.IsConstant)
+                {
+                    parameterArguments.Add(entryBuilder.CreatePrimitiveValue(
+                        location,
+                        argument.BasicValueType,
+                        argument.RawValue));
+                }
+                else if (argument.IsAddressSpace)
+                {
+                    var parameterType = entryBuilder.SpecializeAddressSpaceType(
+                        parameter.Type.As<AddressSpaceType>(location),
+                        argument.AddressSpace);
+                    var newParam = builder.AddParameter(parameterType, parameter.Name);
+
+                    // The remainder of the method still operates on the generic
+                    // address space; the cast is removed by the address-space
+                    // inference passes later on
+                    parameterArguments.Add(entryBuilder.CreateAddressSpaceCast(
+                        location,
+                        newParam,
+                        MemoryAddressSpace.Generic));
+                }
+                else if (argument.IsStructure)
+                {
+                    var structureType = parameter.Type.As<StructureType>(location);
+                    var typeBuilder = entryBuilder.CreateStructureType(
+                        structureType.NumFields);
+                    for (int j = 0, e2 = structureType.NumFields; j < e2; ++j)
+                    {
+                        var fieldType = structureType.Fields[j];
+                        var addressSpace = argument.FieldAddressSpaces[j];
+                        typeBuilder.Add(addressSpace == MemoryAddressSpace.Generic
+                            ? fieldType
+                            : entryBuilder.SpecializeAddressSpaceType(
+                                fieldType.As<AddressSpaceType>(location),
+                                addressSpace));
+                    }
+                    var newParam = builder.AddParameter(
+                        typeBuilder.Seal(),
+                        parameter.Name);
+
+                    // Rebuild the original structure using generic pointers
+                    var instance = entryBuilder.CreateStructure(
+                        location,
+                        structureType);
+                    for (int j = 0, e2 = structureType.NumFields; j < e2; ++j)
+                    {
+                        Value field = entryBuilder.CreateGetField(
+                            location,
+                            newParam,
+                            new FieldSpan(j));
+                        if (argument.FieldAddressSpaces[j] !=
+                            MemoryAddressSpace.Generic)
+                        {
+                            field = entryBuilder.CreateAddressSpaceCast(
+                                location,
+                                field,
+                                MemoryAddressSpace.Generic);
+                        }
+                        instance.Add(field);
+                    }
+                    parameterArguments.Add(instance.Seal());
+                }
+                else
+                {
+                    parameterArguments.Add(
+                        builder.AddParameter(parameter.Type, parameter.Name));
+                }
+            }
+
+            // Clone the original method body
+            var rebuilder = builder.CreateRebuilder<IRRebuilder.CloneMode>(
+                target.CreateParameterMapping(parameterArguments),
+                target.Blocks);
+            var (exitBlock, exitValue) = rebuilder.Rebuild();
+            exitBlock.CreateReturn(exitValue.Location, exitValue);
+            return method;
+        }
+
+        #endregion
+
+        #region Instance
+
+        /// <summary>
+        /// Constructs a new call-target specializer using default limits.
+        /// </summary>
+        public CallTargetSpecializer()
+            : this(DefaultMaxNumSpecializations, DefaultMaxMethodSize)
+        { }
+
+        /// <summary>
+        /// Constructs a new call-target specializer.
+        /// </summary>
+        /// <param name="maxNumSpecializations">
+        /// The maximum number of specializations per method.
+        /// </param>
+        /// <param name="maxMethodSize">
+        /// The maximum number of values of a method to specialize.
+        /// </param>
+        public CallTargetSpecializer(int maxNumSpecializations, int maxMethodSize)
+        {
+            if (maxNumSpecializations < 0)
+                throw new ArgumentOutOfRangeException(nameof(maxNumSpecializations));
+            if (maxMethodSize < 0)
+                throw new ArgumentOutOfRangeException(nameof(maxMethodSize));
+            MaxNumSpecializations = maxNumSpecializations;
+            MaxMethodSize = maxMethodSize;
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Returns the maximum number of specializations per method.
+        /// </summary>
+        public int MaxNumSpecializations { get; }
+
+        /// <summary>
+        /// Returns the maximum number of values of a method to specialize.
+        /// </summary>
+        public int MaxMethodSize { get; }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Creates a new <see cref="SpecializationProvider"/> instance.
+        /// </summary>
+        protected override SpecializationProvider CreateIntermediate(
+            in MethodCollection methods) =>
+            new SpecializationProvider(methods.Context);
+
+        /// <summary>
+        /// Returns true if the given call should be specialized.
+        /// </summary>
+        private bool CanSpecialize(Method caller, MethodCall call)
+        {
+            var target = call.Target;
+            return target != caller &&
+                target.HasImplementation &&
+                !target.HasFlags(MethodFlags.EntryPoint) &&
+                target.NumParameters == call.Count &&
+                GetMethodSize(target) <= MaxMethodSize &&
+                !AllocatesSharedMemory(target);
+        }
+
+        /// <summary>
+        /// Tries to specialize the given call.
+        /// </summary>
+        /// <returns>True, if the call has been specialized.</returns>
+        private bool TrySpecialize(
+            IRContext context,
+            Method.Builder builder,
+            SpecializationProvider provider,
+            MethodCall call)
+        {
+            if (!CanSpecialize(builder.Method, call))
+                return false;
+
+            // Determine the specialization of all arguments
+            var target = call.Target;
+            var arguments = ImmutableArray.CreateBuilder<ArgumentSpecialization>(
+                call.Count);
+            bool specialized = false;
+            for (int i = 0, e = call.Count; i < e; ++i)
+            {
+                var argument = GetArgumentSpecialization(
+                    target.Parameters[i],
+                    call[i]);
+                specialized |= !argument.IsDefault;
+                arguments.Add(argument);
+            }
+            if (!specialized)
+                return false;
+
+            // Get or create the specialized clone
+            var key = new SpecializationKey(target, arguments.MoveToImmutable());
+            if (!provider.TryGetSpecialization(key, out var specialization))
+            {
+                if (provider.GetNumSpecializations(target) >= MaxNumSpecializations)
+                    return false;
+                specialization = CreateSpecialization(context, key);
+                provider.Register(key, specialization);
+            }
+
+            // Rebuild the call using all remaining arguments
+            var blockBuilder = builder[call.BasicBlock];
+            blockBuilder.SetupInsertPosition(call);
+            var callBuilder = blockBuilder.CreateCall(call.Location, specialization);
+            for (int i = 0, parameterIndex = 0, e = call.Count; i < e; ++i)
+            {
+                var argument = key.Arguments[i];
+                if (argument.IsConstant)
+                    continue;
+                var parameter = specialization.Parameters[parameterIndex++];
+                if (argument.IsAddressSpace)
+                {
+                    callBuilder.Add(call[i].ResolveAs<AddressSpaceCast>().Value);
+                }
+                else if (argument.IsStructure)
+                {
+                    // Pass all specialized fields without their generic casts
+                    var structureValue = call[i].ResolveAs<StructureValue>();
+                    var instance = blockBuilder.CreateStructure(
+                        call.Location,
+                        parameter.Type.As<StructureType>(call.Location));
+                    for (int j = 0, e2 = structureValue.Count; j < e2; ++j)
+                    {
+                        var field = structureValue[j];
+                        instance.Add(argument.FieldAddressSpaces[j] !=
+                            MemoryAddressSpace.Generic
+                            ? field.ResolveAs<AddressSpaceCast>().Value
+                            : field);
+                    }
+                    callBuilder.Add(instance.Seal());
+                }
+                else
+                {
+                    callBuilder.Add(call[i]);
+                }
+            }
+            call.Replace(callBuilder.Seal());
+            blockBuilder.Remove(call);
+            return true;
+        }
+
+        /// <summary>
+        /// Applies the call-target specialization transformation.
+        /// </summary>
+        protected override bool PerformTransformation(
+            IRContext context,
+            Method.Builder builder,
+            in SpecializationProvider intermediate,
+            Landscape landscape,
+            Landscape.Entry current)
+        {
+            var calls = new List<MethodCall>();
+            builder.SourceBlocks.ForEachValue<MethodCall>(calls.Add);
+
+            bool applied = false;
+            foreach (var call in calls)
+                applied |= TrySpecialize(context, builder, intermediate, call);
+            return applied;
+        }
+
+        /// <summary>
+        /// Removes all original call targets that are no longer referenced.
+        /// </summary>
+        protected override void FinishProcessing(
+            in SpecializationProvider intermediate) =>
+            intermediate.RemoveUnreferencedTargets();
+
+        #endregion
+    }
+}
@@ -31,7 +31,7 @@ namespace ILGPU.IR.Transformations
         /// <summary>
         /// Remaps source to target blocks.
         /// </summary>
-        private readonly struct Remapper : TerminatorValue.ITargetRemapper
+        internal readonly struct Remapper : TerminatorValue.ITargetRemapper
         {
             /// <summary>
             /// Constructs a new remapper.
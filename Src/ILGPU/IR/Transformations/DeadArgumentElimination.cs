@@ -0,0 +1,373 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: DeadArgumentElimination.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.IR.Analyses;
+using ILGPU.IR.Rewriting;
+using ILGPU.IR.Values;
+using System.Collections.Generic;
+
+namespace ILGPU.IR.Transformations
+{
+    /// <summary>
+    /// Removes unused parameters and return values of all non-inlined methods and
+    /// propagates constant arguments into their callees.
+    /// </summary>
+    /// <remarks>
+    /// CAUTION: This transformation changes the signatures of all affected methods.
+    /// It assumes that all call sites of a method are contained in the method
+    /// collection being transformed (which is the case for kernel contexts in
+    /// the scope of a backend). Entry points, external methods and methods that are
+    /// part of a recursive call chain are never changed.
+    /// </remarks>
+    public sealed class DeadArgumentElimination :
+        OrderedTransformation<DeadArgumentElimination.CallSiteProvider>
+    {
+        #region Nested Types
+
+        /// <summary>
+        /// Stores all changes that have been applied to a single method signature.
+        /// </summary>
+        internal sealed class Specialization
+        {
+            /// <summary>
+            /// Constructs a new specialization.
+            /// </summary>
+            /// <param name="numParameters">The original number of parameters.</param>
+            public Specialization(int numParameters)
+            {
+                RemovedParameters = new bool[numParameters];
+            }
+
+            /// <summary>
+            /// Returns a flag per original parameter that is set to true if the
+            /// parameter has been removed.
+            /// </summary>
+            public bool[] RemovedParameters { get; }
+
+            /// <summary>
+            /// Returns true if at least one parameter has been removed.
+            /// </summary>
+            public bool HasRemovedParameters { get; set; }
+
+            /// <summary>
+            /// Returns true if the return value has been removed.
+            /// </summary>
+            public bool RemovedReturnValue { get; set; }
+
+            /// <summary>
+            /// Returns true if the signature of the method has changed.
+            /// </summary>
+            public bool HasChanged => HasRemovedParameters | RemovedReturnValue;
+        }
+
+        /// <summary>
+        /// Collects all call sites and tracks all specialized methods.
+        /// </summary>
+        public sealed class CallSiteProvider
+        {
+            #region Instance
+
+            private readonly Dictionary<Method, List<MethodCall>> callSites =
+                new Dictionary<Method, List<MethodCall>>();
+            private readonly Dictionary<Method, Specialization> specializations =
+                new Dictionary<Method, Specialization>();
+            private readonly HashSet<Method> processed = new HashSet<Method>();
+
+            /// <summary>
+            /// Constructs a new provider by gathering all call sites of the given
+            /// methods.
+            /// </summary>
+            /// <param name="methods">The collection of methods.</param>
+            internal CallSiteProvider(in MethodCollection methods)
+            {
+                foreach (var method in methods)
+                {
+                    method.Blocks.ForEachValue<MethodCall>(call =>
+                    {
+                        if (!callSites.TryGetValue(call.Target, out var calls))
+                        {
+                            calls = new List<MethodCall>();
+                            callSites.Add(call.Target, calls);
+                        }
+                        calls.Add(call);
+                    });
+                }
+            }
+
+            #endregion
+
+            #region Methods
+
+            /// <summary>
+            /// Tries to get all call sites of the given method. Succeeds if the
+            /// signature of the method can be safely changed.
+            /// </summary>
+            /// <param name="method">The method to get the call sites for.</param>
+            /// <param name="calls">All call sites of the given method.</param>
+            /// <returns>True, if the signature can be changed.</returns>
+            internal bool TryGetCallSites(Method method, out List<MethodCall> calls)
+            {
+                if (!method.HasImplementation ||
+                    method.HasFlags(MethodFlags.EntryPoint) ||
+                    !callSites.TryGetValue(method, out calls))
+                {
+                    calls = null;
+                    return false;
+                }
+
+                // All callers have to be processed after the current method in order
+                // to update their call sites. This does not hold for recursive
+                // methods and methods that are part of a call cycle.
+                foreach (var call in calls)
+                {
+                    var caller = call.Method;
+                    if (caller == method || processed.Contains(caller))
+                        return false;
+                }
+                return true;
+            }
+
+            /// <summary>
+            /// Marks the given method as processed.
+            /// </summary>
+            /// <param name="method">The processed method.</param>
+            internal void MarkProcessed(Method method) => processed.Add(method);
+
+            /// <summary>
+            /// Registers the specialization of the given method.
+            /// </summary>
+            /// <param name="method">The specialized method.</param>
+            /// <param name="specialization">The specialization.</param>
+            internal void Register(Method method, Specialization specialization) =>
+                specializations.Add(method, specialization);
+
+            /// <summary>
+            /// Tries to get the specialization of the given method.
+            /// </summary>
+            /// <param name="method">The method.</param>
+            /// <param name="specialization">The resolved specialization.</param>
+            /// <returns>True, if the method has been specialized.</returns>
+            internal bool TryGetSpecialization(
+                Method method,
+                out Specialization specialization) =>
+                specializations.TryGetValue(method, out specialization);
+
+            #endregion
+        }
+
+        #endregion
+
+        #region Static
+
+        /// <summary>
+        /// Tries to determine a constant that is passed to the given parameter at all
+        /// call sites.
+        /// </summary>
+        /// <param name="calls">All call sites.</param>
+        /// <param name="parameterIndex">The parameter index.</param>
+        /// <param name="constant">The resolved constant (if any).</param>
+        /// <returns>True, if all call sites pass the same constant.</returns>
+        private static bool TryGetConstantArgument(
+            List<MethodCall> calls,
+            int parameterIndex,
+            out PrimitiveValue constant)
+        {
+            constant = calls[0][parameterIndex].Resolve() as PrimitiveValue;
+            if (constant is null)
+                return false;
+            for (int i = 1, e = calls.Count; i < e; ++i)
+            {
+                if (!(calls[i][parameterIndex].Resolve() is PrimitiveValue other) ||
+                    other.BasicValueType != constant.BasicValueType ||
+                    other.RawValue != constant.RawValue)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// <summary>
+        /// Returns true if the results of all call sites are unused.
+        /// </summary>
+        /// <param name="calls">All call sites.</param>
+        /// <returns>True, if the return value is never used.</returns>
+        private static bool IsReturnValueUnused(List<MethodCall> calls)
+        {
+            foreach (var call in calls)
+            {
+                if (call.Uses.HasAny)
+                    return false;
+            }
+            return true;
+        }
+
+        /// <summary>
+        /// Specializes the signature of the given method.
+        /// </summary>
+        /// <param name="builder">The current method builder.</param>
+        /// <param name="calls">All call sites.</param>
+        /// <returns>The created specialization.</returns>
+        private static Specialization SpecializeSignature(
+            Method.Builder builder,
+            List<MethodCall> calls)
+        {
+            var method = builder.Method;
+            var specialization = new Specialization(builder.NumParams);
+            var entryBuilder = builder.EntryBlockBuilder;
+            entryBuilder.SetupInsertPositionToStart();
+
+            for (int i = 0, e = builder.NumParams; i < e; ++i)
+            {
+                var parameter = builder[i];
+                if (TryGetConstantArgument(calls, i, out var constant))
+                {
+                    // Propagate the constant into the current method
+                    parameter.Replace(entryBuilder.CreatePrimitiveValue(
+                        parameter.Location,
+                        constant.BasicValueType,
+                        constant.RawValue));
+                }
+                else if (!parameter.Uses.HasAny)
+                {
+                    parameter.Replace(entryBuilder.CreateUndefined());
+                }
+                else
+                {
+                    continue;
+                }
+
+                specialization.RemovedParameters[i] = true;
+                specialization.HasRemovedParameters = true;
+            }
+
+            // Remove the return value if it is never used
+            if (!method.IsVoid && IsReturnValueUnused(calls))
+            {
+                builder.UpdateReturnType(builder.TypeContext.VoidType);
+                foreach (var block in builder.SourceBlocks)
+                {
+                    if (block.Terminator is ReturnTerminator terminator)
+                        builder[block].CreateReturn(terminator.Location);
+                }
+                specialization.RemovedReturnValue = true;
+            }
+
+            return specialization;
+        }
+
+        #endregion
+
+        #region Rewriter Methods
+
+        /// <summary>
+        /// Returns true if the target of the given call has been specialized.
+        /// </summary>
+        private static bool CanRewrite(CallSiteProvider data, MethodCall call) =>
+            data.TryGetSpecialization(call.Target, out _);
+
+        /// <summary>
+        /// Rewrites a call to a specialized method.
+        /// </summary>
+        private static void Rewrite(
+            RewriterContext context,
+            CallSiteProvider data,
+            MethodCall call)
+        {
+            data.TryGetSpecialization(call.Target, out var specialization);
+
+            // Rebuild the call using all remaining arguments
+            var callBuilder = context.Builder.CreateCall(call.Location, call.Target);
+            for (int i = 0, e = call.Count; i < e; ++i)
+            {
+                if (!specialization.RemovedParameters[i])
+                    callBuilder.Add(call[i]);
+            }
+            context.ReplaceAndRemove(call, callBuilder.Seal());
+        }
+
+        #endregion
+
+        #region Rewriter
+
+        /// <summary>
+        /// The internal rewriter.
+        /// </summary>
+        private static readonly Rewriter<CallSiteProvider> Rewriter =
+            new Rewriter<CallSiteProvider>();
+
+        /// <summary>
+        /// Registers all rewriting patterns.
+        /// </summary>
+        static DeadArgumentElimination()
+        {
+            Rewriter.Add<MethodCall>(CanRewrite, Rewrite);
+        }
+
+        #endregion
+
+        #region Instance
+
+        /// <summary>
+        /// Constructs a new dead argument elimination transformation.
+        /// </summary>
+        public DeadArgumentElimination() { }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Creates a new <see cref="CallSiteProvider"/> instance.
+        /// </summary>
+        protected override CallSiteProvider CreateIntermediate(
+            in MethodCollection methods) =>
+            new CallSiteProvider(methods);
+
+        /// <summary>
+        /// Applies the dead argument elimination transformation.
+        /// </summary>
+        protected override bool PerformTransformation(
+            IRContext context,
+            Method.Builder builder,
+            in CallSiteProvider intermediate,
+            Landscape landscape,
+            Landscape.Entry current)
+        {
+            // Update all calls to methods that have already been specialized
+            bool applied = Rewriter.Rewrite(
+                builder.SourceBlocks,
+                builder,
+                intermediate);
+
+            // Specialize the signature of the current method
+            if (intermediate.TryGetCallSites(builder.Method, out var calls))
+            {
+                var specialization = SpecializeSignature(builder, calls);
+                if (specialization.HasChanged)
+                {
+                    intermediate.Register(builder.Method, specialization);
+                    applied = true;
+                }
+            }
+
+            intermediate.MarkProcessed(builder.Method);
+            return applied;
+        }
+
+        /// <summary>
+        /// Performs no operation.
+        /// </summary>
+        protected override void FinishProcessing(in CallSiteProvider intermediate) { }
+
+        #endregion
+    }
+}
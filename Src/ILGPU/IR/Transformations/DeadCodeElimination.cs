@@ -9,6 +9,7 @@
 // Source License. See LICENSE.txt for details
 // ---------------------------------------------------------------------------------------
 
+using ILGPU.IR.Analyses;
 using ILGPU.IR.Values;
 using System.Collections.Generic;
 using System.Diagnostics;
@@ -29,6 +30,17 @@ namespace ILGPU.IR.Transformations
 
         #endregion
 
+        #region Properties
+
+        /// <summary>
+        /// Returns <see cref="PreservedAnalyses.ControlFlow"/> since this
+        /// transformation never removes terminators.
+        /// </summary>
+        protected internal override PreservedAnalyses PreservedAnalyses =>
+            PreservedAnalyses.ControlFlow;
+
+        #endregion
+
         #region Methods
 
         /// <summary>
@@ -292,6 +292,11 @@ namespace ILGPU.IR.Transformations
                 if (successors.Length != 2)
                     return false;
 
+                // Keep biased branches to avoid executing the unlikely path in all
+                // cases
+                if (block.Terminator is IfBranch branch && branch.LikelyTarget != null)
+                    return false;
+
                 // Compute the common dominator of all successors
                 var postDominator = PostDominators.GetImmediateCommonDominator(
                    successors);
@@ -1037,15 +1042,19 @@ namespace ILGPU.IR.Transformations
             /// Constructs a new conditional analyzer.
             /// </summary>
             /// <param name="blocks">The current block collection.</param>
+            /// <param name="dominators">The dominators of the current blocks.</param>
             /// <param name="maxBlockSize">The maximum block size.</param>
-            public ConditionalAnalyzer(in BlockCollection blocks, int maxBlockSize)
+            public ConditionalAnalyzer(
+                in BlockCollection blocks,
+                Dominators dominators,
+                int maxBlockSize)
             {
                 kinds = blocks.CreateMap<BlockKind>();
 
                 MaxNumBlocks = blocks.Count;
                 MaxBlockSize = maxBlockSize;
 
-                Dominators = blocks.CreateDominators();
+                Dominators = dominators;
             }
 
             #endregion
@@ -1622,7 +1631,10 @@ namespace ILGPU.IR.Transformations
 
             // Create the conditional analyzer to detect compatible block setups
             var blocks = builder.SourceBlocks;
-            var analyzer = new ConditionalAnalyzer(blocks, MaxBlockSize);
+            var analyzer = new ConditionalAnalyzer(
+                blocks,
+                builder.Method.Analyses.GetDominators(),
+                MaxBlockSize);
 
             // Convert all ifs in post order
             bool applied = false;
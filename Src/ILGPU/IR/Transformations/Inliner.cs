@@ -73,23 +73,46 @@ namespace ILGPU.IR.Transformations
             }
         }
 
+        /// <summary>
+        /// Returns true if inlining the given method is not required, since it has
+        /// been marked for inlining by the generic size heuristic only.
+        /// </summary>
+        /// <param name="method">The method to test.</param>
+        /// <returns>True, if inlining the given method is optional.</returns>
+        private static bool IsOptionalInlineTarget(Method method)
+        {
+            if (!method.HasSource)
+                return false;
+            var source = method.Source;
+            return (source.MethodImplementationFlags &
+                MethodImplAttributes.AggressiveInlining) !=
+                MethodImplAttributes.AggressiveInlining &&
+                source.Module.Name != Context.FullAssemblyModuleName;
+        }
+
         /// <summary>
         /// Tries to inline method calls.
         /// </summary>
         /// <param name="builder">The current method builder.</param>
         /// <param name="currentBlock">The current block (may be modified).</param>
+        /// <param name="isCold">
+        /// True, if the current block is unlikely to be executed.
+        /// </param>
         /// <returns>True, in case of an inlined call.</returns>
         [MethodImpl(MethodImplOptions.AggressiveInlining)]
         private static bool InlineCalls(
             Method.Builder builder,
-            ref BasicBlock currentBlock)
+            ref BasicBlock currentBlock,
+            bool isCold)
         {
             foreach (var valueEntry in currentBlock)
             {
                 if (!(valueEntry.Value is MethodCall call))
                     continue;
 
-                if (call.Target.HasFlags(MethodFlags.Inline))
+                // Avoid code growth in blocks that are unlikely to be executed
+                if (call.Target.HasFlags(MethodFlags.Inline) &&
+                    !(isCold && IsOptionalInlineTarget(call.Target)))
                 {
                     var blockBuilder = builder[currentBlock];
                     var tempBlock = blockBuilder.SpecializeCall(call);
@@ -128,6 +151,7 @@ namespace ILGPU.IR.Transformations
         {
             var processed = builder.SourceBlocks.CreateSet();
             var toProcess = new Stack<BasicBlock>();
+            var coldBlocks = BranchConditions.GetColdBlocks(builder.Method);
 
             bool result = false;
             var currentBlock = builder.EntryBlock;
@@ -136,8 +160,12 @@ namespace ILGPU.IR.Transformations
             {
                 if (processed.Add(currentBlock))
                 {
-                    if (result = InlineCalls(builder, ref currentBlock))
+                    bool isCold = coldBlocks.Contains(currentBlock);
+                    if (result = InlineCalls(builder, ref currentBlock, isCold))
                     {
+                        // The remainder of a cold block is cold as well
+                        if (isCold)
+                            coldBlocks.Add(currentBlock);
                         result = true;
                         continue;
                     }
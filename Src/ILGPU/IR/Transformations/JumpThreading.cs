@@ -0,0 +1,192 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: JumpThreading.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.IR.Analyses;
+using ILGPU.IR.Analyses.ControlFlowDirection;
+using ILGPU.IR.Values;
+
+namespace ILGPU.IR.Transformations
+{
+    /// <summary>
+    /// Threads jumps through branches whose conditions are already known.
+    /// </summary>
+    /// <remarks>
+    /// The pass performs two steps:
+    /// 1) Branches that depend on a phi condition which is constant for a particular
+    /// predecessor are bypassed by retargeting this predecessor to the known successor.
+    /// This is a restricted form of tail duplication that only duplicates the branch
+    /// itself to avoid any code growth.
+    /// 2) Branches whose conditions have already been checked by a dominating branch
+    /// (e.g. repeated guards or bounds checks) are folded into unconditional branches.
+    /// </remarks>
+    public sealed class JumpThreading : UnorderedTransformation
+    {
+        #region Static
+
+        /// <summary>
+        /// Returns true if both conditions are guaranteed to evaluate to the same
+        /// value.
+        /// </summary>
+        /// <param name="first">The first condition.</param>
+        /// <param name="second">The second condition.</param>
+        /// <returns>True, if both conditions are equivalent.</returns>
+        private static bool AreEquivalent(Value first, Value second)
+        {
+            if (first == second)
+                return true;
+            return first is CompareValue firstCompare &&
+                second is CompareValue secondCompare &&
+                firstCompare.Kind == secondCompare.Kind &&
+                firstCompare.Flags == secondCompare.Flags &&
+                firstCompare.Left.Resolve() == secondCompare.Left.Resolve() &&
+                firstCompare.Right.Resolve() == secondCompare.Right.Resolve();
+        }
+
+        /// <summary>
+        /// Tries to determine the value of the given branch condition by inspecting
+        /// all dominating branches of the given block.
+        /// </summary>
+        /// <param name="dominators">The dominators of the parent method.</param>
+        /// <param name="block">The block to analyze.</param>
+        /// <param name="condition">The branch condition of the block.</param>
+        /// <param name="value">The known value of the branch condition.</param>
+        /// <returns>True, if the condition value could be determined.</returns>
+        private static bool TryGetKnownCondition(
+            Dominators<Forwards> dominators,
+            BasicBlock block,
+            Value condition,
+            out bool value)
+        {
+            foreach (var (knownCondition, knownValue) in
+                dominators.GetDominatingConditions(block))
+            {
+                if (AreEquivalent(knownCondition, condition))
+                {
+                    value = knownValue;
+                    return true;
+                }
+            }
+            value = default;
+            return false;
+        }
+
+        /// <summary>
+        /// Retargets all predecessors that pass a constant condition to a block that
+        /// consists of a single phi-dependent branch.
+        /// </summary>
+        /// <param name="builder">The parent method builder.</param>
+        /// <returns>True, if at least one predecessor has been retargeted.</returns>
+        private static bool ThreadPhiBranches(Method.Builder builder)
+        {
+            var blocks = builder.SourceBlocks;
+            var phiSources = blocks.ComputePhiSources();
+
+            bool applied = false;
+            foreach (var block in blocks)
+            {
+                // Check for a block that contains the condition phi only. Blocks that
+                // provide phi arguments cannot be bypassed
+                if (block.Count != 1 ||
+                    phiSources.Contains(block) ||
+                    !(block.Terminator is IfBranch branch) ||
+                    !(branch.Condition.Resolve() is PhiValue phi) ||
+                    phi.BasicBlock != block ||
+                    !phi.Uses.HasExactlyOne)
+                {
+                    continue;
+                }
+
+                for (int i = 0, e = phi.Count; i < e; ++i)
+                {
+                    var source = phi.Sources[i];
+                    if (source == block ||
+                        !(phi[i].Resolve() is PrimitiveValue constant))
+                    {
+                        continue;
+                    }
+
+                    // Jump directly to the known target
+                    var target = constant.Int1Value
+                        ? branch.TrueTarget
+                        : branch.FalseTarget;
+                    source.Terminator.RemapTargets(
+                        builder[source],
+                        new CleanupBlocks.Remapper(block, target));
+                    applied = true;
+                }
+            }
+
+            if (applied)
+                UnreachableCodeElimination.RemoveUnreachableBlocks(builder, blocks);
+            return applied;
+        }
+
+        /// <summary>
+        /// Folds all branches whose conditions are known due to dominating branches.
+        /// </summary>
+        /// <param name="builder">The parent method builder.</param>
+        /// <returns>True, if at least one branch has been folded.</returns>
+        private static bool FoldDominatedBranches(Method.Builder builder)
+        {
+            var blocks = builder.SourceBlocks;
+            var dominators = builder.Method.Analyses.GetDominators();
+
+            bool applied = false;
+            foreach (var block in blocks)
+            {
+                if (!(block.Terminator is IfBranch branch) ||
+                    branch.TrueTarget == branch.FalseTarget ||
+                    !TryGetKnownCondition(
+                        dominators,
+                        block,
+                        branch.Condition.Resolve(),
+                        out bool value))
+                {
+                    continue;
+                }
+
+                builder[block].CreateBranch(
+                    branch.Location,
+                    value ? branch.TrueTarget : branch.FalseTarget);
+                applied = true;
+            }
+
+            if (applied)
+                UnreachableCodeElimination.RemoveUnreachableBlocks(builder, blocks);
+            return applied;
+        }
+
+        #endregion
+
+        #region Instance
+
+        /// <summary>
+        /// Constructs a new jump threading transformation.
+        /// </summary>
+        public JumpThreading() { }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Applies the jump threading transformation.
+        /// </summary>
+        protected override bool PerformTransformation(Method.Builder builder)
+        {
+            bool applied = ThreadPhiBranches(builder);
+            applied |= FoldDominatedBranches(builder);
+            return applied;
+        }
+
+        #endregion
+    }
+}
@@ -198,8 +198,7 @@ namespace ILGPU.IR.Transformations
         /// </summary>
         protected override bool PerformTransformation(Method.Builder builder)
         {
-            var cfg = builder.SourceBlocks.CreateCFG();
-            var loops = cfg.CreateLoops();
+            var loops = builder.Method.Analyses.GetLoops();
 
             // We change the control-flow structure during the transformation but
             // need to get information about previous predecessors and successors
@@ -342,13 +342,16 @@ namespace ILGPU.IR.Transformations
         private struct LoopProcessor : Loops.ILoopProcessor
         {
             private readonly LoopInfos loopInfos;
+            private readonly HashSet<BasicBlock> coldBlocks;
 
             public LoopProcessor(
                 in LoopInfos<ReversePostOrder, Forwards> infos,
+                HashSet<BasicBlock> cold,
                 Method.Builder builder,
                 int maxUnrollFactor)
             {
                 loopInfos = infos;
+                coldBlocks = cold;
                 Builder = builder;
                 MaxUnrollFactor = maxUnrollFactor;
                 Applied = false;
@@ -378,6 +381,7 @@ namespace ILGPU.IR.Transformations
                     Builder,
                     loop,
                     loopInfos,
+                    coldBlocks,
                     MaxUnrollFactor);
         }
 
@@ -477,11 +481,14 @@ namespace ILGPU.IR.Transformations
             Method.Builder builder,
             Loop loop,
             LoopInfos loopInfos,
+            HashSet<BasicBlock> coldBlocks,
             int maxUnrollFactor)
         {
-            // Try to find a loop information entry and ensure a simple loop for now
+            // Try to find a loop information entry and ensure a simple loop for now.
+            // Loops that are unlikely to be executed are not worth the code growth.
             if (!loopInfos.TryGetInfo(loop, out var loopInfo) ||
-                loopInfo.InductionVariables.Length != 1)
+                loopInfo.InductionVariables.Length != 1 ||
+                coldBlocks.Contains(loopInfo.Header))
             {
                 return false;
             }
@@ -587,9 +594,9 @@ namespace ILGPU.IR.Transformations
         /// </summary>
         protected override bool PerformTransformation(Method.Builder builder)
         {
-            var cfg = builder.SourceBlocks.CreateCFG();
-            var loops = cfg.CreateLoops();
+            var loops = builder.Method.Analyses.GetLoops();
             var loopInfos = loops.CreateLoopInfos();
+            var coldBlocks = BranchConditions.GetColdBlocks(builder.Method);
 
             // We change the control-flow structure during the transformation but
             // need to get information about previous predecessors and successors
@@ -597,6 +604,7 @@ namespace ILGPU.IR.Transformations
 
             return loops.ProcessLoops(new LoopProcessor(
                 loopInfos,
+                coldBlocks,
                 builder,
                 MaxUnrollFactor)).Applied;
         }
@@ -0,0 +1,483 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: LowerBFloat16.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.IR.Construction;
+using ILGPU.IR.Rewriting;
+using ILGPU.IR.Types;
+using ILGPU.IR.Values;
+
+namespace ILGPU.IR.Transformations
+{
+    /// <summary>
+    /// Converts brain float values into raw 16-bit integers and single precision
+    /// operations.
+    /// </summary>
+    /// <remarks>
+    /// Brain floats are stored in their raw 16-bit representation. All arithmetic
+    /// operations, comparisons and conversions are carried out in single precision
+    /// and rounded back to the nearest even brain float value. Local and shared
+    /// allocations of brain floats are converted into 16-bit integer allocations.
+    /// Note that the element types of array values are not converted by this
+    /// transformation.
+    /// </remarks>
+    public sealed class LowerBFloat16 : LowerTypes<PrimitiveType>
+    {
+        #region Nested Types
+
+        private sealed class BFloat16TypeLowering : TypeLowering<PrimitiveType>
+        {
+            /// <summary>
+            /// Constructs a new brain float type lowering.
+            /// </summary>
+            /// <param name="builder">The parent builder.</param>
+            public BFloat16TypeLowering(Method.Builder builder)
+                : base(builder)
+            { }
+
+            /// <summary>
+            /// Returns true if the given type depends on a brain float type.
+            /// </summary>
+            public override bool IsTypeDependent(TypeNode type) =>
+                type.HasFlags(TypeFlags.BFloat16Dependent);
+
+            /// <summary>
+            /// Converts brain float types into 16-bit integer types.
+            /// </summary>
+            protected override TypeNode ConvertType<TTypeContext>(
+                TTypeContext typeContext,
+                PrimitiveType type) =>
+                type.BasicValueType == BasicValueType.BFloat16
+                ? typeContext.GetPrimitiveType(BasicValueType.Int16)
+                : type;
+
+            /// <summary>
+            /// Returns 1, since brain floats map to a single integer.
+            /// </summary>
+            protected override int GetNumFields(PrimitiveType type) => 1;
+        }
+
+        #endregion
+
+        #region Rewriter Helper Methods
+
+        /// <summary>
+        /// Returns true if the given value is a brain float.
+        /// </summary>
+        private static bool IsBFloat16(Value value) =>
+            value.BasicValueType == BasicValueType.BFloat16;
+
+        /// <summary>
+        /// Widens a raw brain float into a single precision value.
+        /// </summary>
+        /// <returns>The single precision value.</returns>
+        private static Value WidenToFloat(
+            IRBuilder builder,
+            Location location,
+            Value rawValue)
+        {
+            var extended = builder.CreateConvert(
+                location,
+                rawValue,
+                builder.GetPrimitiveType(BasicValueType.Int32),
+                ConvertFlags.SourceUnsigned);
+            var bits = builder.CreateArithmetic(
+                location,
+                extended,
+                builder.CreatePrimitiveValue(location, 16),
+                BinaryArithmeticKind.Shl);
+            return builder.CreateIntAsFloatCast(location, bits);
+        }
+
+        /// <summary>
+        /// Narrows a single precision value into a raw brain float by rounding to
+        /// the nearest even value.
+        /// </summary>
+        /// <returns>The raw brain float.</returns>
+        private static Value NarrowToBFloat16(
+            IRBuilder builder,
+            Location location,
+            Value floatValue)
+        {
+            var bits = builder.CreateFloatAsIntCast(location, floatValue);
+
+            // Round to nearest even: bits + 0x7FFF + ((bits >> 16) & 1)
+            var lsb = builder.CreateArithmetic(
+                location,
+                builder.CreateArithmetic(
+                    location,
+                    bits,
+                    builder.CreatePrimitiveValue(location, 16),
+                    BinaryArithmeticKind.Shr,
+                    ArithmeticFlags.Unsigned),
+                builder.CreatePrimitiveValue(location, 1),
+                BinaryArithmeticKind.And);
+            var rounded = builder.CreateArithmetic(
+                location,
+                builder.CreateArithmetic(
+                    location,
+                    bits,
+                    builder.CreatePrimitiveValue(location, 0x7FFF),
+                    BinaryArithmeticKind.Add),
+                lsb,
+                BinaryArithmeticKind.Add);
+            var upperBits = builder.CreateConvert(
+                location,
+                builder.CreateArithmetic(
+                    location,
+                    rounded,
+                    builder.CreatePrimitiveValue(location, 16),
+                    BinaryArithmeticKind.Shr,
+                    ArithmeticFlags.Unsigned),
+                builder.GetPrimitiveType(BasicValueType.Int16));
+
+            // Map all NaNs to the canonical quiet NaN to keep them from rounding
+            // into infinities
+            var isNaN = builder.CreateCompare(
+                location,
+                builder.CreateArithmetic(
+                    location,
+                    bits,
+                    builder.CreatePrimitiveValue(location, 0x7FFFFFFF),
+                    BinaryArithmeticKind.And),
+                builder.CreatePrimitiveValue(location, 0x7F800000),
+                CompareKind.GreaterThan,
+                CompareFlags.UnsignedOrUnordered);
+            return builder.CreatePredicate(
+                location,
+                isNaN,
+                builder.CreatePrimitiveValue(location, (short)0x7FC0),
+                upperBits);
+        }
+
+        /// <summary>
+        /// Narrows the given value into a raw brain float if the source value was
+        /// a brain float.
+        /// </summary>
+        private static Value NarrowIfRequired(
+            IRBuilder builder,
+            Value source,
+            Value floatValue) =>
+            IsBFloat16(source)
+            ? NarrowToBFloat16(builder, source.Location, floatValue)
+            : floatValue;
+
+        #endregion
+
+        #region Rewriter Methods
+
+        /// <summary>
+        /// Lowers brain float constants into raw 16-bit integer constants.
+        /// </summary>
+        private static void Lower(
+            RewriterContext context,
+            TypeLowering<PrimitiveType> typeLowering,
+            PrimitiveValue value)
+        {
+            var newValue = context.Builder.CreatePrimitiveValue(
+                value.Location,
+                (short)value.RawValue);
+            context.ReplaceAndRemove(value, newValue);
+        }
+
+        /// <summary>
+        /// Lowers structure values into structures with converted field types.
+        /// </summary>
+        private static void Lower(
+            RewriterContext context,
+            TypeLowering<PrimitiveType> typeLowering,
+            StructureValue value)
+        {
+            var builder = context.Builder;
+            var instance = builder.CreateStructure(
+                value.Location,
+                typeLowering.ConvertType(value) as StructureType);
+            foreach (Value field in value)
+                instance.Add(field);
+            context.ReplaceAndRemove(value, instance.Seal());
+        }
+
+        /// <summary>
+        /// Lowers unary brain float operations.
+        /// </summary>
+        private static void Lower(
+            RewriterContext context,
+            TypeLowering<PrimitiveType> typeLowering,
+            UnaryArithmeticValue value)
+        {
+            var builder = context.Builder;
+            var location = value.Location;
+
+            Value newValue;
+            switch (value.Kind)
+            {
+                case UnaryArithmeticKind.Neg:
+                    newValue = builder.CreateArithmetic(
+                        location,
+                        value.Value,
+                        builder.CreatePrimitiveValue(location, unchecked((short)0x8000)),
+                        BinaryArithmeticKind.Xor);
+                    break;
+                case UnaryArithmeticKind.Abs:
+                    newValue = builder.CreateArithmetic(
+                        location,
+                        value.Value,
+                        builder.CreatePrimitiveValue(location, (short)0x7FFF),
+                        BinaryArithmeticKind.And);
+                    break;
+                default:
+                    newValue = NarrowIfRequired(
+                        builder,
+                        value,
+                        builder.CreateArithmetic(
+                            location,
+                            WidenToFloat(builder, location, value.Value),
+                            value.Kind,
+                            value.Flags));
+                    break;
+            }
+            context.ReplaceAndRemove(value, newValue);
+        }
+
+        /// <summary>
+        /// Lowers binary brain float operations.
+        /// </summary>
+        private static void Lower(
+            RewriterContext context,
+            TypeLowering<PrimitiveType> typeLowering,
+            BinaryArithmeticValue value)
+        {
+            var builder = context.Builder;
+            var location = value.Location;
+            var newValue = builder.CreateArithmetic(
+                location,
+                WidenToFloat(builder, location, value.Left),
+                WidenToFloat(builder, location, value.Right),
+                value.Kind,
+                value.Flags);
+            context.ReplaceAndRemove(
+                value,
+                NarrowIfRequired(builder, value, newValue));
+        }
+
+        /// <summary>
+        /// Lowers ternary brain float operations.
+        /// </summary>
+        private static void Lower(
+            RewriterContext context,
+            TypeLowering<PrimitiveType> typeLowering,
+            TernaryArithmeticValue value)
+        {
+            var builder = context.Builder;
+            var location = value.Location;
+            var newValue = builder.CreateArithmetic(
+                location,
+                WidenToFloat(builder, location, value.First),
+                WidenToFloat(builder, location, value.Second),
+                WidenToFloat(builder, location, value.Third),
+                value.Kind,
+                value.Flags);
+            context.ReplaceAndRemove(
+                value,
+                NarrowIfRequired(builder, value, newValue));
+        }
+
+        /// <summary>
+        /// Lowers brain float comparisons to single precision comparisons.
+        /// </summary>
+        private static void Lower(
+            RewriterContext context,
+            TypeLowering<PrimitiveType> typeLowering,
+            CompareValue value)
+        {
+            var builder = context.Builder;
+            var location = value.Location;
+            var newValue = builder.CreateCompare(
+                location,
+                WidenToFloat(builder, location, value.Left),
+                WidenToFloat(builder, location, value.Right),
+                value.Kind,
+                value.Flags);
+            context.ReplaceAndRemove(value, newValue);
+        }
+
+        /// <summary>
+        /// Lowers conversions from and to brain floats via single precision values.
+        /// </summary>
+        private static void Lower(
+            RewriterContext context,
+            TypeLowering<PrimitiveType> typeLowering,
+            ConvertValue value)
+        {
+            var builder = context.Builder;
+            var location = value.Location;
+            var floatType = builder.GetPrimitiveType(BasicValueType.Float32);
+
+            Value newValue;
+            if (IsBFloat16(value.Value))
+            {
+                newValue = builder.CreateConvert(
+                    location,
+                    WidenToFloat(builder, location, value.Value),
+                    value.Type,
+                    value.Flags);
+            }
+            else
+            {
+                newValue = NarrowToBFloat16(
+                    builder,
+                    location,
+                    builder.CreateConvert(
+                        location,
+                        value.Value,
+                        floatType,
+                        value.Flags));
+            }
+            context.ReplaceAndRemove(value, newValue);
+        }
+
+        /// <summary>
+        /// Lowers float to int casts of brain floats to their raw values.
+        /// </summary>
+        private static void Lower(
+            RewriterContext context,
+            TypeLowering<PrimitiveType> typeLowering,
+            FloatAsIntCast value) =>
+            context.ReplaceAndRemove(value, value.Value.Resolve());
+
+        /// <summary>
+        /// Lowers view casts into casts with converted element types.
+        /// </summary>
+        private static void Lower(
+            RewriterContext context,
+            TypeLowering<PrimitiveType> typeLowering,
+            ViewCast value)
+        {
+            var newValue = context.Builder.CreateViewCast(
+                value.Location,
+                value.Value,
+                typeLowering.ConvertType(value.TargetElementType));
+            context.ReplaceAndRemove(value, newValue);
+        }
+
+        /// <summary>
+        /// Lowers the lengths of dynamic brain float allocations into lengths of
+        /// 16-bit integer allocations.
+        /// </summary>
+        private static void Lower(
+            RewriterContext context,
+            TypeLowering<PrimitiveType> typeLowering,
+            DynamicMemoryLengthValue value)
+        {
+            var newValue = context.Builder.CreateDynamicMemoryLengthValue(
+                value.Location,
+                typeLowering.ConvertType(value.ElementType),
+                value.AddressSpace);
+            context.ReplaceAndRemove(value, newValue);
+        }
+
+        #endregion
+
+        #region Rewriter
+
+        /// <summary>
+        /// The internal rewriter.
+        /// </summary>
+        private static readonly Rewriter<TypeLowering<PrimitiveType>> Rewriter =
+            new Rewriter<TypeLowering<PrimitiveType>>();
+
+        /// <summary>
+        /// Registers the given value if its type depends on a brain float.
+        /// </summary>
+        private static bool IsTypeDependent<TValue>(
+            TypeLowering<PrimitiveType> typeLowering,
+            TValue value)
+            where TValue : Value =>
+            typeLowering.TryRegister(value, value.Type);
+
+        /// <summary>
+        /// Initializes all rewriter patterns.
+        /// </summary>
+        static LowerBFloat16()
+        {
+            AddRewriters(Rewriter);
+
+            // Brain floats map to a single integer field each, which allows us to
+            // keep all field spans and to simply rebuild structure values
+            Rewriter.Add<StructureValue>(IsTypeDependent, Lower);
+
+            Rewriter.Add<PrimitiveValue>(
+                (typeLowering, value) => IsBFloat16(value),
+                Lower);
+            Rewriter.Add<UnaryArithmeticValue>(
+                (typeLowering, value) => IsBFloat16(value.Value),
+                Lower);
+            Rewriter.Add<BinaryArithmeticValue>(
+                (typeLowering, value) => IsBFloat16(value.Left),
+                Lower);
+            Rewriter.Add<TernaryArithmeticValue>(
+                (typeLowering, value) => IsBFloat16(value.First),
+                Lower);
+            Rewriter.Add<CompareValue>(
+                (typeLowering, value) => IsBFloat16(value.Left),
+                Lower);
+            Rewriter.Add<ConvertValue>(
+                (typeLowering, value) =>
+                    IsBFloat16(value) || IsBFloat16(value.Value),
+                Lower);
+            Rewriter.Add<FloatAsIntCast>(
+                (typeLowering, value) => IsBFloat16(value.Value),
+                Lower);
+            Rewriter.Add<ViewCast>(
+                (typeLowering, value) =>
+                    typeLowering.IsTypeDependent(value.TargetElementType),
+                Lower);
+            Rewriter.Add<DynamicMemoryLengthValue>(
+                (typeLowering, value) =>
+                    typeLowering.IsTypeDependent(value.ElementType),
+                Lower);
+
+            // Invalidate all values whose types are derived from their operands
+            Rewriter.Add<LoadElementAddress>(IsTypeDependent, InvalidateType);
+            Rewriter.Add<SubViewValue>(IsTypeDependent, InvalidateType);
+            Rewriter.Add<NewView>(IsTypeDependent, InvalidateType);
+            Rewriter.Add<AlignViewTo>(IsTypeDependent, InvalidateType);
+        }
+
+        #endregion
+
+        #region Instance
+
+        /// <summary>
+        /// Constructs a new brain float lowering transformation.
+        /// </summary>
+        public LowerBFloat16() { }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Creates a new <see cref="BFloat16TypeLowering"/> type converter to convert
+        /// brain float types into 16-bit integer types.
+        /// </summary>
+        protected override TypeLowering<PrimitiveType> CreateLoweringConverter(
+            Method.Builder builder) =>
+            new BFloat16TypeLowering(builder);
+
+        /// <summary>
+        /// Applies the brain float lowering transformation.
+        /// </summary>
+        protected override bool PerformTransformation(Method.Builder builder) =>
+            PerformTransformation(builder, Rewriter);
+
+        #endregion
+    }
+}
@@ -129,12 +129,22 @@ namespace ILGPU.IR.Transformations
             var builder = context.Builder;
             var primitiveType = variable.Type as PrimitiveType;
             Value value = variable;
-            if (primitiveType.BasicValueType < BasicValueType.Int32)
+
+            // Brain floats are widened to single precision values without any
+            // precision loss
+            var basicValueType = primitiveType.BasicValueType;
+            bool requiresConversion =
+                basicValueType < BasicValueType.Int32 ||
+                basicValueType == BasicValueType.BFloat16;
+            if (requiresConversion)
             {
                 value = builder.CreateConvert(
                     sourceValue.Location,
                     value,
-                    builder.GetPrimitiveType(BasicValueType.Int32));
+                    builder.GetPrimitiveType(
+                        basicValueType == BasicValueType.BFloat16
+                        ? BasicValueType.Float32
+                        : BasicValueType.Int32));
             }
 
             TLoweringImplementation loweringImplementation = default;
@@ -142,7 +152,7 @@ namespace ILGPU.IR.Transformations
                 builder,
                 sourceValue,
                 value);
-            if (primitiveType.BasicValueType < BasicValueType.Int32)
+            if (requiresConversion)
             {
                 result = builder.CreateConvert(
                     sourceValue.Location,
@@ -175,12 +175,14 @@ namespace ILGPU.IR.Transformations
             TypeLowering<TType> typeConverter,
             Alloca alloca)
         {
-            // Compute the alloca type
+            // Compute the alloca type and preserve the array length of local and
+            // shared-memory arrays
             var newType = typeConverter.ConvertType(alloca);
             var newAlloca = context.Builder.CreateAlloca(
                 alloca.Location,
                 newType,
-                alloca.AddressSpace);
+                alloca.AddressSpace,
+                alloca.ArrayLength);
             context.ReplaceAndRemove(alloca, newAlloca);
         }
 
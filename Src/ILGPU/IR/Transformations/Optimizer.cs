@@ -107,9 +107,15 @@ namespace ILGPU.IR.Transformations
         /// Adds optimizations passes to convert control-flow ifs into fast predicates.
         /// </summary>
         /// <param name="builder">The transformation manager to populate.</param>
+        /// <remarks>
+        /// Redundant bounds checks are removed before converting ifs, since the
+        /// conditions of all guarding branches are used to prove them.
+        /// </remarks>
         public static void AddConditionalOptimizations(
             this Transformer.Builder builder)
         {
+            builder.Add(new BoundsCheckElimination());
+            builder.Add(new JumpThreading());
             builder.Add(new IfConversion());
             builder.Add(new SimplifyControlFlow());
         }
@@ -165,6 +171,10 @@ namespace ILGPU.IR.Transformations
             {
                 // Specialize all parameter address spaces
                 builder.Add(new InferKernelAddressSpaces(MemoryAddressSpace.Global));
+
+                // Clone non-inlined functions that are called with arguments from
+                // different address spaces or with constant arguments
+                builder.Add(new CallTargetSpecializer());
             }
 
             // Lower all value structures that could have been created during the
@@ -173,6 +183,10 @@ namespace ILGPU.IR.Transformations
             // AddressSpaceSpecializer
             builder.Add(new LowerStructures());
 
+            // Remove unused parameters and return values of all functions that have
+            // not been inlined and propagate constant arguments into their bodies
+            builder.Add(new DeadArgumentElimination());
+
             // Apply UCE and DCE phases in release mode to remove all dead values and
             // branches that could be have been created in prior passes
             builder.Add(new UnreachableCodeElimination());
@@ -187,6 +201,10 @@ namespace ILGPU.IR.Transformations
             else
                 builder.Add(new InferAddressSpaces());
 
+            // Thread jumps through branches that have already been decided by
+            // dominating branches (e.g. repeated bounds checks)
+            builder.Add(new JumpThreading());
+
             // Final cleanup phases to improve performance
             builder.Add(new CleanupBlocks());
             builder.Add(new SimplifyControlFlow());
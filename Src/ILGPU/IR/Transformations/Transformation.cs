@@ -47,6 +47,20 @@ namespace ILGPU.IR.Transformations
 
         #endregion
 
+        #region Properties
+
+        /// <summary>
+        /// Returns the cached analyses that are preserved by this transformation.
+        /// </summary>
+        /// <remarks>
+        /// All other cached analyses of a method are invalidated as soon as this
+        /// transformation has been applied to it.
+        /// </remarks>
+        protected internal virtual PreservedAnalyses PreservedAnalyses =>
+            PreservedAnalyses.None;
+
+        #endregion
+
         #region Methods
 
         /// <summary>
@@ -61,7 +75,7 @@ namespace ILGPU.IR.Transformations
         /// <param name="builder">The current method builder.</param>
         /// <param name="executor">The desired transform executor.</param>
         [MethodImpl(MethodImplOptions.AggressiveInlining)]
-        protected internal static bool ExecuteTransform<TExecutor>(
+        protected internal bool ExecuteTransform<TExecutor>(
             Method.Builder builder,
             in TExecutor executor)
             where TExecutor : struct, ITransformExecutor
@@ -71,6 +85,7 @@ namespace ILGPU.IR.Transformations
             {
                 builder.Method.AddTransformationFlags(
                     MethodTransformationFlags.Dirty);
+                builder.Method.InvalidateAnalyses(PreservedAnalyses);
             }
 
             return result;
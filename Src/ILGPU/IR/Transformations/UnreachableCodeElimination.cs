@@ -9,6 +9,8 @@
 // Source License. See LICENSE.txt for details
 // ---------------------------------------------------------------------------------------
 
+using ILGPU.IR.Analyses.ControlFlowDirection;
+using ILGPU.IR.Analyses.TraversalOrders;
 using ILGPU.IR.Rewriting;
 using ILGPU.IR.Values;
 using ILGPU.Util;
@@ -156,6 +158,45 @@ namespace ILGPU.IR.Transformations
 
         #endregion
 
+        #region Static
+
+        /// <summary>
+        /// Updates the control-flow structure of the given method after its branch
+        /// targets have been changed. Phi arguments of blocks that are no longer
+        /// predecessors are removed and all unreachable blocks are cleared.
+        /// </summary>
+        /// <param name="builder">The parent method builder.</param>
+        /// <param name="blocks">
+        /// The collection of all blocks before changing the branch targets.
+        /// </param>
+        internal static void RemoveUnreachableBlocks(
+            Method.Builder builder,
+            in BasicBlockCollection<ReversePostOrder, Forwards> blocks)
+        {
+            // Update the internal control-flow structure and compute the set of all
+            // remaining reachable basic blocks
+            var updatedBlocks = builder.UpdateControlFlow().ToSet();
+
+            // Update all phi values
+            Rewriter.Rewrite(
+                blocks,
+                builder,
+                new PhiArgumentRemapper(updatedBlocks));
+
+            // Find all unreachable blocks and remove them
+            foreach (var block in blocks)
+            {
+                if (!updatedBlocks.Contains(block))
+                {
+                    // Block is unreachable -> remove all operations
+                    var blockBuilder = builder[block];
+                    blockBuilder.Clear();
+                }
+            }
+        }
+
+        #endregion
+
         #region Instance
 
         /// <summary>
@@ -192,27 +233,7 @@ namespace ILGPU.IR.Transformations
             if (!updated)
                 return false;
 
-            // Update the internal control-flow structure and compute the set of all
-            // remaining reachable basic blocks
-            var updatedBlocks = builder.UpdateControlFlow().ToSet();
-
-            // Update all phi values
-            Rewriter.Rewrite(
-                blocks,
-                builder,
-                new PhiArgumentRemapper(updatedBlocks));
-
-            // Find all unreachable blocks and remove them
-            foreach (var block in blocks)
-            {
-                if (!updatedBlocks.Contains(block))
-                {
-                    // Block is unreachable -> remove all operations
-                    var blockBuilder = builder[block];
-                    blockBuilder.Clear();
-                }
-            }
-
+            RemoveUnreachableBlocks(builder, blocks);
             return true;
         }
 
@@ -0,0 +1,504 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: IRTypeSerializer.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.Resources;
+using System;
+using System.Collections.Generic;
+using System.Collections.Immutable;
+using System.Globalization;
+using System.IO;
+using System.Text;
+
+namespace ILGPU.IR.Types
+{
+    /// <summary>
+    /// Serializes and deserializes IR types using a compact and versioned binary
+    /// format.
+    /// </summary>
+    /// <remarks>
+    /// All types are stored in a single type table in which every type only refers
+    /// to types that have been stored before. This allows a single-pass
+    /// reconstruction of all types using an arbitrary <see cref="IRTypeContext"/>.
+    /// </remarks>
+    public static class IRTypeSerializer
+    {
+        #region Nested Types
+
+        /// <summary>
+        /// Identifies the kind of a serialized type.
+        /// </summary>
+        private enum SerializedTypeKind : byte
+        {
+            Void,
+            String,
+            Handle,
+            Primitive,
+            Padding,
+            Pointer,
+            View,
+            Array,
+            Structure,
+        }
+
+        /// <summary>
+        /// Builds the type table that contains all types and their dependencies.
+        /// </summary>
+        internal sealed class TypeTable
+        {
+            private readonly Dictionary<TypeNode, int> indices =
+                new Dictionary<TypeNode, int>();
+
+            /// <summary>
+            /// Returns all registered types in dependency order.
+            /// </summary>
+            public List<TypeNode> Types { get; } = new List<TypeNode>();
+
+            /// <summary>
+            /// Registers the given type and all of its dependencies.
+            /// </summary>
+            /// <param name="type">The type to register.</param>
+            /// <returns>The index of the type in the type table.</returns>
+            public int Register(TypeNode type)
+            {
+                if (indices.TryGetValue(type, out int index))
+                    return index;
+
+                switch (type)
+                {
+                    case AddressSpaceType addressSpaceType:
+                        Register(addressSpaceType.ElementType);
+                        break;
+                    case ArrayType arrayType:
+                        Register(arrayType.ElementType);
+                        break;
+                    case StructureType structureType:
+                        foreach (var fieldType in structureType.DirectFields)
+                            Register(fieldType);
+                        break;
+                }
+
+                index = Types.Count;
+                Types.Add(type);
+                indices.Add(type, index);
+                return index;
+            }
+
+            /// <summary>
+            /// Returns the index of an already registered type.
+            /// </summary>
+            /// <param name="type">The registered type.</param>
+            /// <returns>The index of the type in the type table.</returns>
+            public int this[TypeNode type] => indices[type];
+        }
+
+        #endregion
+
+        #region Constants
+
+        /// <summary>
+        /// The current version of the binary type format.
+        /// </summary>
+        public const int FormatVersion = 1;
+
+        /// <summary>
+        /// The magic header value ('ILTY').
+        /// </summary>
+        private const int Magic = 0x59544C49;
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Serializes the given types and all of their dependencies into the given
+        /// stream.
+        /// </summary>
+        /// <param name="stream">The target stream.</param>
+        /// <param name="types">The types to serialize.</param>
+        public static void Serialize(Stream stream, IReadOnlyList<TypeNode> types)
+        {
+            if (stream is null)
+                throw new ArgumentNullException(nameof(stream));
+            if (types is null)
+                throw new ArgumentNullException(nameof(types));
+
+            var table = new TypeTable();
+            foreach (var type in types)
+                table.Register(type ?? throw new ArgumentNullException(nameof(types)));
+
+            using var writer = new BinaryWriter(stream, Encoding.UTF8, true);
+            WriteHeader(writer, Magic, FormatVersion);
+            WriteTypeTable(writer, table);
+
+            // Write all root type references
+            writer.Write(types.Count);
+            foreach (var type in types)
+                writer.Write(table[type]);
+        }
+
+        /// <summary>
+        /// Deserializes all root types from the given stream.
+        /// </summary>
+        /// <param name="stream">The source stream.</param>
+        /// <param name="typeContext">The type context to create the types in.</param>
+        /// <returns>All deserialized root types.</returns>
+        public static ImmutableArray<TypeNode> Deserialize(
+            Stream stream,
+            IRTypeContext typeContext)
+        {
+            if (stream is null)
+                throw new ArgumentNullException(nameof(stream));
+            if (typeContext is null)
+                throw new ArgumentNullException(nameof(typeContext));
+
+            using var reader = new BinaryReader(stream, Encoding.UTF8, true);
+            try
+            {
+                ReadHeader(reader, Magic, FormatVersion);
+                var types = ReadTypeTable(reader, typeContext);
+
+                // Read all root type references
+                int numRoots = ReadCount(reader);
+                var result = ImmutableArray.CreateBuilder<TypeNode>(numRoots);
+                for (int i = 0; i < numRoots; ++i)
+                    result.Add(ReadTypeReference(reader, types));
+                return result.MoveToImmutable();
+            }
+            catch (EndOfStreamException e)
+            {
+                throw GetInvalidDataException(e);
+            }
+        }
+
+        #endregion
+
+        #region Type Table
+
+        /// <summary>
+        /// Writes all types of the given type table.
+        /// </summary>
+        /// <param name="writer">The target writer.</param>
+        /// <param name="table">The type table to write.</param>
+        internal static void WriteTypeTable(BinaryWriter writer, TypeTable table)
+        {
+            writer.Write(table.Types.Count);
+            foreach (var type in table.Types)
+                WriteType(writer, table, type);
+        }
+
+        /// <summary>
+        /// Writes a single type entry.
+        /// </summary>
+        /// <param name="writer">The target writer.</param>
+        /// <param name="table">The type table.</param>
+        /// <param name="type">The type to write.</param>
+        private static void WriteType(
+            BinaryWriter writer,
+            TypeTable table,
+            TypeNode type)
+        {
+            switch (type)
+            {
+                case VoidType _:
+                    writer.Write((byte)SerializedTypeKind.Void);
+                    break;
+                case StringType _:
+                    writer.Write((byte)SerializedTypeKind.String);
+                    break;
+                case HandleType _:
+                    writer.Write((byte)SerializedTypeKind.Handle);
+                    break;
+                case PrimitiveType primitiveType:
+                    writer.Write((byte)SerializedTypeKind.Primitive);
+                    WriteEnum(writer, primitiveType.BasicValueType);
+                    break;
+                case PaddingType paddingType:
+                    writer.Write((byte)SerializedTypeKind.Padding);
+                    WriteEnum(writer, paddingType.BasicValueType);
+                    break;
+                case PointerType pointerType:
+                    writer.Write((byte)SerializedTypeKind.Pointer);
+                    writer.Write(table[pointerType.ElementType]);
+                    WriteEnum(writer, pointerType.AddressSpace);
+                    break;
+                case ViewType viewType:
+                    writer.Write((byte)SerializedTypeKind.View);
+                    writer.Write(table[viewType.ElementType]);
+                    WriteEnum(writer, viewType.AddressSpace);
+                    break;
+                case ArrayType arrayType:
+                    writer.Write((byte)SerializedTypeKind.Array);
+                    writer.Write(table[arrayType.ElementType]);
+                    writer.Write(arrayType.NumDimensions);
+                    break;
+                case StructureType structureType:
+                    writer.Write((byte)SerializedTypeKind.Structure);
+                    writer.Write(structureType.Size);
+                    writer.Write(structureType.DirectFields.Length);
+                    foreach (var fieldType in structureType.DirectFields)
+                        writer.Write(table[fieldType]);
+                    break;
+                default:
+                    throw new NotSupportedException(string.Format(
+                        ErrorMessages.NotSupportedTypeSerialization,
+                        type));
+            }
+        }
+
+        /// <summary>
+        /// Reads a type table that has been written by
+        /// <see cref="WriteTypeTable(BinaryWriter, TypeTable)"/>.
+        /// </summary>
+        /// <param name="reader">The source reader.</param>
+        /// <param name="typeContext">The type context to create the types in.</param>
+        /// <returns>All deserialized types in table order.</returns>
+        internal static TypeNode[] ReadTypeTable(
+            BinaryReader reader,
+            IRTypeContext typeContext)
+        {
+            int numTypes = ReadCount(reader);
+            var types = new TypeNode[numTypes];
+            for (int i = 0; i < numTypes; ++i)
+                types[i] = ReadType(reader, typeContext, types, i);
+            return types;
+        }
+
+        /// <summary>
+        /// Reads a single type entry.
+        /// </summary>
+        /// <param name="reader">The source reader.</param>
+        /// <param name="typeContext">The type context to create the type in.</param>
+        /// <param name="types">All types that have been read so far.</param>
+        /// <param name="numTypes">The number of types that have been read.</param>
+        /// <returns>The deserialized type.</returns>
+        private static TypeNode ReadType(
+            BinaryReader reader,
+            IRTypeContext typeContext,
+            TypeNode[] types,
+            int numTypes)
+        {
+            var kind = (SerializedTypeKind)reader.ReadByte();
+            switch (kind)
+            {
+                case SerializedTypeKind.Void:
+                    return typeContext.VoidType;
+                case SerializedTypeKind.String:
+                    return typeContext.StringType;
+                case SerializedTypeKind.Handle:
+                    return typeContext.HandleType;
+                case SerializedTypeKind.Primitive:
+                    return typeContext.GetPrimitiveType(
+                        ReadBasicValueType(reader));
+                case SerializedTypeKind.Padding:
+                    return typeContext.GetPaddingType(
+                        ReadBasicValueType(reader));
+                case SerializedTypeKind.Pointer:
+                    return typeContext.CreatePointerType(
+                        ReadTypeReference(reader, types, numTypes),
+                        ReadEnum<MemoryAddressSpace>(reader));
+                case SerializedTypeKind.View:
+                    return typeContext.CreateViewType(
+                        ReadTypeReference(reader, types, numTypes),
+                        ReadEnum<MemoryAddressSpace>(reader));
+                case SerializedTypeKind.Array:
+                    var elementType = ReadTypeReference(reader, types, numTypes);
+                    int numDimensions = reader.ReadInt32();
+                    if (numDimensions < 1)
+                        throw GetInvalidDataException();
+                    return typeContext.CreateArrayType(elementType, numDimensions);
+                case SerializedTypeKind.Structure:
+                    int size = reader.ReadInt32();
+                    int numFields = reader.ReadInt32();
+                    if (size < 0 || numFields < 0)
+                        throw GetInvalidDataException();
+                    var builder = new StructureType.Builder(
+                        typeContext,
+                        numFields,
+                        size);
+                    for (int i = 0; i < numFields; ++i)
+                        builder.Add(ReadTypeReference(reader, types, numTypes));
+                    return builder.Seal();
+                default:
+                    throw GetInvalidDataException();
+            }
+        }
+
+        /// <summary>
+        /// Reads a basic value type of a primitive or a padding type.
+        /// </summary>
+        /// <param name="reader">The source reader.</param>
+        /// <returns>The basic value type.</returns>
+        private static BasicValueType ReadBasicValueType(BinaryReader reader)
+        {
+            var basicValueType = ReadEnum<BasicValueType>(reader);
+            return basicValueType != BasicValueType.None
+                ? basicValueType
+                : throw GetInvalidDataException();
+        }
+
+        /// <summary>
+        /// Reads a reference to a previously deserialized type.
+        /// </summary>
+        /// <param name="reader">The source reader.</param>
+        /// <param name="types">All types of the type table.</param>
+        /// <returns>The referenced type.</returns>
+        internal static TypeNode ReadTypeReference(
+            BinaryReader reader,
+            TypeNode[] types) =>
+            ReadTypeReference(reader, types, types.Length);
+
+        /// <summary>
+        /// Reads a reference to a previously deserialized type.
+        /// </summary>
+        /// <param name="reader">The source reader.</param>
+        /// <param name="types">All types that have been read so far.</param>
+        /// <param name="numTypes">The number of types that have been read.</param>
+        /// <returns>The referenced type.</returns>
+        private static TypeNode ReadTypeReference(
+            BinaryReader reader,
+            TypeNode[] types,
+            int numTypes)
+        {
+            int index = reader.ReadInt32();
+            return index >= 0 && index < numTypes
+                ? types[index]
+                : throw GetInvalidDataException();
+        }
+
+        #endregion
+
+        #region Format Helpers
+
+        /// <summary>
+        /// Writes a serialization header.
+        /// </summary>
+        /// <param name="writer">The target writer.</param>
+        /// <param name="magic">The magic value of the format.</param>
+        /// <param name="version">The format version.</param>
+        internal static void WriteHeader(BinaryWriter writer, int magic, int version)
+        {
+            writer.Write(magic);
+            writer.Write(version);
+        }
+
+        /// <summary>
+        /// Reads and verifies a serialization header.
+        /// </summary>
+        /// <param name="reader">The source reader.</param>
+        /// <param name="magic">The expected magic value.</param>
+        /// <param name="version">The expected format version.</param>
+        internal static void ReadHeader(BinaryReader reader, int magic, int version)
+        {
+            int serializedMagic;
+            try
+            {
+                serializedMagic = reader.ReadInt32();
+            }
+            catch (EndOfStreamException e)
+            {
+                throw new InvalidDataException(
+                    ErrorMessages.InvalidSerializedIRHeader,
+                    e);
+            }
+            if (serializedMagic != magic)
+                throw new InvalidDataException(ErrorMessages.InvalidSerializedIRHeader);
+
+            int serializedVersion = reader.ReadInt32();
+            if (serializedVersion != version)
+            {
+                throw new InvalidDataException(string.Format(
+                    ErrorMessages.UnsupportedSerializedIRVersion,
+                    serializedVersion));
+            }
+        }
+
+        /// <summary>
+        /// Writes an enumeration value.
+        /// </summary>
+        /// <typeparam name="T">The enumeration type.</typeparam>
+        /// <param name="writer">The target writer.</param>
+        /// <param name="value">The value to write.</param>
+        internal static void WriteEnum<T>(BinaryWriter writer, T value)
+            where T : struct, Enum =>
+            writer.Write(Convert.ToInt32(value, CultureInfo.InvariantCulture));
+
+        /// <summary>
+        /// Reads an enumeration value and verifies that it is a valid value of the
+        /// given enumeration type.
+        /// </summary>
+        /// <typeparam name="T">The enumeration type.</typeparam>
+        /// <param name="reader">The source reader.</param>
+        /// <returns>The validated enumeration value.</returns>
+        /// <remarks>
+        /// Values of flag enumerations may combine all declared flags.
+        /// </remarks>
+        internal static T ReadEnum<T>(BinaryReader reader)
+            where T : struct, Enum
+        {
+            int rawValue = reader.ReadInt32();
+            var enumValue = (T)Enum.ToObject(typeof(T), rawValue);
+            if (typeof(T).IsDefined(typeof(FlagsAttribute), false))
+            {
+                int mask = 0;
+                foreach (var flag in Enum.GetValues(typeof(T)))
+                    mask |= Convert.ToInt32(flag, CultureInfo.InvariantCulture);
+                if ((rawValue & ~mask) != 0)
+                    throw GetInvalidDataException();
+            }
+            else if (!Enum.IsDefined(typeof(T), enumValue))
+            {
+                throw GetInvalidDataException();
+            }
+            return enumValue;
+        }
+
+        /// <summary>
+        /// Reads a non-negative element count.
+        /// </summary>
+        /// <param name="reader">The source reader.</param>
+        /// <returns>The element count.</returns>
+        /// <remarks>
+        /// Every serialized element occupies at least one byte. Hence, counts that
+        /// exceed the remaining stream length are rejected before any allocation.
+        /// </remarks>
+        internal static int ReadCount(BinaryReader reader)
+        {
+            int count = reader.ReadInt32();
+            var stream = reader.BaseStream;
+            if (count < 0 ||
+                stream.CanSeek && count > stream.Length - stream.Position)
+            {
+                throw GetInvalidDataException();
+            }
+            return count;
+        }
+
+        /// <summary>
+        /// Creates a new exception that indicates invalid serialized data.
+        /// </summary>
+        /// <returns>The created exception.</returns>
+        internal static InvalidDataException GetInvalidDataException() =>
+            new InvalidDataException(ErrorMessages.InvalidSerializedIRData);
+
+        /// <summary>
+        /// Creates a new exception that indicates invalid serialized data.
+        /// </summary>
+        /// <param name="innerException">The inner exception.</param>
+        /// <returns>The created exception.</returns>
+        internal static InvalidDataException GetInvalidDataException(
+            Exception innerException) =>
+            new InvalidDataException(
+                ErrorMessages.InvalidSerializedIRData,
+                innerException);
+
+        #endregion
+    }
+}
@@ -35,7 +35,8 @@ namespace ILGPU.IR.Types
                 8,
                 2,
                 4,
-                8);
+                8,
+                2);
 
         /// <summary>
         /// Maps integer-based type size values to <see cref="BasicValueType"/> entries.
@@ -78,6 +79,8 @@ namespace ILGPU.IR.Types
             BasicValueType = basicValueType;
 
             Size = Alignment = BasicTypeInformation[(int)basicValueType];
+            if (basicValueType == BasicValueType.BFloat16)
+                AddFlags(TypeFlags.BFloat16Dependent);
         }
 
         #endregion
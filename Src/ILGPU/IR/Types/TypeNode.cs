@@ -47,6 +47,11 @@ namespace ILGPU.IR.Types
         /// </summary>
         ArrayDependent = 1 << 3,
 
+        /// <summary>
+        /// The type is either a brain float or contains a brain float.
+        /// </summary>
+        BFloat16Dependent = 1 << 4,
+
         /// <summary>
         /// The type depends on an address space.
         /// </summary>
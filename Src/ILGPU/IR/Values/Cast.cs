@@ -669,7 +669,8 @@ namespace ILGPU.IR.Values
             initializer.Assert(
                 basicValueType == BasicValueType.Float16 ||
                 basicValueType == BasicValueType.Float32 ||
-                basicValueType == BasicValueType.Float64);
+                basicValueType == BasicValueType.Float64 ||
+                basicValueType == BasicValueType.BFloat16);
             initializer.Assert(
                 targetType.BasicValueType == BasicValueType.Int16 ||
                 targetType.BasicValueType == BasicValueType.Int32 ||
@@ -202,6 +202,11 @@ namespace ILGPU.IR.Values
         /// </summary>
         public double Float64Value => Unsafe.As<long, double>(ref rawValue);
 
+        /// <summary>
+        /// Returns the value as bf16.
+        /// </summary>
+        public BFloat16 BFloat16Value => Unsafe.As<long, BFloat16>(ref rawValue);
+
         /// <summary>
         /// Returns true if the value is a bool.
         /// </summary>
@@ -256,6 +261,7 @@ namespace ILGPU.IR.Values
                 BasicValueType.Float16 => Float16Value == f32Value,
                 BasicValueType.Float32 => Float32Value == f32Value,
                 BasicValueType.Float64 => Float64Value == f64Value,
+                BasicValueType.BFloat16 => BFloat16Value == f32Value,
                 _ => false
             };
 
@@ -308,6 +314,7 @@ namespace ILGPU.IR.Values
                 BasicValueType.Float16 => Float16Value.ToString(),
                 BasicValueType.Float32 => Float32Value.ToString(),
                 BasicValueType.Float64 => Float64Value.ToString(),
+                BasicValueType.BFloat16 => BFloat16Value.ToString(),
                 _ => $"Raw({rawValue})",
             };
             return $"{result} [{BasicValueType}]";
@@ -194,6 +194,7 @@ namespace ILGPU.IR.Values
                     return builder.CreateConvertToInt32(location, value);
                 case BasicValueType.Float16:
                 case BasicValueType.Float32:
+                case BasicValueType.BFloat16:
                     return builder.CreateConvert(
                         location,
                         value,
@@ -453,6 +453,21 @@ namespace ILGPU.IR.Values
         /// Represents an inverted if branch.
         /// </summary>
         IsInverted = 1 << 0,
+
+        /// <summary>
+        /// The true target is known to be taken in most cases.
+        /// </summary>
+        LikelyTrue = 1 << 1,
+
+        /// <summary>
+        /// The false target is known to be taken in most cases.
+        /// </summary>
+        LikelyFalse = 1 << 2,
+
+        /// <summary>
+        /// A mask of all likelihood flags.
+        /// </summary>
+        LikelyMask = LikelyTrue | LikelyFalse,
     }
 
     /// <summary>
@@ -527,6 +542,17 @@ namespace ILGPU.IR.Values
             ? (FalseTarget, TrueTarget)
             : (TrueTarget, FalseTarget);
 
+        /// <summary>
+        /// Returns the target that is known to be taken in most cases (if any).
+        /// </summary>
+        public BasicBlock LikelyTarget =>
+            (Flags & IfBranchFlags.LikelyMask) switch
+            {
+                IfBranchFlags.LikelyTrue => TrueTarget,
+                IfBranchFlags.LikelyFalse => FalseTarget,
+                _ => null,
+            };
+
         #endregion
 
         #region Methods
@@ -539,6 +565,11 @@ namespace ILGPU.IR.Values
         public Branch Invert(IRBuilder builder)
         {
             this.Assert(builder.BasicBlock == BasicBlock);
+
+            // Swap the likelihood flags since both targets are swapped
+            var flags = Flags ^ IfBranchFlags.IsInverted;
+            if ((flags & IfBranchFlags.LikelyMask) != IfBranchFlags.None)
+                flags ^= IfBranchFlags.LikelyMask;
             return builder.CreateIfBranch(
                 Location,
                 builder.CreateArithmetic(
@@ -547,7 +578,7 @@ namespace ILGPU.IR.Values
                     UnaryArithmeticKind.Not),
                 FalseTarget,
                 TrueTarget,
-                Flags ^ IfBranchFlags.IsInverted);
+                flags);
         }
 
         /// <summary cref="ConditionalBranch.FoldBranch(IRBuilder, PrimitiveValue)"/>
@@ -602,6 +633,8 @@ namespace ILGPU.IR.Values
                 FalseTarget.ToReferenceString();
             if (IsInverted)
                 result += " [Inverted]";
+            if (LikelyTarget != null)
+                result += $" [Likely: {LikelyTarget.ToReferenceString()}]";
             return result;
         }
 
@@ -254,7 +254,13 @@ namespace ILGPU.IR.Values
         /// Returns true if this communication operation works on intrinsic primitive
         /// types.
         /// </summary>
-        public bool IsBuiltIn => BasicValueType >= BasicValueType.Int32;
+        /// <remarks>
+        /// Brain floats are not considered to be intrinsic primitive types, since they
+        /// are exchanged as single precision values.
+        /// </remarks>
+        public bool IsBuiltIn =>
+            BasicValueType >= BasicValueType.Int32 &&
+            BasicValueType != BasicValueType.BFloat16;
 
         #endregion
 
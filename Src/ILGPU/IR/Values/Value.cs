@@ -236,6 +236,23 @@ namespace ILGPU.IR
     /// </summary>
     public abstract class Value : Node, IValue, IEquatable<Value>
     {
+        #region Nested Types
+
+        /// <summary>
+        /// A predicate that accepts all uses that refer to non-replaced values.
+        /// </summary>
+        private readonly struct NonReplacedUsePredicate : InlineList.IPredicate<Use>
+        {
+            /// <summary>
+            /// Returns true if the target of the given use has not been replaced.
+            /// </summary>
+            /// <param name="item">The use to check.</param>
+            /// <returns>True, if the target has not been replaced.</returns>
+            public readonly bool Apply(Use item) => !item.Target.IsReplaced;
+        }
+
+        #endregion
+
         #region Constants
 
         /// <summary>
@@ -461,20 +478,12 @@ namespace ILGPU.IR
         /// </summary>
         internal void GC()
         {
-            // Refresh all value references
-            var newNodes = ValueList.Create(values.Count);
-            foreach (var node in Nodes)
-                newNodes.Add(node.Refresh());
-            newNodes.MoveTo(ref values);
-
-            // Cleanup all uses
-            var newUses = UseList.Create(uses.Count);
-            foreach (var use in uses)
-            {
-                if (!use.Target.IsReplaced)
-                    newUses.Add(use);
-            }
-            newUses.MoveTo(ref uses);
+            // Refresh all value references in place
+            for (int i = 0, e = values.Count; i < e; ++i)
+                values[i] = values[i].Refresh();
+
+            // Cleanup all uses in place
+            uses.RemoveAllExcept(new NonReplacedUsePredicate());
         }
 
         /// <summary>
@@ -190,6 +190,17 @@ namespace ILGPU
         public static ulong FloatAsInt(double value) =>
             Unsafe.As<double, ulong>(ref value);
 
+        /// <summary>
+        /// Casts the given brain float to an int via a reinterpret cast.
+        /// </summary>
+        /// <param name="value">The value to cast.</param>
+        /// <returns>The int value.</returns>
+        [CLSCompliant(false)]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        [InteropIntrinsic(InteropIntrinsicKind.FloatAsInt)]
+        public static ushort FloatAsInt(BFloat16 value) =>
+            value.RawValue;
+
         /// <summary>
         /// Casts the given int to a float via a reinterpret cast.
         /// </summary>
@@ -0,0 +1,93 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: IntrinsicMath.DotProducts.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.IR.Intrinsics;
+using System;
+using System.Runtime.CompilerServices;
+
+namespace ILGPU
+{
+    partial class IntrinsicMath
+    {
+        /// <summary>
+        /// Computes the dot product of four packed signed 8-bit integers and adds
+        /// the result to the given accumulator.
+        /// </summary>
+        /// <param name="first">The first four packed 8-bit integers.</param>
+        /// <param name="second">The second four packed 8-bit integers.</param>
+        /// <param name="accumulator">The 32-bit accumulator.</param>
+        /// <returns>The accumulated dot product.</returns>
+        /// <remarks>
+        /// Maps to a single dp4a instruction on Cuda accelerators with sm_61 or
+        /// higher and to a scalar emulation on all other accelerators.
+        /// </remarks>
+        [IntrinsicImplementation]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static int Dot4(int first, int second, int accumulator) =>
+            Dot4S32Lanes(first, second, accumulator);
+
+        /// <summary>
+        /// Computes the dot product of four packed signed 8-bit integers using
+        /// scalar operations.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        internal static int Dot4S32Lanes(int first, int second, int accumulator) =>
+            accumulator +
+                (sbyte)first * (sbyte)second +
+                (sbyte)(first >> 8) * (sbyte)(second >> 8) +
+                (sbyte)(first >> 16) * (sbyte)(second >> 16) +
+                (first >> 24) * (second >> 24);
+
+        /// <summary>
+        /// Computes the dot product of four packed unsigned 8-bit integers and adds
+        /// the result to the given accumulator.
+        /// </summary>
+        /// <param name="first">The first four packed 8-bit integers.</param>
+        /// <param name="second">The second four packed 8-bit integers.</param>
+        /// <param name="accumulator">The 32-bit accumulator.</param>
+        /// <returns>The accumulated dot product.</returns>
+        /// <remarks>
+        /// Maps to a single dp4a instruction on Cuda accelerators with sm_61 or
+        /// higher and to a scalar emulation on all other accelerators.
+        /// </remarks>
+        [CLSCompliant(false)]
+        [IntrinsicImplementation]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static uint Dot4(uint first, uint second, uint accumulator) =>
+            Dot4U32Lanes(first, second, accumulator);
+
+        /// <summary>
+        /// Computes the dot product of four packed unsigned 8-bit integers using
+        /// scalar operations.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        internal static uint Dot4U32Lanes(uint first, uint second, uint accumulator) =>
+            accumulator +
+                (first & 0xFFU) * (second & 0xFFU) +
+                ((first >> 8) & 0xFFU) * ((second >> 8) & 0xFFU) +
+                ((first >> 16) & 0xFFU) * ((second >> 16) & 0xFFU) +
+                (first >> 24) * (second >> 24);
+
+        /// <summary>
+        /// Packs four signed 8-bit integers into a single 32-bit integer that can be
+        /// passed to <see cref="Dot4(int, int, int)"/>.
+        /// </summary>
+        /// <param name="x">The lowest byte.</param>
+        /// <param name="y">The second byte.</param>
+        /// <param name="z">The third byte.</param>
+        /// <param name="w">The highest byte.</param>
+        /// <returns>The packed integer.</returns>
+        [CLSCompliant(false)]
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static int Pack4(sbyte x, sbyte y, sbyte z, sbyte w) =>
+            (byte)x | (byte)y << 8 | (byte)z << 16 | w << 24;
+    }
+}
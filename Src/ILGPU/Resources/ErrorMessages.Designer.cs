@@ -150,6 +150,15 @@ namespace ILGPU.Resources {
             }
         }
         
+        /// <summary>
+        ///   Looks up a localized string similar to Could not resolve the serialized member &apos;{0}&apos;.
+        /// </summary>
+        internal static string CouldNotResolveSerializedMember {
+            get {
+                return ResourceManager.GetString("CouldNotResolveSerializedMember", resourceCulture);
+            }
+        }
+        
         /// <summary>
         ///   Looks up a localized string similar to Method &apos;{0}&apos; has custom exception semantics..
         /// </summary>
@@ -249,6 +258,24 @@ namespace ILGPU.Resources {
             }
         }
         
+        /// <summary>
+        ///   Looks up a localized string similar to The serialized IR data is invalid or corrupted.
+        /// </summary>
+        internal static string InvalidSerializedIRData {
+            get {
+                return ResourceManager.GetString("InvalidSerializedIRData", resourceCulture);
+            }
+        }
+        
+        /// <summary>
+        ///   Looks up a localized string similar to The stream does not contain serialized IR data.
+        /// </summary>
+        internal static string InvalidSerializedIRHeader {
+            get {
+                return ResourceManager.GetString("InvalidSerializedIRHeader", resourceCulture);
+            }
+        }
+        
         /// <summary>
         ///   Looks up a localized string similar to -.
         /// </summary>
@@ -456,6 +483,15 @@ namespace ILGPU.Resources {
             }
         }
         
+        /// <summary>
+        ///   Looks up a localized string similar to Not supported value &apos;{0}&apos; in IL code generation.
+        /// </summary>
+        internal static string NotSupportedILValue {
+            get {
+                return ResourceManager.GetString("NotSupportedILValue", resourceCulture);
+            }
+        }
+        
         /// <summary>
         ///   Looks up a localized string similar to Not supported indirect call to a method with the signature &apos;{0}&apos;.
         /// </summary>
@@ -564,6 +600,24 @@ namespace ILGPU.Resources {
             }
         }
         
+        /// <summary>
+        ///   Looks up a localized string similar to The kernel &apos;{0}&apos; cannot be generated from its IR.
+        /// </summary>
+        internal static string NotSupportedIRKernel {
+            get {
+                return ResourceManager.GetString("NotSupportedIRKernel", resourceCulture);
+            }
+        }
+        
+        /// <summary>
+        ///   Looks up a localized string similar to &apos;{0}&apos; cannot be serialized.
+        /// </summary>
+        internal static string NotSupportedIRSerialization {
+            get {
+                return ResourceManager.GetString("NotSupportedIRSerialization", resourceCulture);
+            }
+        }
+        
         /// <summary>
         ///   Looks up a localized string similar to IsInstance is currently not supported.
         /// </summary>
@@ -726,6 +780,15 @@ namespace ILGPU.Resources {
             }
         }
         
+        /// <summary>
+        ///   Looks up a localized string similar to Type &apos;{0}&apos; cannot be serialized.
+        /// </summary>
+        internal static string NotSupportedTypeSerialization {
+            get {
+                return ResourceManager.GetString("NotSupportedTypeSerialization", resourceCulture);
+            }
+        }
+        
         /// <summary>
         ///   Looks up a localized string similar to The view intrinsic &apos;{0}&apos; is not supported.
         /// </summary>
@@ -833,5 +896,14 @@ namespace ILGPU.Resources {
                 return ResourceManager.GetString("NoUses", resourceCulture);
             }
         }
+        
+        /// <summary>
+        ///   Looks up a localized string similar to The serialized IR data uses the unsupported format version &apos;{0}&apos;.
+        /// </summary>
+        internal static string UnsupportedSerializedIRVersion {
+            get {
+                return ResourceManager.GetString("UnsupportedSerializedIRVersion", resourceCulture);
+            }
+        }
     }
 }
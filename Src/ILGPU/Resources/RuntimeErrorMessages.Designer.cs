@@ -195,6 +195,24 @@ namespace ILGPU.Resources {
             }
         }
         
+        /// <summary>
+        ///   Looks up a localized string similar to The serialized kernel profile is invalid or corrupted.
+        /// </summary>
+        internal static string InvalidKernelProfileData {
+            get {
+                return ResourceManager.GetString("InvalidKernelProfileData", resourceCulture);
+            }
+        }
+        
+        /// <summary>
+        ///   Looks up a localized string similar to The stream does not contain a serialized kernel profile.
+        /// </summary>
+        internal static string InvalidKernelProfileHeader {
+            get {
+                return ResourceManager.GetString("InvalidKernelProfileHeader", resourceCulture);
+            }
+        }
+        
         /// <summary>
         ///   Looks up a localized string similar to The given kernel specialization is not compatible with the defined group size..
         /// </summary>
@@ -222,6 +240,24 @@ namespace ILGPU.Resources {
             }
         }
         
+        /// <summary>
+        ///   Looks up a localized string similar to The remote peer sent a malformed &apos;{0}&apos; message.
+        /// </summary>
+        internal static string InvalidRemoteMessage {
+            get {
+                return ResourceManager.GetString("InvalidRemoteMessage", resourceCulture);
+            }
+        }
+        
+        /// <summary>
+        ///   Looks up a localized string similar to The remote peer uses an incompatible protocol (version &apos;{0}&apos;).
+        /// </summary>
+        internal static string InvalidRemoteProtocol {
+            get {
+                return ResourceManager.GetString("InvalidRemoteProtocol", resourceCulture);
+            }
+        }
+        
         /// <summary>
         ///   Looks up a localized string similar to Shared-memory size cannot be &lt; 0.
         /// </summary>
@@ -285,6 +321,15 @@ namespace ILGPU.Resources {
             }
         }
         
+        /// <summary>
+        ///   Looks up a localized string similar to Kernel method &apos;{0}&apos; cannot be instrumented for profiling.
+        /// </summary>
+        internal static string NotSupportedKernelInstrumentation {
+            get {
+                return ResourceManager.GetString("NotSupportedKernelInstrumentation", resourceCulture);
+            }
+        }
+        
         /// <summary>
         ///   Looks up a localized string similar to The given kernel specialization is not compatible with the current accelerator..
         /// </summary>
@@ -357,6 +402,33 @@ namespace ILGPU.Resources {
             }
         }
         
+        /// <summary>
+        ///   Looks up a localized string similar to Accelerator extensions are not supported by remote accelerators.
+        /// </summary>
+        internal static string NotSupportedRemoteAcceleratorExtension {
+            get {
+                return ResourceManager.GetString("NotSupportedRemoteAcceleratorExtension", resourceCulture);
+            }
+        }
+        
+        /// <summary>
+        ///   Looks up a localized string similar to Kernel method &apos;{0}&apos; cannot be executed remotely. Only non-generic static methods of assemblies registered with the remote worker can be loaded.
+        /// </summary>
+        internal static string NotSupportedRemoteKernel {
+            get {
+                return ResourceManager.GetString("NotSupportedRemoteKernel", resourceCulture);
+            }
+        }
+        
+        /// <summary>
+        ///   Looks up a localized string similar to Not supported remote kernel argument &apos;{0}&apos;. Only views of remote memory buffers and unmanaged values can be passed to remote kernels.
+        /// </summary>
+        internal static string NotSupportedRemoteKernelArgument {
+            get {
+                return ResourceManager.GetString("NotSupportedRemoteKernelArgument", resourceCulture);
+            }
+        }
+        
         /// <summary>
         ///   Looks up a localized string similar to Not supported target accelerator.
         /// </summary>
@@ -384,6 +456,51 @@ namespace ILGPU.Resources {
             }
         }
         
+        /// <summary>
+        ///   Looks up a localized string similar to The remote device &apos;{0}&apos; has already been used to create an accelerator.
+        /// </summary>
+        internal static string RemoteDeviceInUse {
+            get {
+                return ResourceManager.GetString("RemoteDeviceInUse", resourceCulture);
+            }
+        }
+        
+        /// <summary>
+        ///   Looks up a localized string similar to The serialized kernel &apos;{0}&apos; exceeds the maximum size of {1} bytes.
+        /// </summary>
+        internal static string RemoteKernelTooLarge {
+            get {
+                return ResourceManager.GetString("RemoteKernelTooLarge", resourceCulture);
+            }
+        }
+        
+        /// <summary>
+        ///   Looks up a localized string similar to The remote buffer &apos;{0}&apos; does not exist.
+        /// </summary>
+        internal static string UnknownRemoteBuffer {
+            get {
+                return ResourceManager.GetString("UnknownRemoteBuffer", resourceCulture);
+            }
+        }
+        
+        /// <summary>
+        ///   Looks up a localized string similar to The remote kernel &apos;{0}&apos; does not exist.
+        /// </summary>
+        internal static string UnknownRemoteKernel {
+            get {
+                return ResourceManager.GetString("UnknownRemoteKernel", resourceCulture);
+            }
+        }
+        
+        /// <summary>
+        ///   Looks up a localized string similar to The serialized kernel profile uses the unsupported format version &apos;{0}&apos;.
+        /// </summary>
+        internal static string UnsupportedKernelProfileVersion {
+            get {
+                return ResourceManager.GetString("UnsupportedKernelProfileVersion", resourceCulture);
+            }
+        }
+        
         /// <summary>
         ///   Looks up a localized string similar to Unknown parent accelerator.
         /// </summary>
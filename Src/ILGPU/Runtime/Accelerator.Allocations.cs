@@ -55,6 +55,49 @@ namespace ILGPU.Runtime
                     stride));
         }
 
+        /// <summary>
+        /// Allocates a 1D buffer that can be accessed by host code and by kernels of
+        /// this accelerator and migrates modified pages lazily between both sides.
+        /// </summary>
+        /// <typeparam name="T">The element type.</typeparam>
+        /// <param name="length">The number of elements to allocate.</param>
+        /// <returns>An allocated managed buffer on this accelerator.</returns>
+        public ManagedMemoryBuffer<T> AllocateManaged1D<T>(long length)
+            where T : unmanaged =>
+            AllocateManaged1D<T>(length, ManagedMemoryBuffer<T>.DefaultPageSize);
+
+        /// <summary>
+        /// Allocates a 1D buffer that can be accessed by host code and by kernels of
+        /// this accelerator and migrates modified pages lazily between both sides.
+        /// </summary>
+        /// <typeparam name="T">The element type.</typeparam>
+        /// <param name="length">The number of elements to allocate.</param>
+        /// <param name="pageSize">The migration granularity in bytes.</param>
+        /// <returns>An allocated managed buffer on this accelerator.</returns>
+        public ManagedMemoryBuffer<T> AllocateManaged1D<T>(long length, int pageSize)
+            where T : unmanaged =>
+            AllocateManaged1D<T>(length, pageSize, true);
+
+        /// <summary>
+        /// Allocates a 1D buffer that can be accessed by host code and by kernels of
+        /// this accelerator and migrates modified pages lazily between both sides.
+        /// </summary>
+        /// <typeparam name="T">The element type.</typeparam>
+        /// <param name="length">The number of elements to allocate.</param>
+        /// <param name="pageSize">The migration granularity in bytes.</param>
+        /// <param name="allowMapping">
+        /// True, if the host and a CPU accelerator may share the same memory. If
+        /// false, separate host and accelerator copies are allocated and migrated
+        /// on every accelerator type.
+        /// </param>
+        /// <returns>An allocated managed buffer on this accelerator.</returns>
+        public ManagedMemoryBuffer<T> AllocateManaged1D<T>(
+            long length,
+            int pageSize,
+            bool allowMapping)
+            where T : unmanaged =>
+            new ManagedMemoryBuffer<T>(this, length, pageSize, allowMapping);
+
         /// <summary>
         /// Builds a new 2D stride based on a generic stride description.
         /// </summary>
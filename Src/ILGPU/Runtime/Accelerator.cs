@@ -39,6 +39,11 @@ namespace ILGPU.Runtime
         /// Represents an OpenCL accelerator (CPU/GPU via OpenCL).
         /// </summary>
         OpenCL,
+
+        /// <summary>
+        /// Represents an accelerator that is hosted by a remote worker.
+        /// </summary>
+        Remote,
     }
 
     /// <summary>
@@ -51,6 +51,36 @@ namespace ILGPU.Runtime.CPU
         Parallel = 2,
     }
 
+    /// <summary>
+    /// Specifies how thread groups are distributed among the multiprocessors of a
+    /// <see cref="CPUAccelerator"/>.
+    /// </summary>
+    public enum CPUGroupScheduling
+    {
+        /// <summary>
+        /// Splits the grid into equally sized contiguous ranges of groups, one per
+        /// multiprocessor.
+        /// </summary>
+        /// <remarks>
+        /// This is the default mode.
+        /// </remarks>
+        Static = 0,
+
+        /// <summary>
+        /// Multiprocessors repeatedly claim chunks of
+        /// <see cref="CPUAccelerator.GroupChunkSize"/> groups from a shared counter.
+        /// This balances kernels with irregular per-group work.
+        /// </summary>
+        Dynamic = 1,
+
+        /// <summary>
+        /// Like <see cref="Dynamic"/>, but the size of claimed chunks is proportional
+        /// to the number of remaining groups and decreases towards
+        /// <see cref="CPUAccelerator.GroupChunkSize"/>.
+        /// </summary>
+        Guided = 2,
+    }
+
 
     /// <summary>
     /// Represents a general CPU-based runtime for kernels.
@@ -72,6 +102,11 @@ namespace ILGPU.Runtime.CPU
         private readonly Barrier finishedEventPerMultiprocessor;
         private readonly SemaphoreSlim taskConcurrencyLimit = new SemaphoreSlim(1);
 
+        // Group scheduling
+
+        private int groupChunkSize = 1;
+        private long nextGroupIndex;
+
         /// <summary>
         /// Constructs a new CPU runtime.
         /// </summary>
@@ -138,6 +173,35 @@ namespace ILGPU.Runtime.CPU
         /// </summary>
         public int NumThreads { get; }
 
+        /// <summary>
+        /// Gets or sets the scheduling mode that distributes thread groups among all
+        /// multiprocessors. Changes take effect with the next kernel launch.
+        /// </summary>
+        public CPUGroupScheduling GroupScheduling { get; set; }
+
+        /// <summary>
+        /// Gets or sets the number of groups that are claimed at once (or the minimum
+        /// number of groups in <see cref="CPUGroupScheduling.Guided"/> mode).
+        /// Changes take effect with the next kernel launch.
+        /// </summary>
+        public int GroupChunkSize
+        {
+            get => groupChunkSize;
+            set => groupChunkSize = value > 0
+                ? value
+                : throw new ArgumentOutOfRangeException(nameof(value));
+        }
+
+        /// <summary>
+        /// Returns the scheduling mode of the current launch.
+        /// </summary>
+        internal CPUGroupScheduling ActiveGroupScheduling { get; private set; }
+
+        /// <summary>
+        /// Returns the chunk size of the current launch.
+        /// </summary>
+        internal int ActiveGroupChunkSize { get; private set; }
+
         /// <summary>
         /// Returns the IL backend of this accelerator.
         /// </summary>
@@ -182,7 +246,9 @@ namespace ILGPU.Runtime.CPU
                 this,
                 kernel,
                 launcherMethod,
-                ilKernel.ExecutionHandler);
+                ilKernel.ExecutionHandler,
+                ilKernel.RangeExecutionHandler,
+                ilKernel.StaticSharedMemorySize);
         }
 
         /// <summary>
@@ -306,6 +372,10 @@ namespace ILGPU.Runtime.CPU
             {
                 emitter.Emit(LocalOperation.Load, cpuKernel);
                 emitter.EmitCall(CPUKernel.GetKernelExecutionDelegate);
+                emitter.Emit(LocalOperation.Load, cpuKernel);
+                emitter.EmitCall(CPUKernel.GetKernelRangeExecutionDelegate);
+                emitter.Emit(LocalOperation.Load, cpuKernel);
+                emitter.EmitCall(CPUKernel.GetStaticSharedMemorySize);
 
                 // Load custom user dimension
                 KernelLauncherBuilder.EmitLoadKernelConfig(
@@ -376,6 +446,44 @@ namespace ILGPU.Runtime.CPU
             }
         }
 
+        /// <summary>
+        /// Claims the next chunk of groups of the current launch.
+        /// </summary>
+        /// <param name="linearGridDim">The total number of groups.</param>
+        /// <param name="start">The first claimed linear group index.</param>
+        /// <param name="end">The exclusive end of the claimed range.</param>
+        /// <returns>True, if a non-empty chunk has been claimed.</returns>
+        internal bool TryClaimGroups(int linearGridDim, out int start, out int end)
+        {
+            int chunkSize = ActiveGroupChunkSize;
+            long current;
+            if (ActiveGroupScheduling == CPUGroupScheduling.Guided)
+            {
+                do
+                {
+                    current = Interlocked.Read(ref nextGroupIndex);
+                    if (current >= linearGridDim)
+                        break;
+                    long remaining = linearGridDim - current;
+                    chunkSize = (int)Math.Max(
+                        ActiveGroupChunkSize,
+                        remaining / (2 * NumMultiprocessors));
+                }
+                while (Interlocked.CompareExchange(
+                    ref nextGroupIndex,
+                    current + chunkSize,
+                    current) != current);
+            }
+            else
+            {
+                current = Interlocked.Add(ref nextGroupIndex, chunkSize) - chunkSize;
+            }
+
+            start = (int)Math.Min(current, linearGridDim);
+            end = (int)Math.Min(current + chunkSize, linearGridDim);
+            return start < end;
+        }
+
         internal void FinishTaskProcessing() =>
             // Wait for the result
             finishedEventPerMultiprocessor.SignalAndWait();
@@ -391,6 +499,10 @@ namespace ILGPU.Runtime.CPU
             taskConcurrencyLimit.Wait();
             try
             {
+                ActiveGroupScheduling = GroupScheduling;
+                ActiveGroupChunkSize = GroupChunkSize;
+                nextGroupIndex = 0;
+
                 foreach (var multiprocessor in multiprocessors)
                     multiprocessor.InitLaunch(task);
                 Interlocked.MemoryBarrier();
@@ -468,6 +580,83 @@ namespace ILGPU.Runtime.CPU
 
         #endregion
 
+        #region Zero-Copy Views
+
+        /// <summary>
+        /// Creates a 1D memory buffer that owns the given CPU source buffer.
+        /// </summary>
+        /// <typeparam name="T">The element type.</typeparam>
+        /// <param name="buffer">The wrapped source buffer.</param>
+        /// <returns>The created 1D memory buffer.</returns>
+        private MemoryBuffer1D<T, Stride1D.Dense> CreateWrapper<T>(
+            CPUMemoryBuffer buffer)
+            where T : unmanaged =>
+            new MemoryBuffer1D<T, Stride1D.Dense>(
+                this,
+                new ArrayView<T>(buffer, 0L, buffer.Length));
+
+        /// <summary>
+        /// Pins the given array and exposes it as a memory buffer on this accelerator
+        /// without copying its contents.
+        /// </summary>
+        /// <typeparam name="T">The element type.</typeparam>
+        /// <param name="array">The array to wrap.</param>
+        /// <returns>A buffer whose view directly accesses the given array.</returns>
+        /// <remarks>
+        /// The array remains pinned until the returned buffer is disposed. All views
+        /// of the buffer point to null afterwards and throw an
+        /// <see cref="ObjectDisposedException"/> when they are copied or cleared.
+        /// </remarks>
+        public MemoryBuffer1D<T, Stride1D.Dense> Wrap<T>(T[] array)
+            where T : unmanaged =>
+            CreateWrapper<T>(CPUMemoryBuffer.Pin(this, array));
+
+        /// <summary>
+        /// Pins the given memory and exposes it as a memory buffer on this
+        /// accelerator without copying its contents.
+        /// </summary>
+        /// <typeparam name="T">The element type.</typeparam>
+        /// <param name="memory">The memory to wrap.</param>
+        /// <returns>A buffer whose view directly accesses the given memory.</returns>
+        /// <remarks>
+        /// The memory remains pinned until the returned buffer is disposed. All views
+        /// of the buffer point to null afterwards and throw an
+        /// <see cref="ObjectDisposedException"/> when they are copied or cleared.
+        /// </remarks>
+        public MemoryBuffer1D<T, Stride1D.Dense> Wrap<T>(Memory<T> memory)
+            where T : unmanaged =>
+            CreateWrapper<T>(CPUMemoryBuffer.Pin(this, memory));
+
+        /// <summary>
+        /// Exposes the given native memory as a memory buffer on this accelerator
+        /// without copying its contents.
+        /// </summary>
+        /// <typeparam name="T">The element type.</typeparam>
+        /// <param name="ptr">The native pointer to the first element.</param>
+        /// <param name="length">The number of elements.</param>
+        /// <returns>A buffer whose view directly accesses the given memory.</returns>
+        /// <remarks>
+        /// The caller is responsible for keeping the memory alive until the returned
+        /// buffer is disposed. All views of the buffer point to null afterwards and
+        /// throw an <see cref="ObjectDisposedException"/> when they are copied or
+        /// cleared.
+        /// </remarks>
+        public MemoryBuffer1D<T, Stride1D.Dense> Wrap<T>(IntPtr ptr, long length)
+            where T : unmanaged
+        {
+            if (ptr == IntPtr.Zero)
+                throw new ArgumentNullException(nameof(ptr));
+            if (length < 0)
+                throw new ArgumentOutOfRangeException(nameof(length));
+            return CreateWrapper<T>(CPUMemoryBuffer.Create(
+                this,
+                ptr,
+                length,
+                Interop.SizeOf<T>()));
+        }
+
+        #endregion
+
         #region Page Lock Scope
 
         /// <inheritdoc/>
@@ -25,6 +25,18 @@ namespace ILGPU.Runtime.CPU
         CPUAcceleratorTask task,
         int globalIndex);
 
+    /// <summary>
+    /// Execution delegate for CPU kernels that processes a whole range of global
+    /// thread indices in a single call.
+    /// </summary>
+    /// <param name="task">The referenced task.</param>
+    /// <param name="startIndex">The first global thread index.</param>
+    /// <param name="endIndex">The exclusive end of the global index range.</param>
+    public delegate void CPUKernelRangeExecutionHandler(
+        CPUAcceleratorTask task,
+        int startIndex,
+        int endIndex);
+
     /// <summary>
     /// Represents a single CPU-accelerator task.
     /// </summary>
@@ -34,12 +46,19 @@ namespace ILGPU.Runtime.CPU
 
         internal const int LinearIndex = 1;
 
+        /// <summary>
+        /// The argument index of the exclusive end of a range execution.
+        /// </summary>
+        internal const int EndIndex = 2;
+
         /// <summary>
         /// Contains the required parameter types of the default task constructor.
         /// </summary>
         internal static readonly Type[] ConstructorParameterTypes =
         {
             typeof(CPUKernelExecutionHandler),
+            typeof(CPUKernelRangeExecutionHandler),
+            typeof(int),
             typeof(KernelConfig),
             typeof(RuntimeKernelConfig)
         };
@@ -53,6 +72,16 @@ namespace ILGPU.Runtime.CPU
             typeof(int)                 // linear index
         };
 
+        /// <summary>
+        /// Contains the required parameter types of the range-execution method.
+        /// </summary>
+        internal static readonly Type[] ExecuteRangeParameterTypes =
+        {
+            typeof(CPUAcceleratorTask), // task
+            typeof(int),                // start index
+            typeof(int)                 // end index
+        };
+
         /// <summary>
         /// Gets a task-specific constructor.
         /// </summary>
@@ -103,6 +132,49 @@ namespace ILGPU.Runtime.CPU
             CPUKernelExecutionHandler kernelExecutionDelegate,
             KernelConfig userConfig,
             RuntimeKernelConfig config)
+            : this(kernelExecutionDelegate, null, userConfig, config)
+        { }
+
+        /// <summary>
+        /// Constructs a new accelerator task.
+        /// </summary>
+        /// <param name="kernelExecutionDelegate">The execution method.</param>
+        /// <param name="kernelRangeExecutionDelegate">
+        /// The optional range-execution method.
+        /// </param>
+        /// <param name="userConfig">The user-defined grid configuration.</param>
+        /// <param name="config">The global task configuration.</param>
+        public CPUAcceleratorTask(
+            CPUKernelExecutionHandler kernelExecutionDelegate,
+            CPUKernelRangeExecutionHandler kernelRangeExecutionDelegate,
+            KernelConfig userConfig,
+            RuntimeKernelConfig config)
+            : this(
+                kernelExecutionDelegate,
+                kernelRangeExecutionDelegate,
+                0,
+                userConfig,
+                config)
+        { }
+
+        /// <summary>
+        /// Constructs a new accelerator task.
+        /// </summary>
+        /// <param name="kernelExecutionDelegate">The execution method.</param>
+        /// <param name="kernelRangeExecutionDelegate">
+        /// The optional range-execution method.
+        /// </param>
+        /// <param name="staticSharedMemorySize">
+        /// The size in bytes of all static shared-memory allocations.
+        /// </param>
+        /// <param name="userConfig">The user-defined grid configuration.</param>
+        /// <param name="config">The global task configuration.</param>
+        public CPUAcceleratorTask(
+            CPUKernelExecutionHandler kernelExecutionDelegate,
+            CPUKernelRangeExecutionHandler kernelRangeExecutionDelegate,
+            int staticSharedMemorySize,
+            KernelConfig userConfig,
+            RuntimeKernelConfig config)
         {
             Debug.Assert(
                 kernelExecutionDelegate != null,
@@ -121,7 +193,12 @@ namespace ILGPU.Runtime.CPU
                     RuntimeErrorMessages.InvalidGridDimension);
             }
 
+            if (staticSharedMemorySize < 0)
+                throw new ArgumentOutOfRangeException(nameof(staticSharedMemorySize));
+
             KernelExecutionDelegate = kernelExecutionDelegate;
+            KernelRangeExecutionDelegate = kernelRangeExecutionDelegate;
+            StaticSharedMemorySize = staticSharedMemorySize;
             TotalUserDim = userConfig.GridDim * userConfig.GroupDim;
             GridDim = config.GridDim;
             GroupDim = config.GroupDim;
@@ -157,11 +234,24 @@ namespace ILGPU.Runtime.CPU
         /// </summary>
         public SharedMemoryConfig DynamicSharedMemoryConfig { get; }
 
+        /// <summary>
+        /// Returns the size in bytes of all static shared-memory allocations that
+        /// are preallocated by each multiprocessor.
+        /// </summary>
+        public int StaticSharedMemorySize { get; }
+
         /// <summary>
         /// Returns the associated kernel-execution delegate.
         /// </summary>
         public CPUKernelExecutionHandler KernelExecutionDelegate { get; }
 
+        /// <summary>
+        /// Returns the associated range-execution delegate (if any). It is only
+        /// available for implicitly grouped kernels that do not depend on group or
+        /// warp semantics.
+        /// </summary>
+        public CPUKernelRangeExecutionHandler KernelRangeExecutionDelegate { get; }
+
         #endregion
     }
 }
@@ -31,6 +31,24 @@ namespace ILGPU.Runtime.CPU
                 BindingFlags.NonPublic | BindingFlags.Public | BindingFlags.Instance)
             .GetGetMethod(true);
 
+        /// <summary>
+        /// Represents the <see cref="KernelRangeExecutionDelegate"/> property getter.
+        /// </summary>
+        internal static readonly MethodInfo GetKernelRangeExecutionDelegate =
+            typeof(CPUKernel).GetProperty(
+                nameof(KernelRangeExecutionDelegate),
+                BindingFlags.NonPublic | BindingFlags.Public | BindingFlags.Instance)
+            .GetGetMethod(true);
+
+        /// <summary>
+        /// Represents the <see cref="StaticSharedMemorySize"/> property getter.
+        /// </summary>
+        internal static readonly MethodInfo GetStaticSharedMemorySize =
+            typeof(CPUKernel).GetProperty(
+                nameof(StaticSharedMemorySize),
+                BindingFlags.NonPublic | BindingFlags.Public | BindingFlags.Instance)
+            .GetGetMethod(true);
+
         #endregion
 
         #region Instance
@@ -42,15 +60,25 @@ namespace ILGPU.Runtime.CPU
         /// <param name="kernel">The source kernel.</param>
         /// <param name="launcher">The launcher method for the given kernel.</param>
         /// <param name="kernelExecutionDelegate">The execution method.</param>
+        /// <param name="kernelRangeExecutionDelegate">
+        /// The optional range-execution method.
+        /// </param>
+        /// <param name="staticSharedMemorySize">
+        /// The size in bytes of all static shared-memory allocations.
+        /// </param>
         internal CPUKernel(
             CPUAccelerator accelerator,
             CompiledKernel kernel,
             MethodInfo launcher,
-            CPUKernelExecutionHandler kernelExecutionDelegate)
+            CPUKernelExecutionHandler kernelExecutionDelegate,
+            CPUKernelRangeExecutionHandler kernelRangeExecutionDelegate,
+            int staticSharedMemorySize)
             : base(accelerator, kernel, launcher)
         {
             KernelExecutionDelegate = kernelExecutionDelegate
                 ?? throw new ArgumentNullException(nameof(kernelExecutionDelegate));
+            KernelRangeExecutionDelegate = kernelRangeExecutionDelegate;
+            StaticSharedMemorySize = staticSharedMemorySize;
         }
 
         #endregion
@@ -67,6 +95,16 @@ namespace ILGPU.Runtime.CPU
         /// </summary>
         internal CPUKernelExecutionHandler KernelExecutionDelegate { get; }
 
+        /// <summary>
+        /// Returns the associated range-execution delegate (if any).
+        /// </summary>
+        internal CPUKernelRangeExecutionHandler KernelRangeExecutionDelegate { get; }
+
+        /// <summary>
+        /// Returns the size in bytes of all static shared-memory allocations.
+        /// </summary>
+        internal int StaticSharedMemorySize { get; }
+
         #endregion
 
         #region IDisposable
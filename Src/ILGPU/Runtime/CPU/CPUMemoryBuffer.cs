@@ -12,7 +12,9 @@
 using ILGPU.Resources;
 using ILGPU.Runtime.Cuda;
 using ILGPU.Runtime.OpenCL;
+using ILGPU.Runtime.Remote;
 using System;
+using System.Buffers;
 using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
 
@@ -136,6 +138,18 @@ namespace ILGPU.Runtime.CPU
                         sourceView,
                         targetView);
                     break;
+                case AcceleratorType.Remote:
+                    // Copy from Remote to CPU
+                    if (!(stream is RemoteStream remoteStream))
+                    {
+                        throw new NotSupportedException(
+                            RuntimeErrorMessages.NotSupportedAcceleratorStream);
+                    }
+                    RemoteMemoryBuffer.RemoteCopy(
+                        remoteStream,
+                        sourceView,
+                        targetView);
+                    break;
                 default:
                     throw new NotSupportedException(
                         RuntimeErrorMessages.NotSupportedTargetAccelerator);
@@ -201,6 +215,18 @@ namespace ILGPU.Runtime.CPU
                         sourceView,
                         targetView);
                     break;
+                case AcceleratorType.Remote:
+                    // Copy from CPU to Remote
+                    if (!(stream is RemoteStream remoteStream))
+                    {
+                        throw new NotSupportedException(
+                            RuntimeErrorMessages.NotSupportedAcceleratorStream);
+                    }
+                    RemoteMemoryBuffer.RemoteCopy(
+                        remoteStream,
+                        sourceView,
+                        targetView);
+                    break;
                 default:
                     throw new NotSupportedException(
                         RuntimeErrorMessages.NotSupportedTargetAccelerator);
@@ -258,29 +284,42 @@ namespace ILGPU.Runtime.CPU
         #region Methods
 
         /// <inheritdoc/>
+        /// <remarks>
+        /// CPU buffers may wrap pinned managed memory that has already been released.
+        /// Hence, all host operations verify that this buffer has not been disposed.
+        /// </remarks>
         protected internal override unsafe void MemSet(
             AcceleratorStream stream,
             byte value,
-            in ArrayView<byte> targetView) =>
+            in ArrayView<byte> targetView)
+        {
+            VerifyNotDisposed();
             CPUMemSet(
                 targetView.LoadEffectiveAddressAsPtr(),
                 value,
                 0L,
                 targetView.LengthInBytes);
+        }
 
         /// <inheritdoc/>
         protected internal override void CopyFrom(
             AcceleratorStream stream,
             in ArrayView<byte> sourceView,
-            in ArrayView<byte> targetView) =>
+            in ArrayView<byte> targetView)
+        {
+            VerifyNotDisposed();
             CPUCopyFrom(stream, sourceView, targetView);
+        }
 
         /// <inheritdoc/>
         protected internal override unsafe void CopyTo(
             AcceleratorStream stream,
             in ArrayView<byte> sourceView,
-            in ArrayView<byte> targetView) =>
+            in ArrayView<byte> targetView)
+        {
+            VerifyNotDisposed();
             CPUCopyTo(stream, sourceView, targetView);
+        }
 
         #endregion
     }
@@ -319,9 +358,10 @@ namespace ILGPU.Runtime.CPU
             #region IDisposable
 
             /// <summary>
-            /// Does not perform any operation.
+            /// Invalidates the wrapped pointer without freeing the underlying memory.
             /// </summary>
-            protected override void DisposeAcceleratorObject(bool disposing) { }
+            protected override void DisposeAcceleratorObject(bool disposing) =>
+                NativePtr = IntPtr.Zero;
 
             #endregion
         }
@@ -444,10 +484,55 @@ namespace ILGPU.Runtime.CPU
             #region IDisposable
 
             /// <summary>
-            /// Frees the internal GC handle.
+            /// Frees the internal GC handle and invalidates the wrapped pointer.
             /// </summary>
-            protected override void DisposeAcceleratorObject(bool disposing) =>
+            protected override void DisposeAcceleratorObject(bool disposing)
+            {
                 handle.Free();
+                NativePtr = IntPtr.Zero;
+            }
+
+            #endregion
+        }
+
+        /// <summary>
+        /// Wraps a managed <see cref="Memory{T}"/> instance by pinning it for the
+        /// lifetime of this buffer.
+        /// </summary>
+        /// <typeparam name="T">The element type.</typeparam>
+        sealed class MemorySourceBuffer<T> : CPUMemoryBuffer
+            where T : unmanaged
+        {
+            #region Instance
+
+            private MemoryHandle handle;
+
+            /// <summary>
+            /// Constructs a new memory wrapper.
+            /// </summary>
+            /// <param name="accelerator">The parent CPU accelerator.</param>
+            /// <param name="memory">The managed memory to pin.</param>
+            public unsafe MemorySourceBuffer(
+                CPUAccelerator accelerator,
+                Memory<T> memory)
+                : base(accelerator, memory.Length, Interop.SizeOf<T>())
+            {
+                handle = memory.Pin();
+                NativePtr = new IntPtr(handle.Pointer);
+            }
+
+            #endregion
+
+            #region IDisposable
+
+            /// <summary>
+            /// Unpins the wrapped memory and invalidates the wrapped pointer.
+            /// </summary>
+            protected override void DisposeAcceleratorObject(bool disposing)
+            {
+                handle.Dispose();
+                NativePtr = IntPtr.Zero;
+            }
 
             #endregion
         }
@@ -554,6 +639,33 @@ namespace ILGPU.Runtime.CPU
             ? throw new ArgumentNullException(nameof(accelerator))
             : new PageLockedMemoryBuffer(accelerator, length, elementSize);
 
+        /// <summary>
+        /// Creates a new memory buffer that pins the given .Net array without copying
+        /// its contents.
+        /// </summary>
+        /// <param name="accelerator">The parent CPU accelerator.</param>
+        /// <param name="array">The managed source array.</param>
+        /// <returns>The wrapper memory buffer.</returns>
+        internal static CPUMemoryBuffer Pin<T>(CPUAccelerator accelerator, T[] array)
+            where T : unmanaged =>
+            new ArraySourceBuffer(
+                accelerator,
+                array ?? throw new ArgumentNullException(nameof(array)),
+                Interop.SizeOf<T>());
+
+        /// <summary>
+        /// Creates a new memory buffer that pins the given managed memory without
+        /// copying its contents.
+        /// </summary>
+        /// <param name="accelerator">The parent CPU accelerator.</param>
+        /// <param name="memory">The managed source memory.</param>
+        /// <returns>The wrapper memory buffer.</returns>
+        internal static CPUMemoryBuffer Pin<T>(
+            CPUAccelerator accelerator,
+            Memory<T> memory)
+            where T : unmanaged =>
+            new MemorySourceBuffer<T>(accelerator, memory);
+
         /// <summary>
         /// Creates a new memory buffer wrapper around the given .Net array.
         /// </summary>
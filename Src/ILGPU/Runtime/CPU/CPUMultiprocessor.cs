@@ -13,6 +13,7 @@ using ILGPU.Resources;
 using ILGPU.Util;
 using System;
 using System.Collections;
+using System.Collections.Generic;
 using System.Diagnostics;
 using System.Runtime.CompilerServices;
 using System.Threading;
@@ -61,6 +62,11 @@ namespace ILGPU.Runtime.CPU
 
         private volatile int maxNumLaunchedThreadsPerGroup;
 
+        // Group scheduling
+
+        private readonly List<(int Start, int End)> claimedChunks =
+            new List<(int, int)>();
+
         /// <summary>
         /// Creates a new CPU multiprocessor.
         /// </summary>
@@ -185,7 +191,8 @@ namespace ILGPU.Runtime.CPU
             groupContext.Initialize(
                 task.GridDim,
                 task.GroupDim,
-                task.DynamicSharedMemoryConfig);
+                task.DynamicSharedMemoryConfig,
+                task.StaticSharedMemorySize);
 
             // Initialize each involved warp context
             for (int i = 0, e = numWarps - 1; i < e; ++i)
@@ -206,6 +213,7 @@ namespace ILGPU.Runtime.CPU
             Debug.Assert(task != null, "Invalid accelerator task");
 
             SetupRuntimeClasses(task);
+            claimedChunks.Clear();
             StartOrContinueRuntimeThreads(task.GroupDim.Size);
             BeginLaunch(task);
         }
@@ -215,6 +223,80 @@ namespace ILGPU.Runtime.CPU
         /// </summary>
         public void FinishLaunch() => groupContext.TearDown();
 
+        /// <summary>
+        /// Returns the range of linear group indices of the given chunk.
+        /// </summary>
+        /// <param name="chunkIndex">
+        /// The local index of the chunk processed by this multiprocessor.
+        /// </param>
+        /// <param name="linearGridDim">The total number of groups.</param>
+        /// <param name="start">The first linear group index.</param>
+        /// <param name="end">The exclusive end of the group range.</param>
+        /// <returns>True, if there are groups to process.</returns>
+        /// <remarks>
+        /// All threads of this multiprocessor see the same sequence of chunks, since
+        /// they have to process the same groups to participate in group barriers.
+        /// </remarks>
+        private bool TryGetGroupChunk(
+            int chunkIndex,
+            int linearGridDim,
+            out int start,
+            out int end)
+        {
+            if (Accelerator.ActiveGroupScheduling == CPUGroupScheduling.Static)
+            {
+                int gridChunkSize = IntrinsicMath.DivRoundUp(
+                    linearGridDim,
+                    Accelerator.NumMultiprocessors);
+                start = gridChunkSize * ProcessorIndex;
+                end = Math.Min(start + gridChunkSize, linearGridDim);
+                return chunkIndex < 1 && start < end;
+            }
+
+            lock (claimedChunks)
+            {
+                if (chunkIndex >= claimedChunks.Count)
+                {
+                    if (!Accelerator.TryClaimGroups(linearGridDim, out start, out end))
+                        return false;
+                    claimedChunks.Add((start, end));
+                }
+                (start, end) = claimedChunks[chunkIndex];
+                return true;
+            }
+        }
+
+        /// <summary>
+        /// Executes the share of the current thread of all indices that belong to
+        /// the given range of groups with a single call of the range launcher.
+        /// </summary>
+        /// <param name="rangeLauncher">The range launcher to use.</param>
+        /// <param name="task">The current task.</param>
+        /// <param name="threadIdx">The current thread index.</param>
+        /// <param name="chunkStart">The first linear group index.</param>
+        /// <param name="chunkEnd">The exclusive end of the group range.</param>
+        /// <remarks>
+        /// This avoids all per-index group bookkeeping, since kernels with a range
+        /// launcher do not rely on group or warp semantics.
+        /// </remarks>
+        private static void ExecuteRange(
+            CPUKernelRangeExecutionHandler rangeLauncher,
+            CPUAcceleratorTask task,
+            int threadIdx,
+            int chunkStart,
+            int chunkEnd)
+        {
+            long groupSize = task.GroupDim.Size;
+            long start = chunkStart * groupSize;
+            long end = Math.Min(chunkEnd * groupSize, task.TotalUserDim.Size);
+            long threadRange = (end - start + groupSize - 1) / groupSize;
+
+            long threadStart = start + threadIdx * threadRange;
+            long threadEnd = Math.Min(threadStart + threadRange, end);
+            if (threadStart < threadEnd)
+                rangeLauncher(task, (int)threadStart, (int)threadEnd);
+        }
+
         /// <summary>
         /// Entry point for a single processing thread.
         /// </summary>
@@ -269,36 +351,55 @@ namespace ILGPU.Runtime.CPU
                         try
                         {
                             var launcher = task.KernelExecutionDelegate;
+                            var rangeLauncher = Accelerator.UsesSequentialExecution
+                                ? null
+                                : task.KernelRangeExecutionDelegate;
 
-                            // Split the grid into different chunks that will be processed
-                            // by the available multiprocessors
+                            // Process all chunks of groups that have been assigned to
+                            // this multiprocessor
                             int linearGridDim = task.GridDim.Size;
-                            int gridChunkSize = IntrinsicMath.DivRoundUp(
-                                linearGridDim,
-                                Accelerator.NumMultiprocessors);
-                            int gridOffset = gridChunkSize * ProcessorIndex;
                             int linearUserDim = task.TotalUserDim.Size;
                             for (
-                                int i = gridOffset, e = gridOffset + gridChunkSize;
-                                i < e;
-                                ++i)
+                                int chunkIndex = 0;
+                                TryGetGroupChunk(
+                                    chunkIndex,
+                                    linearGridDim,
+                                    out int chunkStart,
+                                    out int chunkEnd);
+                                ++chunkIndex)
                             {
-                                BeginThreadProcessing();
-                                try
+                                if (rangeLauncher != null)
                                 {
-                                    // Setup the current grid index
-                                    threadContext.GridIndex = Index3D.ReconstructIndex(
-                                        i,
-                                        task.GridDim);
-
-                                    // Invoke the actual kernel launcher
-                                    int globalIndex = i * groupSize + threadIdx;
-                                    if (globalIndex < linearUserDim)
-                                        launcher(task, globalIndex);
+                                    ExecuteRange(
+                                        rangeLauncher,
+                                        task,
+                                        threadIdx,
+                                        chunkStart,
+                                        chunkEnd);
+                                    continue;
                                 }
-                                finally
+
+                                for (int i = chunkStart; i < chunkEnd; ++i)
                                 {
-                                    EndThreadProcessing();
+                                    BeginThreadProcessing();
+                                    try
+                                    {
+                                        // Setup the current grid index
+                                        threadContext.GridIndex =
+                                            Index3D.ReconstructIndex(i, task.GridDim);
+
+                                        // Invoke the actual kernel launcher
+                                        int globalIndex = i * groupSize + threadIdx;
+                                        if (globalIndex < linearUserDim)
+                                        {
+                                            threadContext.ResetInvocationState();
+                                            launcher(task, globalIndex);
+                                        }
+                                    }
+                                    finally
+                                    {
+                                        EndThreadProcessing();
+                                    }
                                 }
                             }
                         }
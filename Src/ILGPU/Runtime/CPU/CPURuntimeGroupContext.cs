@@ -107,18 +107,41 @@ namespace ILGPU.Runtime.CPU
         private volatile int groupCounter;
 
         /// <summary>
-        /// The current dynamic shared memory array size in bytes.
+        /// The current dynamic shared memory array length in elements.
         /// </summary>
         private volatile int dynamicSharedMemoryArrayLength;
 
+        /// <summary>
+        /// The size in bytes of the dynamic part at the beginning of the
+        /// shared-memory pool.
+        /// </summary>
+        private long dynamicSharedMemorySize;
+
+        /// <summary>
+        /// The shared-memory pool that holds the dynamic and all static shared-memory
+        /// allocations of the current kernel.
+        /// </summary>
+        /// <remarks>
+        /// The pool is preallocated at launch time from the statically known
+        /// shared-memory size of the kernel. Since all threads of a group perform
+        /// the same sequence of allocations, each thread can compute the offsets of
+        /// all allocations on its own.
+        /// </remarks>
+        private CPUMemoryBuffer sharedMemoryPool;
+
+        /// <summary>
+        /// The size in bytes of the currently used part of the shared-memory pool.
+        /// </summary>
+        private long sharedMemoryPoolSize;
+
         /// <summary>
         /// A temporary cache for additional shared memory requirements.
         /// </summary>
         /// <remarks>
-        /// Note that this buffer is only required for debug CPU builds. In
-        /// these cases, we cannot move nested
-        /// <see cref="SharedMemory.Allocate{T}(int)"/> instructions out of nested loops
-        /// to provide the best debugging experience.
+        /// Note that this buffer is only required for debug CPU builds and allocations
+        /// that exceed the statically known shared-memory size. In these cases, we
+        /// cannot move nested <see cref="SharedMemory.Allocate{T}(int)"/> instructions
+        /// out of nested loops to provide the best debugging experience.
         /// </remarks>
         private InlineList<CPUMemoryBuffer> sharedMemory =
             InlineList<CPUMemoryBuffer>.Create(16);
@@ -185,10 +208,20 @@ namespace ILGPU.Runtime.CPU
         /// Performs a dynamic shared-memory allocation.
         /// </summary>
         /// <returns>The resolved shared-memory array view.</returns>
+        /// <remarks>
+        /// All dynamic shared-memory allocations refer to the same memory region, in
+        /// the same way as they do on GPUs.
+        /// </remarks>
         [MethodImpl(MethodImplOptions.AggressiveInlining)]
         public ArrayView<T> AllocateSharedMemoryDynamic<T>()
-            where T : unmanaged =>
-            AllocateSharedMemory<T>(dynamicSharedMemoryArrayLength);
+            where T : unmanaged
+        {
+            int extent = dynamicSharedMemoryArrayLength;
+            long sizeInBytes = (long)extent * Interop.SizeOf<T>();
+            return sizeInBytes <= dynamicSharedMemorySize & sizeInBytes > 0
+                ? new ArrayView<T>(sharedMemoryPool, 0, extent)
+                : AllocateSharedMemoryLocked<T>(extent);
+        }
 
         /// <summary>
         /// Performs a shared-memory allocation.
@@ -197,6 +230,34 @@ namespace ILGPU.Runtime.CPU
         /// <returns>The resolved shared-memory array view.</returns>
         [MethodImpl(MethodImplOptions.AggressiveInlining)]
         public ArrayView<T> AllocateSharedMemory<T>(int extent)
+            where T : unmanaged
+        {
+            var threadContext = CPURuntimeThreadContext.Current;
+            int elementSize = Interop.SizeOf<T>();
+
+            // Align the next free offset to a multiple of the element size
+            long offset = dynamicSharedMemorySize + threadContext.SharedMemoryOffset;
+            long index = (offset + elementSize - 1) / elementSize;
+            long sizeInBytes = (long)extent * elementSize;
+            offset = index * elementSize;
+
+            // Fall back to a synchronized allocation in the case of allocations that
+            // have not been considered by the static shared-memory size
+            if (offset + sizeInBytes > sharedMemoryPoolSize | sizeInBytes < 1)
+                return AllocateSharedMemoryLocked<T>(extent);
+
+            threadContext.SharedMemoryOffset =
+                offset + sizeInBytes - dynamicSharedMemorySize;
+            return new ArrayView<T>(sharedMemoryPool, index, extent);
+        }
+
+        /// <summary>
+        /// Performs a shared-memory allocation that is synchronized with all other
+        /// threads of the current group.
+        /// </summary>
+        /// <param name="extent">The number of elements.</param>
+        /// <returns>The resolved shared-memory array view.</returns>
+        private ArrayView<T> AllocateSharedMemoryLocked<T>(int extent)
             where T : unmanaged =>
             PerformLocked<
                 CPURuntimeGroupContext,
@@ -282,20 +343,47 @@ namespace ILGPU.Runtime.CPU
         /// <param name="sharedMemoryConfig">
         /// The current shared memory configuration.
         /// </param>
+        /// <param name="staticSharedMemorySize">
+        /// The size in bytes of all static shared-memory allocations including
+        /// alignment padding.
+        /// </param>
         public void Initialize(
             in Index3D gridDimension,
             in Index3D groupDimension,
-            in SharedMemoryConfig sharedMemoryConfig)
+            in SharedMemoryConfig sharedMemoryConfig,
+            int staticSharedMemorySize)
         {
             GridDimension = gridDimension;
             GroupDimension = groupDimension;
             GroupSize = groupDimension.Size;
             dynamicSharedMemoryArrayLength = sharedMemoryConfig.NumElements;
+            dynamicSharedMemorySize = sharedMemoryConfig.ArraySize;
 
             ClearSharedMemoryAllocations();
+            InitializeSharedMemoryPool(dynamicSharedMemorySize + staticSharedMemorySize);
             Initialize();
         }
 
+        /// <summary>
+        /// Ensures that the shared-memory pool can hold the given number of bytes.
+        /// </summary>
+        /// <param name="size">The required pool size in bytes.</param>
+        private void InitializeSharedMemoryPool(long size)
+        {
+            sharedMemoryPoolSize = size;
+            if (size < 1 || sharedMemoryPool != null &&
+                sharedMemoryPool.LengthInBytes >= size)
+            {
+                return;
+            }
+
+            sharedMemoryPool?.Dispose();
+            sharedMemoryPool = CPUMemoryBuffer.Create(
+                Multiprocessor.Accelerator,
+                size,
+                sizeof(byte));
+        }
+
         /// <summary>
         /// Performs cleanup operations with respect to the previously allocated
         /// shared memory
@@ -326,7 +414,10 @@ namespace ILGPU.Runtime.CPU
         protected override void Dispose(bool disposing)
         {
             if (disposing)
+            {
                 ClearSharedMemoryAllocations();
+                sharedMemoryPool?.Dispose();
+            }
             base.Dispose(disposing);
         }
 
@@ -92,10 +92,33 @@ namespace ILGPU.Runtime.CPU
         /// </summary>
         public int LinearGroupIndex { get; internal set; }
 
+        /// <summary>
+        /// Returns the offset in bytes of the next static shared-memory allocation
+        /// relative to the static part of the shared-memory pool.
+        /// </summary>
+        internal long SharedMemoryOffset { get; set; }
+
+        /// <summary>
+        /// Returns the index of the shuffle slot set to use for the next shuffle.
+        /// </summary>
+        internal int ShuffleSlotSet { get; set; }
+
         #endregion
 
         #region Methods
 
+        /// <summary>
+        /// Resets all per-invocation runtime state. Since all threads of a group
+        /// perform the same sequence of shared-memory allocations and shuffles, each
+        /// thread can track this state on its own without further synchronization.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        internal void ResetInvocationState()
+        {
+            SharedMemoryOffset = 0;
+            ShuffleSlotSet = 0;
+        }
+
         /// <summary>
         /// Makes the current context the active one for this thread.
         /// </summary>
@@ -46,6 +46,26 @@ namespace ILGPU.Runtime.CPU
 
         #endregion
 
+        #region Constants
+
+        /// <summary>
+        /// The number of 64-bit words of a single shuffle slot.
+        /// </summary>
+        private const int ShuffleSlotLength = 2;
+
+        /// <summary>
+        /// The maximum size in bytes of a value that can be shuffled via the
+        /// preallocated shuffle slots.
+        /// </summary>
+        private const int MaxShuffleSlotSize = ShuffleSlotLength * sizeof(long);
+
+        /// <summary>
+        /// The number of alternating shuffle slot sets.
+        /// </summary>
+        private const int NumShuffleSlotSets = 2;
+
+        #endregion
+
         #region Nested Types
 
         /// <summary>
@@ -177,10 +197,23 @@ namespace ILGPU.Runtime.CPU
         #region Instance
 
         /// <summary>
-        /// A temporary location for shuffle values.
+        /// A temporary location for shuffle values that do not fit into the
+        /// preallocated shuffle slots.
         /// </summary>
         private readonly CPUMemoryBufferCache shuffleBuffer;
 
+        /// <summary>
+        /// The preallocated shuffle slots that hold one slot per lane for each of
+        /// the alternating slot sets.
+        /// </summary>
+        /// <remarks>
+        /// Consecutive shuffles use alternating slot sets. This allows us to perform
+        /// a single barrier per shuffle, since a lane can only overwrite a slot of
+        /// the same set after all other lanes have passed the barrier of the next
+        /// shuffle, i.e. after they have read their values from this set.
+        /// </remarks>
+        private readonly long[] shuffleSlots;
+
         /// <summary>
         /// Constructs a new CPU-based runtime context for parallel processing.
         /// </summary>
@@ -195,6 +228,8 @@ namespace ILGPU.Runtime.CPU
 
             shuffleBuffer = new CPUMemoryBufferCache(Multiprocessor.Accelerator);
             shuffleBuffer.Allocate<int>(2 * sizeof(int) * numThreadsPerWarp);
+            shuffleSlots = new long[
+                NumShuffleSlotSets * numThreadsPerWarp * ShuffleSlotLength];
         }
 
         #endregion
@@ -235,7 +270,51 @@ namespace ILGPU.Runtime.CPU
             where T : unmanaged
         {
             config.Validate(WarpSize);
+            if (Interop.SizeOf<T>() > MaxShuffleSlotSize)
+                return ShuffleLocked(variable, config);
+
+            // Determine the slot set to use and toggle it for the next shuffle
+            var threadContext = CPURuntimeThreadContext.Current;
+            int slotSet = threadContext.ShuffleSlotSet;
+            threadContext.ShuffleSlotSet = slotSet ^ 1;
+            int slotOffset = slotSet * WarpSize;
+
+            // Publish the value of this lane and wait for all other lanes
+            Unsafe.WriteUnaligned(
+                ref GetShuffleSlot(slotOffset + config.CurrentLane),
+                variable);
+            Barrier();
 
+            // Read the value of the source lane
+            return config.IsSourceLaneInBounds
+                ? Unsafe.ReadUnaligned<T>(
+                    ref GetShuffleSlot(slotOffset + config.AbsoluteSourceLane))
+                : variable;
+        }
+
+        /// <summary>
+        /// Returns a reference to the given shuffle slot.
+        /// </summary>
+        /// <param name="slotIndex">The absolute slot index.</param>
+        /// <returns>A reference to the first byte of the slot.</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private ref byte GetShuffleSlot(int slotIndex) =>
+            ref Unsafe.As<long, byte>(
+                ref shuffleSlots[slotIndex * ShuffleSlotLength]);
+
+        /// <summary>
+        /// Performs a shuffle operation using a temporary shuffle buffer that is
+        /// synchronized with all other lanes.
+        /// </summary>
+        /// <typeparam name="T">The value type to shuffle.</typeparam>
+        /// <param name="variable">The source variable to shuffle.</param>
+        /// <param name="config">The current shuffle configuration.</param>
+        /// <returns>
+        /// The value of the variable in the scope of the desired lane.
+        /// </returns>
+        private T ShuffleLocked<T>(T variable, in ShuffleConfig config)
+            where T : unmanaged
+        {
             // Allocate a compatible view
             var view = PerformLocked<
                 CPURuntimeWarpContext,
@@ -203,14 +203,30 @@ namespace ILGPU.Runtime
             }
 
             // Resolve kernel and dispatch it
-            var getOrCreateMethod = cacheType.GetMethod(
-                "GetOrCreateKernel",
+            var acquireMethod = cacheType.GetMethod(
+                "AcquireKernel",
                 BindingFlags.Public | BindingFlags.Instance);
+            var cacheEntryType = typeof(SpecializationCacheEntry<TDelegate>);
+            var launcherProperty = cacheEntryType.GetProperty(
+                nameof(SpecializationCacheEntry<TDelegate>.Launcher),
+                BindingFlags.Public | BindingFlags.Instance);
+            var releaseMethod = cacheEntryType.GetMethod(
+                nameof(SpecializationCacheEntry<TDelegate>.Release),
+                BindingFlags.Public | BindingFlags.Instance);
+            var cacheEntryVariable = emitter.DeclareLocal(cacheEntryType);
             emitter.Emit(ArgumentOperation.Load, KernelInstanceParamIdx);
             emitter.Emit(LocalOperation.Load, keyVariable);
-            emitter.EmitCall(getOrCreateMethod);
+            emitter.EmitCall(acquireMethod);
+            emitter.Emit(LocalOperation.Store, cacheEntryVariable);
+
+            // Keep the kernel alive until it has been dispatched, since the cache
+            // disposes evicted kernels as soon as they have been released
+            var ilGenerator = method.ILGenerator;
+            ilGenerator.BeginExceptionBlock();
 
             // Load all arguments
+            emitter.Emit(LocalOperation.Load, cacheEntryVariable);
+            emitter.EmitCall(launcherProperty.GetGetMethod());
             emitter.Emit(ArgumentOperation.Load, KernelStreamParamIdx);
             emitter.Emit(ArgumentOperation.Load, KernelParamDimensionIdx);
             for (int i = 0, e = entry.Parameters.Count; i < e; ++i)
@@ -222,6 +238,12 @@ namespace ILGPU.Runtime
                 BindingFlags.Public | BindingFlags.Instance);
             emitter.EmitCall(invokeMethod);
 
+            // Release the kernel
+            ilGenerator.BeginFinallyBlock();
+            emitter.Emit(LocalOperation.Load, cacheEntryVariable);
+            emitter.EmitCall(releaseMethod);
+            ilGenerator.EndExceptionBlock();
+
             // Return
             emitter.Emit(OpCodes.Ret);
             return method.Finish();
@@ -260,6 +282,16 @@ namespace ILGPU.Runtime
             return keyStructBuilder.CreateType();
         }
 
+        /// <summary>
+        /// Resolves the kernel that is invoked by the given kernel or launcher.
+        /// </summary>
+        /// <param name="kernelOrLauncher">A kernel or a launcher delegate.</param>
+        /// <returns>The resolved kernel or null if it cannot be resolved.</returns>
+        internal static Kernel ResolveKernel(object kernelOrLauncher) =>
+            kernelOrLauncher is Delegate launcher
+            ? launcher.Target as Kernel
+            : kernelOrLauncher as Kernel;
+
         #endregion
 
         #region Instance
@@ -12,10 +12,14 @@
 using ILGPU.Backends;
 using ILGPU.Backends.EntryPoints;
 using ILGPU.Resources;
+using ILGPU.Util;
 using System;
+using System.Collections.Concurrent;
 using System.Collections.Generic;
 using System.Diagnostics;
+using System.Linq;
 using System.Runtime.CompilerServices;
+using System.Threading.Tasks;
 
 namespace ILGPU.Runtime
 {
@@ -26,15 +30,7 @@ namespace ILGPU.Runtime
         /// <summary>
         /// Constant to control GC invocations.
         /// </summary>
-        private const int NumberNewKernelsUntilGC = 128;
-
-        /// <summary>
-        /// Minimum number of kernel objects before we apply GC.
-        /// </summary>
-        /// <remarks>
-        /// Should be less or equal to <see cref="NumberNewKernelsUntilGC"/>.
-        /// </remarks>
-        private const int MinNumberOfKernelsInGC = 128;
+        private const int NumberReleasedKernelsUntilGC = 128;
 
         #endregion
 
@@ -206,22 +202,18 @@ namespace ILGPU.Runtime
         /// <summary>
         /// A cached kernel.
         /// </summary>
-        private struct CachedKernel
+        private readonly struct CachedKernel
         {
             #region Instance
 
-            private WeakReference<object> kernelReference;
-
             /// <summary>
             /// Constructs a new cached kernel.
             /// </summary>
             /// <param name="kernel">The kernel to cache.</param>
             /// <param name="kernelInfo">Detailed kernel information.</param>
-            public CachedKernel(
-                WeakReference<object> kernel,
-                KernelInfo kernelInfo)
+            public CachedKernel(object kernel, KernelInfo kernelInfo)
             {
-                kernelReference = kernel;
+                KernelObject = kernel;
                 KernelInfo = kernelInfo;
             }
 
@@ -229,6 +221,11 @@ namespace ILGPU.Runtime
 
             #region Properties
 
+            /// <summary>
+            /// Returns the cached kernel or launcher.
+            /// </summary>
+            public object KernelObject { get; }
+
             /// <summary>
             /// Returns the stored kernel information.
             /// </summary>
@@ -242,31 +239,16 @@ namespace ILGPU.Runtime
             /// Tries to resolve the associated kernel.
             /// </summary>
             /// <param name="kernel">The resolved kernel.</param>
-            /// <returns>True, if the associated kernel could be resolved.</returns>
-            public readonly bool TryGetKernel<T>(out T kernel)
-                where T : class
-            {
-                kernel = null;
-                return kernelReference.TryGetTarget(out var temp) &&
-                    (kernel = temp as T) != null;
-            }
-
-            /// <summary>
-            /// Tries to update the internal weak reference or creates a new one
-            /// pointing to the given target.
-            /// </summary>
-            /// <param name="target">The new target kernel.</param>
             /// <returns>
-            /// An updated weak reference that points to the given target.
+            /// True, if the associated kernel could be resolved and has not been
+            /// disposed.
             /// </returns>
-            public WeakReference<object> UpdateReference<T>(T target)
+            public bool TryGetKernel<T>(out T kernel)
                 where T : class
             {
-                if (kernelReference != null)
-                    kernelReference.SetTarget(target);
-                else
-                    kernelReference = new WeakReference<object>(target);
-                return kernelReference;
+                kernel = KernelObject as T;
+                return kernel != null &&
+                    !(Kernel.ResolveKernel(kernel)?.IsDisposed ?? false);
             }
 
             #endregion
@@ -314,15 +296,27 @@ namespace ILGPU.Runtime
         /// A cache for compiled kernel objects.
         /// </summary>
         [DebuggerBrowsable(DebuggerBrowsableState.Never)]
-        private Dictionary<
-            CachedCompiledKernelKey,
-            WeakReference<CompiledKernel>> compiledKernelCache;
+        private LruCache<CachedCompiledKernelKey, CompiledKernel> compiledKernelCache;
 
         /// <summary>
         /// A cache for loaded kernel objects.
         /// </summary>
         [DebuggerBrowsable(DebuggerBrowsableState.Never)]
-        private Dictionary<CachedKernelKey, CachedKernel> kernelCache;
+        private LruCache<CachedKernelKey, CachedKernel> kernelCache;
+
+        /// <summary>
+        /// The number of kernels that have been released by the kernel cache since
+        /// the last GC run.
+        /// </summary>
+        [DebuggerBrowsable(DebuggerBrowsableState.Never)]
+        private int numReleasedKernels;
+
+        /// <summary>
+        /// All running background specializations of all specialization caches.
+        /// </summary>
+        [DebuggerBrowsable(DebuggerBrowsableState.Never)]
+        private readonly ConcurrentDictionary<Task, bool> backgroundSpecializations =
+            new ConcurrentDictionary<Task, bool>();
 
         /// <summary>
         /// Initializes the local kernel cache.
@@ -336,10 +330,15 @@ namespace ILGPU.Runtime
                 return;
             }
 
-            compiledKernelCache = new Dictionary<
-                CachedCompiledKernelKey,
-                WeakReference<CompiledKernel>>();
-            kernelCache = new Dictionary<CachedKernelKey, CachedKernel>();
+            var properties = Context.Properties;
+            compiledKernelCache = new LruCache<CachedCompiledKernelKey, CompiledKernel>(
+                properties.MaxNumCachedKernels,
+                properties.MaxKernelCacheSize);
+            kernelCache = new LruCache<CachedKernelKey, CachedKernel>(
+                properties.MaxNumCachedKernels,
+                properties.MaxKernelCacheSize,
+                new KernelCacheCounters(),
+                ReleaseKernel_SyncRoot);
         }
 
         #endregion
@@ -352,21 +351,92 @@ namespace ILGPU.Runtime
         private bool KernelCacheEnabled => kernelCache != null;
 
         /// <summary>
-        /// True, if a GC run is requested to clean disposed child kernels.
+        /// True, if a GC run is requested to clean up released kernels.
+        /// </summary>
+        /// <remarks>This method is invoked in the scope of the locked
+        /// <see cref="syncRoot"/> object.</remarks>
+        private bool RequestKernelCacheGC_SyncRoot =>
+            numReleasedKernels >= NumberReleasedKernelsUntilGC;
+
+        /// <summary>
+        /// Returns the shared usage counters of all specialization caches.
+        /// </summary>
+        internal KernelCacheCounters SpecializationCacheCounters { get; } =
+            new KernelCacheCounters();
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Returns the usage statistics of the compiled-kernel cache.
         /// </summary>
         /// <remarks>
-        /// This method is invoked in the scope of the locked <see cref="syncRoot"/>
-        /// object.
+        /// The compiled-kernel cache stores the generated code of all kernels
+        /// independent of their loaded instances.
         /// </remarks>
-        private bool RequestKernelCacheGC_SyncRoot =>
-            KernelCacheEnabled &&
-            ((compiledKernelCache.Count + 1) % NumberNewKernelsUntilGC == 0 ||
-            (kernelCache.Count + 1) % NumberNewKernelsUntilGC == 0);
+        public KernelCacheStatistics CompiledKernelCacheStatistics =>
+            compiledKernelCache?.Counters.ToStatistics() ?? default;
+
+        /// <summary>
+        /// Returns the usage statistics of the loaded-kernel cache.
+        /// </summary>
+        public KernelCacheStatistics LoadedKernelCacheStatistics =>
+            kernelCache?.Counters.ToStatistics() ?? default;
+
+        /// <summary>
+        /// Returns the accumulated usage statistics of all caches that store
+        /// dynamically specialized kernels.
+        /// </summary>
+        public KernelCacheStatistics SpecializationCacheStatistics =>
+            SpecializationCacheCounters.ToStatistics();
+
+        #endregion
+
+        #region Events
+
+        /// <summary>
+        /// Will be raised if a kernel could not be specialized in the background.
+        /// </summary>
+        /// <remarks>
+        /// Launches keep using the generic kernel in this case. Note that this event
+        /// is raised on a background thread.
+        /// </remarks>
+        public event EventHandler<Exception> SpecializationFailed;
 
         #endregion
 
         #region Methods
 
+        /// <summary>
+        /// Tracks a running background specialization.
+        /// </summary>
+        /// <param name="specialization">The specialization task.</param>
+        internal void TrackSpecialization(Task specialization)
+        {
+            backgroundSpecializations.TryAdd(specialization, true);
+            specialization.ContinueWith(
+                task => backgroundSpecializations.TryRemove(task, out _),
+                TaskScheduler.Default);
+        }
+
+        /// <summary>
+        /// Reports a failed background specialization.
+        /// </summary>
+        /// <param name="exception">The compilation or loading error.</param>
+        internal void OnSpecializationFailed(Exception exception) =>
+            SpecializationFailed?.Invoke(this, exception);
+
+        /// <summary>
+        /// Waits for all background specializations that have been scheduled so far.
+        /// </summary>
+        /// <remarks>
+        /// Failed specializations are reported via <see cref="SpecializationFailed"/>
+        /// before this method returns.
+        /// </remarks>
+        public void WaitForSpecializations() =>
+            Task.WaitAll(backgroundSpecializations.Keys.ToArray());
+
         /// <summary>
         /// Loads a kernel specified by the given method.
         /// </summary>
@@ -402,9 +472,10 @@ namespace ILGPU.Runtime
                         !cached.TryGetKernel(out T result))
                     {
                         result = cachedLoader(kernelLoader, out kernelInfo);
-                        kernelCache[cachedKey] = new CachedKernel(
-                            cached.UpdateReference(result),
-                            kernelInfo);
+                        kernelCache.Add(
+                            cachedKey,
+                            new CachedKernel(result, kernelInfo),
+                            Kernel.ResolveKernel(result)?.CompiledKernel.CodeSize ?? 0);
                     }
                     else
                     {
@@ -569,22 +640,11 @@ namespace ILGPU.Runtime
                 {
                     if (!compiledKernelCache.TryGetValue(
                         cachedKey,
-                        out WeakReference<CompiledKernel> cached) ||
-                        !cached.TryGetTarget(out CompiledKernel result))
+                        out CompiledKernel result))
                     {
                         result = Backend.Compile(entry, specialization);
-                        if (cached == null)
-                        {
-                            compiledKernelCache.Add(
-                                cachedKey,
-                                new WeakReference<CompiledKernel>(result));
-                        }
-                        else
-                        {
-                            cached.SetTarget(result);
-                        }
+                        compiledKernelCache.Add(cachedKey, result, result.CodeSize);
                     }
-                    RequestGC_SyncRoot();
                     return result;
                 }
             }
@@ -595,51 +655,38 @@ namespace ILGPU.Runtime
         }
 
         /// <summary>
-        /// Clears the internal cache.
+        /// Releases a kernel that has been evicted from the kernel cache.
         /// </summary>
-        private void ClearKernelCache_SyncRoot()
-        {
-            if (!KernelCacheEnabled)
-                return;
-            compiledKernelCache.Clear();
-            kernelCache.Clear();
-        }
+        /// <param name="cachedKernel">The released kernel.</param>
+        /// <remarks>
+        /// Loaded kernels are shared with all callers that requested them and cannot
+        /// be disposed at this point. Unreferenced kernels are finalized by the
+        /// runtime instead, and the next GC run removes them from the list of child
+        /// objects. This method is invoked in the scope of the locked
+        /// <see cref="syncRoot"/> object.
+        /// </remarks>
+        private void ReleaseKernel_SyncRoot(CachedKernel cachedKernel) =>
+            ++numReleasedKernels;
 
         /// <summary>
-        /// GC method to clean disposed kernels.
+        /// GC method to clean up released kernels.
         /// </summary>
         /// <remarks>
-        /// This method is invoked in the scope of the locked <see cref="syncRoot"/>
-        /// object.
+        /// This method is invoked after <see cref="ChildObjectsGC_SyncRoot"/>, which
+        /// has already removed all released kernels that have been finalized. It is
+        /// invoked in the scope of the locked <see cref="syncRoot"/> object.
         /// </remarks>
-        private void KernelCacheGC_SyncRoot()
+        private void KernelCacheGC_SyncRoot() => numReleasedKernels = 0;
+
+        /// <summary>
+        /// Clears the internal cache.
+        /// </summary>
+        private void ClearKernelCache_SyncRoot()
         {
             if (!KernelCacheEnabled)
                 return;
-
-            if (compiledKernelCache.Count >= MinNumberOfKernelsInGC)
-            {
-                var oldCompiledKernels = compiledKernelCache;
-                compiledKernelCache = new Dictionary<
-                    CachedCompiledKernelKey,
-                    WeakReference<CompiledKernel>>();
-                foreach (var entry in oldCompiledKernels)
-                {
-                    if (entry.Value.TryGetTarget(out CompiledKernel _))
-                        compiledKernelCache.Add(entry.Key, entry.Value);
-                }
-            }
-
-            if (kernelCache.Count >= MinNumberOfKernelsInGC)
-            {
-                var oldKernels = kernelCache;
-                kernelCache = new Dictionary<CachedKernelKey, CachedKernel>();
-                foreach (var entry in oldKernels)
-                {
-                    if (entry.Value.TryGetKernel(out object _))
-                        kernelCache.Add(entry.Key, entry.Value);
-                }
-            }
+            compiledKernelCache.Clear();
+            kernelCache.Clear();
         }
 
         #endregion
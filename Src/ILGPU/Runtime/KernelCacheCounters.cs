@@ -0,0 +1,82 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: KernelCacheCounters.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using System.Threading;
+
+namespace ILGPU.Runtime
+{
+    /// <summary>
+    /// Thread-safe usage counters that can be shared by several kernel caches.
+    /// </summary>
+    internal sealed class KernelCacheCounters
+    {
+        #region Instance
+
+        private long numHits;
+        private long numMisses;
+        private long numEvictions;
+        private long numEntries;
+        private long size;
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Registers a cache hit.
+        /// </summary>
+        public void AddHit() => Interlocked.Increment(ref numHits);
+
+        /// <summary>
+        /// Registers a cache miss.
+        /// </summary>
+        public void AddMiss() => Interlocked.Increment(ref numMisses);
+
+        /// <summary>
+        /// Registers an evicted entry.
+        /// </summary>
+        public void AddEviction() => Interlocked.Increment(ref numEvictions);
+
+        /// <summary>
+        /// Registers a new entry.
+        /// </summary>
+        /// <param name="entrySize">The size of the entry in bytes.</param>
+        public void AddEntry(long entrySize)
+        {
+            Interlocked.Increment(ref numEntries);
+            Interlocked.Add(ref size, entrySize);
+        }
+
+        /// <summary>
+        /// Unregisters a removed entry.
+        /// </summary>
+        /// <param name="entrySize">The size of the entry in bytes.</param>
+        public void RemoveEntry(long entrySize)
+        {
+            Interlocked.Decrement(ref numEntries);
+            Interlocked.Add(ref size, -entrySize);
+        }
+
+        /// <summary>
+        /// Returns a snapshot of all counters.
+        /// </summary>
+        /// <returns>The current statistics.</returns>
+        public KernelCacheStatistics ToStatistics() =>
+            new KernelCacheStatistics(
+                Interlocked.Read(ref numHits),
+                Interlocked.Read(ref numMisses),
+                Interlocked.Read(ref numEvictions),
+                (int)Interlocked.Read(ref numEntries),
+                Interlocked.Read(ref size));
+
+        #endregion
+    }
+}
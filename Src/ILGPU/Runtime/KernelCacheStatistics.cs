@@ -0,0 +1,98 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: KernelCacheStatistics.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+namespace ILGPU.Runtime
+{
+    /// <summary>
+    /// Represents a snapshot of the usage counters of a kernel cache.
+    /// </summary>
+    public readonly struct KernelCacheStatistics
+    {
+        #region Instance
+
+        /// <summary>
+        /// Constructs new kernel cache statistics.
+        /// </summary>
+        /// <param name="numHits">The number of cache hits.</param>
+        /// <param name="numMisses">The number of cache misses.</param>
+        /// <param name="numEvictions">The number of evicted entries.</param>
+        /// <param name="numEntries">The number of cached entries.</param>
+        /// <param name="size">The accumulated size of all entries in bytes.</param>
+        public KernelCacheStatistics(
+            long numHits,
+            long numMisses,
+            long numEvictions,
+            int numEntries,
+            long size)
+        {
+            NumHits = numHits;
+            NumMisses = numMisses;
+            NumEvictions = numEvictions;
+            NumEntries = numEntries;
+            Size = size;
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Returns the number of lookups that could be served from the cache.
+        /// </summary>
+        public long NumHits { get; }
+
+        /// <summary>
+        /// Returns the number of lookups that required a new kernel.
+        /// </summary>
+        public long NumMisses { get; }
+
+        /// <summary>
+        /// Returns the number of entries that have been evicted from the cache.
+        /// </summary>
+        public long NumEvictions { get; }
+
+        /// <summary>
+        /// Returns the number of entries that are currently cached.
+        /// </summary>
+        public int NumEntries { get; }
+
+        /// <summary>
+        /// Returns the accumulated code size of all cached entries in bytes.
+        /// </summary>
+        public long Size { get; }
+
+        /// <summary>
+        /// Returns the ratio of cache hits to all lookups.
+        /// </summary>
+        public double HitRatio
+        {
+            get
+            {
+                long numLookups = NumHits + NumMisses;
+                return numLookups > 0 ? NumHits / (double)numLookups : 0.0;
+            }
+        }
+
+        #endregion
+
+        #region Object
+
+        /// <summary>
+        /// Returns the string representation of these statistics.
+        /// </summary>
+        /// <returns>The string representation of these statistics.</returns>
+        public override string ToString() =>
+            $"Hits: {NumHits}, Misses: {NumMisses}, Evictions: {NumEvictions}, " +
+            $"Entries: {NumEntries}, Size: {Size}";
+
+        #endregion
+    }
+}
@@ -0,0 +1,691 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: KernelProfile.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.IR.Values;
+using ILGPU.Resources;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Reflection;
+using System.Text;
+using System.Threading;
+
+namespace ILGPU.Runtime
+{
+    /// <summary>
+    /// Stores execution counts of conditional branches that have been recorded by
+    /// instrumented kernels on the CPU accelerator. A profile can be saved, merged
+    /// and used to guide the optimization of kernels for all accelerators.
+    /// </summary>
+    /// <remarks>
+    /// Branches are identified by their declaring method and their IL offset. A
+    /// method is identified by the name of its assembly, its metadata token and its
+    /// signature, which remain valid across rebuilds of unchanged code. Each generic
+    /// instantiation of a method has its own branch counters. The version id of the
+    /// profiled module is stored to detect profiles of different builds, which are
+    /// reported via <see cref="ModuleVersionMismatch"/>.
+    /// </remarks>
+    public sealed class KernelProfile
+    {
+        #region Constants
+
+        /// <summary>
+        /// The current format version of serialized profiles.
+        /// </summary>
+        public const int FormatVersion = 3;
+
+        /// <summary>
+        /// The magic header of serialized profiles ('ILPF').
+        /// </summary>
+        private const int Magic = 0x46504C49;
+
+        /// <summary>
+        /// The minimum number of recorded executions of a branch before it is
+        /// considered to be biased.
+        /// </summary>
+        public const int MinNumSamples = 16;
+
+        /// <summary>
+        /// The minimum ratio of executions that have to take the same branch target
+        /// to consider the branch to be biased.
+        /// </summary>
+        public const double LikelyRatio = 0.9;
+
+        #endregion
+
+        #region Static
+
+        /// <summary>
+        /// All counter arrays that are referenced by instrumented kernels.
+        /// </summary>
+        /// <remarks>
+        /// Counter arrays are referenced weakly, since every instrumented kernel
+        /// keeps its parent context and hence its instrumentation profile alive.
+        /// The slots of reclaimed arrays are reused by subsequent registrations.
+        /// </remarks>
+        private static WeakReference<long[]>[] registeredCounters =
+            Array.Empty<WeakReference<long[]>>();
+
+        /// <summary>
+        /// Synchronizes the registration of counter arrays.
+        /// </summary>
+        private static readonly object registrationLock = new object();
+
+        /// <summary>
+        /// Increments a counter of a registered counter array. This method is
+        /// invoked by instrumented kernels.
+        /// </summary>
+        /// <param name="index">The registration index.</param>
+        /// <param name="counter">The counter index.</param>
+        internal static void RecordBranch(int index, int counter)
+        {
+            var reference = Volatile.Read(ref registeredCounters)[index];
+            if (reference.TryGetTarget(out var counters))
+                Interlocked.Increment(ref counters[counter]);
+        }
+
+        /// <summary>
+        /// Registers the given counter array to make it accessible to instrumented
+        /// kernels.
+        /// </summary>
+        /// <param name="counters">The counter array to register.</param>
+        /// <returns>The registration index.</returns>
+        private static int RegisterCounters(long[] counters)
+        {
+            lock (registrationLock)
+            {
+                // Reuse the slot of a counter array that has been reclaimed
+                var current = registeredCounters;
+                for (int i = 0, e = current.Length; i < e; ++i)
+                {
+                    if (!current[i].TryGetTarget(out _))
+                    {
+                        current[i].SetTarget(counters);
+                        return i;
+                    }
+                }
+
+                var newCounters = new WeakReference<long[]>[current.Length + 1];
+                Array.Copy(current, newCounters, current.Length);
+                newCounters[current.Length] = new WeakReference<long[]>(counters);
+                Volatile.Write(ref registeredCounters, newCounters);
+                return current.Length;
+            }
+        }
+
+        /// <summary>
+        /// Creates a new exception that indicates invalid serialized profile data.
+        /// </summary>
+        /// <returns>The created exception.</returns>
+        private static InvalidDataException GetInvalidDataException() =>
+            new InvalidDataException(RuntimeErrorMessages.InvalidKernelProfileData);
+
+        /// <summary>
+        /// Creates a new exception that indicates invalid serialized profile data.
+        /// </summary>
+        /// <param name="innerException">The inner exception.</param>
+        /// <returns>The created exception.</returns>
+        private static InvalidDataException GetInvalidDataException(
+            Exception innerException) =>
+            new InvalidDataException(
+                RuntimeErrorMessages.InvalidKernelProfileData,
+                innerException);
+
+        /// <summary>
+        /// Returns a string that identifies the signature of the given method. The
+        /// signature of a generic instantiation is the one of its definition.
+        /// </summary>
+        /// <param name="method">The method.</param>
+        /// <returns>The signature string.</returns>
+        private static string GetSignature(MethodBase method)
+        {
+            var declaringType = method.DeclaringType;
+            if (declaringType is null)
+                return method.ToString();
+            if (declaringType.IsGenericType || method.IsGenericMethod)
+            {
+                method = method.Module.ResolveMethod(method.MetadataToken);
+                declaringType = method.DeclaringType;
+            }
+            return declaringType.FullName + "::" + method;
+        }
+
+        /// <summary>
+        /// Returns a string that identifies the generic instantiation of the given
+        /// method, or an empty string for non-generic methods.
+        /// </summary>
+        /// <param name="method">The method.</param>
+        /// <returns>The instantiation string.</returns>
+        private static string GetInstantiation(MethodBase method)
+        {
+            var declaringType = method.DeclaringType;
+            bool isGenericType = declaringType != null && declaringType.IsGenericType;
+            if (!isGenericType && !method.IsGenericMethod)
+                return string.Empty;
+
+            var builder = new StringBuilder();
+            if (isGenericType)
+                AppendTypes(builder, declaringType.GetGenericArguments());
+            builder.Append('|');
+            if (method.IsGenericMethod)
+                AppendTypes(builder, method.GetGenericArguments());
+            return builder.ToString();
+        }
+
+        /// <summary>
+        /// Appends the assembly-qualified names of all given types.
+        /// </summary>
+        /// <param name="builder">The target builder.</param>
+        /// <param name="types">The types to append.</param>
+        private static void AppendTypes(StringBuilder builder, Type[] types)
+        {
+            for (int i = 0, e = types.Length; i < e; ++i)
+            {
+                if (i > 0)
+                    builder.Append(',');
+                builder.Append('[');
+                builder.Append(types[i].AssemblyQualifiedName ?? types[i].Name);
+                builder.Append(']');
+            }
+        }
+
+        #endregion
+
+        #region Nested Types
+
+        /// <summary>
+        /// Identifies a method including its generic instantiation.
+        /// </summary>
+        private readonly struct MethodKey : IEquatable<MethodKey>
+        {
+            /// <summary>
+            /// Constructs a new method key.
+            /// </summary>
+            /// <param name="assemblyName">The name of the declaring assembly.</param>
+            /// <param name="token">The metadata token of the method.</param>
+            /// <param name="signature">The signature string.</param>
+            /// <param name="instantiation">The generic instantiation string.</param>
+            public MethodKey(
+                string assemblyName,
+                int token,
+                string signature,
+                string instantiation)
+            {
+                AssemblyName = assemblyName;
+                Token = token;
+                Signature = signature;
+                Instantiation = instantiation;
+            }
+
+            /// <summary>
+            /// Constructs a new method key.
+            /// </summary>
+            /// <param name="method">The method.</param>
+            public MethodKey(MethodBase method)
+                : this(
+                      method.Module.Assembly.GetName().Name,
+                      method.MetadataToken,
+                      GetSignature(method),
+                      GetInstantiation(method))
+            { }
+
+            /// <summary>
+            /// Returns the simple name of the declaring assembly.
+            /// </summary>
+            public string AssemblyName { get; }
+
+            /// <summary>
+            /// Returns the metadata token of the method.
+            /// </summary>
+            public int Token { get; }
+
+            /// <summary>
+            /// Returns the signature of the method including its declaring type.
+            /// </summary>
+            public string Signature { get; }
+
+            /// <summary>
+            /// Returns the generic type and method arguments of the method, or an
+            /// empty string for non-generic methods.
+            /// </summary>
+            public string Instantiation { get; }
+
+            /// <summary>
+            /// Returns true if the given key is equal to the current one.
+            /// </summary>
+            public bool Equals(MethodKey other) =>
+                AssemblyName == other.AssemblyName &&
+                Token == other.Token &&
+                Signature == other.Signature &&
+                Instantiation == other.Instantiation;
+
+            /// <summary>
+            /// Returns true if the given object is equal to the current one.
+            /// </summary>
+            public override bool Equals(object obj) =>
+                obj is MethodKey other && Equals(other);
+
+            /// <summary>
+            /// Returns the hash code of this key.
+            /// </summary>
+            public override int GetHashCode() =>
+                AssemblyName.GetHashCode() ^ Token ^
+                Signature.GetHashCode() ^ Instantiation.GetHashCode();
+        }
+
+        /// <summary>
+        /// Stores the branch counters of a single method.
+        /// </summary>
+        private sealed class MethodProfile
+        {
+            /// <summary>
+            /// Is not zero if a module version mismatch has been reported.
+            /// </summary>
+            private int mismatchReported;
+
+            /// <summary>
+            /// Constructs a new method profile.
+            /// </summary>
+            /// <param name="moduleId">The version id of the profiled module.</param>
+            /// <param name="offsets">The IL offsets of all branches.</param>
+            public MethodProfile(Guid moduleId, IReadOnlyList<int> offsets)
+            {
+                ModuleId = moduleId;
+                Slots = new Dictionary<int, int>(offsets.Count);
+                foreach (var offset in offsets)
+                    Slots[offset] = Slots.Count;
+                Counters = new long[Slots.Count * 2];
+                RegistrationIndex = -1;
+            }
+
+            /// <summary>
+            /// Returns the version id of the module that has been profiled.
+            /// </summary>
+            public Guid ModuleId { get; }
+
+            /// <summary>
+            /// Maps IL offsets to counter slots.
+            /// </summary>
+            public Dictionary<int, int> Slots { get; }
+
+            /// <summary>
+            /// Stores two counters per slot: the number of executions that took the
+            /// branch target followed by the number of executions that fell through.
+            /// </summary>
+            public long[] Counters { get; }
+
+            /// <summary>
+            /// Returns the registration index of the counter array or -1.
+            /// </summary>
+            public int RegistrationIndex { get; set; }
+
+            /// <summary>
+            /// Adds the given counts to the branch at the given offset.
+            /// </summary>
+            public void Add(int offset, long numTaken, long numNotTaken)
+            {
+                if (!Slots.TryGetValue(offset, out int slot))
+                    return;
+                Interlocked.Add(ref Counters[slot * 2], numTaken);
+                Interlocked.Add(ref Counters[slot * 2 + 1], numNotTaken);
+            }
+
+            /// <summary>
+            /// Returns true if the given method belongs to a different module version
+            /// and this mismatch has not been reported so far.
+            /// </summary>
+            public bool TryReportMismatch(MethodBase method) =>
+                method.Module.ModuleVersionId != ModuleId &&
+                Interlocked.Exchange(ref mismatchReported, 1) == 0;
+        }
+
+        #endregion
+
+        #region Instance
+
+        /// <summary>
+        /// Synchronizes all accesses to the method mapping.
+        /// </summary>
+        private readonly object syncRoot = new object();
+
+        /// <summary>
+        /// Maps methods to their profiles.
+        /// </summary>
+        private readonly Dictionary<MethodKey, MethodProfile> methods =
+            new Dictionary<MethodKey, MethodProfile>();
+
+        /// <summary>
+        /// Constructs a new empty profile.
+        /// </summary>
+        public KernelProfile() { }
+
+        #endregion
+
+        #region Events
+
+        /// <summary>
+        /// Will be raised once per profiled method if the method has been profiled
+        /// in a different version of its module. The counts of such a method are
+        /// still used, although they might not match its current IL code.
+        /// </summary>
+        /// <remarks>
+        /// This event is raised on the thread that queries the profile, which is
+        /// usually a compilation thread.
+        /// </remarks>
+        public event EventHandler<MethodBase> ModuleVersionMismatch;
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Returns the number of profiled methods.
+        /// </summary>
+        public int NumMethods
+        {
+            get
+            {
+                lock (syncRoot)
+                    return methods.Count;
+            }
+        }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Gets or creates the profile of the given method.
+        /// </summary>
+        /// <param name="key">The method key.</param>
+        /// <param name="moduleId">The version id of the profiled module.</param>
+        /// <param name="offsets">The IL offsets of all branches.</param>
+        /// <returns>The method profile.</returns>
+        private MethodProfile GetOrCreateMethodProfile(
+            in MethodKey key,
+            Guid moduleId,
+            IReadOnlyList<int> offsets)
+        {
+            lock (syncRoot)
+            {
+                if (!methods.TryGetValue(key, out var profile))
+                {
+                    profile = new MethodProfile(moduleId, offsets);
+                    methods.Add(key, profile);
+                }
+                return profile;
+            }
+        }
+
+        /// <summary>
+        /// Reports a module version mismatch between the given method and its
+        /// profile, if any.
+        /// </summary>
+        /// <param name="method">The method.</param>
+        /// <param name="profile">The profile of the method.</param>
+        private void CheckModuleVersion(MethodBase method, MethodProfile profile)
+        {
+            if (profile.TryReportMismatch(method))
+                ModuleVersionMismatch?.Invoke(this, method);
+        }
+
+        /// <summary>
+        /// Registers the given method for instrumentation.
+        /// </summary>
+        /// <param name="method">The method to instrument.</param>
+        /// <param name="offsets">The IL offsets of all conditional branches.</param>
+        /// <param name="slots">The counter slot of each branch offset.</param>
+        /// <returns>The registration index of the associated counter array.</returns>
+        internal int RegisterMethod(
+            MethodBase method,
+            IReadOnlyList<int> offsets,
+            out IReadOnlyDictionary<int, int> slots)
+        {
+            var profile = GetOrCreateMethodProfile(
+                new MethodKey(method),
+                method.Module.ModuleVersionId,
+                offsets);
+            CheckModuleVersion(method, profile);
+            lock (syncRoot)
+            {
+                if (profile.RegistrationIndex < 0)
+                    profile.RegistrationIndex = RegisterCounters(profile.Counters);
+            }
+            slots = profile.Slots;
+            return profile.RegistrationIndex;
+        }
+
+        /// <summary>
+        /// Tries to get the recorded counts of the given branch.
+        /// </summary>
+        /// <param name="method">The method containing the branch.</param>
+        /// <param name="ilOffset">The IL offset of the branch instruction.</param>
+        /// <param name="numTaken">
+        /// The number of executions that jumped to the branch target.
+        /// </param>
+        /// <param name="numNotTaken">
+        /// The number of executions that fell through to the next instruction.
+        /// </param>
+        /// <returns>True, if the branch has been profiled.</returns>
+        public bool TryGetBranchCounts(
+            MethodBase method,
+            int ilOffset,
+            out long numTaken,
+            out long numNotTaken)
+        {
+            if (method is null)
+                throw new ArgumentNullException(nameof(method));
+
+            numTaken = numNotTaken = 0;
+            MethodProfile profile;
+            lock (syncRoot)
+            {
+                if (!methods.TryGetValue(new MethodKey(method), out profile))
+                    return false;
+            }
+            CheckModuleVersion(method, profile);
+            if (!profile.Slots.TryGetValue(ilOffset, out int slot))
+                return false;
+            numTaken = Interlocked.Read(ref profile.Counters[slot * 2]);
+            numNotTaken = Interlocked.Read(ref profile.Counters[slot * 2 + 1]);
+            return true;
+        }
+
+        /// <summary>
+        /// Returns the likelihood flags of the given branch, in which the branch
+        /// target is the true target of the resulting if branch.
+        /// </summary>
+        /// <param name="method">The method containing the branch.</param>
+        /// <param name="ilOffset">The IL offset of the branch instruction.</param>
+        /// <returns>The likelihood flags of the given branch.</returns>
+        internal IfBranchFlags GetBranchFlags(MethodBase method, int ilOffset)
+        {
+            if (!TryGetBranchCounts(method, ilOffset, out var taken, out var notTaken))
+                return IfBranchFlags.None;
+
+            long total = taken + notTaken;
+            if (total < MinNumSamples)
+                return IfBranchFlags.None;
+            if (taken >= total * LikelyRatio)
+                return IfBranchFlags.LikelyTrue;
+            if (notTaken >= total * LikelyRatio)
+                return IfBranchFlags.LikelyFalse;
+            return IfBranchFlags.None;
+        }
+
+        /// <summary>
+        /// Adds all counts of the given profile to this profile.
+        /// </summary>
+        /// <param name="other">The profile to merge.</param>
+        public void Merge(KernelProfile other)
+        {
+            if (other is null)
+                throw new ArgumentNullException(nameof(other));
+            if (other == this)
+                return;
+
+            foreach (var (key, profile) in other.GetMethodProfiles())
+            {
+                var offsets = new List<int>(profile.Slots.Keys);
+                var target = GetOrCreateMethodProfile(key, profile.ModuleId, offsets);
+                foreach (var entry in profile.Slots)
+                {
+                    target.Add(
+                        entry.Key,
+                        Interlocked.Read(ref profile.Counters[entry.Value * 2]),
+                        Interlocked.Read(ref profile.Counters[entry.Value * 2 + 1]));
+                }
+            }
+        }
+
+        /// <summary>
+        /// Returns a snapshot of all method profiles.
+        /// </summary>
+        private List<(MethodKey, MethodProfile)> GetMethodProfiles()
+        {
+            lock (syncRoot)
+            {
+                var result = new List<(MethodKey, MethodProfile)>(methods.Count);
+                foreach (var entry in methods)
+                    result.Add((entry.Key, entry.Value));
+                return result;
+            }
+        }
+
+        /// <summary>
+        /// Saves this profile to the given stream.
+        /// </summary>
+        /// <param name="stream">The target stream.</param>
+        public void Save(Stream stream)
+        {
+            if (stream is null)
+                throw new ArgumentNullException(nameof(stream));
+
+            var profiles = GetMethodProfiles();
+            using var writer = new BinaryWriter(stream, Encoding.UTF8, true);
+            writer.Write(Magic);
+            writer.Write(FormatVersion);
+            writer.Write(profiles.Count);
+            foreach (var (key, profile) in profiles)
+            {
+                writer.Write(profile.ModuleId.ToByteArray());
+                writer.Write(key.AssemblyName);
+                writer.Write(key.Token);
+                writer.Write(key.Signature);
+                writer.Write(key.Instantiation);
+                writer.Write(profile.Slots.Count);
+                foreach (var entry in profile.Slots)
+                {
+                    writer.Write(entry.Key);
+                    writer.Write(Interlocked.Read(
+                        ref profile.Counters[entry.Value * 2]));
+                    writer.Write(Interlocked.Read(
+                        ref profile.Counters[entry.Value * 2 + 1]));
+                }
+            }
+        }
+
+        /// <summary>
+        /// Loads a profile from the given stream.
+        /// </summary>
+        /// <param name="stream">The source stream.</param>
+        /// <returns>The loaded profile.</returns>
+        public static KernelProfile Load(Stream stream)
+        {
+            if (stream is null)
+                throw new ArgumentNullException(nameof(stream));
+
+            using var reader = new BinaryReader(stream, Encoding.UTF8, true);
+            int magic;
+            try
+            {
+                magic = reader.ReadInt32();
+            }
+            catch (EndOfStreamException e)
+            {
+                throw new InvalidDataException(
+                    RuntimeErrorMessages.InvalidKernelProfileHeader,
+                    e);
+            }
+            if (magic != Magic)
+            {
+                throw new InvalidDataException(
+                    RuntimeErrorMessages.InvalidKernelProfileHeader);
+            }
+
+            try
+            {
+                int version = reader.ReadInt32();
+                if (version != FormatVersion)
+                {
+                    throw new InvalidDataException(string.Format(
+                        RuntimeErrorMessages.UnsupportedKernelProfileVersion,
+                        version));
+                }
+                return Load(reader);
+            }
+            catch (EndOfStreamException e)
+            {
+                throw GetInvalidDataException(e);
+            }
+            catch (DecoderFallbackException e)
+            {
+                throw GetInvalidDataException(e);
+            }
+        }
+
+        /// <summary>
+        /// Loads all method profiles following the serialization header.
+        /// </summary>
+        /// <param name="reader">The source reader.</param>
+        /// <returns>The loaded profile.</returns>
+        private static KernelProfile Load(BinaryReader reader)
+        {
+            var result = new KernelProfile();
+            int numMethods = reader.ReadInt32();
+            if (numMethods < 0)
+                throw GetInvalidDataException();
+            for (int i = 0; i < numMethods; ++i)
+            {
+                var moduleId = reader.ReadBytes(16);
+                if (moduleId.Length != 16)
+                    throw new EndOfStreamException();
+                var key = new MethodKey(
+                    reader.ReadString(),
+                    reader.ReadInt32(),
+                    reader.ReadString(),
+                    reader.ReadString());
+                int numBranches = reader.ReadInt32();
+                if (numBranches < 0)
+                    throw GetInvalidDataException();
+
+                // Do not preallocate any storage based on untrusted counts
+                var offsets = new List<int>();
+                var counts = new List<(long, long)>();
+                for (int j = 0; j < numBranches; ++j)
+                {
+                    offsets.Add(reader.ReadInt32());
+                    counts.Add((reader.ReadInt64(), reader.ReadInt64()));
+                }
+
+                var profile = result.GetOrCreateMethodProfile(
+                    key,
+                    new Guid(moduleId),
+                    offsets);
+                for (int j = 0; j < numBranches; ++j)
+                    profile.Add(offsets[j], counts[j].Item1, counts[j].Item2);
+            }
+            return result;
+        }
+
+        #endregion
+    }
+}
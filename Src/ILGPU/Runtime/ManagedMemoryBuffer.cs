@@ -0,0 +1,375 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: ManagedMemoryBuffer.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.Runtime.CPU;
+using System;
+using System.Diagnostics;
+
+namespace ILGPU.Runtime
+{
+    /// <summary>
+    /// Specifies how a range of a <see cref="ManagedMemoryBuffer{T}"/> is accessed.
+    /// </summary>
+    [Flags]
+    public enum ManagedMemoryAccess
+    {
+        /// <summary>
+        /// The range is read.
+        /// </summary>
+        Read = 1 << 0,
+
+        /// <summary>
+        /// The range is (completely) overwritten.
+        /// </summary>
+        Write = 1 << 1,
+
+        /// <summary>
+        /// The range is read and written.
+        /// </summary>
+        ReadWrite = Read | Write,
+    }
+
+    /// <summary>
+    /// Represents a 1D buffer that can be accessed by host code and by kernels of its
+    /// parent accelerator. Modified pages are tracked separately for the host and the
+    /// accelerator and are migrated lazily on the next access from the other side.
+    /// </summary>
+    /// <typeparam name="T">The element type.</typeparam>
+    /// <remarks>
+    /// On a <see cref="CPUAccelerator"/> the host memory and the accelerator memory
+    /// are identical and no migration takes place, unless mapping has been disabled
+    /// during allocation. Members of this class are not thread safe. All accesses,
+    /// including the use of previously returned spans and views, have to be
+    /// synchronized externally if the buffer is shared between several threads.
+    /// </remarks>
+    [DebuggerDisplay("Length = {Length}, PageLength = {PageLength}")]
+    public sealed class ManagedMemoryBuffer<T> : AcceleratorObject
+        where T : unmanaged
+    {
+        #region Nested Types
+
+        /// <summary>
+        /// The migration state of a single page.
+        /// </summary>
+        private enum PageState : byte
+        {
+            /// <summary>
+            /// Both copies of the page are identical.
+            /// </summary>
+            Clean,
+
+            /// <summary>
+            /// The host copy of the page has been modified.
+            /// </summary>
+            HostDirty,
+
+            /// <summary>
+            /// The accelerator copy of the page has been modified.
+            /// </summary>
+            DeviceDirty,
+        }
+
+        #endregion
+
+        #region Constants
+
+        /// <summary>
+        /// The default page size in bytes.
+        /// </summary>
+        public const int DefaultPageSize = 4096;
+
+        #endregion
+
+        #region Instance
+
+        private readonly CPUMemoryBuffer hostBuffer;
+        private readonly MemoryBuffer1D<T, Stride1D.Dense> deviceBuffer;
+        private readonly PageState[] pages;
+
+        /// <summary>
+        /// Constructs a new managed memory buffer.
+        /// </summary>
+        /// <param name="accelerator">The parent accelerator.</param>
+        /// <param name="length">The number of elements.</param>
+        /// <param name="pageSize">The page size in bytes.</param>
+        /// <param name="allowMapping">
+        /// True, if the host and the accelerator may share the same memory.
+        /// </param>
+        internal ManagedMemoryBuffer(
+            Accelerator accelerator,
+            long length,
+            int pageSize,
+            bool allowMapping)
+            : base(accelerator)
+        {
+            if (length < 0)
+                throw new ArgumentOutOfRangeException(nameof(length));
+            if (pageSize < 1)
+                throw new ArgumentOutOfRangeException(nameof(pageSize));
+
+            Length = length;
+            IsMapped = allowMapping &&
+                accelerator.AcceleratorType == AcceleratorType.CPU;
+            PageLength = Math.Max(pageSize / Interop.SizeOf<T>(), 1);
+            pages = new PageState[(length + PageLength - 1) / PageLength];
+
+            deviceBuffer = accelerator.Allocate1D<T>(length);
+            if (!IsMapped && length > 0)
+            {
+                hostBuffer = CPUMemoryBuffer.CreatePageLocked(
+                    accelerator,
+                    length,
+                    Interop.SizeOf<T>());
+            }
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Returns the number of elements.
+        /// </summary>
+        public long Length { get; }
+
+        /// <summary>
+        /// Returns the number of elements per page.
+        /// </summary>
+        public int PageLength { get; }
+
+        /// <summary>
+        /// Returns the number of pages.
+        /// </summary>
+        public int NumPages => pages.Length;
+
+        /// <summary>
+        /// Returns true if the host and the accelerator share the same memory.
+        /// </summary>
+        public bool IsMapped { get; }
+
+        /// <summary>
+        /// Returns the number of pages that are currently modified on the host.
+        /// </summary>
+        public int NumHostDirtyPages => CountPages(PageState.HostDirty);
+
+        /// <summary>
+        /// Returns the number of pages that are currently modified on the accelerator.
+        /// </summary>
+        public int NumDeviceDirtyPages => CountPages(PageState.DeviceDirty);
+
+        /// <summary>
+        /// Returns the host copy of all elements.
+        /// </summary>
+        private ArrayView<T> HostView =>
+            IsMapped
+            ? deviceBuffer.View.AsContiguous()
+            : new ArrayView<T>(hostBuffer, 0L, Length);
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Counts all pages with the given state.
+        /// </summary>
+        private int CountPages(PageState state)
+        {
+            int count = 0;
+            foreach (var page in pages)
+                count += page == state ? 1 : 0;
+            return count;
+        }
+
+        /// <summary>
+        /// Checks the given element range and returns the affected page range.
+        /// </summary>
+        private (long StartPage, long EndPage) GetPageRange(long offset, long length)
+        {
+            if (offset < 0 || offset > Length)
+                throw new ArgumentOutOfRangeException(nameof(offset));
+            if (length < 0 || offset + length > Length)
+                throw new ArgumentOutOfRangeException(nameof(length));
+            return (offset / PageLength, (offset + length + PageLength - 1) / PageLength);
+        }
+
+        /// <summary>
+        /// Returns true if the given page has to be transferred before accessing the
+        /// element range <paramref name="offset"/> to <paramref name="end"/>.
+        /// </summary>
+        private bool RequiresTransfer(
+            long page,
+            long offset,
+            long end,
+            ManagedMemoryAccess access)
+        {
+            // Pages that will be completely overwritten do not need to be transferred
+            if ((access & ManagedMemoryAccess.Read) != 0)
+                return true;
+            long pageStart = page * PageLength;
+            long pageEnd = Math.Min(pageStart + PageLength, Length);
+            return pageStart < offset || pageEnd > end;
+        }
+
+        /// <summary>
+        /// Migrates all pages in the given range that are dirty on the other side and
+        /// updates the page states according to the access kind.
+        /// </summary>
+        /// <param name="stream">The accelerator stream to use.</param>
+        /// <param name="offset">The element offset.</param>
+        /// <param name="length">The number of elements.</param>
+        /// <param name="access">The intended access.</param>
+        /// <param name="toHost">True, if the range is accessed by the host.</param>
+        private void Migrate(
+            AcceleratorStream stream,
+            long offset,
+            long length,
+            ManagedMemoryAccess access,
+            bool toHost)
+        {
+            if (stream is null)
+                throw new ArgumentNullException(nameof(stream));
+            var (startPage, endPage) = GetPageRange(offset, length);
+            if (IsMapped || startPage == endPage)
+                return;
+
+            var staleState = toHost ? PageState.DeviceDirty : PageState.HostDirty;
+            var writeState = toHost ? PageState.HostDirty : PageState.DeviceDirty;
+            var hostView = HostView;
+            var deviceView = deviceBuffer.View.AsContiguous();
+            long end = offset + length;
+
+            // Transfer consecutive stale pages with a single copy operation
+            for (long page = startPage; page < endPage; )
+            {
+                if (pages[page] != staleState ||
+                    !RequiresTransfer(page, offset, end, access))
+                {
+                    ++page;
+                    continue;
+                }
+
+                long first = page;
+                while (page < endPage && pages[page] == staleState &&
+                    RequiresTransfer(page, offset, end, access))
+                {
+                    pages[page++] = PageState.Clean;
+                }
+
+                long start = first * PageLength;
+                long count = Math.Min(page * PageLength, Length) - start;
+                var source = (toHost ? deviceView : hostView).SubView(start, count);
+                var target = (toHost ? hostView : deviceView).SubView(start, count);
+                source.CopyTo(stream, target);
+            }
+
+            if ((access & ManagedMemoryAccess.Write) == 0)
+                return;
+            for (long page = startPage; page < endPage; ++page)
+                pages[page] = writeState;
+        }
+
+        /// <summary>
+        /// Makes the given range available to host code.
+        /// </summary>
+        /// <param name="offset">The element offset.</param>
+        /// <param name="length">The number of elements.</param>
+        /// <param name="access">The intended access.</param>
+        /// <returns>A span that accesses the host copy of the given range.</returns>
+        /// <remarks>
+        /// The returned span must not be used after another part of the buffer has
+        /// been accessed by the parent accelerator.
+        /// </remarks>
+        public Span<T> GetHostSpan(long offset, int length, ManagedMemoryAccess access) =>
+            GetHostSpan(Accelerator.DefaultStream, offset, length, access);
+
+        /// <summary>
+        /// Makes the given range available to host code.
+        /// </summary>
+        /// <param name="stream">The accelerator stream to use.</param>
+        /// <param name="offset">The element offset.</param>
+        /// <param name="length">The number of elements.</param>
+        /// <param name="access">The intended access.</param>
+        /// <returns>A span that accesses the host copy of the given range.</returns>
+        /// <remarks>
+        /// The returned span must not be used after another part of the buffer has
+        /// been accessed by the parent accelerator.
+        /// </remarks>
+        public unsafe Span<T> GetHostSpan(
+            AcceleratorStream stream,
+            long offset,
+            int length,
+            ManagedMemoryAccess access)
+        {
+            Migrate(stream, offset, length, access, toHost: true);
+
+            // Wait for pending transfers and kernels that access the host copy
+            stream.Synchronize();
+            if (length < 1)
+                return Span<T>.Empty;
+            var view = HostView.SubView(offset, length);
+            return new Span<T>(view.LoadEffectiveAddressAsPtr().ToPointer(), length);
+        }
+
+        /// <summary>
+        /// Makes all elements available to kernels of the parent accelerator.
+        /// </summary>
+        /// <param name="access">The intended access.</param>
+        /// <returns>A view to pass to kernels of the parent accelerator.</returns>
+        public ArrayView1D<T, Stride1D.Dense> GetView(ManagedMemoryAccess access) =>
+            GetView(Accelerator.DefaultStream, access);
+
+        /// <summary>
+        /// Makes all elements available to kernels of the parent accelerator.
+        /// </summary>
+        /// <param name="stream">The accelerator stream to use.</param>
+        /// <param name="access">The intended access.</param>
+        /// <returns>A view to pass to kernels of the parent accelerator.</returns>
+        public ArrayView1D<T, Stride1D.Dense> GetView(
+            AcceleratorStream stream,
+            ManagedMemoryAccess access) =>
+            GetView(stream, 0L, Length, access);
+
+        /// <summary>
+        /// Makes the given range available to kernels of the parent accelerator.
+        /// </summary>
+        /// <param name="stream">The accelerator stream to use.</param>
+        /// <param name="offset">The element offset.</param>
+        /// <param name="length">The number of elements.</param>
+        /// <param name="access">The intended access.</param>
+        /// <returns>A view to pass to kernels of the parent accelerator.</returns>
+        public ArrayView<T> GetView(
+            AcceleratorStream stream,
+            long offset,
+            long length,
+            ManagedMemoryAccess access)
+        {
+            Migrate(stream, offset, length, access, toHost: false);
+            return deviceBuffer.View.AsContiguous().SubView(offset, length);
+        }
+
+        #endregion
+
+        #region IDisposable
+
+        /// <summary>
+        /// Frees the host and the accelerator copies.
+        /// </summary>
+        protected override void DisposeAcceleratorObject(bool disposing)
+        {
+            if (!disposing)
+                return;
+            deviceBuffer.Dispose();
+            hostBuffer?.Dispose();
+        }
+
+        #endregion
+    }
+}
@@ -0,0 +1,709 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: MultiAccelerator.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.Util;
+using System;
+using System.Collections.Generic;
+using System.Collections.Immutable;
+using System.Diagnostics;
+using System.Linq;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace ILGPU.Runtime
+{
+    /// <summary>
+    /// Specifies how work is distributed among the accelerators of a
+    /// <see cref="MultiAccelerator"/>.
+    /// </summary>
+    public enum MultiAcceleratorWeighting
+    {
+        /// <summary>
+        /// All accelerators receive the same amount of work.
+        /// </summary>
+        Uniform,
+
+        /// <summary>
+        /// Work is distributed according to the maximum number of parallel threads.
+        /// </summary>
+        Throughput,
+
+        /// <summary>
+        /// Work is distributed according to the available device memory.
+        /// </summary>
+        Memory,
+    }
+
+    /// <summary>
+    /// A contiguous part of an index space that is assigned to a single accelerator.
+    /// </summary>
+    [DebuggerDisplay("{Index}: [{Offset}, {Offset + Length}) on {Accelerator}")]
+    public readonly struct AcceleratorPartition
+    {
+        /// <summary>
+        /// Constructs a new partition.
+        /// </summary>
+        /// <param name="index">The accelerator index.</param>
+        /// <param name="accelerator">The assigned accelerator.</param>
+        /// <param name="stream">The stream to use.</param>
+        /// <param name="offset">The offset of the first element or row.</param>
+        /// <param name="length">The number of elements or rows.</param>
+        /// <param name="rowLength">
+        /// The number of elements per row (1 for 1D partitions).
+        /// </param>
+        internal AcceleratorPartition(
+            int index,
+            Accelerator accelerator,
+            AcceleratorStream stream,
+            long offset,
+            long length,
+            long rowLength)
+        {
+            Index = index;
+            Accelerator = accelerator;
+            Stream = stream;
+            Offset = offset;
+            Length = length;
+            RowLength = rowLength;
+        }
+
+        /// <summary>
+        /// Returns the index of the assigned accelerator.
+        /// </summary>
+        public int Index { get; }
+
+        /// <summary>
+        /// Returns the assigned accelerator.
+        /// </summary>
+        public Accelerator Accelerator { get; }
+
+        /// <summary>
+        /// Returns the stream that should be used for all operations.
+        /// </summary>
+        public AcceleratorStream Stream { get; }
+
+        /// <summary>
+        /// Returns the offset of the first element in the global index space. The
+        /// offset of a 2D partition is measured in rows.
+        /// </summary>
+        public long Offset { get; }
+
+        /// <summary>
+        /// Returns the number of elements of this partition. The length of a 2D
+        /// partition is measured in rows.
+        /// </summary>
+        public long Length { get; }
+
+        /// <summary>
+        /// Returns the number of elements per row, which is 1 for 1D partitions.
+        /// </summary>
+        public long RowLength { get; }
+
+        /// <summary>
+        /// Returns the offset of the first element in the flattened global index
+        /// space.
+        /// </summary>
+        public long ElementOffset => Offset * RowLength;
+
+        /// <summary>
+        /// Returns the number of elements in the flattened index space.
+        /// </summary>
+        public long NumElements => Length * RowLength;
+
+        /// <summary>
+        /// Returns the 32-bit extent of this partition. The extent of a 2D partition
+        /// covers its rows only; use <see cref="Extent2D"/> to launch 2D kernels.
+        /// </summary>
+        /// <exception cref="OverflowException">
+        /// Thrown if the length exceeds the 32-bit range.
+        /// </exception>
+        public Index1D Extent => checked((int)Length);
+
+        /// <summary>
+        /// Returns the 32-bit 2D extent of this partition, in which X enumerates the
+        /// elements of a row and Y enumerates the rows of this partition.
+        /// </summary>
+        /// <exception cref="OverflowException">
+        /// Thrown if the row length or the length exceeds the 32-bit range.
+        /// </exception>
+        public Index2D Extent2D =>
+            new Index2D(checked((int)RowLength), checked((int)Length));
+
+        /// <summary>
+        /// Returns the part of the given flattened global view that belongs to this
+        /// partition.
+        /// </summary>
+        /// <typeparam name="T">The element type.</typeparam>
+        /// <param name="view">The global view.</param>
+        /// <returns>The sub view of this partition.</returns>
+        public ArrayView<T> GetSubView<T>(ArrayView<T> view)
+            where T : unmanaged =>
+            view.SubView(ElementOffset, NumElements);
+    }
+
+    /// <summary>
+    /// Distributes data-parallel work among several accelerators.
+    /// </summary>
+    /// <remarks>
+    /// The accelerators are not owned by this instance. Members of this class are
+    /// not thread safe.
+    /// </remarks>
+    public sealed class MultiAccelerator : DisposeBase
+    {
+        #region Static
+
+        /// <summary>
+        /// Returns the default weight of the given accelerator.
+        /// </summary>
+        /// <param name="accelerator">The accelerator.</param>
+        /// <param name="weighting">The weighting kind.</param>
+        /// <returns>The relative weight of the accelerator.</returns>
+        public static double GetWeight(
+            Accelerator accelerator,
+            MultiAcceleratorWeighting weighting) =>
+            weighting switch
+            {
+                MultiAcceleratorWeighting.Throughput =>
+                    Math.Max(accelerator.MaxNumThreads, 1),
+                MultiAcceleratorWeighting.Memory =>
+                    Math.Max(accelerator.MemorySize, 1),
+                _ => 1.0,
+            };
+
+        /// <summary>
+        /// Copies the contents of the source view into the target view. Direct copies
+        /// are used if both views live on the same accelerator, if one of them lives
+        /// on the CPU or if peer access has been enabled. Otherwise, the data is
+        /// staged through the host.
+        /// </summary>
+        /// <typeparam name="T">The element type.</typeparam>
+        /// <param name="sourceStream">A stream of the source accelerator.</param>
+        /// <param name="source">The source view.</param>
+        /// <param name="targetStream">A stream of the target accelerator.</param>
+        /// <param name="target">The target view.</param>
+        public static void Copy<T>(
+            AcceleratorStream sourceStream,
+            ArrayView<T> source,
+            AcceleratorStream targetStream,
+            ArrayView<T> target)
+            where T : unmanaged
+        {
+            if (sourceStream is null)
+                throw new ArgumentNullException(nameof(sourceStream));
+            if (targetStream is null)
+                throw new ArgumentNullException(nameof(targetStream));
+            if (source.Length != target.Length)
+                throw new ArgumentOutOfRangeException(nameof(target));
+            if (source.HasNoData())
+                return;
+
+            var sourceAccelerator = sourceStream.Accelerator;
+            var targetAccelerator = targetStream.Accelerator;
+            if (sourceAccelerator == targetAccelerator ||
+                targetAccelerator.AcceleratorType == AcceleratorType.CPU)
+            {
+                source.CopyTo(sourceStream, target);
+                sourceStream.Synchronize();
+            }
+            else if (sourceAccelerator.AcceleratorType == AcceleratorType.CPU ||
+                sourceAccelerator.HasPeerAccess(targetAccelerator))
+            {
+                source.CopyTo(targetStream, target);
+                targetStream.Synchronize();
+            }
+            else
+            {
+                var staging = source.GetAsArray(sourceStream);
+                target.CopyFromCPU(targetStream, new ReadOnlySpan<T>(staging));
+            }
+        }
+
+        #endregion
+
+        #region Instance
+
+        private readonly ImmutableArray<AcceleratorStream> streams;
+
+        /// <summary>
+        /// Constructs a new multi accelerator that distributes work according to the
+        /// throughput of all accelerators.
+        /// </summary>
+        /// <param name="accelerators">The accelerators to use.</param>
+        public MultiAccelerator(IEnumerable<Accelerator> accelerators)
+            : this(accelerators, MultiAcceleratorWeighting.Throughput)
+        { }
+
+        /// <summary>
+        /// Constructs a new multi accelerator.
+        /// </summary>
+        /// <param name="accelerators">The accelerators to use.</param>
+        /// <param name="weighting">The weighting kind.</param>
+        public MultiAccelerator(
+            IEnumerable<Accelerator> accelerators,
+            MultiAcceleratorWeighting weighting)
+            : this(
+                  accelerators,
+                  accelerators?.Select(t => GetWeight(t, weighting)))
+        { }
+
+        /// <summary>
+        /// Constructs a new multi accelerator.
+        /// </summary>
+        /// <param name="accelerators">The accelerators to use.</param>
+        /// <param name="weights">The relative weight of each accelerator.</param>
+        public MultiAccelerator(
+            IEnumerable<Accelerator> accelerators,
+            IEnumerable<double> weights)
+        {
+            if (accelerators is null)
+                throw new ArgumentNullException(nameof(accelerators));
+            if (weights is null)
+                throw new ArgumentNullException(nameof(weights));
+
+            Accelerators = accelerators.ToImmutableArray();
+            Weights = weights.ToImmutableArray();
+            if (Accelerators.Length < 1 || Accelerators.Any(t => t is null))
+                throw new ArgumentOutOfRangeException(nameof(accelerators));
+            if (Weights.Length != Accelerators.Length ||
+                Weights.Any(t => !(t > 0.0) || double.IsInfinity(t)))
+            {
+                throw new ArgumentOutOfRangeException(nameof(weights));
+            }
+
+            streams = Accelerators.Select(t => t.CreateStream()).ToImmutableArray();
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Returns all accelerators.
+        /// </summary>
+        public ImmutableArray<Accelerator> Accelerators { get; }
+
+        /// <summary>
+        /// Returns the relative weight of each accelerator.
+        /// </summary>
+        public ImmutableArray<double> Weights { get; }
+
+        /// <summary>
+        /// Returns the number of accelerators.
+        /// </summary>
+        public int Count => Accelerators.Length;
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Enables peer access between all pairs of accelerators that support it.
+        /// </summary>
+        /// <returns>The number of enabled peer connections.</returns>
+        public int EnablePeerAccess()
+        {
+            int count = 0;
+            foreach (var accelerator in Accelerators)
+            {
+                foreach (var other in Accelerators)
+                {
+                    if (accelerator != other &&
+                        accelerator.CanAccessPeer(other) &&
+                        accelerator.EnablePeerAccess(other))
+                    {
+                        ++count;
+                    }
+                }
+            }
+            return count;
+        }
+
+        /// <summary>
+        /// Returns a partition that covers the given range.
+        /// </summary>
+        private AcceleratorPartition GetPartition(
+            int index,
+            long offset,
+            long length,
+            long rowLength = 1) =>
+            new AcceleratorPartition(
+                index,
+                Accelerators[index],
+                streams[index],
+                offset,
+                length,
+                rowLength);
+
+        /// <summary>
+        /// Splits the given 1D index space into one partition per accelerator.
+        /// </summary>
+        /// <param name="length">The number of elements.</param>
+        /// <returns>All partitions in ascending order.</returns>
+        public ImmutableArray<AcceleratorPartition> Partition(long length) =>
+            Partition(length, 1);
+
+        /// <summary>
+        /// Splits the given 1D index space into one partition per accelerator. The
+        /// offsets of all partitions are multiples of the given alignment.
+        /// </summary>
+        /// <param name="length">The number of elements.</param>
+        /// <param name="alignment">The partition alignment in elements.</param>
+        /// <returns>All partitions in ascending order.</returns>
+        public ImmutableArray<AcceleratorPartition> Partition(
+            long length,
+            int alignment) =>
+            Partition(length, alignment, 1);
+
+        /// <summary>
+        /// Splits the given index space of rows into one partition per accelerator.
+        /// </summary>
+        /// <param name="length">The number of rows.</param>
+        /// <param name="alignment">The partition alignment in rows.</param>
+        /// <param name="rowLength">The number of elements per row.</param>
+        /// <returns>All partitions in ascending order.</returns>
+        private ImmutableArray<AcceleratorPartition> Partition(
+            long length,
+            int alignment,
+            long rowLength)
+        {
+            if (length < 0)
+                throw new ArgumentOutOfRangeException(nameof(length));
+            if (alignment < 1)
+                throw new ArgumentOutOfRangeException(nameof(alignment));
+
+            double totalWeight = Weights.Sum();
+            double accumulatedWeight = 0.0;
+            var result = ImmutableArray.CreateBuilder<AcceleratorPartition>(Count);
+            long offset = 0;
+            for (int i = 0; i < Count; ++i)
+            {
+                accumulatedWeight += Weights[i];
+                long end = length;
+                if (i + 1 < Count)
+                {
+                    end = (long)(length * (accumulatedWeight / totalWeight));
+                    end = Math.Max(Math.Min(end / alignment * alignment, length), offset);
+                }
+                result.Add(GetPartition(i, offset, end - offset, rowLength));
+                offset = end;
+            }
+            return result.MoveToImmutable();
+        }
+
+        /// <summary>
+        /// Splits the given 2D index space into one partition per accelerator. The
+        /// index space is split along the Y dimension; the offsets and lengths of all
+        /// partitions are measured in rows and each partition spans the whole X
+        /// dimension (see <see cref="AcceleratorPartition.Extent2D"/>).
+        /// </summary>
+        /// <param name="extent">The 2D extent.</param>
+        /// <returns>All partitions in ascending order.</returns>
+        public ImmutableArray<AcceleratorPartition> Partition(LongIndex2D extent)
+        {
+            if (extent.X < 0)
+                throw new ArgumentOutOfRangeException(nameof(extent));
+            return Partition(extent.Y, 1, extent.X);
+        }
+
+        /// <summary>
+        /// Invokes the given body concurrently for each partition of the given index
+        /// space and waits for all accelerators to finish.
+        /// </summary>
+        /// <param name="length">The number of elements.</param>
+        /// <param name="body">
+        /// The body that launches the work of a single partition.
+        /// </param>
+        public void Run(long length, Action<AcceleratorPartition> body) =>
+            Run(Partition(length), body);
+
+        /// <summary>
+        /// Invokes the given body concurrently for each of the given partitions and
+        /// waits for all accelerators to finish.
+        /// </summary>
+        /// <param name="partitions">The partitions to process.</param>
+        /// <param name="body">
+        /// The body that launches the work of a single partition.
+        /// </param>
+        public void Run(
+            ImmutableArray<AcceleratorPartition> partitions,
+            Action<AcceleratorPartition> body)
+        {
+            if (body is null)
+                throw new ArgumentNullException(nameof(body));
+            Parallel.ForEach(partitions, partition =>
+            {
+                if (partition.NumElements > 0)
+                    body(partition);
+                partition.Stream.Synchronize();
+            });
+        }
+
+        /// <summary>
+        /// Processes the given index space in chunks of the given length. Each
+        /// accelerator claims the next unprocessed chunk as soon as it has finished
+        /// its previous one, which balances the load dynamically.
+        /// </summary>
+        /// <param name="length">The number of elements.</param>
+        /// <param name="chunkLength">The number of elements per chunk.</param>
+        /// <param name="body">The body that launches the work of a single chunk.</param>
+        public void RunDynamic(
+            long length,
+            long chunkLength,
+            Action<AcceleratorPartition> body)
+        {
+            if (length < 0)
+                throw new ArgumentOutOfRangeException(nameof(length));
+            if (chunkLength < 1)
+                throw new ArgumentOutOfRangeException(nameof(chunkLength));
+            if (body is null)
+                throw new ArgumentNullException(nameof(body));
+
+            long nextOffset = 0;
+            Parallel.For(0, Count, index =>
+            {
+                while (true)
+                {
+                    long offset = Interlocked.Add(ref nextOffset, chunkLength) -
+                        chunkLength;
+                    if (offset >= length)
+                        break;
+                    var chunk = GetPartition(
+                        index,
+                        offset,
+                        Math.Min(chunkLength, length - offset));
+                    body(chunk);
+
+                    // Wait for this chunk before claiming the next one
+                    chunk.Stream.Synchronize();
+                }
+            });
+        }
+
+        /// <summary>
+        /// Allocates one buffer per partition that holds the elements of the
+        /// partition on its accelerator.
+        /// </summary>
+        /// <typeparam name="T">The element type.</typeparam>
+        /// <param name="partitions">The partitions.</param>
+        /// <returns>The allocated buffers.</returns>
+        public MultiMemoryBuffer<T> Allocate<T>(
+            ImmutableArray<AcceleratorPartition> partitions)
+            where T : unmanaged =>
+            new MultiMemoryBuffer<T>(
+                partitions,
+                partitions.Select(t => t.NumElements));
+
+        /// <summary>
+        /// Allocates a buffer of the given length on each accelerator.
+        /// </summary>
+        /// <typeparam name="T">The element type.</typeparam>
+        /// <param name="length">The number of elements per accelerator.</param>
+        /// <returns>The allocated buffers.</returns>
+        public MultiMemoryBuffer<T> AllocateReplicated<T>(long length)
+            where T : unmanaged
+        {
+            if (length < 0)
+                throw new ArgumentOutOfRangeException(nameof(length));
+            var partitions = Enumerable.Range(0, Count).Select(t =>
+                GetPartition(t, 0L, length)).ToImmutableArray();
+            return new MultiMemoryBuffer<T>(partitions, partitions.Select(_ => length));
+        }
+
+        /// <summary>
+        /// Waits for all accelerators to finish.
+        /// </summary>
+        public void Synchronize()
+        {
+            foreach (var stream in streams)
+                stream.Synchronize();
+        }
+
+        #endregion
+
+        #region IDisposable
+
+        /// <inheritdoc/>
+        protected override void Dispose(bool disposing)
+        {
+            if (disposing)
+            {
+                foreach (var stream in streams)
+                    stream.Dispose();
+            }
+            base.Dispose(disposing);
+        }
+
+        #endregion
+    }
+
+    /// <summary>
+    /// Represents a set of buffers that live on the accelerators of a
+    /// <see cref="MultiAccelerator"/>.
+    /// </summary>
+    /// <typeparam name="T">The element type.</typeparam>
+    public sealed class MultiMemoryBuffer<T> : DisposeBase
+        where T : unmanaged
+    {
+        #region Instance
+
+        private readonly ImmutableArray<MemoryBuffer1D<T, Stride1D.Dense>> buffers;
+
+        /// <summary>
+        /// Allocates a buffer for each partition.
+        /// </summary>
+        /// <param name="partitions">The partitions.</param>
+        /// <param name="lengths">The buffer length of each partition.</param>
+        internal MultiMemoryBuffer(
+            ImmutableArray<AcceleratorPartition> partitions,
+            IEnumerable<long> lengths)
+        {
+            Partitions = partitions;
+            buffers = partitions.Zip(lengths, (partition, length) =>
+                partition.Accelerator.Allocate1D<T>(length)).ToImmutableArray();
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Returns the partitions of all buffers.
+        /// </summary>
+        public ImmutableArray<AcceleratorPartition> Partitions { get; }
+
+        /// <summary>
+        /// Returns the number of buffers.
+        /// </summary>
+        public int Count => buffers.Length;
+
+        /// <summary>
+        /// Returns the view of the buffer with the given partition index.
+        /// </summary>
+        /// <param name="index">The partition index.</param>
+        /// <returns>The view of the buffer of the given partition.</returns>
+        public ArrayView1D<T, Stride1D.Dense> this[int index] => buffers[index].View;
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Returns the view of the buffer that belongs to the given partition.
+        /// </summary>
+        /// <param name="partition">The partition.</param>
+        /// <returns>The view of the buffer of the given partition.</returns>
+        public ArrayView1D<T, Stride1D.Dense> GetView(AcceleratorPartition partition) =>
+            this[partition.Index];
+
+        /// <summary>
+        /// Distributes the given data among all buffers: each buffer receives the
+        /// elements of its partition.
+        /// </summary>
+        /// <param name="data">The source data.</param>
+        public void Scatter(ReadOnlySpan<T> data)
+        {
+            for (int i = 0; i < Count; ++i)
+            {
+                var partition = Partitions[i];
+                var view = buffers[i].View.AsContiguous();
+                view.CopyFromCPU(
+                    partition.Stream,
+                    data.Slice(
+                        checked((int)partition.ElementOffset),
+                        checked((int)view.Length)));
+            }
+        }
+
+        /// <summary>
+        /// Concatenates the contents of all buffers according to their partitions.
+        /// </summary>
+        /// <param name="data">The target data.</param>
+        public void Gather(Span<T> data)
+        {
+            for (int i = 0; i < Count; ++i)
+            {
+                var partition = Partitions[i];
+                var view = buffers[i].View.AsContiguous();
+                view.CopyToCPU(
+                    partition.Stream,
+                    data.Slice(
+                        checked((int)partition.ElementOffset),
+                        checked((int)view.Length)));
+            }
+        }
+
+        /// <summary>
+        /// Combines the contents of all buffers element-wise on the host.
+        /// </summary>
+        /// <param name="data">
+        /// The target data, which receives the combined elements of the first
+        /// <paramref name="data"/>.Length elements of each buffer.
+        /// </param>
+        /// <param name="combine">The associative combination function.</param>
+        public void Reduce(Span<T> data, Func<T, T, T> combine)
+        {
+            if (combine is null)
+                throw new ArgumentNullException(nameof(combine));
+
+            var temp = new T[data.Length];
+            for (int i = 0; i < Count; ++i)
+            {
+                var view = buffers[i].View.AsContiguous().SubView(0, data.Length);
+                if (i < 1)
+                {
+                    view.CopyToCPU(Partitions[i].Stream, data);
+                    continue;
+                }
+                view.CopyToCPU(Partitions[i].Stream, new Span<T>(temp));
+                for (int j = 0; j < data.Length; ++j)
+                    data[j] = combine(data[j], temp[j]);
+            }
+        }
+
+        /// <summary>
+        /// Copies a range of the buffer of one partition to the buffer of another
+        /// partition using peer or host-staged transfers.
+        /// </summary>
+        /// <param name="sourceIndex">The source partition index.</param>
+        /// <param name="sourceOffset">The element offset in the source buffer.</param>
+        /// <param name="targetIndex">The target partition index.</param>
+        /// <param name="targetOffset">The element offset in the target buffer.</param>
+        /// <param name="length">The number of elements to copy.</param>
+        public void Exchange(
+            int sourceIndex,
+            long sourceOffset,
+            int targetIndex,
+            long targetOffset,
+            long length) =>
+            MultiAccelerator.Copy(
+                Partitions[sourceIndex].Stream,
+                buffers[sourceIndex].View.AsContiguous().SubView(sourceOffset, length),
+                Partitions[targetIndex].Stream,
+                buffers[targetIndex].View.AsContiguous().SubView(targetOffset, length));
+
+        #endregion
+
+        #region IDisposable
+
+        /// <inheritdoc/>
+        protected override void Dispose(bool disposing)
+        {
+            if (disposing)
+            {
+                foreach (var buffer in buffers)
+                    buffer.Dispose();
+            }
+            base.Dispose(disposing);
+        }
+
+        #endregion
+    }
+}
@@ -0,0 +1,720 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: RemoteAccelerator.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.Backends;
+using ILGPU.Backends.EntryPoints;
+using ILGPU.Backends.IL;
+using ILGPU.Backends.Remote;
+using ILGPU.Resources;
+using System;
+using System.Diagnostics;
+using System.IO;
+using System.Reflection;
+using System.Reflection.Emit;
+using System.Text;
+
+namespace ILGPU.Runtime.Remote
+{
+    /// <summary>
+    /// Represents an accelerator that is hosted by a <see cref="RemoteWorker"/> in
+    /// another process or on another node.
+    /// </summary>
+    /// <remarks>
+    /// Kernels are compiled into serialized ILGPU IR by the
+    /// <see cref="RemoteBackend"/> and translated by the worker using the backend
+    /// of its local accelerator. All commands except reads, kernel loads and
+    /// synchronizations are sent without waiting for a response, which pipelines
+    /// transfers and launches. Errors of pipelined commands are reported by the
+    /// next command that produces a response.
+    /// </remarks>
+    public sealed class RemoteAccelerator : Accelerator
+    {
+        #region Static
+
+        /// <summary>
+        /// All generic n-D view types that are sent as strided views.
+        /// </summary>
+        private static readonly Type[] StridedViewTypes =
+        {
+            typeof(ArrayView1D<,>),
+            typeof(ArrayView2D<,>),
+            typeof(ArrayView3D<,>),
+        };
+
+        /// <summary>
+        /// Returns true if the given type is an n-D view type.
+        /// </summary>
+        /// <param name="type">The type to test.</param>
+        /// <returns>True, if the given type is an n-D view type.</returns>
+        internal static bool IsStridedViewType(Type type) =>
+            type.IsGenericType &&
+            Array.IndexOf(StridedViewTypes, type.GetGenericTypeDefinition()) >= 0;
+
+        #endregion
+
+        #region Instance
+
+        /// <summary>
+        /// Synchronizes all accesses to the connection.
+        /// </summary>
+        private readonly object connectionLock = new object();
+
+        private readonly byte[] chunk = new byte[RemoteProtocol.ChunkSize];
+        private BinaryReader reader;
+        private BinaryWriter writer;
+        private int nextBufferId;
+        private int nextKernelId;
+
+        /// <summary>
+        /// Constructs a new remote accelerator that takes ownership of the
+        /// connection of the given device.
+        /// </summary>
+        /// <param name="context">The ILGPU context.</param>
+        /// <param name="device">The connected remote device.</param>
+        internal RemoteAccelerator(Context context, RemoteDevice device)
+            : base(context, device)
+        {
+            device.TakeConnection(out reader, out writer);
+            NativePtr = new IntPtr(1);
+
+            DefaultStream = CreateStream();
+
+            Bind();
+            Init(new RemoteBackend(context, device.Capabilities));
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Returns the parent remote device.
+        /// </summary>
+        public new RemoteDevice Device => base.Device as RemoteDevice;
+
+        /// <summary>
+        /// Returns the type of the accelerator hosted by the worker.
+        /// </summary>
+        public AcceleratorType RemoteAcceleratorType => Device.RemoteAcceleratorType;
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Remote accelerators do not support extensions.
+        /// </summary>
+        public override TExtension CreateExtension<
+            TExtension,
+            TExtensionProvider>(TExtensionProvider provider) =>
+            throw new NotSupportedException(
+                RuntimeErrorMessages.NotSupportedRemoteAcceleratorExtension);
+
+        /// <inheritdoc/>
+        protected override MemoryBuffer AllocateRawInternal(
+            long length,
+            int elementSize)
+        {
+            lock (connectionLock)
+            {
+                int id = ++nextBufferId;
+                BeginCommand(RemoteCommand.Allocate);
+                writer.Write(id);
+                writer.Write(length * elementSize);
+                return new RemoteMemoryBuffer(this, id, length, elementSize);
+            }
+        }
+
+        /// <summary>
+        /// Loads a default kernel.
+        /// </summary>
+        protected override Kernel LoadKernelInternal(CompiledKernel kernel) =>
+            LoadKernel(kernel, RemoteKernelMode.Default, 0, out var _);
+
+        /// <summary>
+        /// Loads an implicitly grouped kernel.
+        /// </summary>
+        protected override Kernel LoadImplicitlyGroupedKernelInternal(
+            CompiledKernel kernel,
+            int customGroupSize,
+            out KernelInfo kernelInfo)
+        {
+            if (customGroupSize < 0 || customGroupSize > MaxNumThreadsPerGroup)
+                throw new ArgumentOutOfRangeException(nameof(customGroupSize));
+            var result = LoadKernel(
+                kernel,
+                RemoteKernelMode.ImplicitlyGrouped,
+                customGroupSize,
+                out var remoteInfo);
+            kernelInfo = KernelInfo.CreateFrom(
+                kernel.Info,
+                remoteInfo.MinGroupSize,
+                null);
+            return result;
+        }
+
+        /// <summary>
+        /// Loads an auto grouped kernel.
+        /// </summary>
+        protected override Kernel LoadAutoGroupedKernelInternal(
+            CompiledKernel kernel,
+            out KernelInfo kernelInfo)
+        {
+            var result = LoadKernel(
+                kernel,
+                RemoteKernelMode.AutoGrouped,
+                0,
+                out var remoteInfo);
+            kernelInfo = KernelInfo.CreateFrom(
+                kernel.Info,
+                remoteInfo.MinGroupSize,
+                remoteInfo.MinGridSize);
+            return result;
+        }
+
+        /// <summary>
+        /// Sends the given kernel to the worker, which compiles and loads it using
+        /// its local accelerator.
+        /// </summary>
+        /// <param name="kernel">The kernel to load.</param>
+        /// <param name="mode">The load mode.</param>
+        /// <param name="customGroupSize">The custom group size.</param>
+        /// <param name="kernelInfo">The kernel information of the worker.</param>
+        /// <returns>The loaded kernel.</returns>
+        private Kernel LoadKernel(
+            CompiledKernel kernel,
+            RemoteKernelMode mode,
+            int customGroupSize,
+            out KernelInfo kernelInfo)
+        {
+            if (kernel == null)
+                throw new ArgumentNullException(nameof(kernel));
+            if (!(kernel is RemoteCompiledKernel remoteKernel))
+            {
+                throw new NotSupportedException(
+                    RuntimeErrorMessages.NotSupportedKernel);
+            }
+            var entryPoint = kernel.EntryPoint;
+            if (mode != RemoteKernelMode.Default && entryPoint.IsExplicitlyGrouped)
+            {
+                throw new NotSupportedException(
+                    RuntimeErrorMessages.NotSupportedExplicitlyGroupedKernel);
+            }
+            if (remoteKernel.IRData.Length > RemoteProtocol.MaxKernelSize)
+            {
+                throw new NotSupportedException(string.Format(
+                    RuntimeErrorMessages.RemoteKernelTooLarge,
+                    entryPoint.Name,
+                    RemoteProtocol.MaxKernelSize));
+            }
+            var launcher = GenerateKernelLauncherMethod(entryPoint);
+
+            lock (connectionLock)
+            {
+                int id = ++nextKernelId;
+                BeginCommand(RemoteCommand.LoadKernel);
+                writer.Write(id);
+                writer.Write((byte)mode);
+                writer.Write(entryPoint.IsExplicitlyGrouped);
+                writer.Write(customGroupSize);
+                writer.Write(entryPoint.Specialization.MaxNumThreadsPerGroup ?? 0);
+                writer.Write(
+                    entryPoint.Specialization.MinNumGroupsPerMultiprocessor ?? 0);
+                remoteKernel.WriteIR(writer);
+                writer.Flush();
+
+                ReadStatus();
+                int groupSize = reader.ReadInt32();
+                int minGridSize = reader.ReadInt32();
+                kernelInfo = new KernelInfo(groupSize, minGridSize);
+                return new RemoteKernel(this, kernel, launcher, id);
+            }
+        }
+
+        /// <summary cref="Accelerator.CreateStreamInternal()"/>
+        protected override AcceleratorStream CreateStreamInternal() =>
+            new RemoteStream(this);
+
+        /// <summary cref="Accelerator.Synchronize"/>
+        protected override void SynchronizeInternal() => SynchronizeWorker();
+
+        /// <summary cref="Accelerator.OnBind"/>
+        protected override void OnBind() { }
+
+        /// <summary cref="Accelerator.OnUnbind"/>
+        protected override void OnUnbind() { }
+
+        #endregion
+
+        #region Peer Access
+
+        /// <summary cref="Accelerator.CanAccessPeerInternal(Accelerator)"/>
+        protected override bool CanAccessPeerInternal(Accelerator otherAccelerator) =>
+            false;
+
+        /// <summary cref="Accelerator.EnablePeerAccessInternal(Accelerator)"/>
+        protected override void EnablePeerAccessInternal(
+            Accelerator otherAccelerator) =>
+            throw new InvalidOperationException(
+                RuntimeErrorMessages.CannotEnablePeerAccessToOtherAccelerator);
+
+        /// <summary cref="Accelerator.DisablePeerAccess(Accelerator)"/>
+        protected override void DisablePeerAccessInternal(
+            Accelerator otherAccelerator) =>
+            Debug.Assert(false, "Invalid DisablePeerAccess method");
+
+        #endregion
+
+        #region Launch Methods
+
+        /// <summary>
+        /// Generates a dynamic kernel-launcher method that boxes all arguments and
+        /// forwards them to <see cref="RemoteKernel.Launch(RemoteStream, object,
+        /// object[])"/>.
+        /// </summary>
+        /// <param name="entryPoint">The entry point.</param>
+        /// <returns>The generated launcher method.</returns>
+        private MethodInfo GenerateKernelLauncherMethod(EntryPoint entryPoint)
+        {
+            if (entryPoint.HasByRefParameters)
+            {
+                throw new NotSupportedException(
+                    ErrorMessages.NotSupportedByRefKernelParameters);
+            }
+
+            using var scopedLock = entryPoint.CreateLauncherMethod(
+                Context.RuntimeSystem,
+                out var launcher);
+            var emitter = new ILEmitter(launcher.ILGenerator);
+
+            // Load kernel, stream and the boxed dimension
+            KernelLauncherBuilder.EmitLoadKernelArgument<RemoteKernel, ILEmitter>(
+                Kernel.KernelInstanceParamIdx, emitter);
+            KernelLauncherBuilder.EmitLoadAcceleratorStream<RemoteStream, ILEmitter>(
+                Kernel.KernelStreamParamIdx, emitter);
+            emitter.Emit(ArgumentOperation.Load, Kernel.KernelParamDimensionIdx);
+            emitter.Emit(OpCodes.Box, entryPoint.KernelIndexType);
+
+            // Box all parameters
+            var parameters = entryPoint.Parameters;
+            emitter.EmitConstant(parameters.Count);
+            emitter.Emit(OpCodes.Newarr, typeof(object));
+            for (int i = 0, e = parameters.Count; i < e; ++i)
+            {
+                emitter.Emit(OpCodes.Dup);
+                emitter.EmitConstant(i);
+                emitter.Emit(ArgumentOperation.Load, i + Kernel.KernelParameterOffset);
+                emitter.Emit(OpCodes.Box, parameters[i]);
+                emitter.Emit(OpCodes.Stelem_Ref);
+            }
+
+            // Launch kernel: ((RemoteKernel)kernel).Launch(stream, dim, args);
+            emitter.EmitCall(RemoteKernel.LaunchMethod);
+
+            // End of launch method
+            emitter.Emit(OpCodes.Ret);
+            emitter.Finish();
+
+            return launcher.Finish();
+        }
+
+        #endregion
+
+        #region Remote Methods
+
+        /// <summary>
+        /// Writes the given command.
+        /// </summary>
+        private void BeginCommand(RemoteCommand command)
+        {
+            if (writer is null)
+                throw new ObjectDisposedException(nameof(RemoteAccelerator));
+            writer.Write((byte)command);
+        }
+
+        /// <summary>
+        /// Reads a status and throws an exception in case of an error.
+        /// </summary>
+        private void ReadStatus()
+        {
+            switch (reader.ReadByte())
+            {
+                case RemoteProtocol.StatusOk:
+                    return;
+                case RemoteProtocol.StatusError:
+                    throw new RemoteException(
+                        RemoteAcceleratorType,
+                        reader.ReadString());
+                default:
+                    throw new InvalidDataException(string.Format(
+                        RuntimeErrorMessages.InvalidRemoteProtocol,
+                        RemoteProtocol.Version));
+            }
+        }
+
+        /// <summary>
+        /// Frees the remote buffer or kernel with the given id.
+        /// </summary>
+        /// <param name="command">The free command.</param>
+        /// <param name="id">The buffer or kernel id.</param>
+        internal void Free(RemoteCommand command, int id)
+        {
+            lock (connectionLock)
+            {
+                if (writer is null)
+                    return;
+                try
+                {
+                    writer.Write((byte)command);
+                    writer.Write(id);
+                }
+                catch (IOException)
+                {
+                    // The worker has already been disconnected
+                }
+            }
+        }
+
+        /// <summary>
+        /// Sets a range of the remote buffer with the given id to a byte value.
+        /// </summary>
+        internal void MemSet(
+            int id,
+            long offsetInBytes,
+            long lengthInBytes,
+            byte value)
+        {
+            lock (connectionLock)
+            {
+                BeginCommand(RemoteCommand.MemSet);
+                writer.Write(id);
+                writer.Write(offsetInBytes);
+                writer.Write(lengthInBytes);
+                writer.Write(value);
+            }
+        }
+
+        /// <summary>
+        /// Sends the given CPU data to the remote buffer with the given id.
+        /// </summary>
+        internal unsafe void Write(
+            int id,
+            long offsetInBytes,
+            byte* source,
+            long lengthInBytes)
+        {
+            lock (connectionLock)
+            {
+                while (lengthInBytes > 0)
+                {
+                    int count = (int)Math.Min(lengthInBytes, chunk.Length);
+                    new ReadOnlySpan<byte>(source, count).CopyTo(chunk);
+                    BeginCommand(RemoteCommand.Write);
+                    writer.Write(id);
+                    writer.Write(offsetInBytes);
+                    writer.Write(count);
+                    writer.Write(chunk, 0, count);
+
+                    source += count;
+                    offsetInBytes += count;
+                    lengthInBytes -= count;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Receives data from the remote buffer with the given id.
+        /// </summary>
+        internal unsafe void Read(
+            int id,
+            long offsetInBytes,
+            byte* target,
+            long lengthInBytes)
+        {
+            lock (connectionLock)
+            {
+                BeginCommand(RemoteCommand.Read);
+                writer.Write(id);
+                writer.Write(offsetInBytes);
+                writer.Write(lengthInBytes);
+                writer.Flush();
+
+                while (lengthInBytes > 0)
+                {
+                    ReadStatus();
+                    int count = RemoteProtocol.ReadLength(
+                        reader,
+                        (int)Math.Min(lengthInBytes, chunk.Length),
+                        RemoteCommand.Read);
+                    if (count < 1)
+                        throw RemoteProtocol.GetInvalidMessageException(
+                            RemoteCommand.Read);
+                    RemoteProtocol.ReadExactly(reader, chunk, count);
+                    new ReadOnlySpan<byte>(chunk, 0, count).CopyTo(
+                        new Span<byte>(target, count));
+
+                    target += count;
+                    lengthInBytes -= count;
+                }
+                ReadStatus();
+            }
+        }
+
+        /// <summary>
+        /// Copies data between two remote buffers.
+        /// </summary>
+        internal void Copy(
+            int sourceId,
+            long sourceOffsetInBytes,
+            int targetId,
+            long targetOffsetInBytes,
+            long lengthInBytes)
+        {
+            lock (connectionLock)
+            {
+                BeginCommand(RemoteCommand.Copy);
+                writer.Write(sourceId);
+                writer.Write(sourceOffsetInBytes);
+                writer.Write(targetId);
+                writer.Write(targetOffsetInBytes);
+                writer.Write(lengthInBytes);
+            }
+        }
+
+        /// <summary>
+        /// Serializes a kernel launch.
+        /// </summary>
+        /// <param name="kernel">The kernel to launch.</param>
+        /// <param name="stream">The remote stream.</param>
+        /// <param name="dimension">The boxed kernel dimension.</param>
+        /// <param name="args">The boxed kernel arguments.</param>
+        internal void Launch(
+            RemoteKernel kernel,
+            RemoteStream stream,
+            object dimension,
+            object[] args)
+        {
+            if (stream.Accelerator != this)
+            {
+                throw new NotSupportedException(
+                    RuntimeErrorMessages.NotSupportedAcceleratorStream);
+            }
+
+            // Serialize all arguments first to avoid partially written commands
+            using var payload = new MemoryStream();
+            using (var payloadWriter = new BinaryWriter(payload, Encoding.UTF8, true))
+            {
+                RemoteProtocol.WriteBytes(
+                    payloadWriter,
+                    RemoteProtocol.Serialize(dimension));
+                payloadWriter.Write(args.Length);
+                foreach (var arg in args)
+                    WriteArgument(payloadWriter, arg);
+            }
+
+            lock (connectionLock)
+            {
+                BeginCommand(RemoteCommand.Launch);
+                writer.Write(kernel.Id);
+                writer.Write(payload.GetBuffer(), 0, (int)payload.Length);
+            }
+        }
+
+        /// <summary>
+        /// Serializes a single kernel argument.
+        /// </summary>
+        private void WriteArgument(BinaryWriter target, object arg)
+        {
+            if (IsStridedViewType(arg.GetType()))
+            {
+                target.Write(RemoteProtocol.StridedViewArgument);
+                WriteView(
+                    target,
+                    (IContiguousArrayView)GetViewProperty(
+                        arg,
+                        nameof(ArrayView1D<byte, Stride1D.Dense>.BaseView)));
+                WriteValue(
+                    target,
+                    GetViewProperty(
+                        arg,
+                        nameof(ArrayView1D<byte, Stride1D.Dense>.Extent)));
+                WriteValue(
+                    target,
+                    GetViewProperty(
+                        arg,
+                        nameof(ArrayView1D<byte, Stride1D.Dense>.Stride)));
+            }
+            else if (arg is IContiguousArrayView view)
+            {
+                target.Write(RemoteProtocol.ViewArgument);
+                WriteView(target, view);
+            }
+            else
+            {
+                target.Write(RemoteProtocol.ValueArgument);
+                WriteValue(target, arg);
+            }
+        }
+
+        /// <summary>
+        /// Returns the value of the given property of an n-D view.
+        /// </summary>
+        private static object GetViewProperty(object view, string propertyName) =>
+            view.GetType().GetProperty(propertyName).GetValue(view);
+
+        /// <summary>
+        /// Serializes a dense view of a remote buffer.
+        /// </summary>
+        private void WriteView(BinaryWriter target, IContiguousArrayView view)
+        {
+            if (!view.IsValid)
+            {
+                target.Write(0);
+                target.Write(0L);
+                target.Write(0L);
+                return;
+            }
+            if (!(view.Buffer is RemoteMemoryBuffer buffer) ||
+                buffer.Accelerator != this)
+            {
+                throw new NotSupportedException(
+                    RuntimeErrorMessages.NotSupportedTargetAccelerator);
+            }
+            target.Write(buffer.Id);
+            target.Write(view.IndexInBytes);
+            target.Write(view.LengthInBytes);
+        }
+
+        /// <summary>
+        /// Serializes an unmanaged value.
+        /// </summary>
+        private static void WriteValue(BinaryWriter target, object value)
+        {
+            var data = RemoteProtocol.Serialize(value);
+            if (data.Length > RemoteProtocol.MaxValueSize)
+            {
+                throw new NotSupportedException(string.Format(
+                    RuntimeErrorMessages.NotSupportedRemoteKernelArgument,
+                    value.GetType()));
+            }
+            RemoteProtocol.WriteBytes(target, data);
+        }
+
+        /// <summary>
+        /// Sends all pending commands and waits for the worker to finish them.
+        /// </summary>
+        internal void SynchronizeWorker()
+        {
+            lock (connectionLock)
+            {
+                BeginCommand(RemoteCommand.Synchronize);
+                writer.Flush();
+                ReadStatus();
+            }
+        }
+
+        #endregion
+
+        #region Occupancy
+
+        /// <summary>
+        /// Estimates a group size based on the description of the remote device.
+        /// </summary>
+        private int EstimateGroupSize(
+            Kernel kernel,
+            int maxGroupSize,
+            out int minGridSize)
+        {
+            if (!(kernel is RemoteKernel))
+                throw new NotSupportedException(RuntimeErrorMessages.NotSupportedKernel);
+
+            int groupSize = maxGroupSize > 0
+                ? Math.Min(maxGroupSize, MaxNumThreadsPerGroup)
+                : MaxNumThreadsPerGroup;
+            minGridSize = NumMultiprocessors *
+                Math.Max(MaxNumThreadsPerMultiprocessor / groupSize, 1);
+            return groupSize;
+        }
+
+        /// <summary cref="Accelerator.EstimateMaxActiveGroupsPerMultiprocessor(
+        /// Kernel, int, int)"/>
+        protected override int EstimateMaxActiveGroupsPerMultiprocessorInternal(
+            Kernel kernel,
+            int groupSize,
+            int dynamicSharedMemorySizeInBytes) =>
+            kernel is RemoteKernel
+            ? Math.Max(MaxNumThreadsPerMultiprocessor / groupSize, 1)
+            : throw new NotSupportedException(RuntimeErrorMessages.NotSupportedKernel);
+
+        /// <summary cref="Accelerator.EstimateGroupSizeInternal(
+        /// Kernel, Func{int, int}, int, out int)"/>
+        protected override int EstimateGroupSizeInternal(
+            Kernel kernel,
+            Func<int, int> computeSharedMemorySize,
+            int maxGroupSize,
+            out int minGridSize) =>
+            EstimateGroupSize(kernel, maxGroupSize, out minGridSize);
+
+        /// <summary cref="Accelerator.EstimateGroupSizeInternal(
+        /// Kernel, int, int, out int)"/>
+        protected override int EstimateGroupSizeInternal(
+            Kernel kernel,
+            int dynamicSharedMemorySizeInBytes,
+            int maxGroupSize,
+            out int minGridSize) =>
+            EstimateGroupSize(kernel, maxGroupSize, out minGridSize);
+
+        #endregion
+
+        #region Page Lock Scope
+
+        /// <inheritdoc/>
+        protected override PageLockScope<T> CreatePageLockFromPinnedInternal<T>(
+            IntPtr pinned,
+            long numElements)
+        {
+            Trace.WriteLine(RuntimeErrorMessages.NotSupportedPageLock);
+            return new NullPageLockScope<T>(this, pinned, numElements);
+        }
+
+        #endregion
+
+        #region IDisposable
+
+        /// <summary>
+        /// Shuts the remote worker down and releases the connection.
+        /// </summary>
+        protected override void DisposeAccelerator_SyncRoot(bool disposing)
+        {
+            if (!disposing)
+                return;
+
+            lock (connectionLock)
+            {
+                try
+                {
+                    writer.Write((byte)RemoteCommand.Shutdown);
+                    writer.Flush();
+                }
+                catch (IOException)
+                {
+                    // The worker has already been disconnected
+                }
+                reader.Dispose();
+                writer.Dispose();
+                reader = null;
+                writer = null;
+            }
+        }
+
+        #endregion
+    }
+}
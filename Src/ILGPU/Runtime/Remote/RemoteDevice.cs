@@ -0,0 +1,226 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: RemoteDevice.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.Resources;
+using System;
+using System.IO;
+using System.Text;
+
+namespace ILGPU.Runtime.Remote
+{
+    /// <summary>
+    /// Represents an accelerator that is hosted by a <see cref="RemoteWorker"/> in
+    /// another process or on another node.
+    /// </summary>
+    /// <remarks>
+    /// A remote device owns the connection to its worker. Hence, it can be used to
+    /// create a single accelerator only.
+    /// </remarks>
+    [DeviceType(AcceleratorType.Remote)]
+    public sealed class RemoteDevice : Device
+    {
+        #region Static
+
+        /// <summary>
+        /// Connects to the worker listening on the other end of the given transport.
+        /// </summary>
+        /// <param name="transport">
+        /// The bidirectional transport stream (e.g. a pipe or a network stream).
+        /// </param>
+        /// <returns>The remote device describing the accelerator of the worker.</returns>
+        public static RemoteDevice Connect(Stream transport)
+        {
+            if (transport is null)
+                throw new ArgumentNullException(nameof(transport));
+
+            var reader = new BinaryReader(transport, Encoding.UTF8, leaveOpen: true);
+            var writer = new BinaryWriter(
+                new BufferedStream(transport, RemoteProtocol.ChunkSize),
+                Encoding.UTF8,
+                leaveOpen: true);
+            try
+            {
+                return RemoteProtocol.ReadHandshake(reader, writer);
+            }
+            catch
+            {
+                reader.Dispose();
+                writer.Dispose();
+                throw;
+            }
+        }
+
+        /// <summary>
+        /// Writes the description of the given worker accelerator.
+        /// </summary>
+        /// <param name="writer">The target writer.</param>
+        /// <param name="accelerator">The accelerator of the worker.</param>
+        internal static void Write(BinaryWriter writer, Accelerator accelerator)
+        {
+            writer.Write((int)accelerator.AcceleratorType);
+            writer.Write(accelerator.Name);
+            writer.Write(accelerator.MemorySize);
+            WriteIndex(writer, accelerator.MaxGridSize);
+            WriteIndex(writer, accelerator.MaxGroupSize);
+            writer.Write(accelerator.MaxNumThreadsPerGroup);
+            writer.Write(accelerator.MaxSharedMemoryPerGroup);
+            writer.Write(accelerator.MaxConstantMemory);
+            writer.Write(accelerator.WarpSize);
+            writer.Write(accelerator.NumMultiprocessors);
+            writer.Write(accelerator.MaxNumThreadsPerMultiprocessor);
+            RemoteCapabilityContext.Write(writer, accelerator.Capabilities);
+        }
+
+        /// <summary>
+        /// Writes a 3D index.
+        /// </summary>
+        private static void WriteIndex(BinaryWriter writer, Index3D index)
+        {
+            writer.Write(index.X);
+            writer.Write(index.Y);
+            writer.Write(index.Z);
+        }
+
+        /// <summary>
+        /// Reads a 3D index with positive components.
+        /// </summary>
+        private static Index3D ReadIndex(BinaryReader reader) =>
+            new Index3D(
+                ReadPositive(reader),
+                ReadPositive(reader),
+                ReadPositive(reader));
+
+        /// <summary>
+        /// Reads a positive 32-bit integer.
+        /// </summary>
+        private static int ReadPositive(BinaryReader reader)
+        {
+            int value = reader.ReadInt32();
+            return value > 0 ? value : throw GetInvalidDeviceException();
+        }
+
+        /// <summary>
+        /// Creates an exception that reports a malformed device description.
+        /// </summary>
+        private static InvalidDataException GetInvalidDeviceException() =>
+            new InvalidDataException(string.Format(
+                RuntimeErrorMessages.InvalidRemoteMessage,
+                nameof(RemoteDevice)));
+
+        #endregion
+
+        #region Instance
+
+        private readonly object syncLock = new object();
+        private BinaryReader reader;
+        private BinaryWriter writer;
+
+        /// <summary>
+        /// Reads and validates the description of a worker accelerator.
+        /// </summary>
+        /// <param name="reader">The connected reader.</param>
+        /// <param name="writer">The connected writer.</param>
+        internal RemoteDevice(BinaryReader reader, BinaryWriter writer)
+        {
+            RemoteAcceleratorType = (AcceleratorType)reader.ReadInt32();
+            if (RemoteAcceleratorType < AcceleratorType.CPU ||
+                RemoteAcceleratorType >= AcceleratorType.Remote)
+            {
+                throw GetInvalidDeviceException();
+            }
+            Name = reader.ReadString();
+            MemorySize = reader.ReadInt64();
+            MaxGridSize = ReadIndex(reader);
+            MaxGroupSize = ReadIndex(reader);
+            MaxNumThreadsPerGroup = ReadPositive(reader);
+            MaxSharedMemoryPerGroup = reader.ReadInt32();
+            MaxConstantMemory = reader.ReadInt32();
+            WarpSize = ReadPositive(reader);
+            NumMultiprocessors = ReadPositive(reader);
+            MaxNumThreadsPerMultiprocessor = ReadPositive(reader);
+            if ((MemorySize | MaxSharedMemoryPerGroup | MaxConstantMemory) < 0)
+                throw GetInvalidDeviceException();
+            Capabilities = new RemoteCapabilityContext(reader);
+
+            this.reader = reader;
+            this.writer = writer;
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Returns the type of the accelerator hosted by the worker.
+        /// </summary>
+        public AcceleratorType RemoteAcceleratorType { get; }
+
+        /// <summary>
+        /// Returns the capabilities of the accelerator hosted by the worker.
+        /// </summary>
+        public new RemoteCapabilityContext Capabilities
+        {
+            get => base.Capabilities as RemoteCapabilityContext;
+            private set => base.Capabilities = value;
+        }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Transfers the ownership of the underlying connection to the caller.
+        /// </summary>
+        /// <param name="connectionReader">The connected reader.</param>
+        /// <param name="connectionWriter">The connected writer.</param>
+        internal void TakeConnection(
+            out BinaryReader connectionReader,
+            out BinaryWriter connectionWriter)
+        {
+            lock (syncLock)
+            {
+                if (reader is null)
+                {
+                    throw new InvalidOperationException(string.Format(
+                        RuntimeErrorMessages.RemoteDeviceInUse,
+                        Name));
+                }
+                connectionReader = reader;
+                connectionWriter = writer;
+                reader = null;
+                writer = null;
+            }
+        }
+
+        /// <inheritdoc/>
+        public override Accelerator CreateAccelerator(Context context) =>
+            CreateRemoteAccelerator(context);
+
+        /// <summary>
+        /// Creates a new remote accelerator that takes ownership of the connection.
+        /// </summary>
+        /// <param name="context">The ILGPU context.</param>
+        /// <returns>The created remote accelerator.</returns>
+        public RemoteAccelerator CreateRemoteAccelerator(Context context) =>
+            new RemoteAccelerator(context, this);
+
+        /// <inheritdoc/>
+        protected override void PrintGeneralInfo(TextWriter writer)
+        {
+            writer.Write("  Remote accelerator type:                 ");
+            writer.WriteLine(RemoteAcceleratorType.ToString());
+
+            base.PrintGeneralInfo(writer);
+        }
+
+        #endregion
+    }
+}
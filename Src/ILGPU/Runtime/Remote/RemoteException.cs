@@ -0,0 +1,106 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: RemoteException.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using System;
+using System.Runtime.Serialization;
+using System.Security.Permissions;
+
+namespace ILGPU.Runtime.Remote
+{
+    /// <summary>
+    /// Represents an error that occurred on a remote worker.
+    /// </summary>
+    [Serializable]
+    public sealed class RemoteException : AcceleratorException
+    {
+        #region Instance
+
+        /// <summary>
+        /// Constructs a new remote exception.
+        /// </summary>
+        public RemoteException() { }
+
+        /// <summary>
+        /// Constructs a new remote exception.
+        /// </summary>
+        /// <param name="message">The message that describes the error.</param>
+        public RemoteException(string message)
+            : base(message)
+        { }
+
+        /// <summary>
+        /// Constructs a new remote exception.
+        /// </summary>
+        /// <param name="acceleratorType">The type of the remote accelerator.</param>
+        /// <param name="message">The message that describes the error.</param>
+        public RemoteException(AcceleratorType acceleratorType, string message)
+            : base(message)
+        {
+            RemoteAcceleratorType = acceleratorType;
+        }
+
+        /// <summary>
+        /// Constructs a new remote exception.
+        /// </summary>
+        /// <param name="message">
+        /// The error message that explains the reason for the exception.
+        /// </param>
+        /// <param name="innerException">
+        /// The exception that is the cause of the current exception, or a null reference
+        /// if no inner exception is specified.
+        /// </param>
+        public RemoteException(string message, Exception innerException)
+            : base(message, innerException)
+        { }
+
+        /// <summary cref="Exception(SerializationInfo, StreamingContext)"/>
+        private RemoteException(SerializationInfo info, StreamingContext context)
+            : base(info, context)
+        {
+            RemoteAcceleratorType = (AcceleratorType)info.GetInt32(
+                nameof(RemoteAcceleratorType));
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Returns the type of the remote accelerator.
+        /// </summary>
+        public AcceleratorType RemoteAcceleratorType { get; }
+
+        /// <summary>
+        /// Returns the type of the remote accelerator.
+        /// </summary>
+        public override AcceleratorType AcceleratorType => RemoteAcceleratorType;
+
+        #endregion
+
+        #region Methods
+
+        /// <summary cref="Exception.GetObjectData(
+        /// SerializationInfo, StreamingContext)"/>
+#if !NET5_0_OR_GREATER
+        [SecurityPermission(SecurityAction.Demand, SerializationFormatter = true)]
+#endif
+        public override void GetObjectData(
+            SerializationInfo info,
+            StreamingContext context)
+        {
+            base.GetObjectData(info, context);
+
+            info.AddValue(nameof(RemoteAcceleratorType), (int)RemoteAcceleratorType);
+        }
+
+        #endregion
+    }
+}
@@ -0,0 +1,104 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: RemoteKernel.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.Backends;
+using System.Reflection;
+
+namespace ILGPU.Runtime.Remote
+{
+    /// <summary>
+    /// Represents a kernel that has been loaded by a remote worker.
+    /// </summary>
+    public sealed class RemoteKernel : Kernel
+    {
+        #region Static
+
+        /// <summary>
+        /// Represents the <see cref="Launch(RemoteStream, object, object[])"/>
+        /// method.
+        /// </summary>
+        internal static readonly MethodInfo LaunchMethod =
+            typeof(RemoteKernel).GetMethod(
+                nameof(Launch),
+                BindingFlags.NonPublic | BindingFlags.Instance,
+                null,
+                new[] { typeof(RemoteStream), typeof(object), typeof(object[]) },
+                null);
+
+        #endregion
+
+        #region Instance
+
+        /// <summary>
+        /// Constructs a new remote kernel.
+        /// </summary>
+        /// <param name="accelerator">The associated accelerator.</param>
+        /// <param name="kernel">The source kernel.</param>
+        /// <param name="launcher">The launcher method for the given kernel.</param>
+        /// <param name="id">The kernel id.</param>
+        internal RemoteKernel(
+            RemoteAccelerator accelerator,
+            CompiledKernel kernel,
+            MethodInfo launcher,
+            int id)
+            : base(accelerator, kernel, launcher)
+        {
+            Id = id;
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Returns the associated remote accelerator.
+        /// </summary>
+        public RemoteAccelerator RemoteAccelerator =>
+            Accelerator as RemoteAccelerator;
+
+        /// <summary>
+        /// Returns the kernel id.
+        /// </summary>
+        public int Id { get; }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Sends a launch of this kernel to the worker. This method is invoked by
+        /// the generated launcher.
+        /// </summary>
+        /// <param name="stream">The remote stream.</param>
+        /// <param name="dimension">The boxed kernel dimension.</param>
+        /// <param name="args">The boxed kernel arguments.</param>
+        internal void Launch(
+            RemoteStream stream,
+            object dimension,
+            object[] args) =>
+            RemoteAccelerator.Launch(this, stream, dimension, args);
+
+        #endregion
+
+        #region IDisposable
+
+        /// <summary>
+        /// Frees the kernel on the worker.
+        /// </summary>
+        protected override void DisposeAcceleratorObject(bool disposing)
+        {
+            if (disposing)
+                RemoteAccelerator.Free(RemoteCommand.FreeKernel, Id);
+        }
+
+        #endregion
+    }
+}
@@ -0,0 +1,226 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: RemoteMemoryBuffer.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.Resources;
+using System;
+
+namespace ILGPU.Runtime.Remote
+{
+    /// <summary>
+    /// Represents a buffer that lives in the memory of a remote accelerator.
+    /// </summary>
+    /// <remarks>
+    /// Remote buffers do not have a native pointer. They are identified by an id
+    /// that is unique within their parent accelerator.
+    /// </remarks>
+    public sealed class RemoteMemoryBuffer : MemoryBuffer
+    {
+        #region Static
+
+        /// <summary>
+        /// Returns true if the given view belongs to the given remote accelerator.
+        /// </summary>
+        private static bool IsRemoteView<T>(
+            in ArrayView<T> view,
+            RemoteAccelerator accelerator,
+            out RemoteMemoryBuffer buffer)
+            where T : unmanaged
+        {
+            buffer = view.Buffer as RemoteMemoryBuffer;
+            return buffer != null && buffer.Accelerator == accelerator;
+        }
+
+        /// <summary>
+        /// Performs a remote memset operation.
+        /// </summary>
+        /// <typeparam name="T">The element type.</typeparam>
+        /// <param name="stream">The remote stream to use (must not be null)</param>
+        /// <param name="value">The value to write into the buffer.</param>
+        /// <param name="targetView">The target view to write to.</param>
+        public static void RemoteMemSet<T>(
+            RemoteStream stream,
+            byte value,
+            in ArrayView<T> targetView)
+            where T : unmanaged
+        {
+            if (stream is null)
+                throw new ArgumentNullException(nameof(stream));
+
+            var accelerator = stream.RemoteAccelerator;
+            if (!IsRemoteView(targetView, accelerator, out var buffer))
+            {
+                throw new NotSupportedException(
+                    RuntimeErrorMessages.NotSupportedTargetAccelerator);
+            }
+            if (targetView.HasNoData())
+                return;
+
+            accelerator.MemSet(
+                buffer.Id,
+                targetView.GetIndexInBytes(),
+                targetView.LengthInBytes,
+                value);
+        }
+
+        /// <summary>
+        /// Performs a remote copy operation.
+        /// </summary>
+        /// <typeparam name="T">The element type.</typeparam>
+        /// <param name="stream">The remote stream to use (must not be null)</param>
+        /// <param name="sourceView">The source view to copy from.</param>
+        /// <param name="targetView">The target view to copy to.</param>
+        /// <remarks>
+        /// Supports copies from the CPU to the remote accelerator, from the remote
+        /// accelerator to the CPU and between buffers of the same remote
+        /// accelerator.
+        /// </remarks>
+        public static unsafe void RemoteCopy<T>(
+            RemoteStream stream,
+            in ArrayView<T> sourceView,
+            in ArrayView<T> targetView)
+            where T : unmanaged
+        {
+            if (stream is null)
+                throw new ArgumentNullException(nameof(stream));
+            if (sourceView.LengthInBytes > targetView.LengthInBytes)
+                throw new ArgumentOutOfRangeException(nameof(sourceView));
+
+            // Skip empty buffers
+            if (sourceView.HasNoData())
+                return;
+
+            var accelerator = stream.RemoteAccelerator;
+            long lengthInBytes = sourceView.LengthInBytes;
+            if (IsRemoteView(sourceView, accelerator, out var source))
+            {
+                if (IsRemoteView(targetView, accelerator, out var target))
+                {
+                    // Copy from remote to remote
+                    accelerator.Copy(
+                        source.Id,
+                        sourceView.GetIndexInBytes(),
+                        target.Id,
+                        targetView.GetIndexInBytes(),
+                        lengthInBytes);
+                    return;
+                }
+                if (targetView.GetAcceleratorType() == AcceleratorType.CPU)
+                {
+                    // Copy from remote to CPU
+                    accelerator.Read(
+                        source.Id,
+                        sourceView.GetIndexInBytes(),
+                        (byte*)targetView.LoadEffectiveAddressAsPtr(),
+                        lengthInBytes);
+                    return;
+                }
+            }
+            else if (
+                sourceView.GetAcceleratorType() == AcceleratorType.CPU &&
+                IsRemoteView(targetView, accelerator, out var target))
+            {
+                // Copy from CPU to remote
+                accelerator.Write(
+                    target.Id,
+                    targetView.GetIndexInBytes(),
+                    (byte*)sourceView.LoadEffectiveAddressAsPtr(),
+                    lengthInBytes);
+                return;
+            }
+            throw new NotSupportedException(
+                RuntimeErrorMessages.NotSupportedTargetAccelerator);
+        }
+
+        #endregion
+
+        #region Instance
+
+        /// <summary>
+        /// Constructs a new remote buffer.
+        /// </summary>
+        /// <param name="accelerator">The parent remote accelerator.</param>
+        /// <param name="id">The buffer id.</param>
+        /// <param name="length">The length of this buffer.</param>
+        /// <param name="elementSize">The element size.</param>
+        internal RemoteMemoryBuffer(
+            RemoteAccelerator accelerator,
+            int id,
+            long length,
+            int elementSize)
+            : base(accelerator, length, elementSize)
+        {
+            Id = id;
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Returns the associated remote accelerator.
+        /// </summary>
+        public RemoteAccelerator RemoteAccelerator =>
+            Accelerator as RemoteAccelerator;
+
+        /// <summary>
+        /// Returns the buffer id.
+        /// </summary>
+        public int Id { get; }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Returns the given stream as remote stream.
+        /// </summary>
+        private static RemoteStream GetRemoteStream(AcceleratorStream stream) =>
+            stream as RemoteStream ??
+            throw new NotSupportedException(
+                RuntimeErrorMessages.NotSupportedAcceleratorStream);
+
+        /// <inheritdoc/>
+        protected internal override void MemSet(
+            AcceleratorStream stream,
+            byte value,
+            in ArrayView<byte> targetView) =>
+            RemoteMemSet(GetRemoteStream(stream), value, targetView);
+
+        /// <inheritdoc/>
+        protected internal override void CopyFrom(
+            AcceleratorStream stream,
+            in ArrayView<byte> sourceView,
+            in ArrayView<byte> targetView) =>
+            RemoteCopy(GetRemoteStream(stream), sourceView, targetView);
+
+        /// <inheritdoc/>
+        protected internal override void CopyTo(
+            AcceleratorStream stream,
+            in ArrayView<byte> sourceView,
+            in ArrayView<byte> targetView) =>
+            RemoteCopy(GetRemoteStream(stream), sourceView, targetView);
+
+        #endregion
+
+        #region IDisposable
+
+        /// <summary>
+        /// Frees the remote allocation.
+        /// </summary>
+        protected override void DisposeAcceleratorObject(bool disposing)
+        {
+            if (disposing)
+                RemoteAccelerator.Free(RemoteCommand.Free, Id);
+        }
+
+        #endregion
+    }
+}
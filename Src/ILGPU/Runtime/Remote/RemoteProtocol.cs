@@ -0,0 +1,391 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: RemoteProtocol.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.Resources;
+using System;
+using System.IO;
+using System.Reflection;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace ILGPU.Runtime.Remote
+{
+    /// <summary>
+    /// All commands that can be sent to a <see cref="RemoteWorker"/>.
+    /// </summary>
+    internal enum RemoteCommand : byte
+    {
+        /// <summary>
+        /// Allocates a new buffer: id, length in bytes.
+        /// </summary>
+        Allocate,
+
+        /// <summary>
+        /// Frees a buffer: id.
+        /// </summary>
+        Free,
+
+        /// <summary>
+        /// Sets a range of a buffer to a byte value: id, offset in bytes, length in
+        /// bytes, value.
+        /// </summary>
+        MemSet,
+
+        /// <summary>
+        /// Writes a chunk of data: id, offset in bytes, length, data.
+        /// </summary>
+        Write,
+
+        /// <summary>
+        /// Reads data: id, offset in bytes, length in bytes. The worker responds
+        /// with a sequence of chunks.
+        /// </summary>
+        Read,
+
+        /// <summary>
+        /// Copies data between two buffers: source id, source offset in bytes,
+        /// target id, target offset in bytes, length in bytes.
+        /// </summary>
+        Copy,
+
+        /// <summary>
+        /// Compiles and loads a serialized kernel: id, load mode, group size,
+        /// specialization, IR. The worker responds with a status and the resolved
+        /// group size and minimum grid size.
+        /// </summary>
+        LoadKernel,
+
+        /// <summary>
+        /// Frees a loaded kernel: id.
+        /// </summary>
+        FreeKernel,
+
+        /// <summary>
+        /// Launches a loaded kernel: id, dimension, arguments.
+        /// </summary>
+        Launch,
+
+        /// <summary>
+        /// Waits for all pending operations. The worker responds with a status.
+        /// </summary>
+        Synchronize,
+
+        /// <summary>
+        /// Terminates the worker loop.
+        /// </summary>
+        Shutdown,
+    }
+
+    /// <summary>
+    /// Specifies how a remote kernel is loaded by the worker.
+    /// </summary>
+    internal enum RemoteKernelMode : byte
+    {
+        /// <summary>
+        /// The kernel is loaded as is.
+        /// </summary>
+        Default,
+
+        /// <summary>
+        /// The kernel is loaded as an implicitly grouped kernel with a custom group
+        /// size.
+        /// </summary>
+        ImplicitlyGrouped,
+
+        /// <summary>
+        /// The kernel is loaded as an implicitly grouped kernel whose group size is
+        /// determined by the worker.
+        /// </summary>
+        AutoGrouped,
+    }
+
+    /// <summary>
+    /// Shared constants and serialization helpers of the remote protocol.
+    /// </summary>
+    /// <remarks>
+    /// Commands that do not produce results are not acknowledged, which allows
+    /// clients to pipeline transfers and launches. Errors of these commands are
+    /// reported by the next command that produces a response. All lengths are
+    /// validated before any payload is read; messages violating these limits
+    /// terminate the connection.
+    /// </remarks>
+    internal static class RemoteProtocol
+    {
+        #region Constants
+
+        /// <summary>
+        /// The handshake magic ("ILGR").
+        /// </summary>
+        public const int Magic = 0x52474C49;
+
+        /// <summary>
+        /// The current protocol version.
+        /// </summary>
+        public const int Version = 2;
+
+        /// <summary>
+        /// The maximum number of bytes per transferred data chunk.
+        /// </summary>
+        public const int ChunkSize = 1 << 20;
+
+        /// <summary>
+        /// The maximum size of a serialized kernel in bytes.
+        /// </summary>
+        public const int MaxKernelSize = 1 << 26;
+
+        /// <summary>
+        /// The maximum size of a serialized value in bytes.
+        /// </summary>
+        public const int MaxValueSize = 1 << 16;
+
+        /// <summary>
+        /// The maximum number of kernel arguments.
+        /// </summary>
+        public const int MaxNumArguments = 1 << 10;
+
+        /// <summary>
+        /// The operation succeeded.
+        /// </summary>
+        public const byte StatusOk = 0;
+
+        /// <summary>
+        /// The operation failed; an error message follows.
+        /// </summary>
+        public const byte StatusError = 1;
+
+        /// <summary>
+        /// The argument is a serialized unmanaged value.
+        /// </summary>
+        public const byte ValueArgument = 0;
+
+        /// <summary>
+        /// The argument is a dense view of a remote buffer.
+        /// </summary>
+        public const byte ViewArgument = 1;
+
+        /// <summary>
+        /// The argument is an n-D view of a remote buffer: a dense view followed by
+        /// the serialized extent and stride.
+        /// </summary>
+        public const byte StridedViewArgument = 2;
+
+        #endregion
+
+        #region Static
+
+        /// <summary>
+        /// The generic serialization method.
+        /// </summary>
+        private static readonly MethodInfo SerializeMethod =
+            typeof(RemoteProtocol).GetMethod(
+                nameof(SerializeValue),
+                BindingFlags.NonPublic | BindingFlags.Static);
+
+        /// <summary>
+        /// The generic deserialization method.
+        /// </summary>
+        private static readonly MethodInfo DeserializeMethod =
+            typeof(RemoteProtocol).GetMethod(
+                nameof(DeserializeValue),
+                BindingFlags.NonPublic | BindingFlags.Static);
+
+        /// <summary>
+        /// Serializes the given unmanaged value.
+        /// </summary>
+        private static byte[] SerializeValue<T>(object value)
+            where T : unmanaged
+        {
+            var typedValue = (T)value;
+            var result = new byte[Unsafe.SizeOf<T>()];
+            MemoryMarshal.Write(result, ref typedValue);
+            return result;
+        }
+
+        /// <summary>
+        /// Deserializes an unmanaged value.
+        /// </summary>
+        private static object DeserializeValue<T>(byte[] data)
+            where T : unmanaged =>
+            MemoryMarshal.Read<T>(data);
+
+        /// <summary>
+        /// Serializes the given unmanaged value into its raw bytes.
+        /// </summary>
+        /// <param name="value">The boxed value.</param>
+        /// <returns>The raw bytes of the value.</returns>
+        public static byte[] Serialize(object value)
+        {
+            if (value is null)
+                throw new ArgumentNullException(nameof(value));
+            try
+            {
+                return SerializeMethod.MakeGenericMethod(value.GetType())
+                    .Invoke(null, new object[] { value }) as byte[];
+            }
+            catch (ArgumentException)
+            {
+                throw new NotSupportedException(string.Format(
+                    RuntimeErrorMessages.NotSupportedRemoteKernelArgument,
+                    value.GetType()));
+            }
+        }
+
+        /// <summary>
+        /// Deserializes a value of the given type from its raw bytes.
+        /// </summary>
+        /// <param name="type">The unmanaged value type.</param>
+        /// <param name="data">The raw bytes of the value.</param>
+        /// <returns>The boxed value.</returns>
+        public static object Deserialize(Type type, byte[] data)
+        {
+            MethodInfo deserialize;
+            try
+            {
+                deserialize = DeserializeMethod.MakeGenericMethod(type);
+            }
+            catch (ArgumentException)
+            {
+                throw new NotSupportedException(string.Format(
+                    RuntimeErrorMessages.NotSupportedRemoteKernelArgument,
+                    type));
+            }
+            if (data.Length != Interop.SizeOf(type))
+            {
+                throw new ArgumentException(
+                    string.Format(
+                        RuntimeErrorMessages.NotSupportedRemoteKernelArgument,
+                        type),
+                    nameof(data));
+            }
+            return deserialize.Invoke(null, new object[] { data });
+        }
+
+        /// <summary>
+        /// Creates an exception that reports a malformed message.
+        /// </summary>
+        /// <param name="command">The command of the malformed message.</param>
+        /// <returns>The created exception.</returns>
+        public static InvalidDataException GetInvalidMessageException(
+            RemoteCommand command) =>
+            new InvalidDataException(string.Format(
+                RuntimeErrorMessages.InvalidRemoteMessage,
+                command));
+
+        /// <summary>
+        /// Reads a length and verifies that it lies within [0, maxLength].
+        /// </summary>
+        /// <param name="reader">The source reader.</param>
+        /// <param name="maxLength">The maximum length.</param>
+        /// <param name="command">The current command.</param>
+        /// <returns>The validated length.</returns>
+        public static int ReadLength(
+            BinaryReader reader,
+            int maxLength,
+            RemoteCommand command)
+        {
+            int length = reader.ReadInt32();
+            return length >= 0 && length <= maxLength
+                ? length
+                : throw GetInvalidMessageException(command);
+        }
+
+        /// <summary>
+        /// Reads a non-negative offset or length in bytes.
+        /// </summary>
+        /// <param name="reader">The source reader.</param>
+        /// <param name="command">The current command.</param>
+        /// <returns>The validated offset or length.</returns>
+        public static long ReadOffset(BinaryReader reader, RemoteCommand command)
+        {
+            long offset = reader.ReadInt64();
+            return offset >= 0 ? offset : throw GetInvalidMessageException(command);
+        }
+
+        /// <summary>
+        /// Reads a length-prefixed byte array of at most the given length.
+        /// </summary>
+        /// <param name="reader">The source reader.</param>
+        /// <param name="maxLength">The maximum length.</param>
+        /// <param name="command">The current command.</param>
+        /// <returns>The read bytes.</returns>
+        public static byte[] ReadBytes(
+            BinaryReader reader,
+            int maxLength,
+            RemoteCommand command)
+        {
+            var result = new byte[ReadLength(reader, maxLength, command)];
+            ReadExactly(reader, result, result.Length);
+            return result;
+        }
+
+        /// <summary>
+        /// Writes a length-prefixed byte array.
+        /// </summary>
+        /// <param name="writer">The target writer.</param>
+        /// <param name="data">The bytes to write.</param>
+        public static void WriteBytes(BinaryWriter writer, byte[] data)
+        {
+            writer.Write(data.Length);
+            writer.Write(data);
+        }
+
+        /// <summary>
+        /// Reads exactly the given number of bytes.
+        /// </summary>
+        /// <param name="reader">The source reader.</param>
+        /// <param name="buffer">The target buffer.</param>
+        /// <param name="count">The number of bytes to read.</param>
+        public static void ReadExactly(BinaryReader reader, byte[] buffer, int count)
+        {
+            for (int offset = 0; offset < count; )
+            {
+                int read = reader.Read(buffer, offset, count - offset);
+                if (read < 1)
+                    throw new EndOfStreamException();
+                offset += read;
+            }
+        }
+
+        /// <summary>
+        /// Writes the handshake.
+        /// </summary>
+        /// <param name="writer">The target writer.</param>
+        /// <param name="accelerator">The accelerator of the worker.</param>
+        public static void WriteHandshake(BinaryWriter writer, Accelerator accelerator)
+        {
+            writer.Write(Magic);
+            writer.Write(Version);
+            RemoteDevice.Write(writer, accelerator);
+            writer.Flush();
+        }
+
+        /// <summary>
+        /// Reads and validates the handshake.
+        /// </summary>
+        /// <param name="reader">The source reader.</param>
+        /// <param name="writer">The target writer.</param>
+        /// <returns>The remote device that describes the worker accelerator.</returns>
+        public static RemoteDevice ReadHandshake(BinaryReader reader, BinaryWriter writer)
+        {
+            int magic = reader.ReadInt32();
+            int version = reader.ReadInt32();
+            if (magic != Magic || version != Version)
+            {
+                throw new InvalidDataException(string.Format(
+                    RuntimeErrorMessages.InvalidRemoteProtocol,
+                    version));
+            }
+            return new RemoteDevice(reader, writer);
+        }
+
+        #endregion
+    }
+}
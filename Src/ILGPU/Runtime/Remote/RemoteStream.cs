@@ -0,0 +1,74 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: RemoteStream.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.Resources;
+using System;
+
+namespace ILGPU.Runtime.Remote
+{
+    /// <summary>
+    /// Represents a stream of a <see cref="RemoteAccelerator"/>.
+    /// </summary>
+    /// <remarks>
+    /// All commands are processed in order by a single stream of the worker.
+    /// Hence, synchronizing a remote stream waits for all pending operations of the
+    /// parent accelerator.
+    /// </remarks>
+    public sealed class RemoteStream : AcceleratorStream
+    {
+        #region Instance
+
+        /// <summary>
+        /// Constructs a new remote stream.
+        /// </summary>
+        /// <param name="accelerator">The associated accelerator.</param>
+        internal RemoteStream(RemoteAccelerator accelerator)
+            : base(accelerator)
+        { }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Returns the associated remote accelerator.
+        /// </summary>
+        public RemoteAccelerator RemoteAccelerator =>
+            Accelerator as RemoteAccelerator;
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Sends all pending commands and waits for the worker to finish them.
+        /// </summary>
+        public override void Synchronize() => RemoteAccelerator.SynchronizeWorker();
+
+        /// <summary>
+        /// Profiling markers are not supported by remote streams.
+        /// </summary>
+        protected override ProfilingMarker AddProfilingMarkerInternal() =>
+            throw new NotSupportedException(
+                RuntimeErrorMessages.NotSupportedProfilingMarker);
+
+        #endregion
+
+        #region IDisposable
+
+        /// <summary>
+        /// Does not perform any operation.
+        /// </summary>
+        protected override void DisposeAcceleratorObject(bool disposing) { }
+
+        #endregion
+    }
+}
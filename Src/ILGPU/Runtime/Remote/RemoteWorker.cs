@@ -0,0 +1,744 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: RemoteWorker.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.Backends.EntryPoints;
+using ILGPU.IR;
+using ILGPU.Resources;
+using ILGPU.Util;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Reflection;
+using System.Text;
+
+namespace ILGPU.Runtime.Remote
+{
+    /// <summary>
+    /// Executes commands of a <see cref="RemoteAccelerator"/> on a local accelerator.
+    /// </summary>
+    /// <remarks>
+    /// Kernels are received as serialized ILGPU IR and compiled by the backend of the
+    /// local accelerator. All managed types and methods referenced by a kernel are
+    /// resolved against the ILGPU assembly, the core library and the kernel assemblies
+    /// passed to the constructor. No other assemblies are loaded on behalf of a client.
+    /// Since methods are bound by their metadata tokens and module version ids, clients
+    /// have to use the same builds of all kernel assemblies.
+    /// </remarks>
+    public sealed class RemoteWorker : DisposeBase
+    {
+        #region Nested Types
+
+        /// <summary>
+        /// A kernel argument that has been received from the client.
+        /// </summary>
+        private readonly struct RemoteArgument
+        {
+            public RemoteArgument(
+                byte kind,
+                int bufferId,
+                long offsetInBytes,
+                long lengthInBytes,
+                byte[] data,
+                byte[] strideData)
+            {
+                Kind = kind;
+                BufferId = bufferId;
+                OffsetInBytes = offsetInBytes;
+                LengthInBytes = lengthInBytes;
+                Data = data;
+                StrideData = strideData;
+            }
+
+            /// <summary>
+            /// Returns the argument kind.
+            /// </summary>
+            public byte Kind { get; }
+
+            /// <summary>
+            /// Returns the id of the referenced buffer (if any).
+            /// </summary>
+            public int BufferId { get; }
+
+            /// <summary>
+            /// Returns the offset of the referenced view in bytes.
+            /// </summary>
+            public long OffsetInBytes { get; }
+
+            /// <summary>
+            /// Returns the length of the referenced view in bytes.
+            /// </summary>
+            public long LengthInBytes { get; }
+
+            /// <summary>
+            /// Returns the serialized value or the serialized extent of a strided view.
+            /// </summary>
+            public byte[] Data { get; }
+
+            /// <summary>
+            /// Returns the serialized stride of a strided view.
+            /// </summary>
+            public byte[] StrideData { get; }
+        }
+
+        #endregion
+
+        #region Static
+
+        /// <summary>
+        /// The generic method to create typed views.
+        /// </summary>
+        private static readonly MethodInfo CreateViewMethod =
+            typeof(RemoteWorker).GetMethod(
+                nameof(CreateView),
+                BindingFlags.NonPublic | BindingFlags.Static);
+
+        /// <summary>
+        /// Creates a typed view of the given raw view.
+        /// </summary>
+        private static ArrayView<T> CreateView<T>(ArrayView<byte> view)
+            where T : unmanaged =>
+            view.Cast<T>();
+
+        #endregion
+
+        #region Instance
+
+        private readonly Dictionary<string, Assembly> allowedAssemblies =
+            new Dictionary<string, Assembly>();
+        private readonly HashSet<Assembly> kernelAssemblies;
+        private readonly Dictionary<int, MemoryBuffer> buffers =
+            new Dictionary<int, MemoryBuffer>();
+        private readonly Dictionary<int, Kernel> kernels =
+            new Dictionary<int, Kernel>();
+        private readonly byte[] chunk = new byte[RemoteProtocol.ChunkSize];
+        private readonly BinaryReader reader;
+        private readonly BinaryWriter writer;
+        private readonly AcceleratorStream stream;
+        private string pendingError;
+
+        /// <summary>
+        /// Constructs a new worker.
+        /// </summary>
+        /// <param name="accelerator">The local accelerator to use.</param>
+        /// <param name="transport">
+        /// The bidirectional transport stream (e.g. a pipe or a network stream).
+        /// </param>
+        /// <param name="assemblies">
+        /// All assemblies whose static methods may be loaded as kernels.
+        /// </param>
+        public RemoteWorker(
+            Accelerator accelerator,
+            Stream transport,
+            IEnumerable<Assembly> assemblies)
+        {
+            Accelerator = accelerator
+                ?? throw new ArgumentNullException(nameof(accelerator));
+            if (transport is null)
+                throw new ArgumentNullException(nameof(transport));
+            if (assemblies is null)
+                throw new ArgumentNullException(nameof(assemblies));
+
+            kernelAssemblies = new HashSet<Assembly>(assemblies);
+            AllowAssembly(typeof(RemoteWorker).Assembly);
+            AllowAssembly(typeof(object).Assembly);
+            foreach (var assembly in kernelAssemblies)
+                AllowAssembly(assembly);
+
+            reader = new BinaryReader(transport, Encoding.UTF8, leaveOpen: true);
+            writer = new BinaryWriter(
+                new BufferedStream(transport, RemoteProtocol.ChunkSize),
+                Encoding.UTF8,
+                leaveOpen: true);
+            stream = accelerator.CreateStream();
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Returns the local accelerator.
+        /// </summary>
+        public Accelerator Accelerator { get; }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Processes all incoming commands until the client shuts the worker down or
+        /// closes the transport.
+        /// </summary>
+        /// <remarks>
+        /// Errors of individual commands are reported to the client with the next
+        /// status reply. Malformed messages cannot be recovered from and terminate the
+        /// worker after the error has been reported.
+        /// </remarks>
+        public void Run()
+        {
+            RemoteProtocol.WriteHandshake(writer, Accelerator);
+            try
+            {
+                while (true)
+                {
+                    int command = reader.BaseStream.ReadByte();
+                    if (command < 0 || command == (int)RemoteCommand.Shutdown)
+                        break;
+                    ProcessCommand((RemoteCommand)command);
+                }
+            }
+            catch (InvalidDataException e)
+            {
+                writer.Write(RemoteProtocol.StatusError);
+                writer.Write(e.Message);
+                writer.Flush();
+                throw;
+            }
+        }
+
+        /// <summary>
+        /// Reads and executes a single command.
+        /// </summary>
+        private void ProcessCommand(RemoteCommand command)
+        {
+            switch (command)
+            {
+                case RemoteCommand.Allocate:
+                    Allocate();
+                    break;
+                case RemoteCommand.Free:
+                    Free();
+                    break;
+                case RemoteCommand.MemSet:
+                    MemSet();
+                    break;
+                case RemoteCommand.Write:
+                    Write();
+                    break;
+                case RemoteCommand.Read:
+                    Read();
+                    break;
+                case RemoteCommand.Copy:
+                    Copy();
+                    break;
+                case RemoteCommand.LoadKernel:
+                    LoadKernel();
+                    break;
+                case RemoteCommand.FreeKernel:
+                    FreeKernel();
+                    break;
+                case RemoteCommand.Launch:
+                    Launch();
+                    break;
+                case RemoteCommand.Synchronize:
+                    Execute(() => stream.Synchronize());
+                    WriteStatus();
+                    writer.Flush();
+                    break;
+                default:
+                    throw new InvalidDataException(string.Format(
+                        RuntimeErrorMessages.InvalidRemoteProtocol,
+                        RemoteProtocol.Version));
+            }
+        }
+
+        /// <summary>
+        /// Registers the given assembly to be resolvable by kernels.
+        /// </summary>
+        private void AllowAssembly(Assembly assembly) =>
+            allowedAssemblies[assembly.GetName().Name] = assembly;
+
+        /// <summary>
+        /// Resolves an assembly referenced by a serialized kernel.
+        /// </summary>
+        /// <returns>The allowed assembly or null.</returns>
+        private Assembly ResolveAssembly(AssemblyName assemblyName) =>
+            allowedAssemblies.TryGetValue(assemblyName.Name, out var assembly)
+            ? assembly
+            : null;
+
+        /// <summary>
+        /// Executes the given action and remembers the first error.
+        /// </summary>
+        private void Execute(Action action)
+        {
+            try
+            {
+                action();
+            }
+            catch (Exception e) when (!(e is IOException))
+            {
+                var error = e is TargetInvocationException && e.InnerException != null
+                    ? e.InnerException
+                    : e;
+                pendingError ??= error.Message;
+            }
+        }
+
+        /// <summary>
+        /// Writes the current status and resets all pending errors.
+        /// </summary>
+        /// <returns>True, if no error has occurred.</returns>
+        private bool WriteStatus()
+        {
+            if (pendingError is null)
+            {
+                writer.Write(RemoteProtocol.StatusOk);
+                return true;
+            }
+            writer.Write(RemoteProtocol.StatusError);
+            writer.Write(pendingError);
+            pendingError = null;
+            return false;
+        }
+
+        /// <summary>
+        /// Returns the buffer with the given id.
+        /// </summary>
+        private MemoryBuffer GetBuffer(int id) =>
+            buffers.TryGetValue(id, out var buffer)
+            ? buffer
+            : throw new ArgumentOutOfRangeException(
+                nameof(id),
+                string.Format(RuntimeErrorMessages.UnknownRemoteBuffer, id));
+
+        /// <summary>
+        /// Returns a raw view of the given byte range of a buffer.
+        /// </summary>
+        private ArrayView<byte> GetView(int id, long offsetInBytes, long lengthInBytes)
+        {
+            var buffer = GetBuffer(id);
+            if (offsetInBytes > buffer.LengthInBytes)
+                throw new ArgumentOutOfRangeException(nameof(offsetInBytes));
+            if (lengthInBytes > buffer.LengthInBytes - offsetInBytes)
+                throw new ArgumentOutOfRangeException(nameof(lengthInBytes));
+            return buffer.AsRawArrayView(offsetInBytes, lengthInBytes);
+        }
+
+        /// <summary>
+        /// Returns the kernel with the given id.
+        /// </summary>
+        private Kernel GetKernel(int id) =>
+            kernels.TryGetValue(id, out var kernel)
+            ? kernel
+            : throw new ArgumentOutOfRangeException(
+                nameof(id),
+                string.Format(RuntimeErrorMessages.UnknownRemoteKernel, id));
+
+        /// <summary>
+        /// Allocates a new buffer.
+        /// </summary>
+        private void Allocate()
+        {
+            int id = reader.ReadInt32();
+            long lengthInBytes = RemoteProtocol.ReadOffset(
+                reader,
+                RemoteCommand.Allocate);
+            Execute(() =>
+            {
+                if (buffers.ContainsKey(id))
+                    throw new ArgumentOutOfRangeException(nameof(id));
+                buffers.Add(id, Accelerator.AllocateRaw(lengthInBytes, 1));
+            });
+        }
+
+        /// <summary>
+        /// Frees a buffer.
+        /// </summary>
+        private void Free()
+        {
+            int id = reader.ReadInt32();
+            Execute(() =>
+            {
+                GetBuffer(id).Dispose();
+                buffers.Remove(id);
+            });
+        }
+
+        /// <summary>
+        /// Sets a byte range of a buffer to the given value.
+        /// </summary>
+        private void MemSet()
+        {
+            int id = reader.ReadInt32();
+            long offset = RemoteProtocol.ReadOffset(reader, RemoteCommand.MemSet);
+            long length = RemoteProtocol.ReadOffset(reader, RemoteCommand.MemSet);
+            byte value = reader.ReadByte();
+            Execute(() =>
+            {
+                var view = GetView(id, offset, length);
+                if (length > 0)
+                    view.MemSet(stream, value);
+            });
+        }
+
+        /// <summary>
+        /// Receives a chunk and copies it into the target buffer.
+        /// </summary>
+        private void Write()
+        {
+            int id = reader.ReadInt32();
+            long offset = RemoteProtocol.ReadOffset(reader, RemoteCommand.Write);
+            int length = RemoteProtocol.ReadLength(
+                reader,
+                RemoteProtocol.ChunkSize,
+                RemoteCommand.Write);
+            RemoteProtocol.ReadExactly(reader, chunk, length);
+            Execute(() =>
+            {
+                var view = GetView(id, offset, length);
+                if (length > 0)
+                {
+                    view.CopyFromCPU(
+                        stream,
+                        new ReadOnlySpan<byte>(chunk, 0, length));
+                }
+            });
+        }
+
+        /// <summary>
+        /// Streams the requested range back to the client chunk by chunk.
+        /// </summary>
+        private void Read()
+        {
+            int id = reader.ReadInt32();
+            long offset = RemoteProtocol.ReadOffset(reader, RemoteCommand.Read);
+            long length = RemoteProtocol.ReadOffset(reader, RemoteCommand.Read);
+            Execute(() =>
+            {
+                GetView(id, offset, length);
+                stream.Synchronize();
+            });
+
+            for (long end = offset + length; offset < end && pendingError is null; )
+            {
+                int count = (int)Math.Min(end - offset, chunk.Length);
+                Execute(() =>
+                    GetView(id, offset, count).CopyToCPU(
+                        stream,
+                        new Span<byte>(chunk, 0, count)));
+                if (pendingError != null)
+                    break;
+
+                writer.Write(RemoteProtocol.StatusOk);
+                writer.Write(count);
+                writer.Write(chunk, 0, count);
+                offset += count;
+            }
+            WriteStatus();
+            writer.Flush();
+        }
+
+        /// <summary>
+        /// Copies a byte range between two buffers.
+        /// </summary>
+        private void Copy()
+        {
+            int sourceId = reader.ReadInt32();
+            long sourceOffset = RemoteProtocol.ReadOffset(reader, RemoteCommand.Copy);
+            int targetId = reader.ReadInt32();
+            long targetOffset = RemoteProtocol.ReadOffset(reader, RemoteCommand.Copy);
+            long length = RemoteProtocol.ReadOffset(reader, RemoteCommand.Copy);
+            Execute(() =>
+            {
+                var source = GetView(sourceId, sourceOffset, length);
+                var target = GetView(targetId, targetOffset, length);
+                if (length > 0)
+                    source.CopyTo(stream, target);
+            });
+        }
+
+        /// <summary>
+        /// Compiles and loads a serialized kernel and replies with its launch
+        /// configuration.
+        /// </summary>
+        private void LoadKernel()
+        {
+            int id = reader.ReadInt32();
+            var mode = (RemoteKernelMode)reader.ReadByte();
+            if (mode > RemoteKernelMode.AutoGrouped)
+                throw RemoteProtocol.GetInvalidMessageException(RemoteCommand.LoadKernel);
+            bool explicitlyGrouped = reader.ReadBoolean();
+            int customGroupSize = reader.ReadInt32();
+            int maxNumThreadsPerGroup = reader.ReadInt32();
+            int minNumGroupsPerMultiprocessor = reader.ReadInt32();
+            var irData = RemoteProtocol.ReadBytes(
+                reader,
+                RemoteProtocol.MaxKernelSize,
+                RemoteCommand.LoadKernel);
+
+            KernelInfo kernelInfo = null;
+            Execute(() =>
+            {
+                if (kernels.ContainsKey(id))
+                    throw new ArgumentOutOfRangeException(nameof(id));
+                var specialization = new KernelSpecialization(
+                    maxNumThreadsPerGroup > 0 ? maxNumThreadsPerGroup : (int?)null,
+                    minNumGroupsPerMultiprocessor > 0
+                        ? minNumGroupsPerMultiprocessor
+                        : (int?)null);
+                var compiledKernel = CompileKernel(
+                    irData,
+                    explicitlyGrouped,
+                    specialization);
+                kernels.Add(id, mode switch
+                {
+                    RemoteKernelMode.ImplicitlyGrouped =>
+                        Accelerator.LoadImplicitlyGroupedKernel(
+                            compiledKernel,
+                            customGroupSize,
+                            out kernelInfo),
+                    RemoteKernelMode.AutoGrouped =>
+                        Accelerator.LoadAutoGroupedKernel(
+                            compiledKernel,
+                            out kernelInfo),
+                    _ => Accelerator.LoadKernel(compiledKernel),
+                });
+            });
+
+            // Discard the kernel if a previous command failed, since the client will
+            // not be able to refer to it
+            if (pendingError != null && kernels.TryGetValue(id, out var kernel))
+            {
+                kernel.Dispose();
+                kernels.Remove(id);
+            }
+            if (WriteStatus())
+            {
+                writer.Write(kernelInfo?.MinGroupSize ?? 0);
+                writer.Write(kernelInfo?.MinGridSize ?? 0);
+            }
+            writer.Flush();
+        }
+
+        /// <summary>
+        /// Deserializes the given kernel and compiles it with the local backend.
+        /// </summary>
+        private CompiledKernel CompileKernel(
+            byte[] irData,
+            bool explicitlyGrouped,
+            in KernelSpecialization specialization)
+        {
+            using var irContext = new IRContext(Accelerator.Context);
+            using var irStream = new MemoryStream(irData, false);
+            var method = IRSerializer.Deserialize(irStream, irContext, ResolveAssembly);
+
+            if (!(method.Source is MethodInfo source) ||
+                !source.IsStatic ||
+                source.IsGenericMethod ||
+                source.DeclaringType.IsGenericType ||
+                !kernelAssemblies.Contains(source.Module.Assembly))
+            {
+                throw new NotSupportedException(string.Format(
+                    RuntimeErrorMessages.NotSupportedRemoteKernel,
+                    method.Source));
+            }
+
+            var entry = explicitlyGrouped
+                ? EntryPointDescription.FromExplicitlyGroupedKernel(source)
+                : EntryPointDescription.FromImplicitlyGroupedKernel(source);
+            return Accelerator.Backend.Compile(method, entry, specialization);
+        }
+
+        /// <summary>
+        /// Frees a kernel.
+        /// </summary>
+        private void FreeKernel()
+        {
+            int id = reader.ReadInt32();
+            Execute(() =>
+            {
+                GetKernel(id).Dispose();
+                kernels.Remove(id);
+            });
+        }
+
+        /// <summary>
+        /// Receives all arguments and launches a loaded kernel.
+        /// </summary>
+        private void Launch()
+        {
+            int id = reader.ReadInt32();
+            var dimensionData = RemoteProtocol.ReadBytes(
+                reader,
+                RemoteProtocol.MaxValueSize,
+                RemoteCommand.Launch);
+            var args = new RemoteArgument[RemoteProtocol.ReadLength(
+                reader,
+                RemoteProtocol.MaxNumArguments,
+                RemoteCommand.Launch)];
+            for (int i = 0; i < args.Length; ++i)
+                args[i] = ReadArgument();
+
+            Execute(() =>
+            {
+                var kernel = GetKernel(id);
+                var entryPoint = kernel.CompiledKernel.EntryPoint;
+                var parameters = entryPoint.Parameters;
+                if (parameters.Count != args.Length)
+                {
+                    throw new ArgumentException(
+                        RuntimeErrorMessages.InvalidNumberOfUniformArgs);
+                }
+
+                var reflectionArgs = new object[
+                    Kernel.KernelParameterOffset + args.Length];
+                reflectionArgs[Kernel.KernelInstanceParamIdx] = kernel;
+                reflectionArgs[Kernel.KernelStreamParamIdx] = stream;
+                reflectionArgs[Kernel.KernelParamDimensionIdx] =
+                    RemoteProtocol.Deserialize(entryPoint.KernelIndexType, dimensionData);
+                for (int i = 0; i < args.Length; ++i)
+                {
+                    reflectionArgs[Kernel.KernelParameterOffset + i] =
+                        CreateArgument(parameters[i], args[i]);
+                }
+                kernel.Launcher.Invoke(null, reflectionArgs);
+            });
+        }
+
+        /// <summary>
+        /// Reads a single kernel argument.
+        /// </summary>
+        private RemoteArgument ReadArgument()
+        {
+            byte kind = reader.ReadByte();
+            switch (kind)
+            {
+                case RemoteProtocol.ValueArgument:
+                    return new RemoteArgument(
+                        kind,
+                        0,
+                        0L,
+                        0L,
+                        RemoteProtocol.ReadBytes(
+                            reader,
+                            RemoteProtocol.MaxValueSize,
+                            RemoteCommand.Launch),
+                        null);
+                case RemoteProtocol.ViewArgument:
+                case RemoteProtocol.StridedViewArgument:
+                    int bufferId = reader.ReadInt32();
+                    long offset = RemoteProtocol.ReadOffset(reader, RemoteCommand.Launch);
+                    long length = RemoteProtocol.ReadOffset(reader, RemoteCommand.Launch);
+                    if (kind == RemoteProtocol.ViewArgument)
+                    {
+                        return new RemoteArgument(
+                            kind,
+                            bufferId,
+                            offset,
+                            length,
+                            null,
+                            null);
+                    }
+                    var extentData = RemoteProtocol.ReadBytes(
+                        reader,
+                        RemoteProtocol.MaxValueSize,
+                        RemoteCommand.Launch);
+                    var strideData = RemoteProtocol.ReadBytes(
+                        reader,
+                        RemoteProtocol.MaxValueSize,
+                        RemoteCommand.Launch);
+                    return new RemoteArgument(
+                        kind,
+                        bufferId,
+                        offset,
+                        length,
+                        extentData,
+                        strideData);
+                default:
+                    throw RemoteProtocol.GetInvalidMessageException(RemoteCommand.Launch);
+            }
+        }
+
+        /// <summary>
+        /// Creates a managed kernel argument of the given parameter type.
+        /// </summary>
+        private object CreateArgument(Type paramType, in RemoteArgument arg)
+        {
+            if (arg.Kind == RemoteProtocol.ValueArgument)
+                return RemoteProtocol.Deserialize(paramType, arg.Data);
+
+            bool isView = arg.Kind == RemoteProtocol.ViewArgument
+                ? paramType.IsGenericType &&
+                    paramType.GetGenericTypeDefinition() == typeof(ArrayView<>)
+                : RemoteAccelerator.IsStridedViewType(paramType);
+            if (!isView)
+            {
+                throw new NotSupportedException(string.Format(
+                    RuntimeErrorMessages.NotSupportedRemoteKernelArgument,
+                    paramType));
+            }
+
+            var typeArguments = paramType.GetGenericArguments();
+            var baseView = CreateArgumentView(typeArguments[0], arg);
+            if (arg.Kind == RemoteProtocol.ViewArgument)
+                return baseView;
+
+            // Reconstruct the n-D view and verify that it lies within its base view
+            var extentType = paramType.GetProperty(
+                nameof(ArrayView1D<byte, Stride1D.Dense>.Extent)).PropertyType;
+            var view = (IArrayView)Activator.CreateInstance(
+                paramType,
+                baseView,
+                RemoteProtocol.Deserialize(extentType, arg.Data),
+                RemoteProtocol.Deserialize(typeArguments[1], arg.StrideData));
+            if (view.Length < 0 || view.Length > ((IArrayView)baseView).Length)
+                throw new ArgumentOutOfRangeException(nameof(arg));
+            return view;
+        }
+
+        /// <summary>
+        /// Creates a typed view of the given element type that refers to the buffer
+        /// range of the given argument.
+        /// </summary>
+        private object CreateArgumentView(Type elementType, in RemoteArgument arg)
+        {
+            var viewType = typeof(ArrayView<>).MakeGenericType(elementType);
+            if (arg.BufferId == 0)
+                return Activator.CreateInstance(viewType);
+
+            int elementSize = Interop.SizeOf(elementType);
+            if (arg.OffsetInBytes % elementSize != 0 ||
+                arg.LengthInBytes % elementSize != 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(arg));
+            }
+            var rawView = GetView(arg.BufferId, arg.OffsetInBytes, arg.LengthInBytes);
+            return CreateViewMethod.MakeGenericMethod(elementType).Invoke(
+                null,
+                new object[] { rawView });
+        }
+
+        #endregion
+
+        #region IDisposable
+
+        /// <inheritdoc/>
+        protected override void Dispose(bool disposing)
+        {
+            if (disposing)
+            {
+                foreach (var kernel in kernels.Values)
+                    kernel.Dispose();
+                kernels.Clear();
+                foreach (var buffer in buffers.Values)
+                    buffer.Dispose();
+                buffers.Clear();
+                stream.Dispose();
+                reader.Dispose();
+                writer.Dispose();
+            }
+            base.Dispose(disposing);
+        }
+
+        #endregion
+    }
+}
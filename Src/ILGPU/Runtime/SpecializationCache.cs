@@ -13,9 +13,11 @@ using ILGPU.Backends.EntryPoints;
 using ILGPU.IR;
 using ILGPU.Util;
 using System;
+using System.Collections.Concurrent;
 using System.Collections.Generic;
 using System.Runtime.CompilerServices;
 using System.Threading;
+using System.Threading.Tasks;
 
 namespace ILGPU.Runtime
 {
@@ -34,22 +36,191 @@ namespace ILGPU.Runtime
         object GetSpecializedArg(int index);
     }
 
+    /// <summary>
+    /// A reference-counted kernel launcher that is owned by a
+    /// <see cref="SpecializationCache{TLoader, TArgs, TDelegate}"/>.
+    /// </summary>
+    /// <typeparam name="TDelegate">The launcher delegate type.</typeparam>
+    /// <remarks>
+    /// The cache holds one reference and every launch holds another one until it
+    /// has been dispatched. The kernel is disposed as soon as the cache has evicted
+    /// it and all launches using it have finished.
+    /// </remarks>
+    internal sealed class SpecializationCacheEntry<TDelegate>
+        where TDelegate : Delegate
+    {
+        #region Instance
+
+        private int numReferences = 1;
+        private long lastUse;
+
+        /// <summary>
+        /// Constructs a new entry that is referenced by its cache.
+        /// </summary>
+        /// <param name="launcher">The kernel launcher.</param>
+        public SpecializationCacheEntry(TDelegate launcher)
+        {
+            Launcher = launcher;
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Returns the kernel launcher.
+        /// </summary>
+        public TDelegate Launcher { get; }
+
+        /// <summary>
+        /// Returns the usage stamp of the most recent launch.
+        /// </summary>
+        public long LastUse => Interlocked.Read(ref lastUse);
+
+        /// <summary>
+        /// Returns the size of the kernel in bytes.
+        /// </summary>
+        public long CodeSize =>
+            Kernel.ResolveKernel(Launcher)?.CompiledKernel.CodeSize ?? 0;
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Tries to acquire a reference to this kernel.
+        /// </summary>
+        /// <param name="useStamp">The usage stamp of the current launch.</param>
+        /// <returns>True, if the kernel has not been disposed yet.</returns>
+        public bool TryAcquire(long useStamp)
+        {
+            int current;
+            do
+            {
+                current = Volatile.Read(ref numReferences);
+                if (current < 1)
+                    return false;
+            }
+            while (Interlocked.CompareExchange(
+                ref numReferences,
+                current + 1,
+                current) != current);
+
+            // Usage stamps are only approximately ordered, which suffices to
+            // determine the least recently used kernels
+            Interlocked.Exchange(ref lastUse, useStamp);
+            return true;
+        }
+
+        /// <summary>
+        /// Releases a reference and disposes the kernel when the last reference has
+        /// been released.
+        /// </summary>
+        public void Release()
+        {
+            if (Interlocked.Decrement(ref numReferences) == 0)
+                Kernel.ResolveKernel(Launcher)?.Dispose();
+        }
+
+        #endregion
+    }
+
     /// <summary>
     /// A specialization cache to store and managed specialized kernel versions.
     /// </summary>
     /// <typeparam name="TLoader">The associated loader type.</typeparam>
     /// <typeparam name="TArgs">The arguments key type for caching.</typeparam>
     /// <typeparam name="TDelegate">The launcher delegate type.</typeparam>
+    /// <remarks>
+    /// In <see cref="SpecializationMode.Tiered"/> mode, launches use a generic kernel
+    /// until a specialized kernel for the current arguments has been compiled in the
+    /// background. Cached kernels are looked up using the read lock only and are
+    /// protected by reference counts during their launches. Usages are recorded
+    /// without any lock and are applied to the usage order of the cache before
+    /// new kernels are published. Kernels are compiled without holding any lock.
+    /// </remarks>
     internal class SpecializationCache<TLoader, TArgs, TDelegate> : DisposeBase
         where TLoader : struct, Accelerator.IKernelLoader
         where TArgs : struct, ISpecializationCacheArgs
         where TDelegate : Delegate
     {
+        #region Nested Types
+
+        /// <summary>
+        /// A tracked set of specialization arguments in tiered mode.
+        /// </summary>
+        /// <remarks>
+        /// Launches can be registered concurrently without holding the write lock of
+        /// the parent cache.
+        /// </remarks>
+        private sealed class TieredEntry
+        {
+            private int numLaunches;
+            private int isScheduled;
+
+            /// <summary>
+            /// Registers a new launch using these arguments.
+            /// </summary>
+            /// <param name="threshold">
+            /// The number of launches after which the arguments are specialized.
+            /// </param>
+            /// <returns>
+            /// True, if the caller is responsible for scheduling the specialization.
+            /// </returns>
+            public bool RegisterLaunch(int threshold) =>
+                Interlocked.Increment(ref numLaunches) >= threshold &&
+                Interlocked.CompareExchange(ref isScheduled, 1, 0) == 0;
+        }
+
+        #endregion
+
         #region Instance
 
         private readonly ReaderWriterLockSlim cacheLock = new ReaderWriterLockSlim();
-        private readonly Dictionary<TArgs, TDelegate> kernelCache =
-            new Dictionary<TArgs, TDelegate>();
+        private readonly LruCache<TArgs, SpecializationCacheEntry<TDelegate>>
+            kernelCache;
+
+        /// <summary>
+        /// All kernels that are currently being compiled, which allows concurrent
+        /// launches using the same arguments to wait for a single compilation.
+        /// </summary>
+        private readonly ConcurrentDictionary<
+            TArgs,
+            Lazy<SpecializationCacheEntry<TDelegate>>> pendingKernels =
+            new ConcurrentDictionary<
+                TArgs,
+                Lazy<SpecializationCacheEntry<TDelegate>>>();
+
+        /// <summary>
+        /// The current usage stamp.
+        /// </summary>
+        private long useCounter;
+
+        /// <summary>
+        /// All tracked arguments in tiered mode that have not been specialized yet.
+        /// </summary>
+        /// <remarks>
+        /// Tracked entries do not hold any code and are bounded by their number only.
+        /// They use their own counters, since they do not represent cached kernels.
+        /// </remarks>
+        private readonly LruCache<TArgs, TieredEntry> tieredCache;
+
+        /// <summary>
+        /// Cancels all background specializations that have not been published yet.
+        /// </summary>
+        private readonly CancellationTokenSource cancellationSource =
+            new CancellationTokenSource();
+
+        /// <summary>
+        /// Counts all running background specializations plus one for the cache
+        /// itself, which is released on dispose.
+        /// </summary>
+        private readonly CountdownEvent pendingSpecializations = new CountdownEvent(1);
+
+        /// <summary>
+        /// The generic kernel that is used in tiered mode.
+        /// </summary>
+        private readonly Lazy<SpecializationCacheEntry<TDelegate>> genericKernel;
 
         /// <summary>
         /// Constructs a new specialization cache.
@@ -71,6 +242,22 @@ namespace ILGPU.Runtime
             Loader = loader;
             Entry = entry;
             KernelSpecialization = specialization;
+
+            var properties = accelerator.Context.Properties;
+            IsTiered = properties.SpecializationMode == SpecializationMode.Tiered;
+            Threshold = properties.SpecializationThreshold;
+            MaxNumSpecializations = properties.MaxNumSpecializations;
+            kernelCache = new LruCache<TArgs, SpecializationCacheEntry<TDelegate>>(
+                MaxNumSpecializations,
+                properties.MaxKernelCacheSize,
+                accelerator.SpecializationCacheCounters,
+                ReleaseEntry);
+            tieredCache = new LruCache<TArgs, TieredEntry>(
+                MaxNumSpecializations,
+                long.MaxValue);
+            genericKernel = new Lazy<SpecializationCacheEntry<TDelegate>>(
+                CompileGenericKernel,
+                LazyThreadSafetyMode.ExecutionAndPublication);
         }
 
         #endregion
@@ -102,6 +289,21 @@ namespace ILGPU.Runtime
         /// </summary>
         public KernelSpecialization KernelSpecialization { get; }
 
+        /// <summary>
+        /// Returns true if specialized kernels are compiled in the background.
+        /// </summary>
+        public bool IsTiered { get; }
+
+        /// <summary>
+        /// Returns the number of launches after which arguments are specialized.
+        /// </summary>
+        public int Threshold { get; }
+
+        /// <summary>
+        /// Returns the maximum number of cached arguments.
+        /// </summary>
+        public int MaxNumSpecializations { get; }
+
         #endregion
 
         #region Methods
@@ -197,27 +399,269 @@ namespace ILGPU.Runtime
         }
 
         /// <summary>
-        /// Gets or creates a specialized kernel based on the arguments provided.
+        /// Compiles the generic kernel in which all specialized parameters are passed
+        /// as ordinary kernel arguments.
+        /// </summary>
+        /// <returns>The generic kernel launcher.</returns>
+        private SpecializationCacheEntry<TDelegate> CompileGenericKernel()
+        {
+            var compiledKernel = Accelerator.Backend.Compile(
+                KernelMethod,
+                Entry,
+                KernelSpecialization);
+            var kernel = Loader.LoadKernel(Accelerator, compiledKernel, out var _);
+            return new SpecializationCacheEntry<TDelegate>(
+                kernel.CreateLauncherDelegate<TDelegate>());
+        }
+
+        /// <summary>
+        /// Releases the reference of this cache to the given entry.
+        /// </summary>
+        /// <param name="entry">The evicted, replaced or cleared entry.</param>
+        /// <remarks>
+        /// Specialized kernels are owned by this cache and are disposed as soon as
+        /// they are evicted and all launches using them have finished.
+        /// </remarks>
+        private static void ReleaseEntry(SpecializationCacheEntry<TDelegate> entry) =>
+            entry.Release();
+
+        /// <summary>
+        /// Returns a new usage stamp.
         /// </summary>
-        /// <param name="args">The arguments used to specialize the kernel.</param>
-        /// <returns></returns>
         [MethodImpl(MethodImplOptions.AggressiveInlining)]
-        public TDelegate GetOrCreateKernel(TArgs args)
+        private long NextUse() => Interlocked.Increment(ref useCounter);
+
+        /// <summary>
+        /// Tries to acquire a cached kernel using the read lock only.
+        /// </summary>
+        /// <param name="args">The arguments used to specialize the kernel.</param>
+        /// <param name="entry">The acquired kernel (if any).</param>
+        /// <returns>True, if a cached kernel could be acquired.</returns>
+        private bool TryAcquireCachedKernel(
+            in TArgs args,
+            out SpecializationCacheEntry<TDelegate> entry)
+        {
+            using var readScope = cacheLock.EnterReadScope();
+            return kernelCache.TryPeekValue(args, out entry) &&
+                entry.TryAcquire(NextUse());
+        }
+
+        /// <summary>
+        /// Publishes a compiled kernel in the regular kernel cache.
+        /// </summary>
+        /// <param name="args">The arguments used to specialize the kernel.</param>
+        /// <param name="launcher">The compiled kernel launcher.</param>
+        /// <param name="cancellationToken">
+        /// A token that prevents publication if the cache has been disposed.
+        /// </param>
+        /// <returns>The published entry or null if publication was canceled.</returns>
+        private SpecializationCacheEntry<TDelegate> PublishKernel(
+            in TArgs args,
+            TDelegate launcher,
+            CancellationToken cancellationToken)
+        {
+            var entry = new SpecializationCacheEntry<TDelegate>(launcher);
+            using var writeScope = cacheLock.EnterWriteScope();
+
+            // Check whether the cache has been disposed or whether another thread
+            // has published a kernel for these arguments in the meantime
+            if (cancellationToken.IsCancellationRequested)
+            {
+                entry.Release();
+                return null;
+            }
+            tieredCache.Remove(args);
+            if (kernelCache.TryPeekValue(args, out var existing))
+            {
+                entry.Release();
+                return existing;
+            }
+
+            // Apply all recorded usages before evicting any kernels. The cache is
+            // bounded by the code size of all specialized kernels
+            kernelCache.Reorder(cached => cached.LastUse);
+            kernelCache.Add(args, entry, entry.CodeSize);
+            return entry;
+        }
+
+        /// <summary>
+        /// Schedules a background specialization of the given arguments.
+        /// </summary>
+        /// <param name="args">The arguments used to specialize the kernel.</param>
+        private void ScheduleSpecialization(in TArgs args)
+        {
+            // The count has already reached zero if the cache is being disposed
+            if (!pendingSpecializations.TryAddCount())
+                return;
+            var specializationArgs = args;
+            Accelerator.TrackSpecialization(
+                Task.Run(() => SpecializeKernelInBackground(specializationArgs)));
+        }
+
+        /// <summary>
+        /// Compiles a specialized kernel in the background and publishes it.
+        /// </summary>
+        /// <param name="args">The arguments used to specialize the kernel.</param>
+        /// <remarks>
+        /// Compilation and loading errors are reported to the parent accelerator and
+        /// the affected arguments keep using the generic kernel.
+        /// </remarks>
+        private void SpecializeKernelInBackground(TArgs args)
+        {
+            try
+            {
+                var cancellationToken = cancellationSource.Token;
+                if (cancellationToken.IsCancellationRequested)
+                    return;
+
+                TDelegate launcher;
+                try
+                {
+                    launcher = SpecializeKernel(args);
+                }
+                catch (InternalCompilerException e)
+                {
+                    Accelerator.OnSpecializationFailed(e);
+                    return;
+                }
+                catch (NotSupportedException e)
+                {
+                    Accelerator.OnSpecializationFailed(e);
+                    return;
+                }
+                catch (AcceleratorException e)
+                {
+                    Accelerator.OnSpecializationFailed(e);
+                    return;
+                }
+
+                // Promote the arguments to the regular kernel cache
+                PublishKernel(args, launcher, cancellationToken);
+            }
+            finally
+            {
+                // Dispose waits for this signal before releasing the cache lock
+                pendingSpecializations.Signal();
+            }
+        }
+
+        /// <summary>
+        /// Gets a specialized kernel if one is available and schedules a background
+        /// compilation of hot arguments. Falls back to the generic kernel otherwise.
+        /// </summary>
+        /// <param name="args">The arguments used to specialize the kernel.</param>
+        /// <returns>The kernel to use.</returns>
+        private SpecializationCacheEntry<TDelegate> AcquireTieredKernel(
+            in TArgs args)
         {
-            // Synchronize all accesses below using a read/write scope
-            using var readWriteScope = cacheLock.EnterUpgradeableReadScope();
+            var counters = kernelCache.Counters;
+            var generic = genericKernel.Value;
+            while (true)
+            {
+                using (var readScope = cacheLock.EnterReadScope())
+                {
+                    if (kernelCache.TryPeekValue(args, out var cached) &&
+                        cached.TryAcquire(NextUse()))
+                    {
+                        counters.AddHit();
+                        return cached;
+                    }
+                    if (tieredCache.TryPeekValue(args, out var entry))
+                    {
+                        counters.AddMiss();
+                        if (entry.RegisterLaunch(Threshold))
+                            ScheduleSpecialization(args);
+                        if (!generic.TryAcquire(NextUse()))
+                            throw new ObjectDisposedException(GetType().Name);
+                        return generic;
+                    }
+                }
+
+                // Start tracking the arguments and try again
+                using var writeScope = cacheLock.EnterWriteScope();
+                if (!kernelCache.TryPeekValue(args, out _) &&
+                    !tieredCache.TryPeekValue(args, out _))
+                {
+                    tieredCache.Add(args, new TieredEntry(), 0);
+                }
+            }
+        }
 
-            if (!kernelCache.TryGetValue(args, out var launcher))
+        /// <summary>
+        /// Gets or creates a specialized kernel based on the arguments provided.
+        /// </summary>
+        /// <param name="args">The arguments used to specialize the kernel.</param>
+        /// <returns>The kernel to use.</returns>
+        private SpecializationCacheEntry<TDelegate> AcquireSpecializedKernel(
+            in TArgs args)
+        {
+            var counters = kernelCache.Counters;
+            while (true)
             {
-                // Synchronize all accesses below using a write scope
-                using var writeScope = readWriteScope.EnterWriteScope();
+                if (TryAcquireCachedKernel(args, out var entry))
+                {
+                    counters.AddHit();
+                    return entry;
+                }
+                counters.AddMiss();
+
+                // Compile the kernel without holding any lock. Concurrent launches
+                // using the same arguments wait for the same compilation
+                var specializationArgs = args;
+                var pending = pendingKernels.GetOrAdd(
+                    specializationArgs,
+                    key => new Lazy<SpecializationCacheEntry<TDelegate>>(
+                        () => PublishKernel(
+                            key,
+                            SpecializeKernel(key),
+                            cancellationSource.Token),
+                        LazyThreadSafetyMode.ExecutionAndPublication));
+                try
+                {
+                    entry = pending.Value;
+                }
+                finally
+                {
+                    // Remove only this compilation, since a new one might have been
+                    // started after the kernel has been evicted again
+                    (pendingKernels as ICollection<KeyValuePair<
+                        TArgs,
+                        Lazy<SpecializationCacheEntry<TDelegate>>>>).Remove(
+                        new KeyValuePair<
+                            TArgs,
+                            Lazy<SpecializationCacheEntry<TDelegate>>>(
+                            specializationArgs,
+                            pending));
+                }
+
+                if (entry is null)
+                    throw new ObjectDisposedException(GetType().Name);
 
-                launcher = SpecializeKernel(args);
-                kernelCache.Add(args, launcher);
+                // The kernel might have been evicted by another thread in the
+                // meantime, in which case we have to try again
+                if (entry.TryAcquire(NextUse()))
+                    return entry;
             }
-            return launcher;
         }
 
+        /// <summary>
+        /// Gets or creates a kernel based on the arguments provided and protects it
+        /// from being disposed until
+        /// <see cref="SpecializationCacheEntry{TDelegate}.Release"/> is called.
+        /// </summary>
+        /// <param name="args">The arguments used to specialize the kernel.</param>
+        /// <returns>The acquired kernel to launch.</returns>
+        /// <remarks>
+        /// No lock is held after this method returns. The acquired kernel may be
+        /// evicted from the cache in the meantime, but it is disposed only after it
+        /// has been released.
+        /// </remarks>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public SpecializationCacheEntry<TDelegate> AcquireKernel(TArgs args) =>
+            IsTiered
+            ? AcquireTieredKernel(args)
+            : AcquireSpecializedKernel(args);
+
         #endregion
 
         #region IDisposable
@@ -229,8 +673,22 @@ namespace ILGPU.Runtime
 
             if (disposing)
             {
+                // Cancel all pending specializations and wait for running ones to
+                // leave the cache lock
+                cancellationSource.Cancel();
+                pendingSpecializations.Signal();
+                pendingSpecializations.Wait();
+
+                using (var writeScope = cacheLock.EnterWriteScope())
+                {
+                    kernelCache.Clear();
+                    tieredCache.Clear();
+                    if (genericKernel.IsValueCreated)
+                        genericKernel.Value.Release();
+                }
                 cacheLock.Dispose();
-                kernelCache.Clear();
+                pendingSpecializations.Dispose();
+                cancellationSource.Dispose();
             }
         }
 
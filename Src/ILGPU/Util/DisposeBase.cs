@@ -55,9 +55,6 @@ namespace ILGPU.Util
         /// current object has been disposed, this method throws a
         /// <see cref="ObjectDisposedException"/>.
         /// </summary>
-        /// <remarks>
-        /// This method has been added for general utility purposes and is not used.
-        /// </remarks>
         protected void VerifyNotDisposed()
         {
             if (IsDisposed)
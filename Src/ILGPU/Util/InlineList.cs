@@ -320,6 +320,29 @@ namespace ILGPU.Util
             --Count;
         }
 
+        /// <summary>
+        /// Removes all items that do not satisfy the given predicate without
+        /// allocating a new item array.
+        /// </summary>
+        /// <typeparam name="TPredicate">The predicate type.</typeparam>
+        /// <param name="predicate">The predicate to apply to each item.</param>
+        public void RemoveAllExcept<TPredicate>(TPredicate predicate)
+            where TPredicate : InlineList.IPredicate<T>
+        {
+            int targetIndex = 0;
+            for (int i = 0, e = Count; i < e; ++i)
+            {
+                var item = items[i];
+                if (predicate.Apply(item))
+                    items[targetIndex++] = item;
+            }
+
+            // Release all references to removed items
+            if (targetIndex < Count)
+                Array.Clear(items, targetIndex, Count - targetIndex);
+            Count = targetIndex;
+        }
+
         /// <summary>
         /// Reverses all items in this list.
         /// </summary>
@@ -0,0 +1,313 @@
+﻿// ---------------------------------------------------------------------------------------
+//                                        ILGPU
+//                        Copyright (c) 2016-2020 Marcel Koester
+//                                    www.ilgpu.net
+//
+// File: LruCache.cs
+//
+// This file is part of ILGPU and is distributed under the University of Illinois Open
+// Source License. See LICENSE.txt for details
+// ---------------------------------------------------------------------------------------
+
+using ILGPU.Runtime;
+using System;
+using System.Collections.Generic;
+
+namespace ILGPU.Util
+{
+    /// <summary>
+    /// A cache that is bounded by the number of entries and their accumulated size.
+    /// The least recently used entries are evicted first.
+    /// </summary>
+    /// <typeparam name="TKey">The key type.</typeparam>
+    /// <typeparam name="TValue">The value type.</typeparam>
+    /// <remarks>Members of this class are not thread safe.</remarks>
+    internal sealed class LruCache<TKey, TValue>
+    {
+        #region Nested Types
+
+        /// <summary>
+        /// A single cache entry.
+        /// </summary>
+        private readonly struct Entry
+        {
+            /// <summary>
+            /// Constructs a new cache entry.
+            /// </summary>
+            /// <param name="key">The key.</param>
+            /// <param name="value">The cached value.</param>
+            /// <param name="size">The size of the value in bytes.</param>
+            public Entry(TKey key, TValue value, long size)
+            {
+                Key = key;
+                Value = value;
+                Size = size;
+            }
+
+            /// <summary>
+            /// Returns the key.
+            /// </summary>
+            public TKey Key { get; }
+
+            /// <summary>
+            /// Returns the cached value.
+            /// </summary>
+            public TValue Value { get; }
+
+            /// <summary>
+            /// Returns the size of the value in bytes.
+            /// </summary>
+            public long Size { get; }
+        }
+
+        #endregion
+
+        #region Instance
+
+        /// <summary>
+        /// Maps keys to their nodes in the usage list.
+        /// </summary>
+        private readonly Dictionary<TKey, LinkedListNode<Entry>> entries;
+
+        /// <summary>
+        /// All entries, most recently used first.
+        /// </summary>
+        private readonly LinkedList<Entry> usage = new LinkedList<Entry>();
+
+        /// <summary>
+        /// Constructs a new LRU cache.
+        /// </summary>
+        /// <param name="maxNumEntries">The maximum number of entries.</param>
+        /// <param name="maxSize">The maximum accumulated size in bytes.</param>
+        public LruCache(int maxNumEntries, long maxSize)
+            : this(maxNumEntries, maxSize, new KernelCacheCounters(), null)
+        { }
+
+        /// <summary>
+        /// Constructs a new LRU cache.
+        /// </summary>
+        /// <param name="maxNumEntries">The maximum number of entries.</param>
+        /// <param name="maxSize">The maximum accumulated size in bytes.</param>
+        /// <param name="counters">
+        /// The usage counters to update, which may be shared with other caches.
+        /// </param>
+        /// <param name="released">
+        /// An optional callback that is invoked for each value that is evicted,
+        /// replaced or cleared.
+        /// </param>
+        public LruCache(
+            int maxNumEntries,
+            long maxSize,
+            KernelCacheCounters counters,
+            Action<TValue> released)
+        {
+            if (maxNumEntries < 1)
+                throw new ArgumentOutOfRangeException(nameof(maxNumEntries));
+            if (maxSize < 0)
+                throw new ArgumentOutOfRangeException(nameof(maxSize));
+
+            MaxNumEntries = maxNumEntries;
+            MaxSize = maxSize;
+            Counters = counters ?? throw new ArgumentNullException(nameof(counters));
+            Released = released;
+            entries = new Dictionary<TKey, LinkedListNode<Entry>>();
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Returns the maximum number of entries.
+        /// </summary>
+        public int MaxNumEntries { get; }
+
+        /// <summary>
+        /// Returns the maximum accumulated size in bytes.
+        /// </summary>
+        public long MaxSize { get; }
+
+        /// <summary>
+        /// Returns the number of cached entries.
+        /// </summary>
+        public int Count => entries.Count;
+
+        /// <summary>
+        /// Returns the accumulated size of all entries in bytes.
+        /// </summary>
+        public long Size { get; private set; }
+
+        /// <summary>
+        /// Returns the associated usage counters.
+        /// </summary>
+        public KernelCacheCounters Counters { get; }
+
+        /// <summary>
+        /// Returns the callback that is invoked for each released value (if any).
+        /// </summary>
+        public Action<TValue> Released { get; }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Tries to get a cached value and marks it as most recently used.
+        /// </summary>
+        /// <param name="key">The key.</param>
+        /// <param name="value">The cached value (if any).</param>
+        /// <returns>True, if the value could be found.</returns>
+        public bool TryGetValue(TKey key, out TValue value)
+        {
+            if (!entries.TryGetValue(key, out var node))
+            {
+                Counters.AddMiss();
+                value = default;
+                return false;
+            }
+
+            Counters.AddHit();
+            if (node != usage.First)
+            {
+                usage.Remove(node);
+                usage.AddFirst(node);
+            }
+            value = node.Value.Value;
+            return true;
+        }
+
+        /// <summary>
+        /// Tries to get a cached value without updating the usage order or any
+        /// counters.
+        /// </summary>
+        /// <param name="key">The key.</param>
+        /// <param name="value">The cached value (if any).</param>
+        /// <returns>True, if the value could be found.</returns>
+        /// <remarks>
+        /// In contrast to <see cref="TryGetValue(TKey, out TValue)"/>, this method
+        /// does not modify the cache and can be called by several readers at the
+        /// same time.
+        /// </remarks>
+        public bool TryPeekValue(TKey key, out TValue value)
+        {
+            if (!entries.TryGetValue(key, out var node))
+            {
+                value = default;
+                return false;
+            }
+            value = node.Value.Value;
+            return true;
+        }
+
+        /// <summary>
+        /// Reorders all entries according to usage stamps that have been recorded
+        /// outside of this cache, most recently used first.
+        /// </summary>
+        /// <param name="getUsageStamp">Resolves the usage stamp of a value.</param>
+        /// <remarks>
+        /// This allows readers to record usages without modifying the cache via
+        /// <see cref="TryGetValue(TKey, out TValue)"/>.
+        /// </remarks>
+        public void Reorder(Func<TValue, long> getUsageStamp)
+        {
+            if (usage.Count < 2)
+                return;
+            var nodes = new List<LinkedListNode<Entry>>(usage.Count);
+            for (var node = usage.First; node != null; node = node.Next)
+                nodes.Add(node);
+
+            // Use a stable sort to preserve the current order of equal stamps
+            var stamps = new long[nodes.Count];
+            var indices = new int[nodes.Count];
+            for (int i = 0, e = nodes.Count; i < e; ++i)
+            {
+                stamps[i] = -getUsageStamp(nodes[i].Value.Value);
+                indices[i] = i;
+            }
+            Array.Sort(indices, (left, right) =>
+            {
+                int result = stamps[left].CompareTo(stamps[right]);
+                return result != 0 ? result : left.CompareTo(right);
+            });
+
+            usage.Clear();
+            foreach (var index in indices)
+                usage.AddLast(nodes[index]);
+        }
+
+        /// <summary>
+        /// Adds or replaces a value and evicts the least recently used entries until
+        /// all limits are met. The new entry itself is never evicted.
+        /// </summary>
+        /// <param name="key">The key.</param>
+        /// <param name="value">The value to cache.</param>
+        /// <param name="size">The size of the value in bytes.</param>
+        /// <remarks>
+        /// Replaced and evicted values are passed to <see cref="Released"/>.
+        /// </remarks>
+        public void Add(TKey key, TValue value, long size)
+        {
+            if (entries.TryGetValue(key, out var existing))
+            {
+                RemoveNode(existing);
+                if (!ReferenceEquals(existing.Value.Value, value))
+                    Released?.Invoke(existing.Value.Value);
+            }
+
+            var node = usage.AddFirst(new Entry(key, value, size));
+            entries.Add(key, node);
+            Size += size;
+            Counters.AddEntry(size);
+
+            while (usage.Last != node &&
+                (entries.Count > MaxNumEntries || Size > MaxSize))
+            {
+                var last = usage.Last;
+                RemoveNode(last);
+                Counters.AddEviction();
+                Released?.Invoke(last.Value.Value);
+            }
+        }
+
+        /// <summary>
+        /// Removes the given key from the cache without releasing its value.
+        /// </summary>
+        /// <param name="key">The key to remove.</param>
+        /// <returns>True, if the key has been removed.</returns>
+        public bool Remove(TKey key)
+        {
+            if (!entries.TryGetValue(key, out var node))
+                return false;
+            RemoveNode(node);
+            return true;
+        }
+
+        /// <summary>
+        /// Removes the given node from all internal data structures.
+        /// </summary>
+        /// <param name="node">The node to remove.</param>
+        private void RemoveNode(LinkedListNode<Entry> node)
+        {
+            entries.Remove(node.Value.Key);
+            usage.Remove(node);
+            Size -= node.Value.Size;
+            Counters.RemoveEntry(node.Value.Size);
+        }
+
+        /// <summary>
+        /// Clears all entries while preserving all access counters. All values are
+        /// passed to <see cref="Released"/>.
+        /// </summary>
+        public void Clear()
+        {
+            while (usage.Last != null)
+            {
+                var last = usage.Last;
+                RemoveNode(last);
+                Released?.Invoke(last.Value.Value);
+            }
+        }
+
+        #endregion
+    }
+}
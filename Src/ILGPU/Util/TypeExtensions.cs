@@ -245,6 +245,7 @@ namespace ILGPU.Util
                 BasicValueType.Float16 => typeof(Half),
                 BasicValueType.Float32 => typeof(float),
                 BasicValueType.Float64 => typeof(double),
+                BasicValueType.BFloat16 => typeof(BFloat16),
                 _ => null,
             };
 
@@ -278,6 +279,8 @@ namespace ILGPU.Util
                 default:
                     return type == typeof(Half)
                         ? BasicValueType.Float16
+                        : type == typeof(BFloat16)
+                        ? BasicValueType.BFloat16
                         : BasicValueType.None;
             }
         }
@@ -304,6 +307,8 @@ namespace ILGPU.Util
                 TypeCode.Double => ArithmeticBasicValueType.Float64,
                 _ => type == typeof(Half)
                     ? ArithmeticBasicValueType.Float16
+                    : type == typeof(BFloat16)
+                    ? ArithmeticBasicValueType.BFloat16
                     : ArithmeticBasicValueType.None
             };
 
@@ -337,6 +342,8 @@ namespace ILGPU.Util
                     return BasicValueType.Float32;
                 case ArithmeticBasicValueType.Float64:
                     return BasicValueType.Float64;
+                case ArithmeticBasicValueType.BFloat16:
+                    return BasicValueType.BFloat16;
                 default:
                     return BasicValueType.None;
             }
@@ -371,6 +378,7 @@ namespace ILGPU.Util
                 BasicValueType.Float16 => ArithmeticBasicValueType.Float16,
                 BasicValueType.Float32 => ArithmeticBasicValueType.Float32,
                 BasicValueType.Float64 => ArithmeticBasicValueType.Float64,
+                BasicValueType.BFloat16 => ArithmeticBasicValueType.BFloat16,
                 _ => ArithmeticBasicValueType.None,
             };
 
@@ -422,6 +430,7 @@ namespace ILGPU.Util
                 case BasicValueType.Float16:
                 case BasicValueType.Float32:
                 case BasicValueType.Float64:
+                case BasicValueType.BFloat16:
                     return true;
                 default:
                     return false;
@@ -442,6 +451,7 @@ namespace ILGPU.Util
                 case ArithmeticBasicValueType.Float16:
                 case ArithmeticBasicValueType.Float32:
                 case ArithmeticBasicValueType.Float64:
+                case ArithmeticBasicValueType.BFloat16:
                     return true;
                 default:
                     return false;